@@ -0,0 +1,123 @@
+<?php
+
+require_once(__DIR__ . '/quick/ResourcesPacker.php');
+
+$options = array(
+    array('h',   'help',       0,      false,       'show help'),
+    array('i',   'src',        1,      null,        'source files directory'),
+    array('o',   'output',     1,      null,        'output filename'),
+    array('s',   'stored',     1,      null,        'extension names of the files stored without compression'),
+    array('l',   'level',      1,      9,           'compression level, 0 - 9'),
+    array('c',   'config',     1,      null,        'load options from config file'),
+    array('q',   'quiet',      0,      false,       'quiet'),
+);
+
+function errorhelp()
+{
+    print("\nshow help:\n    pack_resources -h\n\n");
+}
+
+function help()
+{
+    global $options;
+
+    echo <<<EOT
+
+usage: pack_resources -i res -o output ...
+
+options:
+
+EOT;
+
+    for ($i = 0; $i < count($options); $i++)
+    {
+        $o = $options[$i];
+        printf("    -%s %s\n", $o[0], $o[4]);
+    }
+
+    echo <<<EOT
+
+pack all files of a directory to a pack file, which is mounted with CCFileUtils:addPackFile().
+the files are stored as they are when the compression doesn't save at least 10%,
+the images stored as they are are decoded from the pack without being copied.
+
+default stored extension names:
+    png,jpg,jpeg,webp,mp3,ogg,m4a,caf,zip
+
+config file format:
+
+    return array(
+        'src'      => source files directory,
+        'output'   => output filename,
+        'stored'   => extension names of the files stored without compression,
+        'level'    => compression level,
+    );
+
+examples:
+
+    # pack res/* to res.pack
+    pack_resources -i res -o res.pack
+
+    # compress all the files but the mp3
+    pack_resources -i res -o res.pack -s mp3
+
+    # load options from config file
+    pack_resources -c my_config.php
+
+
+EOT;
+
+}
+
+// ----
+
+print("\n");
+if ($argc < 2)
+{
+    help();
+    return(1);
+}
+
+$config = fetchCommandLineArguments($argv, $options, 4);
+if (!$config)
+{
+    errorhelp();
+    return(1);
+}
+
+if ($config['help'])
+{
+    help();
+    return(0);
+}
+
+if ($config['config'])
+{
+    $configFilename = $config['config'];
+    if (file_exists($configFilename))
+    {
+        $config = @include($configFilename);
+    }
+    else
+    {
+        $config = null;
+    }
+
+    if (!is_array($config))
+    {
+        printf("ERR: invalid config file, %s\n", $configFilename);
+        errorhelp();
+        return(1);
+    }
+}
+
+$packer = new ResourcesPacker($config, $options);
+if ($packer->validateConfig())
+{
+    return($packer->run() ? 0 : 1);
+}
+else
+{
+    errorhelp();
+    return(1);
+}
@@ -0,0 +1,259 @@
+<?php
+
+require_once(__DIR__ . '/init.php');
+
+class ResourcesPacker
+{
+    // see CCPackFile.cpp for the format of the packs
+    const PACK_MAGIC = 'CCPK';
+    const PACK_VERSION = 1;
+    const HEADER_SIZE = 32;
+    const ENTRY_SIZE = 32;
+    const DATA_ALIGNMENT = 16;
+
+    const METHOD_STORED = 0;
+    const METHOD_DEFLATED = 1;
+
+    const DEFAULT_STORED_EXTNAMES = 'png,jpg,jpeg,webp,mp3,ogg,m4a,caf,zip';
+
+    private $config;
+    private $options;
+    private $validated = false;
+
+    function __construct($config, $options)
+    {
+        $this->config = $config;
+        $this->options = $options;
+    }
+
+    function validateConfig()
+    {
+        if (PHP_INT_SIZE < 8)
+        {
+            print("ERR: pack_resources needs a 64 bits PHP\n");
+            return false;
+        }
+
+        if (empty($this->config['src']))
+        {
+            printf("ERR: not specifies source files directory\n");
+            return false;
+        }
+
+        if (empty($this->config['output']))
+        {
+            printf("ERR: not specifies output filename\n");
+            return false;
+        }
+
+        if (!isset($this->config['stored']))
+        {
+            $this->config['stored'] = self::DEFAULT_STORED_EXTNAMES;
+        }
+        $stored = explode(',', strtolower($this->config['stored']));
+        $stored = array_map(function($value) {
+            return trim($value, " \t.");
+        }, $stored);
+        $this->config['stored'] = array_filter($stored, function($value) {
+            return !empty($value);
+        });
+
+        if (!isset($this->config['level']) || $this->config['level'] === '')
+        {
+            $this->config['level'] = 9;
+        }
+        $level = (int)$this->config['level'];
+        if ($level < 0 || $level > 9)
+        {
+            printf("ERR: invalid compression level %s\n", $this->config['level']);
+            return false;
+        }
+        $this->config['level'] = $level;
+
+        if (!$this->config['quiet'])
+        {
+            dumpConfig($this->config, $this->options);
+        }
+
+        // check src path
+        $srcpath = realpath($this->config['src']);
+        if (!is_dir($srcpath))
+        {
+            printf("ERR: invalid src dir %s\n", $this->config['src']);
+            return false;
+        }
+        $this->config['srcpath'] = $srcpath;
+        $this->config['srcpathLength'] = strlen($srcpath) + 1;
+
+        if (is_dir($this->config['output']))
+        {
+            printf("ERR: output file is dir %s\n", $this->config['output']);
+            return false;
+        }
+
+        $this->validated = true;
+        return true;
+    }
+
+    function run()
+    {
+        if (!$this->validated)
+        {
+            print("ERR: invalid config\n");
+            return false;
+        }
+
+        if (!$this->config['quiet'])
+        {
+            printf("Pack resource files in path %s\n", $this->config['srcpath']);
+        }
+        $files = array();
+        findFiles($this->config['srcpath'], $files);
+
+        // the entries are sorted by name, the names use '/' on every platform
+        $entries = array();
+        foreach ($files as $path)
+        {
+            $name = str_replace(DS, '/', substr($path, $this->config['srcpathLength']));
+            $entries[$name] = array('path' => $path);
+        }
+        ksort($entries, SORT_STRING);
+
+        $contents = $this->createPack($entries);
+        if ($contents === false)
+        {
+            return false;
+        }
+
+        if (file_put_contents($this->config['output'], $contents) === false)
+        {
+            printf("ERR: cannot write pack file %s\n", $this->config['output']);
+            return false;
+        }
+
+        if (!$this->config['quiet'])
+        {
+            printf("create pack file: %s, %d files, %d KB\n", $this->config['output'], count($entries), ceil(strlen($contents) / 1024));
+            printf("done.\n\n");
+        }
+        return true;
+    }
+
+    protected function createPack(array $entries)
+    {
+        $count = count($entries);
+        $bucketCount = 1;
+        while ($bucketCount < $count * 2)
+        {
+            $bucketCount *= 2;
+        }
+
+        $entriesOffset = self::HEADER_SIZE;
+        $bucketsOffset = $entriesOffset + $count * self::ENTRY_SIZE;
+        $namesOffset = $bucketsOffset + $bucketCount * 4;
+
+        // names table
+        $names = '';
+        foreach ($entries as $name => $entry)
+        {
+            $entries[$name]['nameOffset'] = strlen($names);
+            $entries[$name]['hash'] = $this->hashForName($name);
+            $names .= $name . "\0";
+        }
+        $dataOffset = $this->align($namesOffset + strlen($names));
+
+        // data of the files
+        $data = array();
+        $offset = $dataOffset;
+        foreach ($entries as $name => $entry)
+        {
+            $bytes = file_get_contents($entry['path']);
+            if ($bytes === false)
+            {
+                printf("ERR: cannot read file %s\n", $entry['path']);
+                return false;
+            }
+
+            $size = strlen($bytes);
+            $method = self::METHOD_STORED;
+            $extname = strtolower(pathinfo($name, PATHINFO_EXTENSION));
+            if ($size > 0 && !in_array($extname, $this->config['stored']))
+            {
+                // keep the files stored unless the compression saves at least 10%, they can be read in place
+                $compressed = gzcompress($bytes, $this->config['level']);
+                if ($compressed !== false && strlen($compressed) < $size * 0.9)
+                {
+                    $bytes = $compressed;
+                    $method = self::METHOD_DEFLATED;
+                }
+            }
+
+            $entries[$name]['method'] = $method;
+            $entries[$name]['dataOffset'] = $offset;
+            $entries[$name]['storedSize'] = strlen($bytes);
+            $entries[$name]['size'] = $size;
+
+            $padded = $this->align(strlen($bytes));
+            $data[] = str_pad($bytes, $padded, "\0");
+            $offset += $padded;
+
+            if (!$this->config['quiet'])
+            {
+                printf("  > %s [% 5d KB] %s\n", $method == self::METHOD_STORED ? 'store' : 'deflate', ceil(strlen($bytes) / 1024), $name);
+            }
+        }
+
+        // hash table, an entry goes in the first free bucket from its hash
+        $buckets = array_fill(0, $bucketCount, 0);
+        $index = 0;
+        foreach ($entries as $name => $entry)
+        {
+            $bucket = $entry['hash'] & ($bucketCount - 1);
+            while ($buckets[$bucket] != 0)
+            {
+                $bucket = ($bucket + 1) & ($bucketCount - 1);
+            }
+            $index++;
+            $buckets[$bucket] = $index;
+        }
+
+        $contents = array();
+        $contents[] = self::PACK_MAGIC;
+        $contents[] = pack('V7', self::PACK_VERSION, $count, $bucketCount, $entriesOffset, $bucketsOffset, $namesOffset, 0);
+        foreach ($entries as $name => $entry)
+        {
+            $contents[] = pack('V8', $entry['nameOffset'], strlen($name), $entry['hash'], $entry['method'],
+                               $entry['dataOffset'], $entry['storedSize'], $entry['size'], 0);
+        }
+        foreach ($buckets as $bucket)
+        {
+            $contents[] = pack('V', $bucket);
+        }
+        $contents[] = str_pad($names, $dataOffset - $namesOffset, "\0");
+        $contents = implode('', $contents) . implode('', $data);
+
+        if ($offset > 0xffffffff)
+        {
+            print("ERR: pack file is larger than 4 GB\n");
+            return false;
+        }
+        return $contents;
+    }
+
+    // FNV-1a, CCPackFile::hashForName()
+    protected function hashForName($name)
+    {
+        $hash = 2166136261;
+        $len = strlen($name);
+        for ($i = 0; $i < $len; $i++)
+        {
+            $hash = (($hash ^ ord($name[$i])) * 16777619) & 0xffffffff;
+        }
+        return $hash;
+    }
+
+    protected function align($offset)
+    {
+        return ($offset + self::DATA_ALIGNMENT - 1) & ~(self::DATA_ALIGNMENT - 1);
+    }
+}
@@ -264,7 +264,7 @@ class ScriptsCompiler
             // create ZIP archive
             $zipfile = $this->config['output'];
             $zip = new ZipArchive();
-            if (!$zip->open($zipfile, ZIPARCHIVE::OVERWRITE | ZIPARCHIVE::CM_STORE))
+            if (!$zip->open($zipfile, ZIPARCHIVE::OVERWRITE))
             {
                 return false;
             }
@@ -275,7 +275,13 @@ class ScriptsCompiler
             }
             foreach ($modules as $path => $module)
             {
-                $zip->addFromString($this->config['prefix'] . $module['moduleName'], $bytes[$path]);
+                $name = $this->config['prefix'] . $module['moduleName'];
+                $zip->addFromString($name, $bytes[$path]);
+                // stored chunks are loaded from the archive in place, without inflating them
+                if (method_exists($zip, 'setCompressionName'))
+                {
+                    $zip->setCompressionName($name, ZIPARCHIVE::CM_STORE);
+                }
             }
             $zip->close();
 
@@ -48,6 +48,7 @@ THE SOFTWARE.
 #include "platform/CCFileUtils.h"
 #include "CCApplication.h"
 #include "label_nodes/CCLabelBMFont.h"
+#include "label_nodes/CCGlyphAtlas.h"
 #include "label_nodes/CCLabelAtlas.h"
 #include "actions/CCActionManager.h"
 #include "CCConfiguration.h"
@@ -61,6 +62,11 @@ THE SOFTWARE.
 #include "kazmath/kazmath.h"
 #include "kazmath/GL/matrix.h"
 #include "support/CCProfiling.h"
+#include "support/CCGLRecorder.h"
+#include "sprite_nodes/CCAutoBatchRenderer.h"
+#include "particle_nodes/CCParticleSystem.h"
+#include "support/CCJobPool.h"
+#include "script_support/CCScriptSupport.h"
 #include "platform/CCImage.h"
 #include "CCEGLView.h"
 #include "CCConfiguration.h"
@@ -79,6 +85,7 @@ THE SOFTWARE.
 using namespace std;
 
 unsigned int g_uNumberOfDraws = 0;
+unsigned int g_uNumberOfCulledNodes = 0;
 
 NS_CC_BEGIN
 // XXX it should be a Director ivar. Move it there once support for multiple directors is added
@@ -127,9 +134,14 @@ bool CCDirector::init(void)
     m_pFPSLabel = NULL;
     m_pSPFLabel = NULL;
     m_pDrawsLabel = NULL;
+    m_pGLCallsLabel = NULL;
+    m_pGCLabel = NULL;
     m_uTotalFrames = m_uFrames = 0;
     m_pszFPS = new char[10];
+    m_pszGLCalls = new char[40];
     m_pLastUpdate = new struct cc_timeval();
+    m_fFixedDeltaTime = 0.0f;
+    m_bCullingEnabled = false;
 
     // paused ?
     m_bPaused = false;
@@ -171,6 +183,8 @@ CCDirector::~CCDirector(void)
     CC_SAFE_RELEASE(m_pFPSLabel);
     CC_SAFE_RELEASE(m_pSPFLabel);
     CC_SAFE_RELEASE(m_pDrawsLabel);
+    CC_SAFE_RELEASE(m_pGLCallsLabel);
+    CC_SAFE_RELEASE(m_pGCLabel);
     
     CC_SAFE_RELEASE(m_pRunningScene);
     CC_SAFE_RELEASE(m_pNotificationNode);
@@ -189,6 +203,7 @@ CCDirector::~CCDirector(void)
     CC_SAFE_DELETE(m_pLastUpdate);
     // delete fps string
     delete []m_pszFPS;
+    delete []m_pszGLCalls;
 
     s_SharedDirector = NULL;
 }
@@ -247,6 +262,8 @@ void CCDirector::setGLDefaultValues(void)
 // Draw the Scene
 void CCDirector::drawScene(void)
 {
+    CC_PROFILER_ZONE("CCDirector - drawScene");
+
     // calculate "global" dt
     calculateDeltaTime();
 
@@ -254,6 +271,9 @@ void CCDirector::drawScene(void)
     if (! m_bPaused)
     {
         m_pScheduler->update(m_fDeltaTime);
+
+        // join the particle systems updated in parallel before the render pass
+        CCParticleSystem::runParallelUpdates();
     }
 
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -265,6 +285,13 @@ void CCDirector::drawScene(void)
         setNextScene();
     }
 
+    if (m_bCullingEnabled)
+    {
+        m_obCullingRect.origin = getVisibleOrigin();
+        m_obCullingRect.size = getVisibleSize();
+    }
+    g_uNumberOfCulledNodes = 0;
+
     kmGLPushMatrix();
 
     // draw the scene
@@ -278,6 +305,9 @@ void CCDirector::drawScene(void)
     {
         m_pNotificationNode->visit();
     }
+
+    // draw the sprites still queued by the automatic batching
+    CCAutoBatchRenderer::sharedRenderer()->flush();
     
     if (m_bDisplayStats)
     {
@@ -293,11 +323,24 @@ void CCDirector::drawScene(void)
     {
         m_pobOpenGLView->swapBuffers();
     }
+
+    // close the frame of the recording GL backend
+    CCGLRecorder::sharedRecorder()->endFrame();
     
     if (m_bDisplayStats)
     {
         calculateMPF();
     }
+
+    // let the script engine collect its garbage in the time left before the next frame
+    CCScriptEngineProtocol* pEngine = CCScriptEngineManager::sharedManager()->getScriptEngine();
+    if (pEngine)
+    {
+        struct cc_timeval now;
+        CCTime::gettimeofdayCocos2d(&now, NULL);
+        float fElapsed = (now.tv_sec - m_pLastUpdate->tv_sec) + (now.tv_usec - m_pLastUpdate->tv_usec) / 1000000.0f;
+        pEngine->collectGarbage((float)m_dAnimationInterval - fElapsed);
+    }
 }
 
 void CCDirector::calculateDeltaTime(void)
@@ -317,6 +360,10 @@ void CCDirector::calculateDeltaTime(void)
         m_fDeltaTime = 0;
         m_bNextDeltaTimeZero = false;
     }
+    else if (m_fFixedDeltaTime > 0)
+    {
+        m_fDeltaTime = m_fFixedDeltaTime;
+    }
     else
     {
         m_fDeltaTime = (now.tv_sec - m_pLastUpdate->tv_sec) + (now.tv_usec - m_pLastUpdate->tv_usec) / 1000000.0f;
@@ -377,6 +424,21 @@ void CCDirector::setViewport()
     }
 }
 
+bool CCDirector::isAutoBatchEnabled(void)
+{
+    return CCAutoBatchRenderer::sharedRenderer()->isEnabled();
+}
+
+void CCDirector::setAutoBatchEnabled(bool bAutoBatchEnabled)
+{
+    CCAutoBatchRenderer::sharedRenderer()->setEnabled(bAutoBatchEnabled);
+}
+
+unsigned int CCDirector::getCulledNodeCount(void)
+{
+    return g_uNumberOfCulledNodes;
+}
+
 void CCDirector::setNextDeltaTimeZero(bool bNextDeltaTimeZero)
 {
     m_bNextDeltaTimeZero = bNextDeltaTimeZero;
@@ -384,6 +446,9 @@ void CCDirector::setNextDeltaTimeZero(bool bNextDeltaTimeZero)
 
 void CCDirector::setProjection(ccDirectorProjection kProjection)
 {
+    // the queued sprites are drawn with the current projection
+    CCAutoBatchRenderer::sharedRenderer()->flush();
+
     CCSize size = m_obWinSizeInPoints;
 
     setViewport();
@@ -719,6 +784,8 @@ void CCDirector::purgeDirector()
     CC_SAFE_RELEASE_NULL(m_pFPSLabel);
     CC_SAFE_RELEASE_NULL(m_pSPFLabel);
     CC_SAFE_RELEASE_NULL(m_pDrawsLabel);
+        CC_SAFE_RELEASE_NULL(m_pGLCallsLabel);
+        CC_SAFE_RELEASE_NULL(m_pGCLabel);
 
     // purge bitmap cache
     CCLabelBMFont::purgeCachedData();
@@ -728,6 +795,9 @@ void CCDirector::purgeDirector()
     CCAnimationCache::purgeSharedAnimationCache();
     CCSpriteFrameCache::purgeSharedSpriteFrameCache();
     CCTextureCache::purgeSharedTextureCache();
+    CCAutoBatchRenderer::purgeSharedRenderer();
+    CCGlyphAtlas::purgeSharedGlyphAtlas();
+    CCJobPool::purgeSharedJobPool();
     CCShaderCache::purgeSharedShaderCache();
     CCFileUtils::purgeFileUtils();
     CCConfiguration::purgeConfiguration();
@@ -828,6 +898,9 @@ void CCDirector::showStats(void)
     {
         if (m_pFPSLabel && m_pSPFLabel && m_pDrawsLabel)
         {
+            CCScriptEngineProtocol* pEngine = CCScriptEngineManager::sharedManager()->getScriptEngine();
+            const ccScriptGCStats* pGCStats = pEngine ? pEngine->getGCStats() : NULL;
+
             if (m_fAccumDt > CC_DIRECTOR_STATS_INTERVAL)
             {
                 sprintf(m_pszFPS, "%.3f", m_fSecondsPerFrame);
@@ -840,10 +913,44 @@ void CCDirector::showStats(void)
                 sprintf(m_pszFPS, "%.1f", m_fFrameRate);
                 m_pFPSLabel->setString(m_pszFPS);
                 
-                sprintf(m_pszFPS, "%4lu", (unsigned long)g_uNumberOfDraws);
-                m_pDrawsLabel->setString(m_pszFPS);
+                if (m_bCullingEnabled)
+                {
+                    // draws/culled nodes
+                    sprintf(m_pszGLCalls, "%4lu/%lu", (unsigned long)g_uNumberOfDraws, (unsigned long)g_uNumberOfCulledNodes);
+                    m_pDrawsLabel->setString(m_pszGLCalls);
+                }
+                else
+                {
+                    sprintf(m_pszFPS, "%4lu", (unsigned long)g_uNumberOfDraws);
+                    m_pDrawsLabel->setString(m_pszFPS);
+                }
+
+                // GL calls/vertices/uploads of the last frame, the label atlas only has digits, '.' and '/'
+                CCGLRecorder* pRecorder = CCGLRecorder::sharedRecorder();
+                if (pRecorder->isActive() && m_pGLCallsLabel)
+                {
+                    const ccGLFrameStats& stats = pRecorder->getLastFrameStats();
+                    sprintf(m_pszGLCalls, "%u/%u/%u", stats.calls, stats.vertices,
+                            stats.bufferUploads + stats.textureUploads);
+                    m_pGLCallsLabel->setString(m_pszGLCalls);
+                }
+
+                // milliseconds spent collecting the garbage of the scripts in the last frame/heap size in KB
+                if (pGCStats && m_pGCLabel)
+                {
+                    sprintf(m_pszGLCalls, "%.2f/%u", pGCStats->gcTime * 1000.0f, pGCStats->heapSize);
+                    m_pGCLabel->setString(m_pszGLCalls);
+                }
             }
             
+            if (m_pGLCallsLabel && CCGLRecorder::sharedRecorder()->isActive())
+            {
+                m_pGLCallsLabel->visit();
+            }
+            if (m_pGCLabel && pGCStats)
+            {
+                m_pGCLabel->visit();
+            }
             m_pDrawsLabel->visit();
             m_pFPSLabel->visit();
             m_pSPFLabel->visit();
@@ -879,6 +986,8 @@ void CCDirector::createStatsLabel()
         CC_SAFE_RELEASE_NULL(m_pFPSLabel);
         CC_SAFE_RELEASE_NULL(m_pSPFLabel);
         CC_SAFE_RELEASE_NULL(m_pDrawsLabel);
+        CC_SAFE_RELEASE_NULL(m_pGLCallsLabel);
+        CC_SAFE_RELEASE_NULL(m_pGCLabel);
         textureCache->removeTextureForKey("cc_fps_images");
         CCFileUtils::sharedFileUtils()->purgeCachedEntries();
     }
@@ -929,8 +1038,20 @@ void CCDirector::createStatsLabel()
     m_pDrawsLabel->initWithString("000", texture, 12, 32, '.');
     m_pDrawsLabel->setScale(factor);
 
+    m_pGLCallsLabel = new CCLabelAtlas();
+    m_pGLCallsLabel->setIgnoreContentScaleFactor(true);
+    m_pGLCallsLabel->initWithString("0/0/0", texture, 12, 32, '.');
+    m_pGLCallsLabel->setScale(factor);
+
+    m_pGCLabel = new CCLabelAtlas();
+    m_pGCLabel->setIgnoreContentScaleFactor(true);
+    m_pGCLabel->initWithString("0.00/0", texture, 12, 32, '.');
+    m_pGCLabel->setScale(factor);
+
     CCTexture2D::setDefaultAlphaPixelFormat(currentFormat);
 
+    m_pGCLabel->setPosition(ccpAdd(ccp(0, 68*factor), CC_DIRECTOR_STATS_POSITION));
+    m_pGLCallsLabel->setPosition(ccpAdd(ccp(0, 51*factor), CC_DIRECTOR_STATS_POSITION));
     m_pDrawsLabel->setPosition(ccpAdd(ccp(0, 34*factor), CC_DIRECTOR_STATS_POSITION));
     m_pSPFLabel->setPosition(ccpAdd(ccp(0, 17*factor), CC_DIRECTOR_STATS_POSITION));
     m_pFPSLabel->setPosition(CC_DIRECTOR_STATS_POSITION);
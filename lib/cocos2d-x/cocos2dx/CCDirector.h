@@ -143,6 +143,29 @@ public:
     inline bool isNextDeltaTimeZero(void) { return m_bNextDeltaTimeZero; }
     void setNextDeltaTimeZero(bool bNextDeltaTimeZero);
 
+    /** Advance the scheduler by a fixed delta time every frame instead of the measured one.
+     Useful to make automated runs reproducible. 0 (the default) uses the real clock.
+     */
+    inline float getFixedDeltaTime(void) { return m_fFixedDeltaTime; }
+    inline void setFixedDeltaTime(float fFixedDeltaTime) { m_fFixedDeltaTime = fFixedDeltaTime; }
+
+    /** Whether the nodes outside the visible rect skip drawing.
+     Sprites, sprite batch children (including labels and tile map layers) and particle systems are culled. Default is false.
+     */
+    inline bool isCullingEnabled(void) { return m_bCullingEnabled; }
+    inline void setCullingEnabled(bool bCullingEnabled) { m_bCullingEnabled = bCullingEnabled; }
+    /** The visible rect in world coordinates the culling tests against, updated every frame */
+    inline const CCRect& getCullingRect(void) { return m_obCullingRect; }
+    /** Number of nodes culled while drawing the last frame */
+    unsigned int getCulledNodeCount(void);
+
+    /** Whether the sprites which are not children of a CCSpriteBatchNode are batched automatically.
+     Consecutive sprites, BMFont labels and CCScale9Sprite sharing the same texture, shader and blend function are drawn
+     with a single draw call, see CCAutoBatchRenderer. Default is false.
+     */
+    bool isAutoBatchEnabled(void);
+    void setAutoBatchEnabled(bool bAutoBatchEnabled);
+
     /** Whether or not the Director is paused */
     inline bool isPaused(void) { return m_bPaused; }
 
@@ -393,6 +416,8 @@ protected:
     CCLabelAtlas *m_pFPSLabel;
     CCLabelAtlas *m_pSPFLabel;
     CCLabelAtlas *m_pDrawsLabel;
+    CCLabelAtlas *m_pGLCallsLabel;
+    CCLabelAtlas *m_pGCLabel;
     
     /** Whether or not the Director is paused */
     bool m_bPaused;
@@ -420,6 +445,13 @@ protected:
 
     /* whether or not the next delta time will be zero */
     bool m_bNextDeltaTimeZero;
+
+    /* delta time used for every frame when > 0 */
+    float m_fFixedDeltaTime;
+
+    /* viewport culling */
+    bool m_bCullingEnabled;
+    CCRect m_obCullingRect;
     
     /* projection used */
     ccDirectorProjection m_eProjection;
@@ -432,6 +464,8 @@ protected:
 
     /* store the fps string */
     char *m_pszFPS;
+    /* store the GL recorder and culling stats strings */
+    char *m_pszGLCalls;
 
     /* This object will be visited after the scene. Useful to hook a notification node */
     CCNode *m_pNotificationNode;
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "support/data_support/ccCArray.h"
 #include "cocoa/CCArray.h"
 #include "script_support/CCScriptSupport.h"
+#include "support/CCProfiling.h"
 
 using namespace std;
 
@@ -778,6 +779,8 @@ void CCScheduler::resumeTargets(CCSet* pTargetsToResume)
 // main loop
 void CCScheduler::update(float dt)
 {
+    CC_PROFILER_ZONE("CCScheduler - update");
+
     m_bUpdateHashLocked = true;
 
     if (m_fTimeScale != 1.0f)
@@ -42,6 +42,9 @@ THE SOFTWARE.
 #include "kazmath/GL/matrix.h"
 #include "support/component/CCComponent.h"
 #include "support/component/CCComponentContainer.h"
+#include "support/CCProfiling.h"
+#include <algorithm>
+#include <vector>
 
 #if CC_NODE_RENDER_SUBPIXEL
 #define RENDER_IN_SUBPIXEL
@@ -55,6 +58,10 @@ NS_CC_BEGIN
 static int s_globalOrderOfArrival = 1;
 
 unsigned int CCNode::g_drawOrder = 0;
+unsigned int CCNode::s_uWorldTransformGeneration = 0;
+unsigned int CCNode::s_uModelViewGeneration = 0;
+CCNode* CCNode::s_pModelViewParent = NULL;
+const kmMat4* CCNode::s_pLoadedModelView = NULL;
 
 CCNode::CCNode(void)
 : m_fRotationX(0.0f)
@@ -89,9 +96,19 @@ CCNode::CCNode(void)
 , m_bTransformDirty(true)
 , m_bInverseDirty(true)
 , m_bAdditionalTransformDirty(false)
+, m_uTransformGeneration(0)
+, m_uWorldTransformGeneration(0)
+, m_uWorldLocalGeneration(0)
+, m_uWorldParentGeneration(0)
+, m_uWorldInverseGeneration(0)
+, m_uModelViewGeneration(0)
+, m_uModelViewLocalGeneration(0)
+, m_uModelViewParentGeneration(0)
 , m_bVisible(true)
 , m_bIgnoreAnchorPointForPosition(false)
 , m_bReorderChildDirty(false)
+, m_pReorderedChildren(NULL)
+, m_bReorderedChildrenOverflow(false)
 , m_nScriptHandler(0)
 , m_nUpdateScriptHandler(0)
 , m_pComponentContainer(NULL)
@@ -102,6 +119,7 @@ CCNode::CCNode(void)
 , m_realColor(ccWHITE)
 , m_cascadeColorEnabled(false)
 , m_cascadeOpacityEnabled(false)
+, m_cascadeCullingEnabled(false)
 , m_drawOrder(0)
 , m_bTouchEnabled(false)
 , m_pScriptTouchHandlerEntry(NULL)
@@ -139,6 +157,7 @@ CCNode::~CCNode(void)
     CC_SAFE_RELEASE(m_pGrid);
     CC_SAFE_RELEASE(m_pShaderProgram);
     CC_SAFE_RELEASE(m_pUserObject);
+    CC_SAFE_RELEASE(m_pReorderedChildren);
 
     if(m_pChildren && m_pChildren->count() > 0)
     {
@@ -200,6 +219,10 @@ int CCNode::getZOrder()
 void CCNode::_setZOrder(int z)
 {
     m_nZOrder = z;
+    if (m_pParent)
+    {
+        m_pParent->childReordered(this);
+    }
 }
 
 void CCNode::setZOrder(int z)
@@ -222,6 +245,8 @@ float CCNode::getVertexZ()
 void CCNode::setVertexZ(float var)
 {
     m_fVertexZ = var;
+    // the vertex z is part of the cached model view matrix
+    m_bTransformDirty = true;
 }
 
 
@@ -517,6 +542,10 @@ unsigned int CCNode::getOrderOfArrival()
 void CCNode::setOrderOfArrival(unsigned int uOrderOfArrival)
 {
     m_uOrderOfArrival = uOrderOfArrival;
+    if (m_pParent)
+    {
+        m_pParent->childReordered(this);
+    }
 }
 
 CCGLProgram* CCNode::getShaderProgram()
@@ -629,6 +658,39 @@ void CCNode::setCascadeBoundingBox(const cocos2d::CCRect &boundingBox)
     m_cascadeBoundingBox = boundingBox;
 }
 
+CCRect CCNode::getCullingBox(void)
+{
+    return CCRectZero;
+}
+
+bool CCNode::isCulled(void)
+{
+    CCDirector* pDirector = CCDirector::sharedDirector();
+    if (! pDirector->isCullingEnabled())
+    {
+        return false;
+    }
+
+    CCRect box = getCullingBox();
+    if (box.equals(CCRectZero))
+    {
+        return false;
+    }
+
+    box = CCRectApplyAffineTransform(box, nodeToWorldTransform());
+    return ! box.intersectsRect(pDirector->getCullingRect());
+}
+
+void CCNode::setCascadeCullingEnabled(bool cascadeCullingEnabled)
+{
+    m_cascadeCullingEnabled = cascadeCullingEnabled;
+}
+
+bool CCNode::isCascadeCullingEnabled(void)
+{
+    return m_cascadeCullingEnabled;
+}
+
 CCNode * CCNode::create(void)
 {
 	CCNode * pRet = new CCNode();
@@ -820,6 +882,11 @@ void CCNode::removeAllChildrenWithCleanup(bool cleanup)
         }
         
         m_pChildren->removeAllObjects();
+        if (m_pReorderedChildren)
+        {
+            m_pReorderedChildren->removeAllObjects();
+        }
+        m_bReorderedChildrenOverflow = false;
     }
     
 }
@@ -845,6 +912,11 @@ void CCNode::detachChild(CCNode *child, bool doCleanup)
     // set parent nil at the end
     child->setParent(NULL);
 
+    if (m_pReorderedChildren)
+    {
+        m_pReorderedChildren->removeObject(child);
+    }
+
     m_pChildren->removeObject(child);
 }
 
@@ -855,6 +927,7 @@ void CCNode::insertChild(CCNode* child, int z)
     m_bReorderChildDirty = true;
     ccArrayAppendObjectWithResize(m_pChildren->data, child);
     child->_setZOrder(z);
+    childReordered(child);
 }
 
 void CCNode::reorderChild(CCNode *child, int zOrder)
@@ -865,33 +938,239 @@ void CCNode::reorderChild(CCNode *child, int zOrder)
     child->_setZOrder(zOrder);
 }
 
+// more reordered children than this are not tracked, the sort looks at all the children instead
+#define kCCNodeMaxReorderedChildren 32
+
+void CCNode::childReordered(CCNode* child)
+{
+    if (m_bReorderedChildrenOverflow)
+    {
+        return;
+    }
+
+    if (! m_pReorderedChildren)
+    {
+        m_pReorderedChildren = CCArray::createWithCapacity(4);
+        m_pReorderedChildren->retain();
+    }
+    else if (m_pReorderedChildren->containsObject(child))
+    {
+        return;
+    }
+
+    if (m_pReorderedChildren->count() == kCCNodeMaxReorderedChildren)
+    {
+        m_pReorderedChildren->removeAllObjects();
+        m_bReorderedChildrenOverflow = true;
+        return;
+    }
+    m_pReorderedChildren->addObject(child);
+}
+
 void CCNode::sortAllChildren()
 {
     if (m_bReorderChildDirty)
     {
-        int i,j,length = m_pChildren->data->num;
-        CCNode ** x = (CCNode**)m_pChildren->data->arr;
-        CCNode *tempItem;
+        sortChildrenByZOrder();
+
+        //don't need to check children recursively, that's done in visit of each child
+
+        m_bReorderChildDirty = false;
+    }
+}
+
+// a child, its sort key and its index in the children array before sorting
+typedef struct _ccNodeSortEntry
+{
+    int zOrder;
+    unsigned int orderOfArrival;
+    int index;
+    CCNode* node;
+} ccNodeSortEntry;
+
+// children are drawn by zOrder, then by orderOfArrival when the zOrder is the same
+static inline bool nodeSortKeyLess(const ccNodeSortEntry& a, const ccNodeSortEntry& b)
+{
+    return a.zOrder < b.zOrder || ( a.zOrder == b.zOrder && a.orderOfArrival < b.orderOfArrival );
+}
+
+// the array order breaks the remaining ties, std::sort then gives the result of a stable sort
+static inline bool nodeSortEntryLess(const ccNodeSortEntry& a, const ccNodeSortEntry& b)
+{
+    if (nodeSortKeyLess(a, b))
+    {
+        return true;
+    }
+    return ! nodeSortKeyLess(b, a) && a.index < b.index;
+}
+
+// average distance the insertion sort may move the children before std::sort takes over
+#define kCCNodeSortMaxMovesPerChild 64
+
+// sorting is not reentrant: children are sorted after their parent, from visit
+static std::vector<ccNodeSortEntry> s_sortEntries;
+static std::vector<CCNode*> s_sortMovedNodes;
+static std::vector<int> s_sortMovedIndices;
+static std::vector<CCNode*> s_sortKept;
+
+void CCNode::sortChildrenByZOrder(void)
+{
+    int length = m_pChildren ? m_pChildren->data->num : 0;
+    CCNode ** x = (CCNode**)(m_pChildren ? m_pChildren->data->arr : NULL);
+
+    bool bRelocated = false;
+    if (! m_bReorderedChildrenOverflow && m_pReorderedChildren && m_pReorderedChildren->count() > 0 && length > 1)
+    {
+        bRelocated = relocateReorderedChildren();
+    }
+
+    if (m_pReorderedChildren)
+    {
+        m_pReorderedChildren->removeAllObjects();
+    }
+    m_bReorderedChildrenOverflow = false;
+
+    if (bRelocated)
+    {
+        return;
+    }
+
+    // insertion sort, the cheapest when the children moved a little (children sorted by y).
+    // It gives up when they moved too far, before it goes quadratic.
+    int budget = length * kCCNodeSortMaxMovesPerChild;
+    int i,j;
+    CCNode *tempItem;
+    for(i=1; i<length && budget >= 0; i++)
+    {
+        tempItem = x[i];
+        j = i-1;
+
+        //continue moving element downwards while zOrder is smaller or when zOrder is the same but orderOfArrival is smaller
+        while(j>=0 && ( tempItem->m_nZOrder < x[j]->m_nZOrder || ( tempItem->m_nZOrder== x[j]->m_nZOrder && tempItem->m_uOrderOfArrival < x[j]->m_uOrderOfArrival ) ) )
+        {
+            x[j+1] = x[j];
+            j = j-1;
+        }
+        x[j+1] = tempItem;
+        budget -= i-1-j;
+    }
+
+    if (budget >= 0)
+    {
+        return;
+    }
+
+    // sort the rest, the insertion sort kept the children with the same key in order
+    s_sortEntries.resize(length);
+    for (i = 0; i < length; i++)
+    {
+        ccNodeSortEntry entry = { x[i]->m_nZOrder, x[i]->m_uOrderOfArrival, i, x[i] };
+        s_sortEntries[i] = entry;
+    }
+    std::sort(s_sortEntries.begin(), s_sortEntries.end(), nodeSortEntryLess);
+    for (i = 0; i < length; i++)
+    {
+        x[i] = s_sortEntries[i].node;
+    }
+}
+
+bool CCNode::relocateReorderedChildren(void)
+{
+    int length = m_pChildren->data->num;
+    CCNode ** x = (CCNode**)m_pChildren->data->arr;
+
+    // the reordered children, by key
+    s_sortEntries.clear();
+    s_sortMovedNodes.clear();
+    CCObject* pObj = NULL;
+    CCARRAY_FOREACH(m_pReorderedChildren, pObj)
+    {
+        CCNode* pNode = (CCNode*)pObj;
+        ccNodeSortEntry entry = { pNode->m_nZOrder, pNode->m_uOrderOfArrival, 0, pNode };
+        s_sortEntries.push_back(entry);
+        s_sortMovedNodes.push_back(pNode);
+    }
+    std::sort(s_sortEntries.begin(), s_sortEntries.end(), nodeSortKeyLess);
+
+    // where the reordered children are now, a linear search of pointers is fast for a few children
+    s_sortMovedIndices.clear();
+    for (std::vector<CCNode*>::iterator it = s_sortMovedNodes.begin(); it != s_sortMovedNodes.end(); ++it)
+    {
+        CCNode** pFound = std::find(x, x + length, *it);
+        if (pFound == x + length)
+        {
+            return false;
+        }
+        s_sortMovedIndices.push_back((int)(pFound - x));
+    }
+    std::sort(s_sortMovedIndices.begin(), s_sortMovedIndices.end());
+
+    // the other children didn't change since the last sort, they are still in order
+    s_sortKept.resize(length - s_sortMovedIndices.size());
+    int keptCount = 0;
+    int start = 0;
+    for (std::vector<int>::iterator it = s_sortMovedIndices.begin(); it != s_sortMovedIndices.end(); ++it)
+    {
+        std::copy(x + start, x + *it, s_sortKept.begin() + keptCount);
+        keptCount += *it - start;
+        start = *it + 1;
+    }
+    std::copy(x + start, x + length, s_sortKept.begin() + keptCount);
+    keptCount += length - start;
 
-        // insertion sort
-        for(i=1; i<length; i++)
+    // find where each reordered child goes, the array order would decide ties so they need a full sort
+    int pos = 0;
+    for (std::vector<ccNodeSortEntry>::iterator it = s_sortEntries.begin(); it != s_sortEntries.end(); ++it)
+    {
+        if (it != s_sortEntries.begin() && ! nodeSortKeyLess(*(it - 1), *it))
         {
-            tempItem = x[i];
-            j = i-1;
+            return false;
+        }
 
-            //continue moving element downwards while zOrder is smaller or when zOrder is the same but mutatedIndex is smaller
-            while(j>=0 && ( tempItem->m_nZOrder < x[j]->m_nZOrder || ( tempItem->m_nZOrder== x[j]->m_nZOrder && tempItem->m_uOrderOfArrival < x[j]->m_uOrderOfArrival ) ) )
+        // binary search of the first kept child drawn after this one
+        int lo = pos, hi = keptCount;
+        while (lo < hi)
+        {
+            int mid = (lo + hi) / 2;
+            CCNode* pKept = s_sortKept[mid];
+            ccNodeSortEntry kept = { pKept->m_nZOrder, pKept->m_uOrderOfArrival, 0, pKept };
+            if (nodeSortKeyLess(kept, *it))
+            {
+                lo = mid + 1;
+            }
+            else
             {
-                x[j+1] = x[j];
-                j = j-1;
+                hi = mid;
             }
-            x[j+1] = tempItem;
         }
+        if (lo < keptCount)
+        {
+            CCNode* pKept = s_sortKept[lo];
+            if (pKept->m_nZOrder == it->zOrder && pKept->m_uOrderOfArrival == it->orderOfArrival)
+            {
+                return false;
+            }
+        }
+        it->index = lo;
+        pos = lo;
+    }
 
-        //don't need to check children recursively, that's done in visit of each child
-
-        m_bReorderChildDirty = false;
+    // merge
+    int k = 0;
+    int kept = 0;
+    for (std::vector<ccNodeSortEntry>::iterator it = s_sortEntries.begin(); it != s_sortEntries.end(); ++it)
+    {
+        while (kept < it->index)
+        {
+            x[k++] = s_sortKept[kept++];
+        }
+        x[k++] = it->node;
+    }
+    while (kept < keptCount)
+    {
+        x[k++] = s_sortKept[kept++];
     }
+    return true;
 }
 
  void CCNode::draw()
@@ -904,17 +1183,52 @@ void CCNode::sortAllChildren()
 
 void CCNode::visit()
 {
+    CC_PROFILER_ZONE("CCNode - visit");
+
     m_drawOrder = ++g_drawOrder;
     // quick return if not visible. children won't be drawn.
     if (!m_bVisible) return;
-    kmGLPushMatrix();
 
-     if (m_pGrid && m_pGrid->isActive())
-     {
-         m_pGrid->beforeDraw();
-     }
+    // off-screen nodes skip draw, and their children too if cascade culling is enabled
+    bool bCulled = isCulled();
+    if (bCulled)
+    {
+        CC_INCREMENT_CULLED_NODES(1);
+        if (m_cascadeCullingEnabled)
+        {
+            m_uOrderOfArrival = 0;
+            return;
+        }
+    }
+
+    // while the parent visits its children, its cached matrix is the incoming one.
+    // grids and cameras work on the matrix stack, those nodes push it and read it back.
+    bool bGridActive = m_pGrid && m_pGrid->isActive();
+    bool bUseStack = m_pParent == NULL || m_pParent != s_pModelViewParent || bGridActive || m_pCamera != NULL;
+    CCNode* pPrevModelViewParent = s_pModelViewParent;
+    const kmMat4* pPrevLoadedModelView = s_pLoadedModelView;
+
+    if (bUseStack)
+    {
+        kmGLPushMatrix();
+
+        if (bGridActive)
+        {
+            m_pGrid->beforeDraw();
+        }
+
+        this->transform();
 
-    this->transform();
+        // the camera is not part of the cached matrix, the children read the stack then
+        bool bCamera = m_pCamera != NULL && !bGridActive;
+        s_pLoadedModelView = bCamera ? NULL : &m_tModelViewTransform;
+        s_pModelViewParent = bCamera ? NULL : this;
+    }
+    else
+    {
+        updateModelViewTransform(m_pParent->m_tModelViewTransform, m_pParent->m_uModelViewGeneration);
+        s_pModelViewParent = this;
+    }
 
     CCNode* pNode = NULL;
     unsigned int i = 0;
@@ -938,7 +1252,10 @@ void CCNode::visit()
             }
         }
         // self draw
-        this->draw();
+        if (!bCulled)
+        {
+            this->drawWithModelView();
+        }
 
         for( ; i < arrayData->num; i++ )
         {
@@ -949,20 +1266,41 @@ void CCNode::visit()
             }
         }        
     }
-    else
+    else if (!bCulled)
     {
-        this->draw();
+        this->drawWithModelView();
     }
 
     // reset for next frame
     m_uOrderOfArrival = 0;
 
-     if (m_pGrid && m_pGrid->isActive())
-     {
-         m_pGrid->afterDraw(this);
+    if (bUseStack)
+    {
+        if (bGridActive)
+        {
+            m_pGrid->afterDraw(this);
+        }
+
+        kmGLPopMatrix();
+        s_pLoadedModelView = pPrevLoadedModelView;
     }
- 
-    kmGLPopMatrix();
+    s_pModelViewParent = pPrevModelViewParent;
+}
+
+void CCNode::drawWithModelView()
+{
+    // the children visited without a push left their own matrix on the stack
+    CCNode* pModelViewParent = s_pModelViewParent;
+    if (pModelViewParent == this && s_pLoadedModelView != &m_tModelViewTransform)
+    {
+        kmGLLoadMatrix(&m_tModelViewTransform);
+        s_pLoadedModelView = &m_tModelViewTransform;
+    }
+
+    // nodes visited from draw(), e.g. into a render texture, read the stack
+    s_pModelViewParent = NULL;
+    this->draw();
+    s_pModelViewParent = pModelViewParent;
 }
 
 void CCNode::transformAncestors()
@@ -976,16 +1314,20 @@ void CCNode::transformAncestors()
 
 void CCNode::transform()
 {    
-    kmMat4 transfrom4x4;
-
-    // Convert 3x3 into 4x4 matrix
-    CCAffineTransform tmpAffine = this->nodeToParentTransform();
-    CGAffineToGL(&tmpAffine, transfrom4x4.mat);
-
-    // Update Z vertex manually
-    transfrom4x4.mat[14] = m_fVertexZ;
+    if (m_pParent != NULL && m_pParent == s_pModelViewParent && !(m_pGrid && m_pGrid->isActive()))
+    {
+        updateModelViewTransform(m_pParent->m_tModelViewTransform, m_pParent->m_uModelViewGeneration);
+    }
+    else
+    {
+        kmMat4 parentModelView;
+        kmGLGetMatrix(KM_GL_MODELVIEW, &parentModelView);
+        updateModelViewTransform(parentModelView, 0);
+    }
 
-    kmGLMultMatrix( &transfrom4x4 );
+    kmGLLoadMatrix(&m_tModelViewTransform);
+    // the caller pops the matrix it pushed, what is on top afterwards is unknown
+    s_pLoadedModelView = NULL;
 
 
     // XXX: Expensive calls. Camera should be integrated into the cached affine matrix
@@ -1315,6 +1657,7 @@ CCAffineTransform CCNode::nodeToParentTransform(void)
         }
 
         m_bTransformDirty = false;
+        ++m_uTransformGeneration;
     }
 
     return m_sTransform;
@@ -1337,19 +1680,78 @@ CCAffineTransform CCNode::parentToNodeTransform(void)
     return m_sInverse;
 }
 
-CCAffineTransform CCNode::nodeToWorldTransform()
+void CCNode::updateWorldTransform(void)
 {
+    unsigned int parentGeneration = 0;
+    if (m_pParent)
+    {
+        m_pParent->updateWorldTransform();
+        parentGeneration = m_pParent->m_uWorldTransformGeneration;
+    }
+
+    // recomputes the local transform if it is dirty, which bumps m_uTransformGeneration
     CCAffineTransform t = this->nodeToParentTransform();
 
-    for (CCNode *p = m_pParent; p != NULL; p = p->getParent())
-        t = CCAffineTransformConcat(t, p->nodeToParentTransform());
+    if (m_uWorldTransformGeneration == 0
+        || m_uWorldLocalGeneration != m_uTransformGeneration
+        || m_uWorldParentGeneration != parentGeneration)
+    {
+        m_sWorldTransform = m_pParent ? CCAffineTransformConcat(t, m_pParent->m_sWorldTransform) : t;
+        m_uWorldLocalGeneration = m_uTransformGeneration;
+        m_uWorldParentGeneration = parentGeneration;
+        m_uWorldTransformGeneration = ++s_uWorldTransformGeneration;
+    }
+}
+
+void CCNode::updateModelViewTransform(const kmMat4& parentModelView, unsigned int uParentGeneration)
+{
+    // recomputes the local transform if it is dirty, which bumps m_uTransformGeneration
+    CCAffineTransform tmpAffine = this->nodeToParentTransform();
+
+    if (m_uModelViewGeneration == 0
+        || m_uModelViewLocalGeneration != m_uTransformGeneration
+        || m_uModelViewParentGeneration != uParentGeneration
+        || (uParentGeneration == 0 && memcmp(&parentModelView, &m_tParentModelView, sizeof(kmMat4)) != 0))
+    {
+        kmMat4 transfrom4x4;
+
+        // Convert 3x3 into 4x4 matrix
+        CGAffineToGL(&tmpAffine, transfrom4x4.mat);
+
+        // Update Z vertex manually
+        transfrom4x4.mat[14] = m_fVertexZ;
 
-    return t;
+        kmMat4Multiply(&m_tModelViewTransform, &parentModelView, &transfrom4x4);
+        if (uParentGeneration == 0)
+        {
+            m_tParentModelView = parentModelView;
+        }
+        m_uModelViewLocalGeneration = m_uTransformGeneration;
+        m_uModelViewParentGeneration = uParentGeneration;
+        m_uModelViewGeneration = ++s_uModelViewGeneration;
+
+        if (s_pLoadedModelView == &m_tModelViewTransform)
+        {
+            s_pLoadedModelView = NULL;
+        }
+    }
+}
+
+CCAffineTransform CCNode::nodeToWorldTransform()
+{
+    updateWorldTransform();
+    return m_sWorldTransform;
 }
 
 CCAffineTransform CCNode::worldToNodeTransform(void)
 {
-    return CCAffineTransformInvert(this->nodeToWorldTransform());
+    updateWorldTransform();
+    if (m_uWorldInverseGeneration != m_uWorldTransformGeneration)
+    {
+        m_sWorldInverse = CCAffineTransformInvert(m_sWorldTransform);
+        m_uWorldInverseGeneration = m_uWorldTransformGeneration;
+    }
+    return m_sWorldInverse;
 }
 
 CCPoint CCNode::convertToNodeSpace(const CCPoint& worldPoint)
@@ -186,7 +186,7 @@ public:
      *
      * This is an internal method. Don't call it outside the framework.
      * The difference between setZOrder(int) and _setOrder(int) is:
-     * - _setZOrder(int) is a pure setter for m_nZOrder memeber variable
+     * - _setZOrder(int) is a pure setter for m_nZOrder memeber variable, it only tells the parent to relocate this node in the next sort
      * - setZOrder(int) firstly changes m_nZOrder, then recorder this node in its parent's chilren array.
      */
     virtual void _setZOrder(int z);
@@ -607,7 +607,7 @@ public:
      *
      * @return a CCNode object whose tag equals to the input parameter
      */
-    CCNode * getChildByTag(int tag);
+    virtual CCNode * getChildByTag(int tag);
     /**
      * Return an array of children
      *
@@ -1020,6 +1020,25 @@ public:
     virtual CCRect getCascadeBoundingBox(bool convertToWorld = true);
     virtual void setCascadeBoundingBox(const CCRect &boundingBox);
 
+    /**
+     * Returns the box of what the node draws, in node coordinates.
+     * Used by the viewport culling of CCDirector, nodes returning an empty box are never culled.
+     */
+    virtual CCRect getCullingBox(void);
+
+    /**
+     * Returns true if the culling of CCDirector is enabled and the culling box of the node,
+     * in world coordinates, doesn't intersect the visible rect.
+     */
+    bool isCulled(void);
+
+    /**
+     * Sets whether the children are skipped together with the node when it is culled.
+     * Only enable it when all the children lie inside the culling box of the node. Default is false.
+     */
+    virtual void setCascadeCullingEnabled(bool cascadeCullingEnabled);
+    virtual bool isCascadeCullingEnabled(void);
+
     /// @{
     /// @name Actions
 
@@ -1236,6 +1255,10 @@ public:
     
     /**
      * Performs OpenGL view-matrix transformation based on position, scale, rotation and other attributes.
+     *
+     * The resulting model view matrix is cached, it's only recomputed when the node transform
+     * or the incoming matrix changed since the last call. When the parent is visiting its children,
+     * its cached matrix is used as the incoming matrix instead of reading back the matrix stack.
      */
     void transform(void);
     /**
@@ -1267,6 +1290,8 @@ public:
 
     /** 
      * Returns the world affine transform matrix. The matrix is in Pixels.
+     *
+     * The matrix is cached, it's only recomputed when the node or one of its ancestors changed.
      */
     virtual CCAffineTransform nodeToWorldTransform(void);
 
@@ -1525,6 +1550,9 @@ private:
     
     /// helper that reorder a child
     void insertChild(CCNode* child, int z);
+
+    /// remembers a child whose zOrder or orderOfArrival changed, to relocate it in the next sort
+    void childReordered(CCNode* child);
     
     /// Removes a child, call child->onExit(), do cleanup, remove it from children array.
     void detachChild(CCNode *child, bool doCleanup);
@@ -1559,6 +1587,10 @@ protected:
     CCAffineTransform m_sAdditionalTransform; ///< transform
     CCAffineTransform m_sTransform;     ///< transform
     CCAffineTransform m_sInverse;       ///< transform
+    CCAffineTransform m_sWorldTransform;    ///< cached node to world transform
+    CCAffineTransform m_sWorldInverse;      ///< cached world to node transform
+    kmMat4 m_tModelViewTransform;       ///< cached model view matrix, the parent matrix times the local transform
+    kmMat4 m_tParentModelView;          ///< matrix read from the matrix stack m_tModelViewTransform was computed from
     
     CCCamera *m_pCamera;                ///< a camera
     
@@ -1589,12 +1621,37 @@ protected:
     bool m_bTransformDirty;             ///< transform dirty flag
     bool m_bInverseDirty;               ///< transform dirty flag
     bool m_bAdditionalTransformDirty;   ///< The flag to check whether the additional transform is dirty
+
+    unsigned int m_uTransformGeneration;        ///< incremented each time a dirty m_sTransform is recomputed
+    unsigned int m_uWorldTransformGeneration;   ///< unique id of m_sWorldTransform, children compare it to know if it changed
+    unsigned int m_uWorldLocalGeneration;       ///< m_uTransformGeneration m_sWorldTransform was computed with
+    unsigned int m_uWorldParentGeneration;      ///< parent m_uWorldTransformGeneration m_sWorldTransform was computed with
+    unsigned int m_uWorldInverseGeneration;     ///< m_uWorldTransformGeneration m_sWorldInverse was computed from
+    unsigned int m_uModelViewGeneration;        ///< unique id of m_tModelViewTransform, children compare it to know if it changed
+    unsigned int m_uModelViewLocalGeneration;   ///< m_uTransformGeneration m_tModelViewTransform was computed with
+    unsigned int m_uModelViewParentGeneration;  ///< parent m_uModelViewGeneration m_tModelViewTransform was computed with, 0 if read from the stack
+    static unsigned int s_uWorldTransformGeneration;
+    static unsigned int s_uModelViewGeneration;
+    static CCNode* s_pModelViewParent;          ///< node visiting its children, they multiply its cached matrix instead of reading the stack
+    static const kmMat4* s_pLoadedModelView;    ///< cached matrix on top of the matrix stack, NULL if unknown
+
     bool m_bVisible;                    ///< is this node visible
     
     bool m_bIgnoreAnchorPointForPosition; ///< true if the Anchor Point will be (0,0) when you position the CCNode, false otherwise.
                                           ///< Used by CCLayer and CCScene.
     
     bool m_bReorderChildDirty;          ///< children order dirty flag
+    CCArray *m_pReorderedChildren;      ///< children whose zOrder or orderOfArrival changed since the last sort, lazy alloc
+    bool m_bReorderedChildrenOverflow;  ///< too many children changed to track them, the next sort looks at all of them
+
+    /** Sorts m_pChildren by zOrder then orderOfArrival, shared by the sortAllChildren overrides.
+     Only the reordered children are relocated when they are few, otherwise the whole array is sorted with
+     an insertion sort if it is nearly sorted or a full sort if not. Children with the same zOrder and
+     orderOfArrival keep their order.
+     */
+    void sortChildrenByZOrder(void);
+    /** Moves the reordered children to their place, false if the whole array needs to be sorted */
+    bool relocateReorderedChildren(void);
     
     int m_nScriptHandler;               ///< script handler for onEnter() & onExit(), used in Javascript binding and Lua binding.
     int m_nUpdateScriptHandler;         ///< script handler for update() callback per frame, which is invoked from lua & javascript.
@@ -1609,6 +1666,7 @@ protected:
     ccColor3B m_realColor;
     bool m_cascadeColorEnabled;
     bool m_cascadeOpacityEnabled;
+    bool m_cascadeCullingEnabled;
 
     unsigned int m_drawOrder;
     static unsigned int g_drawOrder;
@@ -1621,6 +1679,13 @@ protected:
  
     virtual int excuteScriptTouchHandler(int nEventType, CCTouch *pTouch);
     virtual int excuteScriptTouchHandler(int nEventType, CCSet *pTouches);
+
+    /** Recomputes m_sWorldTransform if the node or one of its ancestors changed */
+    void updateWorldTransform(void);
+    /** Recomputes m_tModelViewTransform if the node or the incoming matrix changed, a generation of 0 means the matrix was read from the stack */
+    void updateModelViewTransform(const kmMat4& parentModelView, unsigned int uParentGeneration);
+    /** Loads the cached model view matrix unless it is already on top of the stack, then calls draw() */
+    void drawWithModelView(void);
  
     friend class CCScene;
 };
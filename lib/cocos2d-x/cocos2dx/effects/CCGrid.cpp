@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "effects/CCGrid.h"
 #include "CCDirector.h"
 #include "effects/CCGrabber.h"
+#include "sprite_nodes/CCAutoBatchRenderer.h"
 #include "support/ccUtils.h"
 #include "shaders/CCGLProgram.h"
 #include "shaders/CCShaderCache.h"
@@ -199,6 +200,9 @@ void CCGridBase::set2DProjection()
 
 void CCGridBase::beforeDraw(void)
 {
+    // the queued sprites are not part of the grabbed texture
+    CCAutoBatchRenderer::sharedRenderer()->flush();
+
     // save projection
     CCDirector *director = CCDirector::sharedDirector();
     m_directorProjection = director->getProjection();
@@ -211,6 +215,7 @@ void CCGridBase::beforeDraw(void)
 
 void CCGridBase::afterDraw(cocos2d::CCNode *pTarget)
 {
+    CCAutoBatchRenderer::sharedRenderer()->flush();
     m_pGrabber->afterRender(m_pTexture);
 
     // restore projection
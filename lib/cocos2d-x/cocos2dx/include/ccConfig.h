@@ -190,6 +190,37 @@ Only valid for cocos2d-mac. Not supported on cocos2d-ios.
     #endif
 #endif
 
+/** @def CC_TEXTURE_ATLAS_DIRTY_RANGES
+ Number of disjoint ranges of updated quads a CCTextureAtlas keeps track of. Only these ranges are
+ uploaded to its VBO on the next draw. When there are more, the closest ranges are merged.
+
+ Default is 4.
+ */
+#ifndef CC_TEXTURE_ATLAS_DIRTY_RANGES
+#define CC_TEXTURE_ATLAS_DIRTY_RANGES 4
+#endif
+
+/** @def CC_TEXTURE_ATLAS_ORPHAN_PERCENT
+ When at least this percentage of the quads of a CCTextureAtlas were updated, its VBO is orphaned
+ (re-specified with glBufferData) and all the quads are uploaded, instead of updating the ranges in place.
+ The driver then doesn't wait for the draws of the previous frame that still read the buffer.
+
+ Default is 50.
+ */
+#ifndef CC_TEXTURE_ATLAS_ORPHAN_PERCENT
+#define CC_TEXTURE_ATLAS_ORPHAN_PERCENT 50
+#endif
+
+/** @def CC_AUTO_BATCH_MAX_NODE_QUADS
+ When automatic batching is enabled (CCDirector::setAutoBatchEnabled), sprite batch nodes
+ with up to this many quads (labels, CCScale9Sprite) are merged into the automatic batch.
+ Bigger batch nodes are drawn by their own texture atlas, which keeps its vertices in a VBO.
+
+ Default is 128.
+ */
+#ifndef CC_AUTO_BATCH_MAX_NODE_QUADS
+#define CC_AUTO_BATCH_MAX_NODE_QUADS 128
+#endif
 
 /** @def CC_USE_LA88_LABELS
  If enabled, it will use LA88 (Luminance Alpha 16-bit textures) for CCLabelTTF objects.
@@ -250,9 +281,110 @@ To enable set it to a value different than 0. Disabled by default.
 #define CC_LABELATLAS_DEBUG_DRAW 0
 #endif
 
+/** @def CC_TEXTURE_CACHE_ASYNC_THREADS
+ Number of threads decoding the images loaded by CCTextureCache::addImageAsync.
+ 
+ 0 (the default) starts one thread per processor core.
+ */
+#ifndef CC_TEXTURE_CACHE_ASYNC_THREADS
+#define CC_TEXTURE_CACHE_ASYNC_THREADS 0
+#endif
+
+/** @def CC_TEXTURE_CACHE_ASYNC_UPLOAD_BYTES_PER_FRAME
+ Bytes of texture data the images loaded by CCTextureCache::addImageAsync may upload per frame,
+ the remaining ones are uploaded during the next frames. 0 means no limit.
+ */
+#ifndef CC_TEXTURE_CACHE_ASYNC_UPLOAD_BYTES_PER_FRAME
+#define CC_TEXTURE_CACHE_ASYNC_UPLOAD_BYTES_PER_FRAME (4 * 1024 * 1024)
+#endif
+
+/** @def CC_TEXTURE_CACHE_ASYNC_UPLOAD_TIME_PER_FRAME
+ Seconds the images loaded by CCTextureCache::addImageAsync may spend uploading per frame.
+ 0 (the default) means no limit.
+ */
+#ifndef CC_TEXTURE_CACHE_ASYNC_UPLOAD_TIME_PER_FRAME
+#define CC_TEXTURE_CACHE_ASYNC_UPLOAD_TIME_PER_FRAME 0
+#endif
+
+/** @def CC_TEXTURE_CACHE_ASYNC_UPLOAD_SLICE_BYTES
+ The images loaded by CCTextureCache::addImageAsync bigger than this size are uploaded in slices of rows
+ of about this size, possibly over several frames. 0 uploads every image at once.
+ */
+#ifndef CC_TEXTURE_CACHE_ASYNC_UPLOAD_SLICE_BYTES
+#define CC_TEXTURE_CACHE_ASYNC_UPLOAD_SLICE_BYTES (1024 * 1024)
+#endif
+
+/** @def CC_TEXTURE_CACHE_ASYNC_CANCEL_RELEASED_TARGETS
+ Whether CCTextureCache cancels the asynchronous loads of a target that nobody else retains anymore.
+ 
+ Disabled by default: the target is retained until its callback, and only cancelImageAsync drops its loads.
+ */
+#ifndef CC_TEXTURE_CACHE_ASYNC_CANCEL_RELEASED_TARGETS
+#define CC_TEXTURE_CACHE_ASYNC_CANCEL_RELEASED_TARGETS 0
+#endif
+
+/** @def CC_TEXTURE_CACHE_MEMORY_BUDGET
+ Bytes of memory the textures of CCTextureCache may use. When a texture is added the least recently used
+ textures that only the cache retains are removed until they fit in it. 0 (the default) means no limit.
+ */
+#ifndef CC_TEXTURE_CACHE_MEMORY_BUDGET
+#define CC_TEXTURE_CACHE_MEMORY_BUDGET 0
+#endif
+
+/** @def CC_JOB_POOL_THREADS
+ Number of threads running the jobs of CCJobPool, the thread that hands them out included.
+ 
+ 0 (the default) runs one thread per processor core.
+ */
+#ifndef CC_JOB_POOL_THREADS
+#define CC_JOB_POOL_THREADS 0
+#endif
+
+/** @def CC_PARTICLE_SYSTEM_PARALLEL_UPDATE
+ If enabled, the particle systems are simulated in parallel on the threads of CCJobPool,
+ see CCParticleSystem::setParallelUpdateEnabled.
+ 
+ To enable set it to a value different than 0. Disabled by default.
+ */
+#ifndef CC_PARTICLE_SYSTEM_PARALLEL_UPDATE
+#define CC_PARTICLE_SYSTEM_PARALLEL_UPDATE 0
+#endif
+
+/** @def CC_LABELBMFONT_GLYPH_QUADS
+ If enabled, CCLabelBMFont draws its characters as quads of its texture atlas
+ instead of creating a CCSprite child per character, see CCLabelBMFont::setGlyphQuadsEnabled.
+ 
+ To enable set it to a value different than 0. Disabled by default.
+ */
+#ifndef CC_LABELBMFONT_GLYPH_QUADS
+#define CC_LABELBMFONT_GLYPH_QUADS 0
+#endif
+
+/** @def CC_LABELTTF_GLYPH_ATLAS
+ If enabled, CCLabelTTF draws quads of glyphs rasterized once in the shared CCGlyphAtlas
+ instead of rendering its whole string into a texture, see CCLabelTTF::setGlyphAtlasEnabled.
+ 
+ To enable set it to a value different than 0. Disabled by default.
+ */
+#ifndef CC_LABELTTF_GLYPH_ATLAS
+#define CC_LABELTTF_GLYPH_ATLAS 0
+#endif
+
+/** @def CC_TMX_LAYER_CHUNK_SIZE
+ If not 0, CCTMXLayer splits its tiles into square chunks of this many tiles per side, each one with its own
+ vertex buffer, and only draws the chunks intersecting the visible rect, see CCTMXLayer::setDefaultChunkSize.
+ It can't be greater than 128.
+
+ To enable set it to a value different than 0, like 32. Disabled by default.
+ */
+#ifndef CC_TMX_LAYER_CHUNK_SIZE
+#define CC_TMX_LAYER_CHUNK_SIZE 0
+#endif
+
 /** @def CC_ENABLE_PROFILERS
- If enabled, will activate various profilers within cocos2d. This statistical data will be output to the console
- once per second showing average time (in milliseconds) required to execute the specific routine(s).
+ If enabled, will activate various profilers within cocos2d. The recorded zones can be summarized
+ in the console with CC_PROFILER_DISPLAY_TIMERS() or dumped as a Chrome trace with
+ CCProfiler::dumpChromeTrace().
  Useful for debugging purposes only. It is recommended to leave it disabled.
  
  To enable set it to a value different than 0. Disabled by default.
@@ -261,6 +393,14 @@ To enable set it to a value different than 0. Disabled by default.
 #define CC_ENABLE_PROFILERS 0
 #endif
 
+/** @def CC_PROFILER_EVENTS_PER_THREAD
+ Number of profiler events kept by the ring buffer of each thread.
+ Once full, the oldest events are overwritten.
+ */
+#ifndef CC_PROFILER_EVENTS_PER_THREAD
+#define CC_PROFILER_EVENTS_PER_THREAD 65536
+#endif
+
 /** Enable Lua engine debug log */
 #ifndef CC_LUA_ENGINE_DEBUG
 #define CC_LUA_ENGINE_DEBUG 0
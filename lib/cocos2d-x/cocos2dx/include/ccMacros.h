@@ -197,12 +197,20 @@ It should work same as apples CFSwapInt32LittleToHost(..)
 #define CC_PROFILER_DISPLAY_TIMERS() CCProfiler::sharedProfiler()->displayTimers()
 #define CC_PROFILER_PURGE_ALL() CCProfiler::sharedProfiler()->releaseAllTimers()
 
-#define CC_PROFILER_START(__name__) CCProfilingBeginTimingBlock(__name__)
-#define CC_PROFILER_STOP(__name__) CCProfilingEndTimingBlock(__name__)
+#define CC_PROFILER_CONCAT_(__a__, __b__) __a__##__b__
+#define CC_PROFILER_CONCAT(__a__, __b__) CC_PROFILER_CONCAT_(__a__, __b__)
+
+/** records the enclosing scope as a zone, __name__ must be a string literal */
+#define CC_PROFILER_ZONE(__name__) \
+    static const cocos2d::ccProfilerZone CC_PROFILER_CONCAT(s_ccProfilerZone, __LINE__) = { __name__, __FILE__, __LINE__ }; \
+    cocos2d::CCProfilerScope CC_PROFILER_CONCAT(ccProfilerScope, __LINE__)(&CC_PROFILER_CONCAT(s_ccProfilerZone, __LINE__))
+
+#define CC_PROFILER_START(__name__) do{ static const cocos2d::ccProfilerZone s_ccProfilerZone = { __name__, __FILE__, __LINE__ }; cocos2d::CCProfilerBeginZone(&s_ccProfilerZone); } while(0)
+#define CC_PROFILER_STOP(__name__) cocos2d::CCProfilerEndZone(__name__)
 #define CC_PROFILER_RESET(__name__) CCProfilingResetTimingBlock(__name__)
 
-#define CC_PROFILER_START_CATEGORY(__cat__, __name__) do{ if(__cat__) CCProfilingBeginTimingBlock(__name__); } while(0)
-#define CC_PROFILER_STOP_CATEGORY(__cat__, __name__) do{ if(__cat__) CCProfilingEndTimingBlock(__name__); } while(0)
+#define CC_PROFILER_START_CATEGORY(__cat__, __name__) do{ if(__cat__) CC_PROFILER_START(__name__); } while(0)
+#define CC_PROFILER_STOP_CATEGORY(__cat__, __name__) do{ if(__cat__) CC_PROFILER_STOP(__name__); } while(0)
 #define CC_PROFILER_RESET_CATEGORY(__cat__, __name__) do{ if(__cat__) CCProfilingResetTimingBlock(__name__); } while(0)
 
 #define CC_PROFILER_START_INSTANCE(__id__, __name__) do{ CCProfilingBeginTimingBlock( CCString::createWithFormat("%08X - %s", __id__, __name__)->getCString() ); } while(0)
@@ -215,6 +223,8 @@ It should work same as apples CFSwapInt32LittleToHost(..)
 #define CC_PROFILER_DISPLAY_TIMERS() do {} while (0)
 #define CC_PROFILER_PURGE_ALL() do {} while (0)
 
+#define CC_PROFILER_ZONE(__name__) do {} while (0)
+
 #define CC_PROFILER_START(__name__)  do {} while (0)
 #define CC_PROFILER_STOP(__name__) do {} while (0)
 #define CC_PROFILER_RESET(__name__) do {} while (0)
@@ -248,6 +258,13 @@ It should work same as apples CFSwapInt32LittleToHost(..)
 extern unsigned int CC_DLL g_uNumberOfDraws;
 #define CC_INCREMENT_GL_DRAWS(__n__) g_uNumberOfDraws += __n__
 
+/** @def CC_INCREMENT_CULLED_NODES
+ Increments the count of nodes skipped by the viewport culling in this frame.
+ The number is displayed next to the GL draws when the CCDirector's stats and culling are enabled.
+ */
+extern unsigned int CC_DLL g_uNumberOfCulledNodes;
+#define CC_INCREMENT_CULLED_NODES(__n__) g_uNumberOfCulledNodes += __n__
+
 /*******************/
 /** Notifications **/
 /*******************/
@@ -0,0 +1,325 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CCGlyphAtlas.h"
+#include "ccMacros.h"
+#include "CCDirector.h"
+#include "CCEventType.h"
+#include "platform/CCImage.h"
+#include "support/CCNotificationCenter.h"
+#include "support/ccUTF8.h"
+#include "support/image_support/ccPixelConversion.h"
+#include "textures/CCTexture2D.h"
+#include <stdio.h>
+#include <string.h>
+
+NS_CC_BEGIN
+
+static CCGlyphAtlas* s_pSharedGlyphAtlas = NULL;
+
+CCGlyphAtlas* CCGlyphAtlas::sharedGlyphAtlas(void)
+{
+    if (! s_pSharedGlyphAtlas)
+    {
+        s_pSharedGlyphAtlas = new CCGlyphAtlas();
+    }
+    return s_pSharedGlyphAtlas;
+}
+
+void CCGlyphAtlas::purgeSharedGlyphAtlas(void)
+{
+    CC_SAFE_RELEASE_NULL(s_pSharedGlyphAtlas);
+}
+
+CCGlyphAtlas::CCGlyphAtlas(void)
+: m_uMaxPages(4)
+, m_uGeneration(0)
+{
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    // listen the event when app go to background
+    CCNotificationCenter::sharedNotificationCenter()->addObserver(this,
+                                                           callfuncO_selector(CCGlyphAtlas::listenBackToForeground),
+                                                           EVENT_COME_TO_FOREGROUND,
+                                                           NULL);
+#endif
+}
+
+CCGlyphAtlas::~CCGlyphAtlas(void)
+{
+    removeAllGlyphs();
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    CCNotificationCenter::sharedNotificationCenter()->removeObserver(this, EVENT_COME_TO_FOREGROUND);
+#endif
+}
+
+void CCGlyphAtlas::listenBackToForeground(CCObject *obj)
+{
+    // the pages were only filled with glTexSubImage2D, the glyphs are rasterized again when needed
+    removeAllGlyphs();
+}
+
+void CCGlyphAtlas::setMaxPages(unsigned int uMaxPages)
+{
+    m_uMaxPages = MAX(uMaxPages, 1u);
+}
+
+void CCGlyphAtlas::removeAllGlyphs(void)
+{
+    for (unsigned int i = 0; i < m_pages.size(); ++i)
+    {
+        CC_SAFE_RELEASE(m_pages[i].texture);
+    }
+    m_pages.clear();
+    m_fonts.clear();
+    m_uGeneration++;
+}
+
+CCGlyphAtlas::ccGlyphAtlasFont* CCGlyphAtlas::fontForName(const char* fontName, int fontSize)
+{
+    char size[16];
+    snprintf(size, sizeof(size), "@%d", fontSize);
+    std::string key = std::string(fontName) + size;
+
+    std::map<std::string, ccGlyphAtlasFont>::iterator it = m_fonts.find(key);
+    if (it == m_fonts.end())
+    {
+        it = m_fonts.insert(std::make_pair(key, ccGlyphAtlasFont())).first;
+        it->second.lineHeight = 0;
+    }
+    return &it->second;
+}
+
+const ccGlyph* CCGlyphAtlas::getGlyph(const char* fontName, int fontSize, unsigned short character)
+{
+    ccGlyphAtlasFont* font = fontForName(fontName, fontSize);
+
+    std::map<unsigned short, ccGlyph>::iterator it = font->glyphs.find(character);
+    if (it != font->glyphs.end())
+    {
+        // the pages of the glyphs being laid out in this frame are not evicted
+        if (it->second.rect.size.width > 0)
+        {
+            touchPage(it->second.page);
+        }
+        return &it->second;
+    }
+
+    ccGlyph glyph;
+    if (! addGlyph(fontName, fontSize, character, &glyph))
+    {
+        return NULL;
+    }
+    return &(font->glyphs[character] = glyph);
+}
+
+float CCGlyphAtlas::getLineHeight(const char* fontName, int fontSize)
+{
+    return fontForName(fontName, fontSize)->lineHeight;
+}
+
+CCTexture2D* CCGlyphAtlas::getPageTexture(unsigned int page)
+{
+    return page < m_pages.size() ? m_pages[page].texture : NULL;
+}
+
+void CCGlyphAtlas::touchPage(unsigned int page)
+{
+    if (page < m_pages.size())
+    {
+        m_pages[page].lastUsedFrame = CCDirector::sharedDirector()->getTotalFrames();
+    }
+}
+
+bool CCGlyphAtlas::addGlyph(const char* fontName, int fontSize, unsigned short character, ccGlyph* pGlyph)
+{
+    unsigned short utf16[2] = { character, 0 };
+    char* utf8 = cc_utf16_to_utf8(utf16, 1, NULL, NULL);
+    if (! utf8)
+    {
+        return false;
+    }
+
+    CCImage* pImage = new CCImage();
+    bool bRet = pImage->initWithString(utf8, 0, 0, CCImage::kAlignTopLeft, fontName, fontSize);
+    CC_SAFE_DELETE_ARRAY(utf8);
+    if (! bRet || ! pImage->getData())
+    {
+        CCLOG("cocos2d: CCGlyphAtlas: can't render character %d of %s", character, fontName);
+        CC_SAFE_RELEASE(pImage);
+        return false;
+    }
+
+    unsigned int width = pImage->getWidth();
+    unsigned int height = pImage->getHeight();
+
+    ccGlyphAtlasFont* font = fontForName(fontName, fontSize);
+    font->lineHeight = MAX(font->lineHeight, (float)height);
+
+    pGlyph->page = 0;
+    pGlyph->rect = CCRectZero;
+    pGlyph->advance = (float)width;
+
+    // blank characters only move the pen
+    bool bBlank = (character == ' ' || character == '\t' || character == 0x3000);
+
+    unsigned int page, x, y;
+    // one pixel of padding on the right and the bottom, so the linear filtering never reads the next glyph
+    if (! bBlank && allocateRect(width + 1, height + 1, &page, &x, &y))
+    {
+        unsigned int stride = width + 1;
+        unsigned char* alpha = new unsigned char[width * height];
+        unsigned char* padded = new unsigned char[stride * (height + 1)];
+        memset(padded, 0, stride * (height + 1));
+        ccConvertPixels(pImage->getData(), pImage->hasAlpha(), width, height, kCCTexture2DPixelFormat_A8, false, alpha);
+        for (unsigned int row = 0; row < height; ++row)
+        {
+            memcpy(padded + row * stride, alpha + row * width, width);
+        }
+
+        m_pages[page].texture->updateWithData(padded, x, y, stride, height + 1);
+        CC_SAFE_DELETE_ARRAY(alpha);
+        CC_SAFE_DELETE_ARRAY(padded);
+
+        pGlyph->page = page;
+        pGlyph->rect = CCRectMake((float)x, (float)y, (float)width, (float)height);
+    }
+
+    CC_SAFE_RELEASE(pImage);
+    return true;
+}
+
+bool CCGlyphAtlas::allocateRectInPage(ccGlyphAtlasPage& page, unsigned int width, unsigned int height, unsigned int* pX, unsigned int* pY)
+{
+    // the glyphs are packed in shelves, a new shelf is opened when the current one is full
+    if (page.cursorX + width > kCCGlyphAtlasPageSize)
+    {
+        page.shelfY += page.shelfHeight;
+        page.shelfHeight = 0;
+        page.cursorX = 0;
+    }
+    if (width > kCCGlyphAtlasPageSize || page.shelfY + MAX(page.shelfHeight, height) > kCCGlyphAtlasPageSize)
+    {
+        return false;
+    }
+
+    *pX = page.cursorX;
+    *pY = page.shelfY;
+    page.cursorX += width;
+    page.shelfHeight = MAX(page.shelfHeight, height);
+    return true;
+}
+
+bool CCGlyphAtlas::allocateRect(unsigned int width, unsigned int height, unsigned int* pPage, unsigned int* pX, unsigned int* pY)
+{
+    if (width > kCCGlyphAtlasPageSize || height > kCCGlyphAtlasPageSize)
+    {
+        // doesn't fit even in an empty page, don't evict one for nothing
+        return false;
+    }
+
+    // the page of a new glyph is used by this frame, a later glyph of the same label must not evict it
+    unsigned int frame = CCDirector::sharedDirector()->getTotalFrames();
+    for (unsigned int i = 0; i < m_pages.size(); ++i)
+    {
+        if (allocateRectInPage(m_pages[i], width, height, pX, pY))
+        {
+            m_pages[i].lastUsedFrame = frame;
+            *pPage = i;
+            return true;
+        }
+    }
+
+    unsigned int page = (unsigned int)m_pages.size();
+    if (m_pages.size() >= m_uMaxPages)
+    {
+        // reuse the page drawn least recently, the pages drawn in this frame have quads waiting to be drawn
+        for (unsigned int i = 0; i < m_pages.size(); ++i)
+        {
+            if (m_pages[i].lastUsedFrame != frame && (page == m_pages.size() || m_pages[i].lastUsedFrame < m_pages[page].lastUsedFrame))
+            {
+                page = i;
+            }
+        }
+        if (page == m_pages.size())
+        {
+            CCLOG("cocos2d: CCGlyphAtlas: all the %u pages are used by this frame, adding one", (unsigned int)m_pages.size());
+        }
+    }
+
+    if (page < m_pages.size())
+    {
+        evictPage(page);
+    }
+    else
+    {
+        unsigned char* zeros = new unsigned char[kCCGlyphAtlasPageSize * kCCGlyphAtlasPageSize];
+        memset(zeros, 0, kCCGlyphAtlasPageSize * kCCGlyphAtlasPageSize);
+
+        ccGlyphAtlasPage newPage;
+        newPage.texture = new CCTexture2D();
+        newPage.texture->initWithData(zeros, kCCTexture2DPixelFormat_A8, kCCGlyphAtlasPageSize, kCCGlyphAtlasPageSize,
+                                      CCSizeMake(kCCGlyphAtlasPageSize, kCCGlyphAtlasPageSize));
+        CC_SAFE_DELETE_ARRAY(zeros);
+        newPage.shelfY = 0;
+        newPage.shelfHeight = 0;
+        newPage.cursorX = 0;
+        newPage.lastUsedFrame = frame;
+        m_pages.push_back(newPage);
+    }
+
+    *pPage = page;
+    return allocateRectInPage(m_pages[page], width, height, pX, pY);
+}
+
+void CCGlyphAtlas::evictPage(unsigned int page)
+{
+    std::map<std::string, ccGlyphAtlasFont>::iterator font = m_fonts.begin();
+    while (font != m_fonts.end())
+    {
+        std::map<unsigned short, ccGlyph>& glyphs = font->second.glyphs;
+        std::map<unsigned short, ccGlyph>::iterator it = glyphs.begin();
+        while (it != glyphs.end())
+        {
+            if (it->second.page == page && it->second.rect.size.width > 0)
+            {
+                glyphs.erase(it++);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        ++font;
+    }
+
+    ccGlyphAtlasPage& evicted = m_pages[page];
+    evicted.shelfY = 0;
+    evicted.shelfHeight = 0;
+    evicted.cursorX = 0;
+    evicted.lastUsedFrame = CCDirector::sharedDirector()->getTotalFrames();
+    m_uGeneration++;
+}
+
+NS_CC_END
@@ -0,0 +1,141 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_GLYPH_ATLAS_H__
+#define __CC_GLYPH_ATLAS_H__
+
+#include "cocoa/CCObject.h"
+#include "cocoa/CCGeometry.h"
+#include <map>
+#include <string>
+#include <vector>
+
+NS_CC_BEGIN
+
+class CCTexture2D;
+
+/**
+ * @addtogroup label
+ * @{
+ */
+
+/** A glyph rasterized in a page of the CCGlyphAtlas */
+typedef struct _ccGlyph
+{
+    //! index of the page holding the glyph
+    unsigned int page;
+    //! rect of the glyph in the page, in pixels
+    CCRect rect;
+    //! amount to move the pen after the glyph, in pixels
+    float advance;
+} ccGlyph;
+
+/** CCGlyphAtlas
+ Rasterizes the glyphs of the TTF labels once per font and size, into A8 pages shared by all the labels.
+
+ Glyphs are rendered one by one with CCImage::initWithString, so each platform keeps its own font
+ rasterizer, and are packed in shelves of pages of kCCGlyphAtlasPageSize x kCCGlyphAtlasPageSize pixels.
+ When all the pages are full and their count reached getMaxPages(), the least recently drawn page is
+ emptied and reused. Its glyphs are forgotten, and getGeneration() changes so the labels using them
+ lay their text out again.
+ *@js NA
+ *@lua NA
+ */
+class CC_DLL CCGlyphAtlas : public CCObject
+{
+public:
+    static CCGlyphAtlas* sharedGlyphAtlas(void);
+    static void purgeSharedGlyphAtlas(void);
+
+    CCGlyphAtlas(void);
+    virtual ~CCGlyphAtlas(void);
+
+    /** Returns the glyph of a character of a font at a size in pixels, rasterizing it if it isn't in a page yet.
+     Returns NULL if the platform can't render the character.
+     */
+    const ccGlyph* getGlyph(const char* fontName, int fontSize, unsigned short character);
+
+    /** Height of the lines of a font at a size in pixels, the tallest glyph rasterized so far */
+    float getLineHeight(const char* fontName, int fontSize);
+
+    /** Texture of a page */
+    CCTexture2D* getPageTexture(unsigned int page);
+
+    /** Marks a page as drawn in the current frame, the pages drawn least recently are evicted first */
+    void touchPage(unsigned int page);
+
+    /** Number of pages allocated */
+    inline unsigned int getPageCount(void) { return (unsigned int)m_pages.size(); }
+
+    /** Number of pages above which the least recently drawn page is reused. Default is 4. */
+    inline unsigned int getMaxPages(void) { return m_uMaxPages; }
+    void setMaxPages(unsigned int uMaxPages);
+
+    /** Changes each time glyphs are forgotten, the glyphs and pages returned before can't be used anymore */
+    inline unsigned int getGeneration(void) { return m_uGeneration; }
+
+    /** Forgets all the glyphs and releases the pages */
+    void removeAllGlyphs(void);
+
+    /** listen the event that coming to foreground on Android */
+    void listenBackToForeground(CCObject *obj);
+
+private:
+    typedef struct _ccGlyphAtlasPage
+    {
+        CCTexture2D* texture;
+        unsigned int shelfY;
+        unsigned int shelfHeight;
+        unsigned int cursorX;
+        unsigned int lastUsedFrame;
+    } ccGlyphAtlasPage;
+
+    typedef struct _ccGlyphAtlasFont
+    {
+        std::map<unsigned short, ccGlyph> glyphs;
+        float lineHeight;
+    } ccGlyphAtlasFont;
+
+    ccGlyphAtlasFont* fontForName(const char* fontName, int fontSize);
+    bool addGlyph(const char* fontName, int fontSize, unsigned short character, ccGlyph* pGlyph);
+    bool allocateRect(unsigned int width, unsigned int height, unsigned int* pPage, unsigned int* pX, unsigned int* pY);
+    bool allocateRectInPage(ccGlyphAtlasPage& page, unsigned int width, unsigned int height, unsigned int* pX, unsigned int* pY);
+    void evictPage(unsigned int page);
+
+private:
+    std::map<std::string, ccGlyphAtlasFont> m_fonts;
+    std::vector<ccGlyphAtlasPage> m_pages;
+    unsigned int m_uMaxPages;
+    unsigned int m_uGeneration;
+};
+
+/** size of the pages of the CCGlyphAtlas, in pixels */
+#define kCCGlyphAtlasPageSize 1024
+
+// end of label group
+/// @}
+
+NS_CC_END
+
+#endif // __CC_GLYPH_ATLAS_H__
@@ -47,6 +47,13 @@ using namespace std;
 
 NS_CC_BEGIN
 
+// the glyph quads are rounded like the letter sprites
+#if CC_SPRITEBATCHNODE_RENDER_SUBPIXEL
+#define RENDER_IN_SUBPIXEL
+#else
+#define RENDER_IN_SUBPIXEL(__ARGS__) (ceil(__ARGS__))
+#endif
+
 // The return value needs to be deleted by CC_SAFE_DELETE_ARRAY.
 static unsigned short* copyUTF16StringN(unsigned short* str)
 {
@@ -184,227 +191,378 @@ void CCBMFontConfiguration::purgeFontDefDictionary()
 std::set<unsigned int>* CCBMFontConfiguration::parseConfigFile(const char *controlFile)
 {    
     std::string fullpath = CCFileUtils::sharedFileUtils()->fullPathForFilename(controlFile);
-    CCString *contents = CCString::createWithContentsOfFile(fullpath.c_str());
+    unsigned long size = 0;
+    unsigned char* data = CCFileUtils::sharedFileUtils()->getFileData(fullpath.c_str(), "rb", &size);
 
-    CCAssert(contents, "CCBMFontConfiguration::parseConfigFile | Open file error.");
-    
-    set<unsigned int> *validCharsString = new set<unsigned int>();
+    CCAssert(data, "CCBMFontConfiguration::parseConfigFile | Open file error.");
 
-    if (!contents)
+    if (!data)
     {
         CCLOG("cocos2d: Error parsing FNTfile %s", controlFile);
         return NULL;
     }
 
-    // parse spacing / padding
-    std::string line;
-    std::string strLeft = contents->getCString();
-    while (strLeft.length() > 0)
+    set<unsigned int> *validCharsString = NULL;
+    if (size >= 4 && memcmp(data, "BMF", 3) == 0)
     {
-        int pos = strLeft.find('\n');
+        validCharsString = this->parseBinaryConfigFile(data, size, controlFile);
+    }
+    else
+    {
+        validCharsString = this->parseTextConfigFile((const char*)data, size, controlFile);
+    }
+    delete [] data;
+
+    return validCharsString;
+}
 
-        if (pos != (int)std::string::npos)
+// Fields of the text format are scanned in place, without copying the lines
+static inline bool isFntBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static int parseFntInt(const char* p, const char* end)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+    int value = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        value = value * 10 + (*p - '0');
+        ++p;
+    }
+    return negative ? -value : value;
+}
+
+static inline bool isFntKey(const char* key, const char* keyEnd, const char* name, size_t nameLength)
+{
+    return (size_t)(keyEnd - key) == nameLength && memcmp(key, name, nameLength) == 0;
+}
+#define FNT_KEY(__name__) isFntKey(key, keyEnd, __name__, sizeof(__name__) - 1)
+
+std::set<unsigned int>* CCBMFontConfiguration::parseTextConfigFile(const char* contents, unsigned long size, const char *controlFile)
+{
+    set<unsigned int> *validCharsString = new set<unsigned int>();
+
+    const char* end = contents + size;
+    const char* p = contents;
+    while (p < end)
+    {
+        const char* lineEnd = (const char*)memchr(p, '\n', end - p);
+        if (! lineEnd)
         {
-            // the data is more than a line.get one line
-            line = strLeft.substr(0, pos);
-            strLeft = strLeft.substr(pos + 1);
+            lineEnd = end;
         }
-        else
+
+        // the tag of the line: info, common, page, chars, char, kernings or kerning
+        const char* tag = p;
+        while (p < lineEnd && ! isFntBlank(*p))
         {
-            // get the left data
-            line = strLeft;
-            strLeft.erase();
+            ++p;
         }
+        const char* tagEnd = p;
 
-        if(line.substr(0,strlen("info face")) == "info face") 
+        enum { kLineIgnored, kLineInfo, kLineCommon, kLinePage, kLineChar, kLineKerning } lineType = kLineIgnored;
+        if (isFntKey(tag, tagEnd, "char", 4))
+        {
+            lineType = kLineChar;
+        }
+        else if (isFntKey(tag, tagEnd, "kerning", 7))
         {
-            // XXX: info parsing is incomplete
-            // Not needed for the Hiero editors, but needed for the AngelCode editor
-            //            [self parseInfoArguments:line];
-            this->parseInfoArguments(line);
+            lineType = kLineKerning;
         }
-        // Check to see if the start of the line is something we are interested in
-        else if(line.substr(0,strlen("common lineHeight")) == "common lineHeight")
+        else if (isFntKey(tag, tagEnd, "info", 4))
         {
-            this->parseCommonArguments(line);
+            lineType = kLineInfo;
         }
-        else if(line.substr(0,strlen("page id")) == "page id")
+        else if (isFntKey(tag, tagEnd, "common", 6))
         {
-            this->parseImageFileName(line, controlFile);
+            lineType = kLineCommon;
         }
-        else if(line.substr(0,strlen("chars c")) == "chars c")
+        else if (isFntKey(tag, tagEnd, "page", 4))
         {
-            // Ignore this line
+            lineType = kLinePage;
         }
-        else if(line.substr(0,strlen("char")) == "char")
+
+        tCCFontDefHashElement* element = NULL;
+        int kerningFirst = 0, kerningSecond = 0, kerningAmount = 0;
+        if (lineType == kLineChar)
+        {
+            element = (tCCFontDefHashElement*)calloc(1, sizeof(*element));
+        }
+
+        // the key=value fields, values may be quoted
+        while (lineType != kLineIgnored && p < lineEnd)
         {
-            // Parse the current line and create a new CharDef
-            tCCFontDefHashElement* element = (tCCFontDefHashElement*)malloc( sizeof(*element) );
-            this->parseCharacterDefinition(line, &element->fontDef);
+            while (p < lineEnd && isFntBlank(*p))
+            {
+                ++p;
+            }
+            const char* key = p;
+            while (p < lineEnd && *p != '=' && ! isFntBlank(*p))
+            {
+                ++p;
+            }
+            const char* keyEnd = p;
+            if (p >= lineEnd || *p != '=')
+            {
+                continue;
+            }
+            ++p;
+
+            const char* value = p;
+            const char* valueEnd = NULL;
+            if (p < lineEnd && *p == '"')
+            {
+                value = ++p;
+                while (p < lineEnd && *p != '"')
+                {
+                    ++p;
+                }
+                valueEnd = p;
+                if (p < lineEnd)
+                {
+                    ++p;
+                }
+            }
+            else
+            {
+                while (p < lineEnd && ! isFntBlank(*p))
+                {
+                    ++p;
+                }
+                valueEnd = p;
+            }
+
+            switch (lineType)
+            {
+            case kLineChar:
+                if (FNT_KEY("id"))
+                {
+                    element->fontDef.charID = (unsigned int)parseFntInt(value, valueEnd);
+                }
+                else if (FNT_KEY("x"))
+                {
+                    element->fontDef.rect.origin.x = (float)parseFntInt(value, valueEnd);
+                }
+                else if (FNT_KEY("y"))
+                {
+                    element->fontDef.rect.origin.y = (float)parseFntInt(value, valueEnd);
+                }
+                else if (FNT_KEY("width"))
+                {
+                    element->fontDef.rect.size.width = (float)parseFntInt(value, valueEnd);
+                }
+                else if (FNT_KEY("height"))
+                {
+                    element->fontDef.rect.size.height = (float)parseFntInt(value, valueEnd);
+                }
+                else if (FNT_KEY("xoffset"))
+                {
+                    element->fontDef.xOffset = (short)parseFntInt(value, valueEnd);
+                }
+                else if (FNT_KEY("yoffset"))
+                {
+                    element->fontDef.yOffset = (short)parseFntInt(value, valueEnd);
+                }
+                else if (FNT_KEY("xadvance"))
+                {
+                    element->fontDef.xAdvance = (short)parseFntInt(value, valueEnd);
+                }
+                break;
+            case kLineKerning:
+                if (FNT_KEY("first"))
+                {
+                    kerningFirst = parseFntInt(value, valueEnd);
+                }
+                else if (FNT_KEY("second"))
+                {
+                    kerningSecond = parseFntInt(value, valueEnd);
+                }
+                else if (FNT_KEY("amount"))
+                {
+                    kerningAmount = parseFntInt(value, valueEnd);
+                }
+                break;
+            case kLineInfo:
+                if (FNT_KEY("padding"))
+                {
+                    int* padding[4] = { &m_tPadding.top, &m_tPadding.right, &m_tPadding.bottom, &m_tPadding.left };
+                    for (int i = 0; i < 4 && value < valueEnd; ++i)
+                    {
+                        *padding[i] = parseFntInt(value, valueEnd);
+                        while (value < valueEnd && *value != ',')
+                        {
+                            ++value;
+                        }
+                        ++value;
+                    }
+                    CCLOG("cocos2d: padding: %d,%d,%d,%d", m_tPadding.left, m_tPadding.top, m_tPadding.right, m_tPadding.bottom);
+                }
+                break;
+            case kLineCommon:
+                if (FNT_KEY("lineHeight"))
+                {
+                    m_nCommonHeight = parseFntInt(value, valueEnd);
+                }
+                else if (FNT_KEY("scaleW") || FNT_KEY("scaleH"))
+                {
+                    CCAssert(parseFntInt(value, valueEnd) <= CCConfiguration::sharedConfiguration()->getMaxTextureSize(), "CCLabelBMFont: page can't be larger than supported");
+                }
+                else if (FNT_KEY("pages"))
+                {
+                    CCAssert(parseFntInt(value, valueEnd) == 1, "CCBitfontAtlas: only supports 1 page");
+                }
+                break;
+            case kLinePage:
+                if (FNT_KEY("id"))
+                {
+                    CCAssert(parseFntInt(value, valueEnd) == 0, "LabelBMFont file could not be found");
+                }
+                else if (FNT_KEY("file"))
+                {
+                    m_sAtlasName = CCFileUtils::sharedFileUtils()->fullPathFromRelativeFile(std::string(value, valueEnd).c_str(), controlFile);
+                }
+                break;
+            default:
+                break;
+            }
+        }
 
+        if (lineType == kLineChar)
+        {
             element->key = element->fontDef.charID;
             HASH_ADD_INT(m_pFontDefDictionary, key, element);
-            
-            validCharsString->insert(element->fontDef.charID);
+
+            // the characters are usually sorted, inserting at the end is then constant time
+            validCharsString->insert(validCharsString->end(), element->fontDef.charID);
         }
-//        else if(line.substr(0,strlen("kernings count")) == "kernings count")
-//        {
-//            this->parseKerningCapacity(line);
-//        }
-        else if(line.substr(0,strlen("kerning first")) == "kerning first")
+        else if (lineType == kLineKerning)
         {
-            this->parseKerningEntry(line);
+            this->addKerningEntry(kerningFirst, kerningSecond, kerningAmount);
         }
+
+        p = lineEnd < end ? lineEnd + 1 : end;
     }
-    
+
     return validCharsString;
 }
+#undef FNT_KEY
 
-void CCBMFontConfiguration::parseImageFileName(std::string line, const char *fntFile)
+// Little endian fields of the binary format
+static inline unsigned int readFntUInt(const unsigned char* p)
 {
-    //////////////////////////////////////////////////////////////////////////
-    // line to parse:
-    // page id=0 file="bitmapFontTest.png"
-    //////////////////////////////////////////////////////////////////////////
-
-    // page ID. Sanity check
-    int index = line.find('=')+1;
-    int index2 = line.find(' ', index);
-    std::string value = line.substr(index, index2-index);
-    CCAssert(atoi(value.c_str()) == 0, "LabelBMFont file could not be found");
-    // file 
-    index = line.find('"')+1;
-    index2 = line.find('"', index);
-    value = line.substr(index, index2-index);
-
-    m_sAtlasName = CCFileUtils::sharedFileUtils()->fullPathFromRelativeFile(value.c_str(), fntFile);
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
 }
 
-void CCBMFontConfiguration::parseInfoArguments(std::string line)
+static inline unsigned short readFntUShort(const unsigned char* p)
 {
-    //////////////////////////////////////////////////////////////////////////
-    // possible lines to parse:
-    // info face="Script" size=32 bold=0 italic=0 charset="" unicode=1 stretchH=100 smooth=1 aa=1 padding=1,4,3,2 spacing=0,0 outline=0
-    // info face="Cracked" size=36 bold=0 italic=0 charset="" unicode=0 stretchH=100 smooth=1 aa=1 padding=0,0,0,0 spacing=1,1
-    //////////////////////////////////////////////////////////////////////////
-
-    // padding
-    int index = line.find("padding=");
-    int index2 = line.find(' ', index);
-    std::string value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "padding=%d,%d,%d,%d", &m_tPadding.top, &m_tPadding.right, &m_tPadding.bottom, &m_tPadding.left);
-    CCLOG("cocos2d: padding: %d,%d,%d,%d", m_tPadding.left, m_tPadding.top, m_tPadding.right, m_tPadding.bottom);
+    return (unsigned short)(p[0] | (p[1] << 8));
 }
 
-void CCBMFontConfiguration::parseCommonArguments(std::string line)
+std::set<unsigned int>* CCBMFontConfiguration::parseBinaryConfigFile(const unsigned char* data, unsigned long size, const char *controlFile)
 {
     //////////////////////////////////////////////////////////////////////////
-    // line to parse:
-    // common lineHeight=104 base=26 scaleW=1024 scaleH=512 pages=1 packed=0
+    // AngelCode binary format, version 3:
+    // "BMF" 3, then blocks made of a type byte, a 4 bytes size and the block
+    // 1: info, 2: common, 3: page names, 4: chars (20 bytes each), 5: kerning pairs (10 bytes each)
     //////////////////////////////////////////////////////////////////////////
 
-    // Height
-    int index = line.find("lineHeight=");
-    int index2 = line.find(' ', index);
-    std::string value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "lineHeight=%d", &m_nCommonHeight);
-    // scaleW. sanity check
-    index = line.find("scaleW=") + strlen("scaleW=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    CCAssert(atoi(value.c_str()) <= CCConfiguration::sharedConfiguration()->getMaxTextureSize(), "CCLabelBMFont: page can't be larger than supported");
-    // scaleH. sanity check
-    index = line.find("scaleH=") + strlen("scaleH=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    CCAssert(atoi(value.c_str()) <= CCConfiguration::sharedConfiguration()->getMaxTextureSize(), "CCLabelBMFont: page can't be larger than supported");
-    // pages. sanity check
-    index = line.find("pages=") + strlen("pages=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    CCAssert(atoi(value.c_str()) == 1, "CCBitfontAtlas: only supports 1 page");
-
-    // packed (ignore) What does this mean ??
-}
-
-void CCBMFontConfiguration::parseCharacterDefinition(std::string line, ccBMFontDef *characterDefinition)
-{    
-    //////////////////////////////////////////////////////////////////////////
-    // line to parse:
-    // char id=32   x=0     y=0     width=0     height=0     xoffset=0     yoffset=44    xadvance=14     page=0  chnl=0 
-    //////////////////////////////////////////////////////////////////////////
+    if (data[3] != 3)
+    {
+        CCLOG("cocos2d: Error parsing FNTfile %s, version %d of the binary format is not supported", controlFile, data[3]);
+        return NULL;
+    }
 
-    // Character ID
-    int index = line.find("id=");
-    int index2 = line.find(' ', index);
-    std::string value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "id=%u", &characterDefinition->charID);
-
-    // Character x
-    index = line.find("x=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "x=%f", &characterDefinition->rect.origin.x);
-    // Character y
-    index = line.find("y=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "y=%f", &characterDefinition->rect.origin.y);
-    // Character width
-    index = line.find("width=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "width=%f", &characterDefinition->rect.size.width);
-    // Character height
-    index = line.find("height=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "height=%f", &characterDefinition->rect.size.height);
-    // Character xoffset
-    index = line.find("xoffset=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "xoffset=%hd", &characterDefinition->xOffset);
-    // Character yoffset
-    index = line.find("yoffset=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "yoffset=%hd", &characterDefinition->yOffset);
-    // Character xadvance
-    index = line.find("xadvance=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "xadvance=%hd", &characterDefinition->xAdvance);
-}
-
-void CCBMFontConfiguration::parseKerningEntry(std::string line)
-{        
-    //////////////////////////////////////////////////////////////////////////
-    // line to parse:
-    // kerning first=121  second=44  amount=-7
-    //////////////////////////////////////////////////////////////////////////
+    set<unsigned int> *validCharsString = new set<unsigned int>();
 
-    // first
-    int first;
-    int index = line.find("first=");
-    int index2 = line.find(' ', index);
-    std::string value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "first=%d", &first);
-
-    // second
-    int second;
-    index = line.find("second=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "second=%d", &second);
-
-    // amount
-    int amount;
-    index = line.find("amount=");
-    index2 = line.find(' ', index);
-    value = line.substr(index, index2-index);
-    sscanf(value.c_str(), "amount=%d", &amount);
+    unsigned long offset = 4;
+    while (offset + 5 <= size)
+    {
+        unsigned char blockType = data[offset];
+        unsigned long blockSize = readFntUInt(data + offset + 1);
+        offset += 5;
+        if (blockSize > size - offset)
+        {
+            CCLOG("cocos2d: Error parsing FNTfile %s, block %d is truncated", controlFile, blockType);
+            break;
+        }
+        const unsigned char* block = data + offset;
+
+        switch (blockType)
+        {
+        case 1:
+            // fontSize(2) bitField(1) charSet(1) stretchH(2) aa(1) paddingUp(1) paddingRight(1) paddingDown(1) paddingLeft(1) ...
+            if (blockSize >= 11)
+            {
+                m_tPadding.top = block[7];
+                m_tPadding.right = block[8];
+                m_tPadding.bottom = block[9];
+                m_tPadding.left = block[10];
+                CCLOG("cocos2d: padding: %d,%d,%d,%d", m_tPadding.left, m_tPadding.top, m_tPadding.right, m_tPadding.bottom);
+            }
+            break;
+        case 2:
+            // lineHeight(2) base(2) scaleW(2) scaleH(2) pages(2) ...
+            if (blockSize >= 10)
+            {
+                m_nCommonHeight = readFntUShort(block);
+                CCAssert(readFntUShort(block + 4) <= CCConfiguration::sharedConfiguration()->getMaxTextureSize(), "CCLabelBMFont: page can't be larger than supported");
+                CCAssert(readFntUShort(block + 6) <= CCConfiguration::sharedConfiguration()->getMaxTextureSize(), "CCLabelBMFont: page can't be larger than supported");
+                CCAssert(readFntUShort(block + 8) == 1, "CCBitfontAtlas: only supports 1 page");
+            }
+            break;
+        case 3:
+            // the null terminated name of the first page
+            if (blockSize > 0)
+            {
+                std::string file((const char*)block, strnlen((const char*)block, blockSize));
+                m_sAtlasName = CCFileUtils::sharedFileUtils()->fullPathFromRelativeFile(file.c_str(), controlFile);
+            }
+            break;
+        case 4:
+            // id(4) x(2) y(2) width(2) height(2) xoffset(2) yoffset(2) xadvance(2) page(1) chnl(1)
+            for (unsigned long i = 0; i + 20 <= blockSize; i += 20)
+            {
+                const unsigned char* c = block + i;
+                tCCFontDefHashElement* element = (tCCFontDefHashElement*)malloc(sizeof(*element));
+                element->fontDef.charID = readFntUInt(c);
+                element->fontDef.rect = CCRectMake(readFntUShort(c + 4), readFntUShort(c + 6), readFntUShort(c + 8), readFntUShort(c + 10));
+                element->fontDef.xOffset = (short)readFntUShort(c + 12);
+                element->fontDef.yOffset = (short)readFntUShort(c + 14);
+                element->fontDef.xAdvance = (short)readFntUShort(c + 16);
+
+                element->key = element->fontDef.charID;
+                HASH_ADD_INT(m_pFontDefDictionary, key, element);
+
+                validCharsString->insert(validCharsString->end(), element->fontDef.charID);
+            }
+            break;
+        case 5:
+            // first(4) second(4) amount(2)
+            for (unsigned long i = 0; i + 10 <= blockSize; i += 10)
+            {
+                const unsigned char* k = block + i;
+                this->addKerningEntry((int)readFntUInt(k), (int)readFntUInt(k + 4), (short)readFntUShort(k + 8));
+            }
+            break;
+        default:
+            break;
+        }
+
+        offset += blockSize;
+    }
 
+    return validCharsString;
+}
+
+void CCBMFontConfiguration::addKerningEntry(int first, int second, int amount)
+{
     tCCKerningHashElement *element = (tCCKerningHashElement *)calloc( sizeof( *element ), 1 );
     element->amount = amount;
     element->key = (first<<16) | (second&0xffff);
@@ -538,6 +696,8 @@ CCLabelBMFont::CCLabelBMFont()
 , m_bLineBreakWithoutSpaces(false)
 , m_tImageOffset(CCPointZero)
 , m_pReusedChar(NULL)
+, m_bGlyphQuads(CC_LABELBMFONT_GLYPH_QUADS != 0)
+, m_bGlyphQuadsDirty(false)
 {
 
 }
@@ -579,6 +739,13 @@ void CCLabelBMFont::createFontChars()
 
     unsigned int quantityOfLines = 1;
     unsigned int stringLen = m_sString ? cc_wcslen(m_sString) : 0;
+    if (m_bGlyphQuads)
+    {
+        ccBMFontLetter noLetter;
+        noLetter.valid = false;
+        m_tLetters.assign(stringLen, noLetter);
+        m_bGlyphQuadsDirty = true;
+    }
     if (stringLen == 0)
     {
         return;
@@ -639,52 +806,68 @@ void CCLabelBMFont::createFontChars()
         rect.origin.x += m_tImageOffset.x;
         rect.origin.y += m_tImageOffset.y;
 
-        CCSprite *fontChar;
+        // See issue 1343. cast( signed short + unsigned integer ) == unsigned integer (sign is lost!)
+        int yOffset = m_pConfiguration->m_nCommonHeight - fontDef.yOffset;
+        CCPoint fontPos = ccp( (float)nextFontPositionX + fontDef.xOffset + fontDef.rect.size.width*0.5f + kerningAmount,
+            (float)nextFontPositionY + yOffset - rect.size.height*0.5f * CC_CONTENT_SCALE_FACTOR() );
 
-        bool hasSprite = true;
-        fontChar = (CCSprite*)(this->getChildByTag(i));
-        if(fontChar )
+        if (m_bGlyphQuads)
         {
-            // Reusing previous Sprite
-			fontChar->setVisible(true);
+            // the quad of the letter is written by updateGlyphQuads
+            ccBMFontLetter& letter = m_tLetters[i];
+            letter.position = CC_POINT_PIXELS_TO_POINTS(fontPos);
+            letter.rect = rect;
+            letter.valid = true;
         }
         else
         {
-            // New Sprite ? Set correct color, opacity, etc...
-            if( 0 )
+            CCSprite *fontChar;
+
+            bool hasSprite = true;
+            fontChar = (CCSprite*)(this->getChildByTag(i));
+            if(fontChar )
             {
-				/* WIP: Doesn't support many features yet.
-				 But this code is super fast. It doesn't create any sprite.
-				 Ideal for big labels.
-				 */
-				fontChar = m_pReusedChar;
-				fontChar->setBatchNode(NULL);
-				hasSprite = false;
-			}
+                // Reusing previous Sprite
+                fontChar->setVisible(true);
+            }
             else
             {
-                fontChar = new CCSprite();
-                fontChar->initWithTexture(m_pobTextureAtlas->getTexture(), rect);
-                addChild(fontChar, i, i);
-                fontChar->release();
-			}
-            
-            // Apply label properties
-			fontChar->setOpacityModifyRGB(m_isOpacityModifyRGB);
-            
-			// Color MUST be set before opacity, since opacity might change color if OpacityModifyRGB is on
-			fontChar->updateDisplayedColor(m_displayedColor);
-			fontChar->updateDisplayedOpacity(m_displayedOpacity);
-        }
+                // New Sprite ? Set correct color, opacity, etc...
+                if( 0 )
+                {
+                    /* WIP: Doesn't support many features yet.
+                     But this code is super fast. It doesn't create any sprite.
+                     Ideal for big labels.
+                     */
+                    fontChar = m_pReusedChar;
+                    fontChar->setBatchNode(NULL);
+                    hasSprite = false;
+                }
+                else
+                {
+                    fontChar = new CCSprite();
+                    fontChar->initWithTexture(m_pobTextureAtlas->getTexture(), rect);
+                    addChild(fontChar, i, i);
+                    fontChar->release();
+                }
 
-        // updating previous sprite
-        fontChar->setTextureRect(rect, false, rect.size);
+                // Apply label properties
+                fontChar->setOpacityModifyRGB(m_isOpacityModifyRGB);
 
-        // See issue 1343. cast( signed short + unsigned integer ) == unsigned integer (sign is lost!)
-        int yOffset = m_pConfiguration->m_nCommonHeight - fontDef.yOffset;
-        CCPoint fontPos = ccp( (float)nextFontPositionX + fontDef.xOffset + fontDef.rect.size.width*0.5f + kerningAmount,
-            (float)nextFontPositionY + yOffset - rect.size.height*0.5f * CC_CONTENT_SCALE_FACTOR() );
-        fontChar->setPosition(CC_POINT_PIXELS_TO_POINTS(fontPos));
+                // Color MUST be set before opacity, since opacity might change color if OpacityModifyRGB is on
+                fontChar->updateDisplayedColor(m_displayedColor);
+                fontChar->updateDisplayedOpacity(m_displayedOpacity);
+            }
+
+            // updating previous sprite
+            fontChar->setTextureRect(rect, false, rect.size);
+            fontChar->setPosition(CC_POINT_PIXELS_TO_POINTS(fontPos));
+
+            if (! hasSprite)
+            {
+                updateQuadFromSprite(fontChar, i);
+            }
+        }
 
         // update kerning
         nextFontPositionX += fontDef.xAdvance + kerningAmount;
@@ -694,11 +877,6 @@ void CCLabelBMFont::createFontChars()
         {
             longestLine = nextFontPositionX;
         }
-        
-        if (! hasSprite)
-        {
-            updateQuadFromSprite(fontChar, i);
-        }
     }
 
     // If the last character processed has an xAdvance which is less that the width of the characters image, then we need
@@ -810,20 +988,20 @@ void CCLabelBMFont::updateLabel()
         float startOfLine = -1, startOfWord = -1;
         int skip = 0;
 
-        CCArray* children = getChildren();
-        for (unsigned int j = 0; j < children->count(); j++)
+        unsigned int letterCount = getLetterCount();
+        for (unsigned int j = 0; j < letterCount; j++)
         {
-            CCSprite* characterSprite;
+            int characterTag;
             unsigned int justSkipped = 0;
             
-            while (!(characterSprite = (CCSprite*)this->getChildByTag(j + skip + justSkipped)))
+            while (!hasLetter(characterTag = j + skip + justSkipped))
             {
                 justSkipped++;
             }
             
             skip += justSkipped;
             
-            if (!characterSprite->isVisible())
+            if (!isLetterVisible(characterTag))
                 continue;
 
             if (i >= stringLength)
@@ -833,7 +1011,7 @@ void CCLabelBMFont::updateLabel()
 
             if (!start_word)
             {
-                startOfWord = getLetterPosXLeft( characterSprite );
+                startOfWord = getLetterPosXLeft( characterTag );
                 start_word = true;
             }
             if (!start_line)
@@ -864,7 +1042,7 @@ void CCLabelBMFont::updateLabel()
 
                 if (!startOfWord)
                 {
-                    startOfWord = getLetterPosXLeft( characterSprite );
+                    startOfWord = getLetterPosXLeft( characterTag );
                     start_word = true;
                 }
                 if (!startOfLine)
@@ -887,7 +1065,7 @@ void CCLabelBMFont::updateLabel()
             }
 
             // Out of bounds.
-            if ( getLetterPosXRight( characterSprite ) - startOfLine > m_fWidth )
+            if ( getLetterPosXRight( characterTag ) - startOfLine > m_fWidth )
             {
                 if (!m_bLineBreakWithoutSpaces)
                 {
@@ -925,7 +1103,7 @@ void CCLabelBMFont::updateLabel()
 
                     if (!startOfWord)
                     {
-                        startOfWord = getLetterPosXLeft( characterSprite );
+                        startOfWord = getLetterPosXLeft( characterTag );
                         start_word = true;
                     }
                     if (!startOfLine)
@@ -988,11 +1166,10 @@ void CCLabelBMFont::updateLabel()
                 int index = i + line_length - 1 + lineNumber;
                 if (index < 0) continue;
 
-                CCSprite* lastChar = (CCSprite*)getChildByTag(index);
-                if ( lastChar == NULL )
+                if ( !hasLetter(index) )
                     continue;
 
-                lineWidth = lastChar->getPosition().x + lastChar->getContentSize().width/2.0f;
+                lineWidth = getLetterRight(index);
 
                 float shift = 0;
                 switch (m_pAlignment)
@@ -1014,8 +1191,7 @@ void CCLabelBMFont::updateLabel()
                         index = i + j + lineNumber;
                         if (index < 0) continue;
 
-                        CCSprite* characterSprite = (CCSprite*)getChildByTag(index);
-                        characterSprite->setPosition(ccpAdd(characterSprite->getPosition(), ccp(shift, 0.0f)));
+                        moveLetter(index, shift);
                     }
                 }
 
@@ -1078,6 +1254,227 @@ float CCLabelBMFont::getLetterPosXRight( CCSprite* sp )
     return sp->getPosition().x * m_fScaleX + (sp->getContentSize().width * m_fScaleX * sp->getAnchorPoint().x);
 }
 
+// LabelBMFont - Letters, sprites or quads
+bool CCLabelBMFont::hasLetter(int tag)
+{
+    if (m_bGlyphQuads)
+    {
+        return tag >= 0 && tag < (int)m_tLetters.size() && m_tLetters[tag].valid;
+    }
+    return CCSpriteBatchNode::getChildByTag(tag) != NULL;
+}
+
+bool CCLabelBMFont::isLetterVisible(int tag)
+{
+    if (m_bGlyphQuads)
+    {
+        // the letters of the previous strings are forgotten, not hidden
+        return true;
+    }
+    return CCSpriteBatchNode::getChildByTag(tag)->isVisible();
+}
+
+unsigned int CCLabelBMFont::getLetterCount()
+{
+    if (m_bGlyphQuads)
+    {
+        unsigned int count = 0;
+        for (unsigned int i = 0; i < m_tLetters.size(); ++i)
+        {
+            if (m_tLetters[i].valid)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+    return m_pChildren ? m_pChildren->count() : 0;
+}
+
+float CCLabelBMFont::getLetterPosXLeft(int tag)
+{
+    if (m_bGlyphQuads)
+    {
+        const ccBMFontLetter& letter = m_tLetters[tag];
+        return letter.position.x * m_fScaleX - (letter.rect.size.width * m_fScaleX * 0.5f);
+    }
+    return getLetterPosXLeft((CCSprite*)CCSpriteBatchNode::getChildByTag(tag));
+}
+
+float CCLabelBMFont::getLetterPosXRight(int tag)
+{
+    if (m_bGlyphQuads)
+    {
+        const ccBMFontLetter& letter = m_tLetters[tag];
+        return letter.position.x * m_fScaleX + (letter.rect.size.width * m_fScaleX * 0.5f);
+    }
+    return getLetterPosXRight((CCSprite*)CCSpriteBatchNode::getChildByTag(tag));
+}
+
+float CCLabelBMFont::getLetterRight(int tag)
+{
+    if (m_bGlyphQuads)
+    {
+        const ccBMFontLetter& letter = m_tLetters[tag];
+        return letter.position.x + letter.rect.size.width/2.0f;
+    }
+    CCSprite* sp = (CCSprite*)CCSpriteBatchNode::getChildByTag(tag);
+    return sp->getPosition().x + sp->getContentSize().width/2.0f;
+}
+
+void CCLabelBMFont::moveLetter(int tag, float shift)
+{
+    if (m_bGlyphQuads)
+    {
+        if (hasLetter(tag))
+        {
+            m_tLetters[tag].position.x += shift;
+            m_bGlyphQuadsDirty = true;
+        }
+        return;
+    }
+    CCSprite* sp = (CCSprite*)CCSpriteBatchNode::getChildByTag(tag);
+    sp->setPosition(ccpAdd(sp->getPosition(), ccp(shift, 0.0f)));
+}
+
+// writes the quads of the letters, like the letter sprites would
+void CCLabelBMFont::updateGlyphQuads()
+{
+    m_bGlyphQuadsDirty = false;
+    m_pobTextureAtlas->removeAllQuads();
+
+    unsigned int count = getLetterCount();
+    if (count == 0)
+    {
+        return;
+    }
+    if (count > m_pobTextureAtlas->getCapacity())
+    {
+        m_pobTextureAtlas->resizeCapacity(count);
+    }
+
+    CCTexture2D* texture = m_pobTextureAtlas->getTexture();
+    float atlasWidth = (float)texture->getPixelsWide();
+    float atlasHeight = (float)texture->getPixelsHigh();
+
+    ccColor4B color4 = { m_displayedColor.r, m_displayedColor.g, m_displayedColor.b, m_displayedOpacity };
+    // special opacity for premultiplied textures
+    if (m_isOpacityModifyRGB)
+    {
+        color4.r *= m_displayedOpacity/255.0f;
+        color4.g *= m_displayedOpacity/255.0f;
+        color4.b *= m_displayedOpacity/255.0f;
+    }
+
+    ccV3F_C4B_T2F_Quad quad;
+    quad.bl.colors = quad.br.colors = quad.tl.colors = quad.tr.colors = color4;
+
+    unsigned int index = 0;
+    for (unsigned int i = 0; i < m_tLetters.size(); ++i)
+    {
+        const ccBMFontLetter& letter = m_tLetters[i];
+        if (! letter.valid)
+        {
+            continue;
+        }
+
+        CCRect rect = CC_RECT_POINTS_TO_PIXELS(letter.rect);
+        float left, right, top, bottom;
+#if CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+        left    = (2*rect.origin.x+1)/(2*atlasWidth);
+        right   = left + (rect.size.width*2-2)/(2*atlasWidth);
+        top     = (2*rect.origin.y+1)/(2*atlasHeight);
+        bottom  = top + (rect.size.height*2-2)/(2*atlasHeight);
+#else
+        left    = rect.origin.x/atlasWidth;
+        right   = (rect.origin.x + rect.size.width) / atlasWidth;
+        top     = rect.origin.y/atlasHeight;
+        bottom  = (rect.origin.y + rect.size.height) / atlasHeight;
+#endif // ! CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+
+        quad.bl.texCoords.u = left;
+        quad.bl.texCoords.v = bottom;
+        quad.br.texCoords.u = right;
+        quad.br.texCoords.v = bottom;
+        quad.tl.texCoords.u = left;
+        quad.tl.texCoords.v = top;
+        quad.tr.texCoords.u = right;
+        quad.tr.texCoords.v = top;
+
+        // the letters are centered on their position
+        const CCSize& size = letter.rect.size;
+        float x1 = letter.position.x - size.width * 0.5f;
+        float y1 = letter.position.y - size.height * 0.5f;
+        float x2 = size.width + x1;
+        float y2 = size.height + y1;
+        quad.bl.vertices = vertex3(RENDER_IN_SUBPIXEL(x1), RENDER_IN_SUBPIXEL(y1), 0);
+        quad.br.vertices = vertex3(RENDER_IN_SUBPIXEL(x2), RENDER_IN_SUBPIXEL(y1), 0);
+        quad.tl.vertices = vertex3(RENDER_IN_SUBPIXEL(x1), RENDER_IN_SUBPIXEL(y2), 0);
+        quad.tr.vertices = vertex3(RENDER_IN_SUBPIXEL(x2), RENDER_IN_SUBPIXEL(y2), 0);
+
+        m_pobTextureAtlas->updateQuad(&quad, index++);
+    }
+}
+
+void CCLabelBMFont::setGlyphQuadsEnabled(bool bEnabled)
+{
+    if (m_bGlyphQuads == bEnabled)
+    {
+        return;
+    }
+
+    if (bEnabled)
+    {
+        // removes the quads of the letter sprites too
+        removeAllChildrenWithCleanup(true);
+    }
+    else
+    {
+        m_tLetters.clear();
+        m_bGlyphQuadsDirty = false;
+        m_pobTextureAtlas->removeAllQuads();
+    }
+    m_bGlyphQuads = bEnabled;
+
+    if (m_pConfiguration)
+    {
+        updateLabel();
+    }
+}
+
+bool CCLabelBMFont::isGlyphQuadsEnabled()
+{
+    return m_bGlyphQuads;
+}
+
+CCNode* CCLabelBMFont::getChildByTag(int tag)
+{
+    if (m_bGlyphQuads && hasLetter(tag))
+    {
+        // a letter is requested, it needs its sprite
+        setGlyphQuadsEnabled(false);
+    }
+    return CCSpriteBatchNode::getChildByTag(tag);
+}
+
+void CCLabelBMFont::setOpacityModifyRGB(bool bValue)
+{
+    CCSpriteBatchNode::setOpacityModifyRGB(bValue);
+    m_bGlyphQuadsDirty = m_bGlyphQuads;
+}
+
+void CCLabelBMFont::updateDisplayedColor(const ccColor3B& parentColor)
+{
+    CCSpriteBatchNode::updateDisplayedColor(parentColor);
+    m_bGlyphQuadsDirty = m_bGlyphQuads;
+}
+
+void CCLabelBMFont::updateDisplayedOpacity(GLubyte parentOpacity)
+{
+    CCSpriteBatchNode::updateDisplayedOpacity(parentOpacity);
+    m_bGlyphQuadsDirty = m_bGlyphQuads;
+}
+
 // LabelBMFont - FntFile
 void CCLabelBMFont::setFntFile(const char* fntFile)
 {
@@ -1108,19 +1505,24 @@ CCBMFontConfiguration* CCLabelBMFont::getConfiguration() const
 	return m_pConfiguration;
 }
 
-//LabelBMFont - Debug draw
-#if CC_LABELBMFONT_DEBUG_DRAW
+//LabelBMFont - Draw
 void CCLabelBMFont::draw()
 {
+    if (m_bGlyphQuadsDirty)
+    {
+        updateGlyphQuads();
+    }
+
     CCSpriteBatchNode::draw();
+
+#if CC_LABELBMFONT_DEBUG_DRAW
     const CCSize& s = this->getContentSize();
     CCPoint vertices[4]={
         ccp(0,0),ccp(s.width,0),
         ccp(s.width,s.height),ccp(0,s.height),
     };
     ccDrawPoly(vertices, 4, true);
-}
-
 #endif // CC_LABELBMFONT_DEBUG_DRAW
+}
 
 NS_CC_END
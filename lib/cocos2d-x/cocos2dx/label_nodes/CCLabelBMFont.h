@@ -87,6 +87,18 @@ typedef struct _BMFontPadding {
     int bottom;
 } ccBMFontPadding;
 
+/** @struct ccBMFontLetter
+Letter of a CCLabelBMFont drawn as a quad of the label atlas
+*/
+typedef struct _BMFontLetter {
+    //! center of the letter in the label, in points
+    CCPoint position;
+    //! rect of the letter in the texture, in points
+    CCRect rect;
+    //! false for the characters without a letter: line breaks and characters missing in the font
+    bool valid;
+} ccBMFontLetter;
+
 typedef struct _FontDefHashElement
 {
 	unsigned int	key;		// key. Font Unicode value
@@ -150,11 +162,9 @@ public:
     std::set<unsigned int>* getCharacterSet() const;
 private:
     std::set<unsigned int>* parseConfigFile(const char *controlFile);
-    void parseCharacterDefinition(std::string line, ccBMFontDef *characterDefinition);
-    void parseInfoArguments(std::string line);
-    void parseCommonArguments(std::string line);
-    void parseImageFileName(std::string line, const char *fntFile);
-    void parseKerningEntry(std::string line);
+    std::set<unsigned int>* parseTextConfigFile(const char* contents, unsigned long size, const char *controlFile);
+    std::set<unsigned int>* parseBinaryConfigFile(const unsigned char* data, unsigned long size, const char *controlFile);
+    void addKerningEntry(int first, int second, int amount);
     void purgeKerningDictionary();
     void purgeFontDefDictionary();
 };
@@ -170,7 +180,8 @@ Features:
 - change the opacity
 - It can be used as part of a menu item.
 - anchorPoint can be used to align the "label"
-- Supports AngelCode text format
+- Supports AngelCode text and binary formats
+- Labels whose string changes often can draw their characters as quads, without sprites (see setGlyphQuadsEnabled)
 
 Limitations:
 - All inner characters are using an anchorPoint of (0.5f, 0.5f) and it is not recommend to change it
@@ -244,14 +255,38 @@ public:
     void setFntFile(const char* fntFile);
     const char* getFntFile();
 	CCBMFontConfiguration* getConfiguration() const;
-#if CC_LABELBMFONT_DEBUG_DRAW
+
+    /** Whether the characters are drawn as quads of the label atlas, without a CCSprite child per character.
+     The quads follow the kerning, the alignment, the width and the color and opacity of the label,
+     they are written by the next draw. It is much lighter for the labels whose string changes often.
+     getChildByTag switches the label back to the letter sprites: the letters can still be
+     rotated, scaled or tinted one by one. Children must not be added to a label that draws quads.
+     Defaults to CC_LABELBMFONT_GLYPH_QUADS.
+     */
+    void setGlyphQuadsEnabled(bool bEnabled);
+    bool isGlyphQuadsEnabled();
+
+    /** returns the sprite of the letter at the index tag of the string, see setGlyphQuadsEnabled */
+    virtual CCNode* getChildByTag(int tag);
+    virtual void setOpacityModifyRGB(bool bValue);
+    virtual void updateDisplayedColor(const ccColor3B& parentColor);
+    virtual void updateDisplayedOpacity(GLubyte parentOpacity);
     virtual void draw();
-#endif // CC_LABELBMFONT_DEBUG_DRAW
 private:
     char * atlasNameFromFntFile(const char *fntFile);
     int kerningAmountForFirst(unsigned short first, unsigned short second);
     float getLetterPosXLeft( CCSprite* characterSprite );
     float getLetterPosXRight( CCSprite* characterSprite );
+
+    // letters by index in the string, sprites or quads
+    bool hasLetter(int tag);
+    bool isLetterVisible(int tag);
+    unsigned int getLetterCount();
+    float getLetterPosXLeft(int tag);
+    float getLetterPosXRight(int tag);
+    float getLetterRight(int tag);
+    void moveLetter(int tag, float shift);
+    void updateGlyphQuads();
     
 protected:
     virtual void setString(unsigned short *newString, bool needUpdateLabel);
@@ -278,6 +313,11 @@ protected:
     
     // reused char
     CCSprite *m_pReusedChar;
+
+    // the characters are drawn as quads, m_tLetters holds them
+    bool m_bGlyphQuads;
+    bool m_bGlyphQuadsDirty;
+    std::vector<ccBMFontLetter> m_tLetters;
 };
 
 /** Free function that parses a FNT file a place it on the cache
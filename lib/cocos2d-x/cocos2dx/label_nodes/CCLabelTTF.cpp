@@ -27,6 +27,14 @@ THE SOFTWARE.
 #include "shaders/CCGLProgram.h"
 #include "shaders/CCShaderCache.h"
 #include "CCApplication.h"
+#include "CCGlyphAtlas.h"
+#include "shaders/ccGLStateCache.h"
+#include "sprite_nodes/CCAutoBatchRenderer.h"
+#include "support/ccUTF8.h"
+#include "support/CCProfiling.h"
+#include "kazmath/GL/matrix.h"
+#include <algorithm>
+#include <stddef.h>
 
 NS_CC_BEGIN
 
@@ -48,7 +56,10 @@ CCLabelTTF::CCLabelTTF()
 , m_shadowEnabled(false)
 , m_strokeEnabled(false)
 , m_textFillColor(ccWHITE)
+, m_bGlyphAtlas(CC_LABELTTF_GLYPH_ATLAS != 0)
+, m_uGlyphGeneration(0)
 {
+    m_tGlyphColor = ccc4(0, 0, 0, 0);
 }
 
 CCLabelTTF::~CCLabelTTF()
@@ -292,6 +303,26 @@ void CCLabelTTF::setFontName(const char *fontName)
 // Helper
 bool CCLabelTTF::updateTexture()
 {
+    CCShaderCache* pShaderCache = CCShaderCache::sharedShaderCache();
+    if (isGlyphAtlasUsed())
+    {
+        // the glyphs are white in the alpha channel of the pages, the vertex colors tint them
+        if (getShaderProgram() == pShaderCache->programForKey(SHADER_PROGRAM))
+        {
+            this->setShaderProgram(pShaderCache->programForKey(kCCShader_PositionTextureA8Color));
+        }
+        this->setTexture(NULL);
+        this->updateGlyphQuads();
+        return true;
+    }
+
+    if (getShaderProgram() == pShaderCache->programForKey(kCCShader_PositionTextureA8Color))
+    {
+        this->setShaderProgram(pShaderCache->programForKey(SHADER_PROGRAM));
+    }
+    m_tGlyphQuads.clear();
+    m_tGlyphRuns.clear();
+
     CCTexture2D *tex;
     tex = new CCTexture2D();
     
@@ -328,6 +359,294 @@ bool CCLabelTTF::updateTexture()
     return true;
 }
 
+// Glyph atlas
+void CCLabelTTF::setGlyphAtlasEnabled(bool bEnabled)
+{
+    if (m_bGlyphAtlas != bEnabled)
+    {
+        m_bGlyphAtlas = bEnabled;
+        this->updateTexture();
+    }
+}
+
+bool CCLabelTTF::isGlyphAtlasEnabled()
+{
+    return m_bGlyphAtlas;
+}
+
+bool CCLabelTTF::isGlyphAtlasUsed()
+{
+    return m_bGlyphAtlas && ! m_shadowEnabled && ! m_strokeEnabled;
+}
+
+static bool glyphRunLess(const std::pair<unsigned int, ccV3F_C4B_T2F_Quad>& a, const std::pair<unsigned int, ccV3F_C4B_T2F_Quad>& b)
+{
+    return a.first < b.first;
+}
+
+void CCLabelTTF::updateGlyphQuads()
+{
+    CCGlyphAtlas* pAtlas = CCGlyphAtlas::sharedGlyphAtlas();
+    m_uGlyphGeneration = pAtlas->getGeneration();
+    m_tGlyphQuads.clear();
+    m_tGlyphRuns.clear();
+
+    // laid out in pixels, like the texture of the label would be rendered
+    float scale = CC_CONTENT_SCALE_FACTOR();
+    int fontSize = (int)(m_fFontSize * scale);
+    CCSize dimensions = CC_SIZE_POINTS_TO_PIXELS(m_tDimensions);
+
+    int length = 0;
+    unsigned short* utf16 = cc_utf8_to_utf16(m_string.c_str(), -1, &length);
+    std::vector<ccGlyph> glyphs(length);
+    for (int i = 0; i < length; ++i)
+    {
+        const ccGlyph* glyph = (utf16[i] == '\n') ? NULL : pAtlas->getGlyph(m_pFontName->c_str(), fontSize, utf16[i]);
+        if (glyph)
+        {
+            glyphs[i] = *glyph;
+        }
+        else
+        {
+            glyphs[i].page = 0;
+            glyphs[i].rect = CCRectZero;
+            glyphs[i].advance = 0;
+        }
+    }
+    float lineHeight = pAtlas->getLineHeight(m_pFontName->c_str(), fontSize);
+
+    // lines break at '\n', and at the last space before the width of the dimensions
+    std::vector<int> lineStarts, lineEnds;
+    std::vector<float> lineWidths;
+    int lineStart = 0, lastSpace = -1;
+    float x = 0, widthBeforeSpace = 0, maxWidth = 0;
+    for (int i = 0; i <= length; ++i)
+    {
+        if (i == length || utf16[i] == '\n')
+        {
+            lineStarts.push_back(lineStart);
+            lineEnds.push_back(i);
+            lineWidths.push_back(x);
+            maxWidth = MAX(maxWidth, x);
+            lineStart = i + 1;
+            lastSpace = -1;
+            x = 0;
+            continue;
+        }
+
+        float advance = glyphs[i].advance;
+        if (dimensions.width > 0 && x + advance > dimensions.width && i > lineStart)
+        {
+            int lineEnd = i;
+            float lineWidth = x;
+            if (lastSpace > lineStart)
+            {
+                lineEnd = lastSpace;
+                lineWidth = widthBeforeSpace;
+            }
+            lineStarts.push_back(lineStart);
+            lineEnds.push_back(lineEnd);
+            lineWidths.push_back(lineWidth);
+            maxWidth = MAX(maxWidth, lineWidth);
+
+            lineStart = (lineEnd == i) ? i : lineEnd + 1;
+            lastSpace = -1;
+            x = 0;
+            for (int j = lineStart; j < i; ++j)
+            {
+                x += glyphs[j].advance;
+            }
+        }
+
+        if (utf16[i] == ' ')
+        {
+            lastSpace = i;
+            widthBeforeSpace = x;
+        }
+        x += advance;
+    }
+    CC_SAFE_DELETE_ARRAY(utf16);
+
+    float width = dimensions.width > 0 ? dimensions.width : maxWidth;
+    float textHeight = lineHeight * lineStarts.size();
+    float height = dimensions.height > 0 ? dimensions.height : textHeight;
+    float top = height;
+    if (m_vAlignment == kCCVerticalTextAlignmentCenter)
+    {
+        top -= floorf((height - textHeight) / 2);
+    }
+    else if (m_vAlignment == kCCVerticalTextAlignmentBottom)
+    {
+        top -= height - textHeight;
+    }
+
+    std::vector<std::pair<unsigned int, ccV3F_C4B_T2F_Quad> > quads;
+    quads.reserve(length);
+    for (unsigned int line = 0; line < lineStarts.size(); ++line)
+    {
+        float penX = 0;
+        if (m_hAlignment == kCCTextAlignmentCenter)
+        {
+            penX = floorf((width - lineWidths[line]) / 2);
+        }
+        else if (m_hAlignment == kCCTextAlignmentRight)
+        {
+            penX = width - lineWidths[line];
+        }
+        float lineTop = top - lineHeight * line;
+
+        for (int i = lineStarts[line]; i < lineEnds[line]; ++i)
+        {
+            const ccGlyph& glyph = glyphs[i];
+            if (glyph.rect.size.width > 0)
+            {
+                ccV3F_C4B_T2F_Quad quad;
+                float left = penX / scale;
+                float right = (penX + glyph.rect.size.width) / scale;
+                float bottom = (lineTop - glyph.rect.size.height) / scale;
+                float upper = lineTop / scale;
+                quad.bl.vertices = vertex3(left, bottom, 0);
+                quad.br.vertices = vertex3(right, bottom, 0);
+                quad.tl.vertices = vertex3(left, upper, 0);
+                quad.tr.vertices = vertex3(right, upper, 0);
+
+                float u1 = glyph.rect.origin.x / kCCGlyphAtlasPageSize;
+                float u2 = (glyph.rect.origin.x + glyph.rect.size.width) / kCCGlyphAtlasPageSize;
+                float v1 = glyph.rect.origin.y / kCCGlyphAtlasPageSize;
+                float v2 = (glyph.rect.origin.y + glyph.rect.size.height) / kCCGlyphAtlasPageSize;
+                quad.bl.texCoords = tex2(u1, v2);
+                quad.br.texCoords = tex2(u2, v2);
+                quad.tl.texCoords = tex2(u1, v1);
+                quad.tr.texCoords = tex2(u2, v1);
+
+                quads.push_back(std::make_pair(glyph.page, quad));
+            }
+            penX += glyph.advance;
+        }
+    }
+
+    // one draw per page of the atlas
+    std::stable_sort(quads.begin(), quads.end(), glyphRunLess);
+    for (unsigned int i = 0; i < quads.size(); ++i)
+    {
+        if (m_tGlyphRuns.empty() || m_tGlyphRuns.back().page != quads[i].first)
+        {
+            ccGlyphRun run = { quads[i].first, i, 0 };
+            m_tGlyphRuns.push_back(run);
+        }
+        m_tGlyphRuns.back().count++;
+        m_tGlyphQuads.push_back(quads[i].second);
+    }
+
+    // 6 indices per quad, made once for the longest string
+    unsigned int quadCount = MIN((unsigned int)m_tGlyphQuads.size(), 65536u / 4);
+    for (unsigned int i = m_tGlyphIndices.size() / 6; i < quadCount; ++i)
+    {
+        GLushort index = (GLushort)(i * 4);
+        GLushort indices[6] = { index, (GLushort)(index + 1), (GLushort)(index + 2), (GLushort)(index + 3), (GLushort)(index + 2), (GLushort)(index + 1) };
+        m_tGlyphIndices.insert(m_tGlyphIndices.end(), indices, indices + 6);
+    }
+
+    // the sprite keeps the size of the label, for the anchor point and the culling
+    this->setTextureRect(CCRectMake(0, 0, width / scale, height / scale));
+
+    m_tGlyphColor = ccc4(0, 0, 0, 0);
+    updateGlyphColors();
+}
+
+void CCLabelTTF::updateGlyphColors()
+{
+    ccColor4B color4 = { (GLubyte)(m_displayedColor.r * m_textFillColor.r / 255),
+                         (GLubyte)(m_displayedColor.g * m_textFillColor.g / 255),
+                         (GLubyte)(m_displayedColor.b * m_textFillColor.b / 255),
+                         m_displayedOpacity };
+    if (m_bOpacityModifyRGB)
+    {
+        color4.r *= m_displayedOpacity /255.0f;
+        color4.g *= m_displayedOpacity /255.0f;
+        color4.b *= m_displayedOpacity /255.0f;
+    }
+
+    if (color4.r == m_tGlyphColor.r && color4.g == m_tGlyphColor.g && color4.b == m_tGlyphColor.b && color4.a == m_tGlyphColor.a)
+    {
+        return;
+    }
+    m_tGlyphColor = color4;
+
+    for (unsigned int i = 0; i < m_tGlyphQuads.size(); ++i)
+    {
+        ccV3F_C4B_T2F_Quad& quad = m_tGlyphQuads[i];
+        quad.bl.colors = color4;
+        quad.br.colors = color4;
+        quad.tl.colors = color4;
+        quad.tr.colors = color4;
+    }
+}
+
+void CCLabelTTF::draw(void)
+{
+    if (! isGlyphAtlasUsed())
+    {
+        CCSprite::draw();
+        return;
+    }
+
+    CC_PROFILER_START_CATEGORY(kCCProfilerCategorySprite, "CCLabelTTF - draw");
+
+    // glyphs of the label were evicted from the atlas
+    CCGlyphAtlas* pAtlas = CCGlyphAtlas::sharedGlyphAtlas();
+    if (m_uGlyphGeneration != pAtlas->getGeneration())
+    {
+        updateGlyphQuads();
+    }
+    updateGlyphColors();
+
+    CCAutoBatchRenderer* pBatchRenderer = CCAutoBatchRenderer::sharedRenderer();
+    if (! pBatchRenderer->isEnabled() && ! m_tGlyphRuns.empty())
+    {
+        CC_NODE_DRAW_SETUP();
+
+        ccGLBlendFunc( m_sBlendFunc.src, m_sBlendFunc.dst );
+        ccGLEnableVertexAttribs( kCCVertexAttribFlag_PosColorTex );
+
+#define kQuadSize sizeof(ccV3F_C4B_T2F)
+        long offset = (long)&m_tGlyphQuads[0];
+        glVertexAttribPointer(kCCVertexAttrib_Position, 3, GL_FLOAT, GL_FALSE, kQuadSize, (void*) (offset + offsetof(ccV3F_C4B_T2F, vertices)));
+        glVertexAttribPointer(kCCVertexAttrib_TexCoords, 2, GL_FLOAT, GL_FALSE, kQuadSize, (void*) (offset + offsetof(ccV3F_C4B_T2F, texCoords)));
+        glVertexAttribPointer(kCCVertexAttrib_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE, kQuadSize, (void*) (offset + offsetof(ccV3F_C4B_T2F, colors)));
+#undef kQuadSize
+    }
+
+    for (unsigned int i = 0; i < m_tGlyphRuns.size(); ++i)
+    {
+        const ccGlyphRun& run = m_tGlyphRuns[i];
+        // quads past the 16 bit indices are not drawn
+        unsigned int count = MIN(run.count, (unsigned int)m_tGlyphIndices.size() / 6 - MIN(run.start, (unsigned int)m_tGlyphIndices.size() / 6));
+        if (count == 0)
+        {
+            continue;
+        }
+
+        pAtlas->touchPage(run.page);
+        GLuint texture = pAtlas->getPageTexture(run.page)->getName();
+        if (pBatchRenderer->isEnabled())
+        {
+            // drawn with the consecutive sprites and labels sharing the same page, shader and blending
+            pBatchRenderer->addQuads(&m_tGlyphQuads[run.start], count, texture, getShaderProgram(), m_sBlendFunc);
+        }
+        else
+        {
+            ccGLBindTexture2D(texture);
+            glDrawElements(GL_TRIANGLES, (GLsizei)count * 6, GL_UNSIGNED_SHORT, &m_tGlyphIndices[run.start * 6]);
+            CC_INCREMENT_GL_DRAWS(1);
+        }
+    }
+
+    CHECK_GL_ERROR_DEBUG();
+
+    CC_PROFILER_STOP_CATEGORY(kCCProfilerCategorySprite, "CCLabelTTF - draw");
+}
+
 void CCLabelTTF::enableShadow(const CCSize &shadowOffset, float shadowOpacity, float shadowBlur, bool updateTexture)
 {
     #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID) || (CC_TARGET_PLATFORM == CC_PLATFORM_IOS)
@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "sprite_nodes/CCSprite.h"
 #include "textures/CCTexture2D.h"
+#include <vector>
 
 NS_CC_BEGIN
 
@@ -53,6 +54,9 @@ NS_CC_BEGIN
  *                                          kCCTextAlignmentLeft, kCCVerticalTextAlignmentCenter);
  * @endcode
  *
+ * Labels whose string changes often can be built from glyphs shared by all the labels instead
+ * (see setGlyphAtlasEnabled): changing their string only moves quads.
+ *
  */
 class CC_DLL CCLabelTTF : public CCSprite, public CCLabelProtocol
 {
@@ -161,9 +165,27 @@ public:
     
     const char* getFontName();
     void setFontName(const char *fontName);
+
+    /** Whether the label is drawn with quads of glyphs rasterized once in the shared CCGlyphAtlas,
+     instead of rendering the whole string into a texture of its own each time it changes.
+     The glyphs are rendered one by one, so kerning is lost and lines are wrapped by the label.
+     Labels with a shadow or a stroke always use a texture of their own.
+     Default is CC_LABELTTF_GLYPH_ATLAS.
+     */
+    void setGlyphAtlasEnabled(bool bEnabled);
+    bool isGlyphAtlasEnabled();
+
+    /**
+     *  @js NA
+     *  @lua NA
+     */
+    virtual void draw(void);
     
 private:
     bool updateTexture();
+    bool isGlyphAtlasUsed();
+    void updateGlyphQuads();
+    void updateGlyphColors();
 protected:
     
     /** set the text definition for this label */
@@ -198,7 +220,22 @@ protected:
     /** font tint */
     ccColor3B   m_textFillColor;
 
-    
+    /** quads of glyphs */
+    typedef struct _ccGlyphRun
+    {
+        unsigned int page;
+        unsigned int start;
+        unsigned int count;
+    } ccGlyphRun;
+
+    bool m_bGlyphAtlas;
+    std::vector<ccV3F_C4B_T2F_Quad> m_tGlyphQuads;
+    std::vector<GLushort> m_tGlyphIndices;
+    // the quads sharing a page of the atlas
+    std::vector<ccGlyphRun> m_tGlyphRuns;
+    // generation of the atlas the quads were made with
+    unsigned int m_uGlyphGeneration;
+    ccColor4B m_tGlyphColor;
 };
 
 
@@ -2,6 +2,7 @@
 #include "CCClippingRegionNode.h"
 #include "CCDirector.h"
 #include "CCEGLView.h"
+#include "sprite_nodes/CCAutoBatchRenderer.h"
 
 NS_CC_BEGIN
 
@@ -30,6 +31,8 @@ void CCClippingRegionNode::visit()
 {
     if (m_clippingEnabled)
     {
+        // the queued sprites are drawn without the scissor
+        CCAutoBatchRenderer::sharedRenderer()->flush();
         glEnable(GL_SCISSOR_TEST);
         
         const CCPoint pos = convertToWorldSpace(CCPoint(m_clippingRegion.origin.x, m_clippingRegion.origin.y));
@@ -43,6 +46,7 @@ void CCClippingRegionNode::visit()
     
     if (m_clippingEnabled)
     {
+        CCAutoBatchRenderer::sharedRenderer()->flush();
         glDisable(GL_SCISSOR_TEST);
     }
 }
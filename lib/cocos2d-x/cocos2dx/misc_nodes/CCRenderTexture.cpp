@@ -38,6 +38,7 @@ THE SOFTWARE.
 #include "support/CCNotificationCenter.h"
 #include "CCEventType.h"
 #include "effects/CCGrid.h"
+#include "sprite_nodes/CCAutoBatchRenderer.h"
 // extern
 #include "kazmath/GL/matrix.h"
 #include "CCEGLView.h"
@@ -362,6 +363,9 @@ bool CCRenderTexture::initWithWidthAndHeight(int w, int h, CCTexture2DPixelForma
 
 void CCRenderTexture::begin()
 {
+    // the queued sprites belong to the previous frame buffer
+    CCAutoBatchRenderer::sharedRenderer()->flush();
+
     kmGLMatrixMode(KM_GL_PROJECTION);
 	kmGLPushMatrix();
 	kmGLMatrixMode(KM_GL_MODELVIEW);
@@ -471,6 +475,8 @@ void CCRenderTexture::beginWithClear(float r, float g, float b, float a, float d
 
 void CCRenderTexture::end()
 {
+    CCAutoBatchRenderer::sharedRenderer()->flush();
+
     CCDirector *director = CCDirector::sharedDirector();
     
     glBindFramebuffer(GL_FRAMEBUFFER, m_nOldFBO);
@@ -511,6 +517,7 @@ void CCRenderTexture::clearStencil(int stencilValue)
     int stencilClearValue;
     glGetIntegerv(GL_STENCIL_CLEAR_VALUE, &stencilClearValue);
 
+    CCAutoBatchRenderer::sharedRenderer()->flush();
     glClearStencil(stencilValue);
     glClear(GL_STENCIL_BUFFER_BIT);
 
@@ -405,6 +405,9 @@ void CCParticleBatchNode::draw(void)
 {
     CC_PROFILER_START("CCParticleBatchNode - draw");
 
+    // the children updated in parallel write the atlas
+    CCParticleSystem::runParallelUpdates();
+
     if( m_pTextureAtlas->getTotalQuads() == 0 )
     {
         return;
@@ -437,8 +440,9 @@ void CCParticleBatchNode::increaseAtlasCapacityTo(unsigned int quantity)
 //sets a 0'd quad into the quads array
 void CCParticleBatchNode::disableParticle(unsigned int particleIndex)
 {
-    ccV3F_C4B_T2F_Quad* quad = &((m_pTextureAtlas->getQuads())[particleIndex]);
+    ccV3F_C4B_T2F_Quad* quad = &((m_pTextureAtlas->getQuadsForUpdate())[particleIndex]);
     quad->br.vertices.x = quad->br.vertices.y = quad->tr.vertices.x = quad->tr.vertices.y = quad->tl.vertices.x = quad->tl.vertices.y = quad->bl.vertices.x = quad->bl.vertices.y = 0.0f;
+    m_pTextureAtlas->markQuadsDirty(particleIndex, 1);
 }
 
 // CCParticleBatchNode - add / remove / reorder helper methods
@@ -43,6 +43,7 @@ THE SOFTWARE.
 
 #include "CCParticleSystem.h"
 #include "CCParticleBatchNode.h"
+#include "ccParticleKernels.h"
 #include "ccTypes.h"
 #include "textures/CCTextureCache.h"
 #include "textures/CCTextureAtlas.h"
@@ -54,16 +55,22 @@ THE SOFTWARE.
 #include "support/zip_support/ZipUtils.h"
 #include "CCDirector.h"
 #include "support/CCProfiling.h"
+#include "support/CCJobPool.h"
 // opengl
 #include "CCGL.h"
 
 #include <string>
+#include <vector>
 
 using namespace std;
 
 
 NS_CC_BEGIN
 
+static bool s_bParallelUpdate = (CC_PARTICLE_SYSTEM_PARALLEL_UPDATE != 0);
+// systems whose update is queued for runParallelUpdates, retained
+static vector<void*> s_pendingSystems;
+
 // ideas taken from:
 //     . The ocean spray in your face [Jeff Lander]
 //        http://www.double.co.nz/dust/col0798.pdf
@@ -84,12 +91,20 @@ NS_CC_BEGIN
 CCParticleSystem::CCParticleSystem()
 : m_sPlistFile("")
 , m_fElapsed(0)
-, m_pParticles(NULL)
 , m_fEmitCounter(0)
 , m_uParticleIdx(0)
 , m_pBatchNode(NULL)
 , m_uAtlasIndex(0)
 , m_bTransformSystemDirty(false)
+, m_bUpdatePending(false)
+, m_fUpdateDt(0)
+, m_bStepping(false)
+, m_tUpdateWorldPosition(CCPointZero)
+, m_bFinished(false)
+, m_uRandomSeed(0)
+, m_bHasRandomSeed(false)
+, m_uRandomState(0)
+, m_bUseRandomState(false)
 , m_uAllocatedParticles(0)
 , m_bIsActive(true)
 , m_uParticleCount(0)
@@ -134,6 +149,7 @@ CCParticleSystem::CCParticleSystem()
     modeB.rotatePerSecondVar = 0;
     m_tBlendFunc.src = CC_BLEND_SRC;
     m_tBlendFunc.dst = CC_BLEND_DST;
+    memset(&m_tParticleData, 0, sizeof(m_tParticleData));
 }
 // implementation CCParticleSystem
 
@@ -394,11 +410,7 @@ bool CCParticleSystem::initWithTotalParticles(unsigned int numberOfParticles)
 {
     m_uTotalParticles = numberOfParticles;
 
-    CC_SAFE_FREE(m_pParticles);
-    
-    m_pParticles = (tCCParticle*)calloc(m_uTotalParticles, sizeof(tCCParticle));
-
-    if( ! m_pParticles )
+    if( ! ccParticleDataAlloc(&m_tParticleData, m_uTotalParticles) )
     {
         CCLOG("Particle system: not enough memory");
         this->release();
@@ -410,7 +422,7 @@ bool CCParticleSystem::initWithTotalParticles(unsigned int numberOfParticles)
     {
         for (unsigned int i = 0; i < m_uTotalParticles; i++)
         {
-            m_pParticles[i].atlasIndex=i;
+            m_tParticleData.atlasIndex[i]=i;
         }
     }
     // default, active
@@ -448,7 +460,7 @@ CCParticleSystem::~CCParticleSystem()
     // Since the scheduler retains the "target (in this case the ParticleSystem)
 	// it is not needed to call "unscheduleUpdate" here. In fact, it will be called in "cleanup"
     //unscheduleUpdate();
-    CC_SAFE_FREE(m_pParticles);
+    ccParticleDataFree(&m_tParticleData);
     CC_SAFE_RELEASE(m_pTexture);
 }
 
@@ -459,8 +471,11 @@ bool CCParticleSystem::addParticle()
         return false;
     }
 
-    tCCParticle * particle = &m_pParticles[ m_uParticleCount ];
-    this->initParticle(particle);
+    // the particle is initialized as a structure, then stored in the arrays
+    tCCParticle particle;
+    ccParticleDataGetParticle(&m_tParticleData, m_uParticleCount, &particle);
+    this->initParticle(&particle);
+    ccParticleDataSetParticle(&m_tParticleData, m_uParticleCount, &particle);
     ++m_uParticleCount;
 
     return true;
@@ -470,27 +485,27 @@ void CCParticleSystem::initParticle(tCCParticle* particle)
 {
     // timeToLive
     // no negative life. prevent division by 0
-    particle->timeToLive = m_fLife + m_fLifeVar * CCRANDOM_MINUS1_1();
+    particle->timeToLive = m_fLife + m_fLifeVar * randomMinus1To1();
     particle->timeToLive = MAX(0, particle->timeToLive);
 
     // position
-    particle->pos.x = m_tSourcePosition.x + m_tPosVar.x * CCRANDOM_MINUS1_1();
+    particle->pos.x = m_tSourcePosition.x + m_tPosVar.x * randomMinus1To1();
 
-    particle->pos.y = m_tSourcePosition.y + m_tPosVar.y * CCRANDOM_MINUS1_1();
+    particle->pos.y = m_tSourcePosition.y + m_tPosVar.y * randomMinus1To1();
 
 
     // Color
     ccColor4F start;
-    start.r = clampf(m_tStartColor.r + m_tStartColorVar.r * CCRANDOM_MINUS1_1(), 0, 1);
-    start.g = clampf(m_tStartColor.g + m_tStartColorVar.g * CCRANDOM_MINUS1_1(), 0, 1);
-    start.b = clampf(m_tStartColor.b + m_tStartColorVar.b * CCRANDOM_MINUS1_1(), 0, 1);
-    start.a = clampf(m_tStartColor.a + m_tStartColorVar.a * CCRANDOM_MINUS1_1(), 0, 1);
+    start.r = clampf(m_tStartColor.r + m_tStartColorVar.r * randomMinus1To1(), 0, 1);
+    start.g = clampf(m_tStartColor.g + m_tStartColorVar.g * randomMinus1To1(), 0, 1);
+    start.b = clampf(m_tStartColor.b + m_tStartColorVar.b * randomMinus1To1(), 0, 1);
+    start.a = clampf(m_tStartColor.a + m_tStartColorVar.a * randomMinus1To1(), 0, 1);
 
     ccColor4F end;
-    end.r = clampf(m_tEndColor.r + m_tEndColorVar.r * CCRANDOM_MINUS1_1(), 0, 1);
-    end.g = clampf(m_tEndColor.g + m_tEndColorVar.g * CCRANDOM_MINUS1_1(), 0, 1);
-    end.b = clampf(m_tEndColor.b + m_tEndColorVar.b * CCRANDOM_MINUS1_1(), 0, 1);
-    end.a = clampf(m_tEndColor.a + m_tEndColorVar.a * CCRANDOM_MINUS1_1(), 0, 1);
+    end.r = clampf(m_tEndColor.r + m_tEndColorVar.r * randomMinus1To1(), 0, 1);
+    end.g = clampf(m_tEndColor.g + m_tEndColorVar.g * randomMinus1To1(), 0, 1);
+    end.b = clampf(m_tEndColor.b + m_tEndColorVar.b * randomMinus1To1(), 0, 1);
+    end.a = clampf(m_tEndColor.a + m_tEndColorVar.a * randomMinus1To1(), 0, 1);
 
     particle->color = start;
     particle->deltaColor.r = (end.r - start.r) / particle->timeToLive;
@@ -499,7 +514,7 @@ void CCParticleSystem::initParticle(tCCParticle* particle)
     particle->deltaColor.a = (end.a - start.a) / particle->timeToLive;
 
     // size
-    float startS = m_fStartSize + m_fStartSizeVar * CCRANDOM_MINUS1_1();
+    float startS = m_fStartSize + m_fStartSizeVar * randomMinus1To1();
     startS = MAX(0, startS); // No negative value
 
     particle->size = startS;
@@ -510,21 +525,21 @@ void CCParticleSystem::initParticle(tCCParticle* particle)
     }
     else
     {
-        float endS = m_fEndSize + m_fEndSizeVar * CCRANDOM_MINUS1_1();
+        float endS = m_fEndSize + m_fEndSizeVar * randomMinus1To1();
         endS = MAX(0, endS); // No negative values
         particle->deltaSize = (endS - startS) / particle->timeToLive;
     }
 
     // rotation
-    float startA = m_fStartSpin + m_fStartSpinVar * CCRANDOM_MINUS1_1();
-    float endA = m_fEndSpin + m_fEndSpinVar * CCRANDOM_MINUS1_1();
+    float startA = m_fStartSpin + m_fStartSpinVar * randomMinus1To1();
+    float endA = m_fEndSpin + m_fEndSpinVar * randomMinus1To1();
     particle->rotation = startA;
     particle->deltaRotation = (endA - startA) / particle->timeToLive;
 
     // position
     if( m_ePositionType == kCCPositionTypeFree )
     {
-        particle->startPos = this->convertToWorldSpace(CCPointZero);
+        particle->startPos = m_bStepping ? m_tUpdateWorldPosition : this->convertToWorldSpace(CCPointZero);
     }
     else if ( m_ePositionType == kCCPositionTypeRelative )
     {
@@ -532,23 +547,23 @@ void CCParticleSystem::initParticle(tCCParticle* particle)
     }
 
     // direction
-    float a = CC_DEGREES_TO_RADIANS( m_fAngle + m_fAngleVar * CCRANDOM_MINUS1_1() );    
+    float a = CC_DEGREES_TO_RADIANS( m_fAngle + m_fAngleVar * randomMinus1To1() );    
 
     // Mode Gravity: A
     if (m_nEmitterMode == kCCParticleModeGravity) 
     {
         CCPoint v(cosf( a ), sinf( a ));
-        float s = modeA.speed + modeA.speedVar * CCRANDOM_MINUS1_1();
+        float s = modeA.speed + modeA.speedVar * randomMinus1To1();
 
         // direction
         particle->modeA.dir = ccpMult( v, s );
 
         // radial accel
-        particle->modeA.radialAccel = modeA.radialAccel + modeA.radialAccelVar * CCRANDOM_MINUS1_1();
+        particle->modeA.radialAccel = modeA.radialAccel + modeA.radialAccelVar * randomMinus1To1();
  
 
         // tangential accel
-        particle->modeA.tangentialAccel = modeA.tangentialAccel + modeA.tangentialAccelVar * CCRANDOM_MINUS1_1();
+        particle->modeA.tangentialAccel = modeA.tangentialAccel + modeA.tangentialAccelVar * randomMinus1To1();
 
         // rotation is dir
         if(modeA.rotationIsDir)
@@ -559,8 +574,8 @@ void CCParticleSystem::initParticle(tCCParticle* particle)
     else 
     {
         // Set the default diameter of the particle from the source position
-        float startRadius = modeB.startRadius + modeB.startRadiusVar * CCRANDOM_MINUS1_1();
-        float endRadius = modeB.endRadius + modeB.endRadiusVar * CCRANDOM_MINUS1_1();
+        float startRadius = modeB.startRadius + modeB.startRadiusVar * randomMinus1To1();
+        float endRadius = modeB.endRadius + modeB.endRadiusVar * randomMinus1To1();
 
         particle->modeB.radius = startRadius;
 
@@ -574,12 +589,39 @@ void CCParticleSystem::initParticle(tCCParticle* particle)
         }
 
         particle->modeB.angle = a;
-        particle->modeB.degreesPerSecond = CC_DEGREES_TO_RADIANS(modeB.rotatePerSecond + modeB.rotatePerSecondVar * CCRANDOM_MINUS1_1());
+        particle->modeB.degreesPerSecond = CC_DEGREES_TO_RADIANS(modeB.rotatePerSecond + modeB.rotatePerSecondVar * randomMinus1To1());
     }    
 }
 
+float CCParticleSystem::randomMinus1To1()
+{
+    if (! m_bUseRandomState)
+    {
+        return CCRANDOM_MINUS1_1();
+    }
+    // LCG of Numerical Recipes, the 24 high bits make the float
+    m_uRandomState = m_uRandomState * 1664525u + 1013904223u;
+    return (float)(m_uRandomState >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+void CCParticleSystem::setRandomSeed(unsigned int uSeed)
+{
+    m_uRandomSeed = uSeed;
+    m_uRandomState = uSeed;
+    m_bHasRandomSeed = true;
+}
+
+unsigned int CCParticleSystem::getRandomSeed()
+{
+    return m_uRandomSeed;
+}
+
 void CCParticleSystem::stopSystem()
 {
+    if (m_bUpdatePending)
+    {
+        runParallelUpdates();
+    }
     m_bIsActive = false;
     m_fElapsed = m_fDuration;
     m_fEmitCounter = 0;
@@ -587,12 +629,19 @@ void CCParticleSystem::stopSystem()
 
 void CCParticleSystem::resetSystem()
 {
+    if (m_bUpdatePending)
+    {
+        runParallelUpdates();
+    }
     m_bIsActive = true;
     m_fElapsed = 0;
+    if (m_bHasRandomSeed)
+    {
+        m_uRandomState = m_uRandomSeed;
+    }
     for (m_uParticleIdx = 0; m_uParticleIdx < m_uParticleCount; ++m_uParticleIdx)
     {
-        tCCParticle *p = &m_pParticles[m_uParticleIdx];
-        p->timeToLive = 0;
+        m_tParticleData.timeToLive[m_uParticleIdx] = 0;
     }
 }
 bool CCParticleSystem::isFull()
@@ -603,8 +652,42 @@ bool CCParticleSystem::isFull()
 // ParticleSystem - MainLoop
 void CCParticleSystem::update(float dt)
 {
-    dt *= m_timeScale;
+    // updated twice in the same frame, by updateWithNoTime for instance
+    if (m_bUpdatePending)
+    {
+        runParallelUpdates();
+    }
+
+    m_fUpdateDt = dt * m_timeScale;
+    m_bUseRandomState = m_bHasRandomSeed || s_bParallelUpdate;
+
+    // the jobs can't read the node tree
+    if (m_ePositionType == kCCPositionTypeFree)
+    {
+        m_tUpdateWorldPosition = this->convertToWorldSpace(CCPointZero);
+    }
+
+    if (s_bParallelUpdate)
+    {
+        if (! m_bHasRandomSeed)
+        {
+            // rand() isn't thread safe, it only picks the state of an unseeded system
+            m_uRandomState = (unsigned int)rand();
+        }
+        this->retain();
+        m_bUpdatePending = true;
+        s_pendingSystems.push_back(this);
+        return;
+    }
+
+    step(m_fUpdateDt);
+    finishStep();
+}
+
+void CCParticleSystem::step(float dt)
+{
     CC_PROFILER_START_CATEGORY(kCCProfilerCategoryParticles , "CCParticleSystem - update");
+    m_bStepping = true;
 
     if (m_bIsActive && m_fEmissionRate)
     {
@@ -633,7 +716,7 @@ void CCParticleSystem::update(float dt)
     CCPoint currentPosition = CCPointZero;
     if (m_ePositionType == kCCPositionTypeFree)
     {
-        currentPosition = this->convertToWorldSpace(CCPointZero);
+        currentPosition = m_tUpdateWorldPosition;
     }
     else if (m_ePositionType == kCCPositionTypeRelative)
     {
@@ -642,133 +725,145 @@ void CCParticleSystem::update(float dt)
 
     if (m_bVisible)
     {
+        // life, the dead particles are replaced by the last ones
+        ccParticleUpdateLife(&m_tParticleData, m_uParticleCount, dt);
+
         while (m_uParticleIdx < m_uParticleCount)
         {
-            tCCParticle *p = &m_pParticles[m_uParticleIdx];
-
-            // life
-            p->timeToLive -= dt;
-
-            if (p->timeToLive > 0) 
+            if (m_tParticleData.timeToLive[m_uParticleIdx] > 0)
             {
-                // Mode A: gravity, direction, tangential accel & radial accel
-                if (m_nEmitterMode == kCCParticleModeGravity) 
-                {
-                    CCPoint tmp, radial, tangential;
+                ++m_uParticleIdx;
+                continue;
+            }
 
-                    radial = CCPointZero;
-                    // radial acceleration
-                    if (p->pos.x || p->pos.y)
-                    {
-                        radial = ccpNormalize(p->pos);
-                    }
-                    tangential = radial;
-                    radial = ccpMult(radial, p->modeA.radialAccel);
-
-                    // tangential acceleration
-                    float newy = tangential.x;
-                    tangential.x = -tangential.y;
-                    tangential.y = newy;
-                    tangential = ccpMult(tangential, p->modeA.tangentialAccel);
-
-                    // (gravity + radial + tangential) * dt
-                    tmp = ccpAdd( ccpAdd( radial, tangential), modeA.gravity);
-                    tmp = ccpMult( tmp, dt);
-                    p->modeA.dir = ccpAdd( p->modeA.dir, tmp);
-                    tmp = ccpMult(p->modeA.dir, dt);
-                    p->pos = ccpAdd( p->pos, tmp );
-                }
+            // life < 0
+            unsigned int currentIndex = m_tParticleData.atlasIndex[m_uParticleIdx];
+            if( m_uParticleIdx != m_uParticleCount-1 )
+            {
+                ccParticleDataCopyParticle(&m_tParticleData, m_uParticleIdx, m_uParticleCount-1);
+            }
+            if (m_pBatchNode)
+            {
+                //disable the switched particle, like CCParticleBatchNode::disableParticle
+                //the children of the batch node write disjoint ranges of the atlas, finishStep marks them dirty
+                ccV3F_C4B_T2F_Quad* quad = &(m_pBatchNode->getTextureAtlas()->getQuadsForUpdate()[m_uAtlasIndex+currentIndex]);
+                quad->br.vertices.x = quad->br.vertices.y = quad->tr.vertices.x = quad->tr.vertices.y = quad->tl.vertices.x = quad->tl.vertices.y = quad->bl.vertices.x = quad->bl.vertices.y = 0.0f;
 
-                // Mode B: radius movement
-                else 
-                {                
-                    // Update the angle and radius of the particle.
-                    p->modeB.angle += p->modeB.degreesPerSecond * dt;
-                    p->modeB.radius += p->modeB.deltaRadius * dt;
+                //switch indexes
+                m_tParticleData.atlasIndex[m_uParticleCount-1] = currentIndex;
+            }
 
-                    p->pos.x = - cosf(p->modeB.angle) * p->modeB.radius;
-                    p->pos.y = - sinf(p->modeB.angle) * p->modeB.radius;
-                }
+            --m_uParticleCount;
 
-                // color
-                p->color.r += (p->deltaColor.r * dt);
-                p->color.g += (p->deltaColor.g * dt);
-                p->color.b += (p->deltaColor.b * dt);
-                p->color.a += (p->deltaColor.a * dt);
+            if( m_uParticleCount == 0 && m_bIsAutoRemoveOnFinish )
+            {
+                // removed from its parent by finishStep, on the main thread
+                m_bFinished = true;
+                m_bStepping = false;
+                CC_PROFILER_STOP_CATEGORY(kCCProfilerCategoryParticles , "CCParticleSystem - update");
+                return;
+            }
+        }
 
-                // size
-                p->size += (p->deltaSize * dt);
-                p->size = MAX( 0, p->size );
+        // Mode A: gravity, direction, tangential accel & radial accel
+        if (m_nEmitterMode == kCCParticleModeGravity)
+        {
+            ccParticleUpdateGravityMode(&m_tParticleData, m_uParticleCount, modeA.gravity, dt);
+        }
+        // Mode B: radius movement
+        else
+        {
+            ccParticleUpdateRadiusMode(&m_tParticleData, m_uParticleCount, dt);
+        }
 
-                // angle
-                p->rotation += (p->deltaRotation * dt);
+        // translate the quads to correct position, since matrix transform isn't performed in batchnode
+        // don't update the particles with the new position information, it will interfere with the radius and tangential calculations
+        CCPoint offset = m_pBatchNode ? m_obPosition : CCPointZero;
+        m_tParticleBounds = ccParticleUpdateCommon(&m_tParticleData, m_uParticleCount, dt, m_ePositionType, currentPosition, offset);
 
-                //
-                // update values in quad
-                //
+        //
+        // update values in quad
+        //
+        updateQuadsWithParticles();
+        m_uParticleIdx = m_uParticleCount;
 
-                CCPoint    newPos;
+        m_bTransformSystemDirty = false;
+    }
 
-                if (m_ePositionType == kCCPositionTypeFree || m_ePositionType == kCCPositionTypeRelative) 
-                {
-                    CCPoint diff = ccpSub( currentPosition, p->startPos );
-                    newPos = ccpSub(p->pos, diff);
-                } 
-                else
-                {
-                    newPos = p->pos;
-                }
+    m_bStepping = false;
+    CC_PROFILER_STOP_CATEGORY(kCCProfilerCategoryParticles , "CCParticleSystem - update");
+}
 
-                // translate newPos to correct position, since matrix transform isn't performed in batchnode
-                // don't update the particle with the new position information, it will interfere with the radius and tangential calculations
-                if (m_pBatchNode)
-                {
-                    newPos.x+=m_obPosition.x;
-                    newPos.y+=m_obPosition.y;
-                }
+void CCParticleSystem::finishStep()
+{
+    if (m_bFinished)
+    {
+        m_bFinished = false;
+        this->unscheduleUpdate();
+        if (m_pParent)
+        {
+            m_pParent->removeChild(this, true);
+        }
+        return;
+    }
 
-                updateQuadWithParticle(p, newPos);
-                //updateParticleImp(self, updateParticleSel, p, newPos);
+    if (m_pBatchNode)
+    {
+        // the quads of the system are written by step without marking the shared atlas
+        m_pBatchNode->getTextureAtlas()->markQuadsDirty(m_uAtlasIndex, m_uTotalParticles);
+    }
+    else
+    {
+        postStep();
+    }
+}
 
-                // update particle counter
-                ++m_uParticleIdx;
-            } 
-            else 
-            {
-                // life < 0
-                int currentIndex = p->atlasIndex;
-                if( m_uParticleIdx != m_uParticleCount-1 )
-                {
-                    m_pParticles[m_uParticleIdx] = m_pParticles[m_uParticleCount-1];
-                }
-                if (m_pBatchNode)
-                {
-                    //disable the switched particle
-                    m_pBatchNode->disableParticle(m_uAtlasIndex+currentIndex);
+void CCParticleSystem::runStepJob(void* pData)
+{
+    CCParticleSystem* pSystem = static_cast<CCParticleSystem*>(pData);
+    pSystem->step(pSystem->m_fUpdateDt);
+}
 
-                    //switch indexes
-                    m_pParticles[m_uParticleCount-1].atlasIndex = currentIndex;
-                }
+void CCParticleSystem::runParallelUpdates()
+{
+    if (s_pendingSystems.empty())
+    {
+        return;
+    }
 
+    // the systems queued while they are finished go to the next call
+    vector<void*> systems;
+    systems.swap(s_pendingSystems);
 
-                --m_uParticleCount;
+    CC_PROFILER_START_CATEGORY(kCCProfilerCategoryParticles, "CCParticleSystem - runParallelUpdates");
+    CCJobPool::sharedJobPool()->runJobs(runStepJob, &systems[0], (unsigned int)systems.size());
 
-                if( m_uParticleCount == 0 && m_bIsAutoRemoveOnFinish )
-                {
-                    this->unscheduleUpdate();
-                    m_pParent->removeChild(this, true);
-                    return;
-                }
-            }
-        } //while
-        m_bTransformSystemDirty = false;
+    for (vector<void*>::iterator it = systems.begin(); it != systems.end(); ++it)
+    {
+        static_cast<CCParticleSystem*>(*it)->m_bUpdatePending = false;
     }
-    if (! m_pBatchNode)
+    // in the order of the updates, like the serial update
+    for (vector<void*>::iterator it = systems.begin(); it != systems.end(); ++it)
     {
-        postStep();
+        CCParticleSystem* pSystem = static_cast<CCParticleSystem*>(*it);
+        pSystem->finishStep();
+        pSystem->release();
     }
+    CC_PROFILER_STOP_CATEGORY(kCCProfilerCategoryParticles, "CCParticleSystem - runParallelUpdates");
+}
 
-    CC_PROFILER_STOP_CATEGORY(kCCProfilerCategoryParticles , "CCParticleSystem - update");
+void CCParticleSystem::setParallelUpdateEnabled(bool bEnabled)
+{
+    if (! bEnabled)
+    {
+        runParallelUpdates();
+    }
+    s_bParallelUpdate = bEnabled;
+}
+
+bool CCParticleSystem::isParallelUpdateEnabled()
+{
+    return s_bParallelUpdate;
 }
 
 void CCParticleSystem::updateWithNoTime(void)
@@ -783,6 +878,16 @@ void CCParticleSystem::updateQuadWithParticle(tCCParticle* particle, const CCPoi
     // should be overridden
 }
 
+void CCParticleSystem::updateQuadsWithParticles()
+{
+    tCCParticle particle;
+    for (m_uParticleIdx = 0; m_uParticleIdx < m_uParticleCount; ++m_uParticleIdx)
+    {
+        ccParticleDataGetParticle(&m_tParticleData, m_uParticleIdx, &particle);
+        updateQuadWithParticle(&particle, ccp(m_tParticleData.drawPosX[m_uParticleIdx], m_tParticleData.drawPosY[m_uParticleIdx]));
+    }
+}
+
 void CCParticleSystem::postStep()
 {
     // should be overridden
@@ -1244,6 +1349,10 @@ unsigned int CCParticleSystem::getTotalParticles()
 
 void CCParticleSystem::setTotalParticles(unsigned int var)
 {
+    if (m_bUpdatePending)
+    {
+        runParallelUpdates();
+    }
     CCAssert( var <= m_uAllocatedParticles, "Particle: resizing particle array only supported for quads");
     m_uTotalParticles = var;
 }
@@ -1323,13 +1432,18 @@ void CCParticleSystem::setBatchNode(CCParticleBatchNode* batchNode)
 {
     if( m_pBatchNode != batchNode ) {
 
+        if (m_bUpdatePending)
+        {
+            runParallelUpdates();
+        }
+
         m_pBatchNode = batchNode; // weak reference
 
         if( batchNode ) {
             //each particle needs a unique index
             for (unsigned int i = 0; i < m_uTotalParticles; i++)
             {
-                m_pParticles[i].atlasIndex=i;
+                m_tParticleData.atlasIndex[i]=i;
             }
         }
     }
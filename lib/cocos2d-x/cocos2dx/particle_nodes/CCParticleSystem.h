@@ -125,6 +125,53 @@ typedef struct sCCParticle {
 
 }tCCParticle;
 
+/**
+Structure of arrays that holds the values of the particles of a system: one array per member of tCCParticle,
+the particle i being made of the i-th value of every array. It lets the update process 4 particles at once.
+The arrays are allocated in one block starting at posX, see ccParticleDataAlloc.
+*/
+typedef struct sCCParticleData {
+    float*          posX;
+    float*          posY;
+    float*          startPosX;
+    float*          startPosY;
+
+    float*          colorR;
+    float*          colorG;
+    float*          colorB;
+    float*          colorA;
+    float*          deltaColorR;
+    float*          deltaColorG;
+    float*          deltaColorB;
+    float*          deltaColorA;
+
+    float*          size;
+    float*          deltaSize;
+
+    float*          rotation;
+    float*          deltaRotation;
+
+    float*          timeToLive;
+
+    unsigned int*   atlasIndex;
+
+    //! Mode A: gravity, direction, radial accel, tangential accel
+    float*          dirX;
+    float*          dirY;
+    float*          radialAccel;
+    float*          tangentialAccel;
+
+    //! Mode B: radius mode
+    float*          angle;
+    float*          degreesPerSecond;
+    float*          radius;
+    float*          deltaRadius;
+
+    //! position of the quad of the particle, computed by the update
+    float*          drawPosX;
+    float*          drawPosY;
+}tCCParticleData;
+
 //typedef void (*CC_UPDATE_PARTICLE_IMP)(id, SEL, tCCParticle*, CCPoint);
 
 class CCTexture2D;
@@ -216,8 +263,8 @@ protected:
         float rotatePerSecondVar;
     } modeB;
 
-    //! Array of particles
-    tCCParticle *m_pParticles;
+    //! Arrays of particles
+    tCCParticleData m_tParticleData;
 
     // color modulate
     //    BOOL colorModulate;
@@ -228,6 +275,9 @@ protected:
     //!  particle idx
     unsigned int m_uParticleIdx;
 
+    //! box of the particles drawn in the last update, in node coordinates
+    CCRect m_tParticleBounds;
+
     // Optimization
     //CC_UPDATE_PARTICLE_IMP    updateParticleImp;
     //SEL                        updateParticleSel;
@@ -240,6 +290,24 @@ protected:
 
     //true if scaled or rotated
     bool m_bTransformSystemDirty;
+
+    //! the update is queued for runParallelUpdates
+    bool m_bUpdatePending;
+    //! time step of the queued update, time scale applied
+    float m_fUpdateDt;
+    //! true while step runs: initParticle reads the world position cached by update instead of the node tree
+    bool m_bStepping;
+    //! world position of the system, cached on the main thread by update
+    CCPoint m_tUpdateWorldPosition;
+    //! the last particle died in step, the system is removed from its parent by finishStep
+    bool m_bFinished;
+
+    //! seed given by setRandomSeed
+    unsigned int m_uRandomSeed;
+    bool m_bHasRandomSeed;
+    //! state of the random numbers of the system, used instead of rand() when seeded or updated in parallel
+    unsigned int m_uRandomState;
+    bool m_bUseRandomState;
     // Number of allocated particles
     unsigned int m_uAllocatedParticles;
 
@@ -425,14 +493,50 @@ public:
 
     //! should be overridden by subclasses
     virtual void updateQuadWithParticle(tCCParticle* particle, const CCPoint& newPosition);
+    /** Updates the quads of the m_uParticleCount living particles, at the drawPos computed by the update.
+     The default implementation calls updateQuadWithParticle for every particle,
+     CCParticleSystemQuad overrides it to write the quads straight from the particle arrays.
+     @js NA
+     @lua NA
+     */
+    virtual void updateQuadsWithParticles();
     //! should be overridden by subclasses
     virtual void postStep();
 
     virtual void update(float dt);
     virtual void updateWithNoTime(void);
 
+    /** Seeds the random numbers of the system. A seeded system emits the same particles for the same
+     sequence of updates, whether it is updated serially or in parallel. resetSystem starts the sequence again.
+     */
+    void setRandomSeed(unsigned int uSeed);
+    unsigned int getRandomSeed();
+
+    /** Whether the particle systems are simulated in parallel on the threads of CCJobPool.
+     When enabled, update only queues the system: emission, integration and the quads are computed
+     by runParallelUpdates, which CCDirector calls after the scheduler tick, before the render pass.
+     Subclasses that override initParticle or updateQuadWithParticle must keep them free of the node tree,
+     the autorelease pool and OpenGL. Defaults to CC_PARTICLE_SYSTEM_PARALLEL_UPDATE.
+     */
+    static void setParallelUpdateEnabled(bool bEnabled);
+    static bool isParallelUpdateEnabled();
+
+    /** Runs the queued updates as jobs and waits for them. Called by CCDirector every frame,
+     and before a queued system is drawn, reset, stopped or resized.
+     */
+    static void runParallelUpdates();
+
 protected:
     virtual void updateBlendFunc();
+    //! simulates the particles, on any thread
+    void step(float dt);
+    //! main thread part of the update: auto-remove, atlas dirty range and postStep
+    void finishStep();
+    //! random number in [-1, 1], from the state of the system or CCRANDOM_MINUS1_1
+    float randomMinus1To1();
+
+private:
+    static void runStepJob(void* pData);
 };
 
 // end of particle_nodes group
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "sprite_nodes/CCSpriteFrame.h"
 #include "CCDirector.h"
 #include "CCParticleBatchNode.h"
+#include "ccParticleKernels.h"
 #include "textures/CCTextureAtlas.h"
 #include "shaders/CCShaderCache.h"
 #include "shaders/ccGLStateCache.h"
@@ -248,7 +249,8 @@ void CCParticleSystemQuad::updateQuadWithParticle(tCCParticle* particle, const C
 
     if (m_pBatchNode)
     {
-        ccV3F_C4B_T2F_Quad *batchQuads = m_pBatchNode->getTextureAtlas()->getQuads();
+        // the range of the system is marked dirty by finishStep
+        ccV3F_C4B_T2F_Quad *batchQuads = m_pBatchNode->getTextureAtlas()->getQuadsForUpdate();
         quad = &(batchQuads[m_uAtlasIndex+particle->atlasIndex]);
     }
     else
@@ -323,6 +325,19 @@ void CCParticleSystemQuad::updateQuadWithParticle(tCCParticle* particle, const C
         quad->tr.vertices.y = newPosition.y + size_2;                
     }
 }
+void CCParticleSystemQuad::updateQuadsWithParticles()
+{
+    if (m_pBatchNode)
+    {
+        ccV3F_C4B_T2F_Quad *batchQuads = m_pBatchNode->getTextureAtlas()->getQuadsForUpdate();
+        ccParticleFillQuads(&m_tParticleData, m_uParticleCount, &(batchQuads[m_uAtlasIndex]), true, m_bOpacityModifyRGB);
+    }
+    else
+    {
+        ccParticleFillQuads(&m_tParticleData, m_uParticleCount, m_pQuads, false, m_bOpacityModifyRGB);
+    }
+}
+
 void CCParticleSystemQuad::postStep()
 {
     glBindBuffer(GL_ARRAY_BUFFER, m_pBuffersVBO[0]);
@@ -344,9 +359,19 @@ void CCParticleSystemQuad::postStep()
 	CHECK_GL_ERROR_DEBUG();
 }
 
+CCRect CCParticleSystemQuad::getCullingBox(void)
+{
+    // particles of a batch node are drawn by the CCParticleBatchNode
+    return m_pBatchNode ? CCRectZero : m_tParticleBounds;
+}
+
 // overriding draw method
 void CCParticleSystemQuad::draw()
 {    
+    if (m_bUpdatePending)
+    {
+        runParallelUpdates();
+    }
 
 	if (NULL == m_pTexture)
 	{
@@ -410,29 +435,31 @@ void CCParticleSystemQuad::draw()
 
 void CCParticleSystemQuad::setTotalParticles(unsigned int tp)
 {
+    if (m_bUpdatePending)
+    {
+        runParallelUpdates();
+    }
+
     // If we are setting the total number of particles to a number higher
     // than what is allocated, we need to allocate new arrays
     if( tp > m_uAllocatedParticles )
     {
         // Allocate new memory
-        size_t particlesSize = tp * sizeof(tCCParticle);
         size_t quadsSize = sizeof(m_pQuads[0]) * tp * 1;
         size_t indicesSize = sizeof(m_pIndices[0]) * tp * 6 * 1;
 
-        tCCParticle* particlesNew = (tCCParticle*)realloc(m_pParticles, particlesSize);
+        bool bParticlesAllocated = ccParticleDataAlloc(&m_tParticleData, tp);
         ccV3F_C4B_T2F_Quad* quadsNew = (ccV3F_C4B_T2F_Quad*)realloc(m_pQuads, quadsSize);
         GLushort* indicesNew = (GLushort*)realloc(m_pIndices, indicesSize);
 
-        if (particlesNew && quadsNew && indicesNew)
+        if (bParticlesAllocated && quadsNew && indicesNew)
         {
-            // Assign pointers
-            m_pParticles = particlesNew;
+            // Assign pointers, the particle arrays are already cleared
             m_pQuads = quadsNew;
             m_pIndices = indicesNew;
 
             // Clear the memory
             // XXX: Bug? If the quads are cleared, then drawing doesn't work... WHY??? XXX
-            memset(m_pParticles, 0, particlesSize);
             memset(m_pQuads, 0, quadsSize);
             memset(m_pIndices, 0, indicesSize);
 
@@ -441,7 +468,6 @@ void CCParticleSystemQuad::setTotalParticles(unsigned int tp)
         else
         {
             // Out of memory, failed to resize some array
-            if (particlesNew) m_pParticles = particlesNew;
             if (quadsNew) m_pQuads = quadsNew;
             if (indicesNew) m_pIndices = indicesNew;
 
@@ -456,7 +482,7 @@ void CCParticleSystemQuad::setTotalParticles(unsigned int tp)
         {
             for (unsigned int i = 0; i < m_uTotalParticles; i++)
             {
-                m_pParticles[i].atlasIndex=i;
+                m_tParticleData.atlasIndex[i]=i;
             }
         }
 
@@ -103,10 +103,18 @@ public:
      * @js NA
      */
     virtual void setTexture(CCTexture2D* texture);
-    /**
+    /** Writes the quad of one particle. updateQuadsWithParticles doesn't call it, so overriding it alone
+     no longer changes the quads.
      * @js NA
      */
     virtual void updateQuadWithParticle(tCCParticle* particle, const CCPoint& newPosition);
+    /** Writes all the quads at once from the particle arrays, without calling updateQuadWithParticle.
+     Subclasses that customize the quads per particle must also override this method and call
+     CCParticleSystem::updateQuadsWithParticles(), which calls updateQuadWithParticle for every particle.
+     * @js NA
+     * @lua NA
+     */
+    virtual void updateQuadsWithParticles();
     /**
      * @js NA
      */
@@ -116,6 +124,11 @@ public:
      * @lua NA
      */
     virtual void draw();
+    /**
+     * @js NA
+     * @lua NA
+     */
+    virtual CCRect getCullingBox(void);
     /**
      * @js NA
      */
@@ -0,0 +1,750 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ccParticleKernels.h"
+#include "ccMacros.h"
+#include "support/CCPointExtension.h"
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CC_PARTICLE_KERNELS_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define CC_PARTICLE_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+NS_CC_BEGIN
+
+#if defined(CC_PARTICLE_KERNELS_SSE2) || defined(CC_PARTICLE_KERNELS_NEON)
+static const bool s_bVectorAvailable = true;
+#else
+static const bool s_bVectorAvailable = false;
+#endif
+static bool s_bVectorized = s_bVectorAvailable;
+
+// number of float arrays of tCCParticleData, atlasIndex excepted
+static const unsigned int kFloatArrayCount = 27;
+
+bool ccParticleDataAlloc(tCCParticleData* data, unsigned int capacity)
+{
+    // the vector loops read and write the particles 4 by 4
+    unsigned int stride = (capacity + 3) & ~3u;
+    if (stride == 0)
+    {
+        stride = 4;
+    }
+    float* block = (float*)calloc((kFloatArrayCount + 1) * (size_t)stride, sizeof(float));
+    if (! block)
+    {
+        return false;
+    }
+    ccParticleDataFree(data);
+
+    float** arrays[kFloatArrayCount] =
+    {
+        &data->posX, &data->posY, &data->startPosX, &data->startPosY,
+        &data->colorR, &data->colorG, &data->colorB, &data->colorA,
+        &data->deltaColorR, &data->deltaColorG, &data->deltaColorB, &data->deltaColorA,
+        &data->size, &data->deltaSize, &data->rotation, &data->deltaRotation, &data->timeToLive,
+        &data->dirX, &data->dirY, &data->radialAccel, &data->tangentialAccel,
+        &data->angle, &data->degreesPerSecond, &data->radius, &data->deltaRadius,
+        &data->drawPosX, &data->drawPosY,
+    };
+    // posX is the start of the block, it is what ccParticleDataFree frees
+    for (unsigned int i = 0; i < kFloatArrayCount; ++i)
+    {
+        *arrays[i] = block + i * stride;
+    }
+    data->atlasIndex = (unsigned int*)(block + kFloatArrayCount * stride);
+    return true;
+}
+
+void ccParticleDataFree(tCCParticleData* data)
+{
+    free(data->posX);
+    memset(data, 0, sizeof(*data));
+}
+
+void ccParticleDataSetParticle(tCCParticleData* data, unsigned int index, const tCCParticle* particle)
+{
+    data->posX[index] = particle->pos.x;
+    data->posY[index] = particle->pos.y;
+    data->startPosX[index] = particle->startPos.x;
+    data->startPosY[index] = particle->startPos.y;
+    data->colorR[index] = particle->color.r;
+    data->colorG[index] = particle->color.g;
+    data->colorB[index] = particle->color.b;
+    data->colorA[index] = particle->color.a;
+    data->deltaColorR[index] = particle->deltaColor.r;
+    data->deltaColorG[index] = particle->deltaColor.g;
+    data->deltaColorB[index] = particle->deltaColor.b;
+    data->deltaColorA[index] = particle->deltaColor.a;
+    data->size[index] = particle->size;
+    data->deltaSize[index] = particle->deltaSize;
+    data->rotation[index] = particle->rotation;
+    data->deltaRotation[index] = particle->deltaRotation;
+    data->timeToLive[index] = particle->timeToLive;
+    data->atlasIndex[index] = particle->atlasIndex;
+    data->dirX[index] = particle->modeA.dir.x;
+    data->dirY[index] = particle->modeA.dir.y;
+    data->radialAccel[index] = particle->modeA.radialAccel;
+    data->tangentialAccel[index] = particle->modeA.tangentialAccel;
+    data->angle[index] = particle->modeB.angle;
+    data->degreesPerSecond[index] = particle->modeB.degreesPerSecond;
+    data->radius[index] = particle->modeB.radius;
+    data->deltaRadius[index] = particle->modeB.deltaRadius;
+}
+
+void ccParticleDataGetParticle(const tCCParticleData* data, unsigned int index, tCCParticle* particle)
+{
+    particle->pos.x = data->posX[index];
+    particle->pos.y = data->posY[index];
+    particle->startPos.x = data->startPosX[index];
+    particle->startPos.y = data->startPosY[index];
+    particle->color.r = data->colorR[index];
+    particle->color.g = data->colorG[index];
+    particle->color.b = data->colorB[index];
+    particle->color.a = data->colorA[index];
+    particle->deltaColor.r = data->deltaColorR[index];
+    particle->deltaColor.g = data->deltaColorG[index];
+    particle->deltaColor.b = data->deltaColorB[index];
+    particle->deltaColor.a = data->deltaColorA[index];
+    particle->size = data->size[index];
+    particle->deltaSize = data->deltaSize[index];
+    particle->rotation = data->rotation[index];
+    particle->deltaRotation = data->deltaRotation[index];
+    particle->timeToLive = data->timeToLive[index];
+    particle->atlasIndex = data->atlasIndex[index];
+    particle->modeA.dir.x = data->dirX[index];
+    particle->modeA.dir.y = data->dirY[index];
+    particle->modeA.radialAccel = data->radialAccel[index];
+    particle->modeA.tangentialAccel = data->tangentialAccel[index];
+    particle->modeB.angle = data->angle[index];
+    particle->modeB.degreesPerSecond = data->degreesPerSecond[index];
+    particle->modeB.radius = data->radius[index];
+    particle->modeB.deltaRadius = data->deltaRadius[index];
+}
+
+void ccParticleDataCopyParticle(tCCParticleData* data, unsigned int dst, unsigned int src)
+{
+    tCCParticle particle;
+    ccParticleDataGetParticle(data, src, &particle);
+    ccParticleDataSetParticle(data, dst, &particle);
+}
+
+// scalar loops, they do the math of the former per particle update
+
+static void updateLifeScalar(tCCParticleData* data, unsigned int begin, unsigned int end, float dt)
+{
+    for (unsigned int i = begin; i < end; ++i)
+    {
+        data->timeToLive[i] -= dt;
+    }
+}
+
+static void updateGravityModeScalar(tCCParticleData* data, unsigned int begin, unsigned int end, const CCPoint& gravity, float dt)
+{
+    for (unsigned int i = begin; i < end; ++i)
+    {
+        CCPoint pos(data->posX[i], data->posY[i]);
+        CCPoint tmp, radial, tangential;
+
+        radial = CCPointZero;
+        // radial acceleration
+        if (pos.x || pos.y)
+        {
+            radial = ccpNormalize(pos);
+        }
+        tangential = radial;
+        radial = ccpMult(radial, data->radialAccel[i]);
+
+        // tangential acceleration
+        float newy = tangential.x;
+        tangential.x = -tangential.y;
+        tangential.y = newy;
+        tangential = ccpMult(tangential, data->tangentialAccel[i]);
+
+        // (gravity + radial + tangential) * dt
+        tmp = ccpAdd( ccpAdd( radial, tangential), gravity);
+        tmp = ccpMult( tmp, dt);
+        data->dirX[i] += tmp.x;
+        data->dirY[i] += tmp.y;
+        data->posX[i] = pos.x + data->dirX[i] * dt;
+        data->posY[i] = pos.y + data->dirY[i] * dt;
+    }
+}
+
+static void updateRadiusModeScalar(tCCParticleData* data, unsigned int begin, unsigned int end, float dt)
+{
+    for (unsigned int i = begin; i < end; ++i)
+    {
+        // Update the angle and radius of the particle.
+        data->angle[i] += data->degreesPerSecond[i] * dt;
+        data->radius[i] += data->deltaRadius[i] * dt;
+
+        data->posX[i] = - cosf(data->angle[i]) * data->radius[i];
+        data->posY[i] = - sinf(data->angle[i]) * data->radius[i];
+    }
+}
+
+static void updateCommonScalar(tCCParticleData* data, unsigned int begin, unsigned int end, float dt,
+                               bool bMoveWithStart, const CCPoint& currentPosition, const CCPoint& offset,
+                               float* bounds)
+{
+    float minX = bounds[0], minY = bounds[1], maxX = bounds[2], maxY = bounds[3];
+    for (unsigned int i = begin; i < end; ++i)
+    {
+        // color
+        data->colorR[i] += (data->deltaColorR[i] * dt);
+        data->colorG[i] += (data->deltaColorG[i] * dt);
+        data->colorB[i] += (data->deltaColorB[i] * dt);
+        data->colorA[i] += (data->deltaColorA[i] * dt);
+
+        // size
+        data->size[i] += (data->deltaSize[i] * dt);
+        data->size[i] = MAX( 0, data->size[i] );
+
+        // angle
+        data->rotation[i] += (data->deltaRotation[i] * dt);
+
+        float x = data->posX[i];
+        float y = data->posY[i];
+        if (bMoveWithStart)
+        {
+            x -= currentPosition.x - data->startPosX[i];
+            y -= currentPosition.y - data->startPosY[i];
+        }
+        x += offset.x;
+        y += offset.y;
+        data->drawPosX[i] = x;
+        data->drawPosY[i] = y;
+
+        // half diagonal, the quad may be rotated
+        float radius = data->size[i] * 0.7072f;
+        minX = MIN(minX, x - radius);
+        minY = MIN(minY, y - radius);
+        maxX = MAX(maxX, x + radius);
+        maxY = MAX(maxY, y + radius);
+    }
+    bounds[0] = minX;
+    bounds[1] = minY;
+    bounds[2] = maxX;
+    bounds[3] = maxY;
+}
+
+static void fillQuadsScalar(const tCCParticleData* data, unsigned int begin, unsigned int end, ccV3F_C4B_T2F_Quad* quads,
+                            bool bUseAtlasIndex, bool bPremultiplyAlpha)
+{
+    for (unsigned int i = begin; i < end; ++i)
+    {
+        ccV3F_C4B_T2F_Quad* quad = &quads[bUseAtlasIndex ? data->atlasIndex[i] : i];
+
+        float r = data->colorR[i], g = data->colorG[i], b = data->colorB[i], a = data->colorA[i];
+        ccColor4B color = (bPremultiplyAlpha)
+            ? ccc4( r*a*255, g*a*255, b*a*255, a*255)
+            : ccc4( r*255, g*255, b*255, a*255);
+
+        quad->bl.colors = color;
+        quad->br.colors = color;
+        quad->tl.colors = color;
+        quad->tr.colors = color;
+
+        // vertices
+        GLfloat size_2 = data->size[i]/2;
+        GLfloat x = data->drawPosX[i];
+        GLfloat y = data->drawPosY[i];
+        if (data->rotation[i])
+        {
+            GLfloat x1 = -size_2;
+            GLfloat y1 = -size_2;
+
+            GLfloat x2 = size_2;
+            GLfloat y2 = size_2;
+
+            GLfloat rad = (GLfloat)-CC_DEGREES_TO_RADIANS(data->rotation[i]);
+            GLfloat cr = cosf(rad);
+            GLfloat sr = sinf(rad);
+
+            quad->bl.vertices.x = x1 * cr - y1 * sr + x;
+            quad->bl.vertices.y = x1 * sr + y1 * cr + y;
+            quad->br.vertices.x = x2 * cr - y1 * sr + x;
+            quad->br.vertices.y = x2 * sr + y1 * cr + y;
+            quad->tr.vertices.x = x2 * cr - y2 * sr + x;
+            quad->tr.vertices.y = x2 * sr + y2 * cr + y;
+            quad->tl.vertices.x = x1 * cr - y2 * sr + x;
+            quad->tl.vertices.y = x1 * sr + y2 * cr + y;
+        }
+        else
+        {
+            quad->bl.vertices.x = x - size_2;
+            quad->bl.vertices.y = y - size_2;
+            quad->br.vertices.x = x + size_2;
+            quad->br.vertices.y = y - size_2;
+            quad->tl.vertices.x = x - size_2;
+            quad->tl.vertices.y = y + size_2;
+            quad->tr.vertices.x = x + size_2;
+            quad->tr.vertices.y = y + size_2;
+        }
+    }
+}
+
+#if defined(CC_PARTICLE_KERNELS_SSE2) || defined(CC_PARTICLE_KERNELS_NEON)
+
+// 4 floats, and the few operations the loops need. The comparisons return masks of all ones or zeros.
+
+#if defined(CC_PARTICLE_KERNELS_SSE2)
+
+typedef __m128 v4f;
+typedef __m128i v4i;
+
+static inline v4f v4Load(const float* p) { return _mm_loadu_ps(p); }
+static inline void v4Store(float* p, v4f v) { _mm_storeu_ps(p, v); }
+static inline void v4iStore(int* p, v4i v) { _mm_storeu_si128((__m128i*)p, v); }
+static inline v4f v4Set(float f) { return _mm_set1_ps(f); }
+static inline v4f v4Add(v4f a, v4f b) { return _mm_add_ps(a, b); }
+static inline v4f v4Sub(v4f a, v4f b) { return _mm_sub_ps(a, b); }
+static inline v4f v4Mul(v4f a, v4f b) { return _mm_mul_ps(a, b); }
+static inline v4f v4Div(v4f a, v4f b) { return _mm_div_ps(a, b); }
+static inline v4f v4Sqrt(v4f a) { return _mm_sqrt_ps(a); }
+// v4Max(a, b) is MAX(b, a) of ccMacros.h and v4Min(a, b) is MIN(b, a), b is kept when a is NaN
+static inline v4f v4Max(v4f a, v4f b) { return _mm_max_ps(a, b); }
+static inline v4f v4Min(v4f a, v4f b) { return _mm_min_ps(a, b); }
+static inline v4f v4Eq(v4f a, v4f b) { return _mm_cmpeq_ps(a, b); }
+static inline v4f v4Gt(v4f a, v4f b) { return _mm_cmpgt_ps(a, b); }
+static inline v4f v4And(v4f a, v4f b) { return _mm_and_ps(a, b); }
+static inline v4f v4Xor(v4f a, v4f b) { return _mm_xor_ps(a, b); }
+static inline v4f v4Select(v4f mask, v4f a, v4f b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+static inline bool v4Any(v4f mask) { return _mm_movemask_ps(mask) != 0; }
+static inline v4i v4ToInt(v4f a) { return _mm_cvttps_epi32(a); }
+static inline v4f v4FromInt(v4i a) { return _mm_cvtepi32_ps(a); }
+static inline v4f v4FromBits(v4i a) { return _mm_castsi128_ps(a); }
+static inline v4i v4ToBits(v4f a) { return _mm_castps_si128(a); }
+static inline v4i v4iSet(int i) { return _mm_set1_epi32(i); }
+static inline v4i v4iAdd(v4i a, v4i b) { return _mm_add_epi32(a, b); }
+static inline v4i v4iSub(v4i a, v4i b) { return _mm_sub_epi32(a, b); }
+static inline v4i v4iAnd(v4i a, v4i b) { return _mm_and_si128(a, b); }
+static inline v4i v4iEq(v4i a, v4i b) { return _mm_cmpeq_epi32(a, b); }
+static inline v4i v4iShl29(v4i a) { return _mm_slli_epi32(a, 29); }
+static inline v4f v4Lanes() { return _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f); }
+
+#else
+
+typedef float32x4_t v4f;
+typedef int32x4_t v4i;
+
+static inline v4f v4Load(const float* p) { return vld1q_f32(p); }
+static inline void v4Store(float* p, v4f v) { vst1q_f32(p, v); }
+static inline void v4iStore(int* p, v4i v) { vst1q_s32(p, v); }
+static inline v4f v4Set(float f) { return vdupq_n_f32(f); }
+static inline v4f v4Add(v4f a, v4f b) { return vaddq_f32(a, b); }
+static inline v4f v4Sub(v4f a, v4f b) { return vsubq_f32(a, b); }
+static inline v4f v4Mul(v4f a, v4f b) { return vmulq_f32(a, b); }
+static inline v4f v4Select(v4f mask, v4f a, v4f b) { return vbslq_f32(vreinterpretq_u32_f32(mask), a, b); }
+static inline v4f v4Eq(v4f a, v4f b) { return vreinterpretq_f32_u32(vceqq_f32(a, b)); }
+static inline v4f v4Gt(v4f a, v4f b) { return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+#if defined(__aarch64__)
+static inline v4f v4Div(v4f a, v4f b) { return vdivq_f32(a, b); }
+static inline v4f v4Sqrt(v4f a) { return vsqrtq_f32(a); }
+#else
+// ARMv7 NEON has no division nor square root, refine the estimates twice
+static inline v4f v4Div(v4f a, v4f b)
+{
+    v4f r = vrecpeq_f32(b);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    r = vmulq_f32(vrecpsq_f32(b, r), r);
+    return vmulq_f32(a, r);
+}
+static inline v4f v4Sqrt(v4f a)
+{
+    v4f r = vrsqrteq_f32(a);
+    r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+    r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+    return v4Select(v4Eq(a, vdupq_n_f32(0)), a, vmulq_f32(a, r));
+}
+#endif
+static inline v4f v4Max(v4f a, v4f b) { return v4Select(v4Gt(a, b), a, b); }
+static inline v4f v4Min(v4f a, v4f b) { return v4Select(v4Gt(b, a), a, b); }
+static inline v4f v4And(v4f a, v4f b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+static inline v4f v4Xor(v4f a, v4f b) { return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+static inline bool v4Any(v4f mask)
+{
+    uint32x4_t m = vreinterpretq_u32_f32(mask);
+    uint32x2_t t = vorr_u32(vget_low_u32(m), vget_high_u32(m));
+    return (vget_lane_u32(t, 0) | vget_lane_u32(t, 1)) != 0;
+}
+static inline v4i v4ToInt(v4f a) { return vcvtq_s32_f32(a); }
+static inline v4f v4FromInt(v4i a) { return vcvtq_f32_s32(a); }
+static inline v4f v4FromBits(v4i a) { return vreinterpretq_f32_s32(a); }
+static inline v4i v4ToBits(v4f a) { return vreinterpretq_s32_f32(a); }
+static inline v4i v4iSet(int i) { return vdupq_n_s32(i); }
+static inline v4i v4iAdd(v4i a, v4i b) { return vaddq_s32(a, b); }
+static inline v4i v4iSub(v4i a, v4i b) { return vsubq_s32(a, b); }
+static inline v4i v4iAnd(v4i a, v4i b) { return vandq_s32(a, b); }
+static inline v4i v4iEq(v4i a, v4i b) { return vreinterpretq_s32_u32(vceqq_s32(a, b)); }
+static inline v4i v4iShl29(v4i a) { return vshlq_n_s32(a, 29); }
+static inline v4f v4Lanes() { static const float lanes[4] = {0.0f, 1.0f, 2.0f, 3.0f}; return vld1q_f32(lanes); }
+
+#endif
+
+static inline v4f v4SignMask() { return v4FromBits(v4iSet((int)0x80000000)); }
+static inline v4f v4Neg(v4f a) { return v4Xor(a, v4SignMask()); }
+static inline v4f v4Abs(v4f a) { return v4FromBits(v4iAnd(v4ToBits(a), v4iSet(0x7fffffff))); }
+
+// above this the reduction of the argument of the polynomials loses precision, the C library is used
+static const float kSinCosMaxArgument = 8192.0f;
+
+// sine and cosine of x, with the range reduction and the polynomials of the Cephes library
+static void v4SinCos(v4f x, v4f* s, v4f* c)
+{
+    if (v4Any(v4Gt(v4Abs(x), v4Set(kSinCosMaxArgument))))
+    {
+        float in[4], outSin[4], outCos[4];
+        v4Store(in, x);
+        for (int i = 0; i < 4; ++i)
+        {
+            outSin[i] = sinf(in[i]);
+            outCos[i] = cosf(in[i]);
+        }
+        *s = v4Load(outSin);
+        *c = v4Load(outCos);
+        return;
+    }
+
+    v4f signSin = v4And(x, v4SignMask());
+    x = v4Abs(x);
+
+    // octant of x, rounded up to an even one
+    v4i j = v4ToInt(v4Mul(x, v4Set(1.27323954473516f)));
+    j = v4iAnd(v4iAdd(j, v4iSet(1)), v4iSet(~1));
+    v4f y = v4FromInt(j);
+
+    v4f polyMask = v4FromBits(v4iEq(v4iAnd(j, v4iSet(2)), v4iSet(0)));
+    signSin = v4Xor(signSin, v4FromBits(v4iShl29(v4iAnd(j, v4iSet(4)))));
+    v4f signCos = v4FromBits(v4iShl29(v4iSub(v4iSet(4), v4iAnd(v4iSub(j, v4iSet(2)), v4iSet(4)))));
+
+    // x - y * pi / 4 in extended precision
+    x = v4Add(x, v4Mul(y, v4Set(-0.78515625f)));
+    x = v4Add(x, v4Mul(y, v4Set(-2.4187564849853515625e-4f)));
+    x = v4Add(x, v4Mul(y, v4Set(-3.77489497744594108e-8f)));
+
+    v4f z = v4Mul(x, x);
+    v4f polyCos = v4Set(2.443315711809948e-5f);
+    polyCos = v4Add(v4Mul(polyCos, z), v4Set(-1.388731625493765e-3f));
+    polyCos = v4Add(v4Mul(polyCos, z), v4Set(4.166664568298827e-2f));
+    polyCos = v4Mul(v4Mul(polyCos, z), z);
+    polyCos = v4Add(v4Sub(polyCos, v4Mul(z, v4Set(0.5f))), v4Set(1.0f));
+
+    v4f polySin = v4Set(-1.9515295891e-4f);
+    polySin = v4Add(v4Mul(polySin, z), v4Set(8.3321608736e-3f));
+    polySin = v4Add(v4Mul(polySin, z), v4Set(-1.6666654611e-1f));
+    polySin = v4Add(v4Mul(v4Mul(polySin, z), x), x);
+
+    *s = v4Xor(v4Select(polyMask, polySin, polyCos), signSin);
+    *c = v4Xor(v4Select(polyMask, polyCos, polySin), signCos);
+}
+
+// the vector loops go over the groups of 4 particles [0, count rounded up to 4), which the arrays have room for.
+// The lanes past count hold dead particles or padding, computing them is harmless but nothing is written
+// out of the arrays for them.
+
+static void updateLifeVector(tCCParticleData* data, unsigned int count, float dt)
+{
+    v4f vdt = v4Set(dt);
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        v4Store(data->timeToLive + i, v4Sub(v4Load(data->timeToLive + i), vdt));
+    }
+}
+
+static void updateGravityModeVector(tCCParticleData* data, unsigned int count, const CCPoint& gravity, float dt)
+{
+    v4f vdt = v4Set(dt);
+    v4f gravityX = v4Set(gravity.x);
+    v4f gravityY = v4Set(gravity.y);
+    v4f zero = v4Set(0.0f);
+    v4f one = v4Set(1.0f);
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        v4f posX = v4Load(data->posX + i);
+        v4f posY = v4Load(data->posY + i);
+
+        // radial acceleration: the normalized position, (1, 0) if its length is 0 like CCPoint::normalize,
+        // nothing at the origin
+        v4f length = v4Sqrt(v4Add(v4Mul(posX, posX), v4Mul(posY, posY)));
+        v4f lengthZero = v4Eq(length, zero);
+        v4f origin = v4And(v4Eq(posX, zero), v4Eq(posY, zero));
+        v4f radialX = v4Select(lengthZero, v4Select(origin, zero, one), v4Div(posX, length));
+        v4f radialY = v4Select(lengthZero, zero, v4Div(posY, length));
+
+        // tangential acceleration
+        v4f radialAccel = v4Load(data->radialAccel + i);
+        v4f tangentialAccel = v4Load(data->tangentialAccel + i);
+        v4f tangentialX = v4Mul(v4Neg(radialY), tangentialAccel);
+        v4f tangentialY = v4Mul(radialX, tangentialAccel);
+        radialX = v4Mul(radialX, radialAccel);
+        radialY = v4Mul(radialY, radialAccel);
+
+        // (gravity + radial + tangential) * dt
+        v4f dirX = v4Add(v4Load(data->dirX + i), v4Mul(v4Add(v4Add(radialX, tangentialX), gravityX), vdt));
+        v4f dirY = v4Add(v4Load(data->dirY + i), v4Mul(v4Add(v4Add(radialY, tangentialY), gravityY), vdt));
+        v4Store(data->dirX + i, dirX);
+        v4Store(data->dirY + i, dirY);
+        v4Store(data->posX + i, v4Add(posX, v4Mul(dirX, vdt)));
+        v4Store(data->posY + i, v4Add(posY, v4Mul(dirY, vdt)));
+    }
+}
+
+static void updateRadiusModeVector(tCCParticleData* data, unsigned int count, float dt)
+{
+    v4f vdt = v4Set(dt);
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        v4f angle = v4Add(v4Load(data->angle + i), v4Mul(v4Load(data->degreesPerSecond + i), vdt));
+        v4f radius = v4Add(v4Load(data->radius + i), v4Mul(v4Load(data->deltaRadius + i), vdt));
+        v4Store(data->angle + i, angle);
+        v4Store(data->radius + i, radius);
+
+        v4f s, c;
+        v4SinCos(angle, &s, &c);
+        v4Store(data->posX + i, v4Mul(v4Neg(c), radius));
+        v4Store(data->posY + i, v4Mul(v4Neg(s), radius));
+    }
+}
+
+static void updateCommonVector(tCCParticleData* data, unsigned int count, float dt,
+                               bool bMoveWithStart, const CCPoint& currentPosition, const CCPoint& offset,
+                               float* bounds)
+{
+    v4f vdt = v4Set(dt);
+    v4f zero = v4Set(0.0f);
+    v4f currentX = v4Set(currentPosition.x);
+    v4f currentY = v4Set(currentPosition.y);
+    v4f offsetX = v4Set(offset.x);
+    v4f offsetY = v4Set(offset.y);
+    v4f minX = v4Set(FLT_MAX), minY = v4Set(FLT_MAX), maxX = v4Set(-FLT_MAX), maxY = v4Set(-FLT_MAX);
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        // color
+        v4Store(data->colorR + i, v4Add(v4Load(data->colorR + i), v4Mul(v4Load(data->deltaColorR + i), vdt)));
+        v4Store(data->colorG + i, v4Add(v4Load(data->colorG + i), v4Mul(v4Load(data->deltaColorG + i), vdt)));
+        v4Store(data->colorB + i, v4Add(v4Load(data->colorB + i), v4Mul(v4Load(data->deltaColorB + i), vdt)));
+        v4Store(data->colorA + i, v4Add(v4Load(data->colorA + i), v4Mul(v4Load(data->deltaColorA + i), vdt)));
+
+        // size
+        v4f size = v4Max(v4Add(v4Load(data->size + i), v4Mul(v4Load(data->deltaSize + i), vdt)), zero);
+        v4Store(data->size + i, size);
+
+        // angle
+        v4Store(data->rotation + i, v4Add(v4Load(data->rotation + i), v4Mul(v4Load(data->deltaRotation + i), vdt)));
+
+        v4f x = v4Load(data->posX + i);
+        v4f y = v4Load(data->posY + i);
+        if (bMoveWithStart)
+        {
+            x = v4Sub(x, v4Sub(currentX, v4Load(data->startPosX + i)));
+            y = v4Sub(y, v4Sub(currentY, v4Load(data->startPosY + i)));
+        }
+        x = v4Add(x, offsetX);
+        y = v4Add(y, offsetY);
+        v4Store(data->drawPosX + i, x);
+        v4Store(data->drawPosY + i, y);
+
+        // half diagonal, the quad may be rotated. The lanes past count are left out
+        v4f radius = v4Mul(size, v4Set(0.7072f));
+        v4f alive = v4Gt(v4Set((float)(count - i)), v4Lanes());
+        minX = v4Select(alive, v4Min(v4Sub(x, radius), minX), minX);
+        minY = v4Select(alive, v4Min(v4Sub(y, radius), minY), minY);
+        maxX = v4Select(alive, v4Max(v4Add(x, radius), maxX), maxX);
+        maxY = v4Select(alive, v4Max(v4Add(y, radius), maxY), maxY);
+    }
+
+    float lanes[4][4];
+    v4Store(lanes[0], minX);
+    v4Store(lanes[1], minY);
+    v4Store(lanes[2], maxX);
+    v4Store(lanes[3], maxY);
+    for (int l = 0; l < 4; ++l)
+    {
+        bounds[0] = MIN(bounds[0], lanes[0][l]);
+        bounds[1] = MIN(bounds[1], lanes[1][l]);
+        bounds[2] = MAX(bounds[2], lanes[2][l]);
+        bounds[3] = MAX(bounds[3], lanes[3][l]);
+    }
+}
+
+static void fillQuadsVector(const tCCParticleData* data, unsigned int count, ccV3F_C4B_T2F_Quad* quads,
+                            bool bUseAtlasIndex, bool bPremultiplyAlpha)
+{
+    v4f v255 = v4Set(255.0f);
+    v4f half = v4Set(0.5f);
+    v4f degreesToRadians = v4Set(0.01745329252f);
+    for (unsigned int i = 0; i < count; i += 4)
+    {
+        // colors
+        v4f r = v4Load(data->colorR + i);
+        v4f g = v4Load(data->colorG + i);
+        v4f b = v4Load(data->colorB + i);
+        v4f a = v4Load(data->colorA + i);
+        if (bPremultiplyAlpha)
+        {
+            r = v4Mul(r, a);
+            g = v4Mul(g, a);
+            b = v4Mul(b, a);
+        }
+        int colors[4][4];
+        v4iStore(colors[0], v4ToInt(v4Mul(r, v255)));
+        v4iStore(colors[1], v4ToInt(v4Mul(g, v255)));
+        v4iStore(colors[2], v4ToInt(v4Mul(b, v255)));
+        v4iStore(colors[3], v4ToInt(v4Mul(a, v255)));
+
+        // vertices, a rotation of 0 gives the same ones as the unrotated quad
+        v4f size_2 = v4Mul(v4Load(data->size + i), half);
+        v4f x = v4Load(data->drawPosX + i);
+        v4f y = v4Load(data->drawPosY + i);
+        v4f sr, cr;
+        v4SinCos(v4Neg(v4Mul(v4Load(data->rotation + i), degreesToRadians)), &sr, &cr);
+
+        v4f x1 = v4Neg(size_2);
+        v4f y1 = x1;
+        v4f x2 = size_2;
+        v4f y2 = size_2;
+        v4f x1cr = v4Mul(x1, cr), x1sr = v4Mul(x1, sr), x2cr = v4Mul(x2, cr), x2sr = v4Mul(x2, sr);
+        v4f y1cr = v4Mul(y1, cr), y1sr = v4Mul(y1, sr), y2cr = v4Mul(y2, cr), y2sr = v4Mul(y2, sr);
+
+        float vertices[8][4];
+        v4Store(vertices[0], v4Add(v4Sub(x1cr, y1sr), x));
+        v4Store(vertices[1], v4Add(v4Add(x1sr, y1cr), y));
+        v4Store(vertices[2], v4Add(v4Sub(x2cr, y1sr), x));
+        v4Store(vertices[3], v4Add(v4Add(x2sr, y1cr), y));
+        v4Store(vertices[4], v4Add(v4Sub(x2cr, y2sr), x));
+        v4Store(vertices[5], v4Add(v4Add(x2sr, y2cr), y));
+        v4Store(vertices[6], v4Add(v4Sub(x1cr, y2sr), x));
+        v4Store(vertices[7], v4Add(v4Add(x1sr, y2cr), y));
+
+        unsigned int lanes = MIN(4, count - i);
+        for (unsigned int l = 0; l < lanes; ++l)
+        {
+            ccV3F_C4B_T2F_Quad* quad = &quads[bUseAtlasIndex ? data->atlasIndex[i + l] : i + l];
+            ccColor4B color = ccc4((GLubyte)colors[0][l], (GLubyte)colors[1][l], (GLubyte)colors[2][l], (GLubyte)colors[3][l]);
+            quad->bl.colors = color;
+            quad->br.colors = color;
+            quad->tl.colors = color;
+            quad->tr.colors = color;
+
+            quad->bl.vertices.x = vertices[0][l];
+            quad->bl.vertices.y = vertices[1][l];
+            quad->br.vertices.x = vertices[2][l];
+            quad->br.vertices.y = vertices[3][l];
+            quad->tr.vertices.x = vertices[4][l];
+            quad->tr.vertices.y = vertices[5][l];
+            quad->tl.vertices.x = vertices[6][l];
+            quad->tl.vertices.y = vertices[7][l];
+        }
+    }
+}
+
+#endif // CC_PARTICLE_KERNELS_SSE2 || CC_PARTICLE_KERNELS_NEON
+
+void ccParticleUpdateLife(tCCParticleData* data, unsigned int count, float dt)
+{
+#if defined(CC_PARTICLE_KERNELS_SSE2) || defined(CC_PARTICLE_KERNELS_NEON)
+    if (s_bVectorized)
+    {
+        updateLifeVector(data, count, dt);
+        return;
+    }
+#endif
+    updateLifeScalar(data, 0, count, dt);
+}
+
+void ccParticleUpdateGravityMode(tCCParticleData* data, unsigned int count, const CCPoint& gravity, float dt)
+{
+#if defined(CC_PARTICLE_KERNELS_SSE2) || defined(CC_PARTICLE_KERNELS_NEON)
+    if (s_bVectorized)
+    {
+        updateGravityModeVector(data, count, gravity, dt);
+        return;
+    }
+#endif
+    updateGravityModeScalar(data, 0, count, gravity, dt);
+}
+
+void ccParticleUpdateRadiusMode(tCCParticleData* data, unsigned int count, float dt)
+{
+#if defined(CC_PARTICLE_KERNELS_SSE2) || defined(CC_PARTICLE_KERNELS_NEON)
+    if (s_bVectorized)
+    {
+        updateRadiusModeVector(data, count, dt);
+        return;
+    }
+#endif
+    updateRadiusModeScalar(data, 0, count, dt);
+}
+
+CCRect ccParticleUpdateCommon(tCCParticleData* data, unsigned int count, float dt,
+                              tCCPositionType positionType, const CCPoint& currentPosition, const CCPoint& offset)
+{
+    bool bMoveWithStart = (positionType == kCCPositionTypeFree || positionType == kCCPositionTypeRelative);
+    float bounds[4] = {FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX};
+#if defined(CC_PARTICLE_KERNELS_SSE2) || defined(CC_PARTICLE_KERNELS_NEON)
+    if (s_bVectorized)
+    {
+        updateCommonVector(data, count, dt, bMoveWithStart, currentPosition, offset, bounds);
+    }
+    else
+#endif
+    {
+        updateCommonScalar(data, 0, count, dt, bMoveWithStart, currentPosition, offset, bounds);
+    }
+    return (bounds[0] <= bounds[2]) ? CCRectMake(bounds[0], bounds[1], bounds[2] - bounds[0], bounds[3] - bounds[1]) : CCRectZero;
+}
+
+void ccParticleFillQuads(const tCCParticleData* data, unsigned int count, ccV3F_C4B_T2F_Quad* quads,
+                         bool bUseAtlasIndex, bool bPremultiplyAlpha)
+{
+#if defined(CC_PARTICLE_KERNELS_SSE2) || defined(CC_PARTICLE_KERNELS_NEON)
+    if (s_bVectorized)
+    {
+        fillQuadsVector(data, count, quads, bUseAtlasIndex, bPremultiplyAlpha);
+        return;
+    }
+#endif
+    fillQuadsScalar(data, 0, count, quads, bUseAtlasIndex, bPremultiplyAlpha);
+}
+
+void ccSetParticleKernelsVectorized(bool bVectorized)
+{
+    s_bVectorized = bVectorized && s_bVectorAvailable;
+}
+
+bool ccIsParticleKernelsVectorized()
+{
+    return s_bVectorized;
+}
+
+NS_CC_END
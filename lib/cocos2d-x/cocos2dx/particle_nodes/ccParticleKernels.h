@@ -0,0 +1,88 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __PARTICLE_NODES_CCPARTICLEKERNELS_H__
+#define __PARTICLE_NODES_CCPARTICLEKERNELS_H__
+
+#include "CCParticleSystem.h"
+
+/** @file ccParticleKernels.h
+Storage and update loops of the particles of a CCParticleSystem.
+The loops use SSE2 or NEON when the target supports them and process 4 particles at once.
+They give the same results as the scalar ones, except for the sines and cosines of the radius mode and of
+the rotated quads which are computed with a polynomial, within a few ulps of the C library.
+*/
+
+NS_CC_BEGIN
+
+/** Allocates the arrays of data for capacity particles, rounded up to a multiple of 4, and zeroes them.
+ The previous arrays are freed, or kept if there is not enough memory.
+ @return false if there is not enough memory
+ */
+bool CC_DLL ccParticleDataAlloc(tCCParticleData* data, unsigned int capacity);
+
+/** Frees the arrays of data. */
+void CC_DLL ccParticleDataFree(tCCParticleData* data);
+
+/** Stores particle as the particle index of data. */
+void CC_DLL ccParticleDataSetParticle(tCCParticleData* data, unsigned int index, const tCCParticle* particle);
+
+/** Reads the particle index of data. */
+void CC_DLL ccParticleDataGetParticle(const tCCParticleData* data, unsigned int index, tCCParticle* particle);
+
+/** Copies the particle src of data over the particle dst, atlasIndex included. */
+void CC_DLL ccParticleDataCopyParticle(tCCParticleData* data, unsigned int dst, unsigned int src);
+
+/** Subtracts dt from the timeToLive of the count first particles. */
+void CC_DLL ccParticleUpdateLife(tCCParticleData* data, unsigned int count, float dt);
+
+/** Moves the count first particles in gravity mode: radial and tangential accelerations, gravity and direction. */
+void CC_DLL ccParticleUpdateGravityMode(tCCParticleData* data, unsigned int count, const CCPoint& gravity, float dt);
+
+/** Moves the count first particles in radius mode: rotation around the source position. */
+void CC_DLL ccParticleUpdateRadiusMode(tCCParticleData* data, unsigned int count, float dt);
+
+/** Updates the color, size and rotation of the count first particles, and computes their drawPos.
+ In free and relative position types the particles are moved by the distance from their startPos to currentPosition.
+ offset is added to the drawPos, it is the position of the system when it is rendered by a CCParticleBatchNode.
+ @return the box of the quads, which may be rotated, or an empty rect if count is 0
+ */
+CCRect CC_DLL ccParticleUpdateCommon(tCCParticleData* data, unsigned int count, float dt,
+                                     tCCPositionType positionType, const CCPoint& currentPosition, const CCPoint& offset);
+
+/** Writes the vertices and colors of the count first particles into quads, like CCParticleSystemQuad::updateQuadWithParticle.
+ The particle i goes to quads[data->atlasIndex[i]] if bUseAtlasIndex, otherwise to quads[i].
+ */
+void CC_DLL ccParticleFillQuads(const tCCParticleData* data, unsigned int count, ccV3F_C4B_T2F_Quad* quads,
+                                bool bUseAtlasIndex, bool bPremultiplyAlpha);
+
+/** Whether the update loops use the SSE2 / NEON code. Enabled by default when the target has it,
+ disabling it runs the scalar code, e.g. to compare them.
+ */
+void CC_DLL ccSetParticleKernelsVectorized(bool bVectorized);
+bool CC_DLL ccIsParticleKernelsVectorized();
+
+NS_CC_END
+
+#endif // __PARTICLE_NODES_CCPARTICLEKERNELS_H__
@@ -27,9 +27,12 @@ THE SOFTWARE.
 #include "cocoa/CCDictionary.h"
 #include "cocoa/CCString.h"
 #include "CCSAXParser.h"
+#include "CCPackFile.h"
 #include "support/tinyxml2/tinyxml2.h"
 #include "support/zip_support/unzip.h"
 #include <stack>
+#include <algorithm>
+#include <pthread.h>
 
 using namespace std;
 
@@ -457,6 +460,11 @@ CCArray* CCFileUtils::createCCArrayWithContentsOfFile(const std::string& filenam
 
 CCFileUtils* CCFileUtils::s_sharedFileUtils = NULL;
 
+// the loading threads read the mounted packs while the main thread may mount others
+static pthread_rwlock_t s_packFilesLock = PTHREAD_RWLOCK_INITIALIZER;
+// the views are counted and released by the loading threads too
+static pthread_mutex_t s_packFileViewsLock = PTHREAD_MUTEX_INITIALIZER;
+
 void CCFileUtils::purgeFileUtils()
 {
     CC_SAFE_DELETE(s_sharedFileUtils);
@@ -470,6 +478,7 @@ CCFileUtils::CCFileUtils()
 CCFileUtils::~CCFileUtils()
 {
     CC_SAFE_RELEASE(m_pFilenameLookupDict);
+    removeAllPackFiles();
 }
 
 bool CCFileUtils::init()
@@ -492,8 +501,11 @@ unsigned char* CCFileUtils::getFileData(const char* pszFileName, const char* psz
     *pSize = 0;
     do
     {
-        // read the file from hardware
         std::string fullPath = fullPathForFilename(pszFileName);
+        pBuffer = getFileDataFromPacks(fullPath, pSize);
+        CC_BREAK_IF(pBuffer);
+
+        // read the file from hardware
         FILE *fp = fopen(fullPath.c_str(), pszMode);
         CC_BREAK_IF(!fp);
         
@@ -556,6 +568,205 @@ unsigned char* CCFileUtils::getFileDataFromZip(const char* pszZipFilePath, const
     return pBuffer;
 }
 
+const unsigned char* CCFileUtils::getFileView(const char* pszFileName, unsigned long * pSize)
+{
+    const unsigned char* pData = NULL;
+    *pSize = 0;
+
+    std::string fullPath = fullPathForFilename(pszFileName);
+    pthread_rwlock_rdlock(&s_packFilesLock);
+    std::string name;
+    CCPackFile* pPack = packForFullPath(fullPath, &name);
+    if (pPack)
+    {
+        pData = pPack->getFileView(name, pSize);
+    }
+    if (pData)
+    {
+        // keeps the pack in memory until the view is released
+        pthread_mutex_lock(&s_packFileViewsLock);
+        ++m_packFileViews[pPack];
+        pthread_mutex_unlock(&s_packFileViewsLock);
+    }
+    pthread_rwlock_unlock(&s_packFilesLock);
+    return pData;
+}
+
+void CCFileUtils::releaseFileView(const unsigned char* pData)
+{
+    if (! pData)
+    {
+        return;
+    }
+
+    CCPackFile* pRemovedPack = NULL;
+    pthread_mutex_lock(&s_packFileViewsLock);
+    for (std::map<CCPackFile*, unsigned int>::iterator it = m_packFileViews.begin(); it != m_packFileViews.end(); ++it)
+    {
+        if (it->first->containsData(pData))
+        {
+            if (--it->second == 0)
+            {
+                std::vector<CCPackFile*>::iterator removed = std::find(m_removedPackFiles.begin(), m_removedPackFiles.end(), it->first);
+                if (removed != m_removedPackFiles.end())
+                {
+                    pRemovedPack = *removed;
+                    m_removedPackFiles.erase(removed);
+                }
+                m_packFileViews.erase(it);
+            }
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_packFileViewsLock);
+
+    // nothing else references a removed pack
+    CC_SAFE_RELEASE(pRemovedPack);
+}
+
+void CCFileUtils::releasePackFile(CCPackFile* pPack)
+{
+    pthread_mutex_lock(&s_packFileViewsLock);
+    bool bViewed = m_packFileViews.find(pPack) != m_packFileViews.end();
+    if (bViewed)
+    {
+        m_removedPackFiles.push_back(pPack);
+    }
+    pthread_mutex_unlock(&s_packFileViewsLock);
+
+    if (! bViewed)
+    {
+        pPack->release();
+    }
+}
+
+bool CCFileUtils::addPackFile(const char* pszPackPath)
+{
+    CCPackFile* pPack = CCPackFile::create(pszPackPath);
+    if (! pPack)
+    {
+        return false;
+    }
+
+    pthread_rwlock_wrlock(&s_packFilesLock);
+    pPack->retain();
+    m_packFiles.push_back(pPack);
+    pthread_rwlock_unlock(&s_packFilesLock);
+
+    m_fullPathCache.clear();
+    return true;
+}
+
+void CCFileUtils::removePackFile(const char* pszPackPath)
+{
+    std::string fullPath = fullPathForFilename(pszPackPath);
+
+    pthread_rwlock_wrlock(&s_packFilesLock);
+    for (std::vector<CCPackFile*>::iterator it = m_packFiles.begin(); it != m_packFiles.end(); ++it)
+    {
+        if ((*it)->getPath() == fullPath)
+        {
+            releasePackFile(*it);
+            m_packFiles.erase(it);
+            break;
+        }
+    }
+    pthread_rwlock_unlock(&s_packFilesLock);
+
+    m_fullPathCache.clear();
+}
+
+void CCFileUtils::removeAllPackFiles()
+{
+    pthread_rwlock_wrlock(&s_packFilesLock);
+    for (std::vector<CCPackFile*>::iterator it = m_packFiles.begin(); it != m_packFiles.end(); ++it)
+    {
+        releasePackFile(*it);
+    }
+    m_packFiles.clear();
+    pthread_rwlock_unlock(&s_packFilesLock);
+
+    m_fullPathCache.clear();
+}
+
+CCPackFile* CCFileUtils::packForFullPath(const std::string& strFullPath, std::string* pFileName)
+{
+    for (std::vector<CCPackFile*>::reverse_iterator it = m_packFiles.rbegin(); it != m_packFiles.rend(); ++it)
+    {
+        const std::string& packPath = (*it)->getPath();
+        if (strFullPath.length() > packPath.length() && strFullPath[packPath.length()] == '/'
+            && strFullPath.compare(0, packPath.length(), packPath) == 0)
+        {
+            *pFileName = strFullPath.substr(packPath.length() + 1);
+            return *it;
+        }
+    }
+    return NULL;
+}
+
+std::string CCFileUtils::getFullPathInPacks(const std::string& strFilename)
+{
+    std::string fullPath;
+    if (m_packFiles.empty())
+    {
+        return fullPath;
+    }
+
+    std::string file = strFilename;
+    std::string file_path = "";
+    size_t pos = strFilename.find_last_of("/");
+    if (pos != std::string::npos)
+    {
+        file_path = strFilename.substr(0, pos+1);
+        file = strFilename.substr(pos+1);
+    }
+
+    pthread_rwlock_rdlock(&s_packFilesLock);
+    for (std::vector<CCPackFile*>::reverse_iterator it = m_packFiles.rbegin(); it != m_packFiles.rend() && fullPath.empty(); ++it)
+    {
+        for (std::vector<std::string>::iterator resOrderIter = m_searchResolutionsOrderArray.begin();
+             resOrderIter != m_searchResolutionsOrderArray.end(); ++resOrderIter)
+        {
+            std::string name = file_path + *resOrderIter + file;
+            if ((*it)->fileExists(name))
+            {
+                fullPath = (*it)->getPath() + "/" + name;
+                break;
+            }
+        }
+    }
+    pthread_rwlock_unlock(&s_packFilesLock);
+    return fullPath;
+}
+
+unsigned char* CCFileUtils::getFileDataFromPacks(const std::string& strFullPath, unsigned long * pSize)
+{
+    unsigned char* pData = NULL;
+    pthread_rwlock_rdlock(&s_packFilesLock);
+    std::string name;
+    CCPackFile* pPack = packForFullPath(strFullPath, &name);
+    if (pPack)
+    {
+        pData = pPack->getFileData(name, pSize);
+    }
+    pthread_rwlock_unlock(&s_packFilesLock);
+    return pData;
+}
+
+bool CCFileUtils::isFileExistInPacks(const std::string& strFullPath)
+{
+    bool bFound = false;
+    pthread_rwlock_rdlock(&s_packFilesLock);
+    std::string name;
+    CCPackFile* pPack = packForFullPath(strFullPath, &name);
+    if (pPack)
+    {
+        bFound = pPack->fileExists(name);
+    }
+    pthread_rwlock_unlock(&s_packFilesLock);
+    return bFound;
+}
+
 std::string CCFileUtils::getNewFilename(const char* pszFileName)
 {
     const char* pszNewFileName = NULL;
@@ -616,7 +827,13 @@ std::string CCFileUtils::fullPathForFilename(const char* pszFileName)
     // Get the new file name.
     std::string newFilename = getNewFilename(pszFileName);
     
-    string fullpath = "";
+    // the files of the mounted packs are found first
+    string fullpath = getFullPathInPacks(newFilename);
+    if (fullpath.length() > 0)
+    {
+        m_fullPathCache.insert(std::pair<std::string, std::string>(pszFileName, fullpath));
+        return fullpath;
+    }
     
     for (std::vector<std::string>::iterator searchPathsIter = m_searchPathArrayCheck.begin();
          searchPathsIter != m_searchPathArrayCheck.end(); ++searchPathsIter) {
@@ -35,6 +35,7 @@ NS_CC_BEGIN
 
 class CCDictionary;
 class CCArray;
+class CCPackFile;
 /**
  * @addtogroup platform
  * @{
@@ -109,6 +110,27 @@ public:
      */
     virtual unsigned char* getFileDataFromZip(const char* pszZipFilePath, const char* pszFileName, unsigned long * pSize);
 
+    /**
+     *  Gets the data of a file stored uncompressed in a mounted pack, without copying it.
+     *
+     *  @param[in]  pszFileName The resource file name which contains the path.
+     *  @param[out] pSize If the file is found, it will be the data size, otherwise 0.
+     *  @return The data of the file, or NULL if the file isn't stored as it is in a pack. getFileData() reads the other files.
+     *  @warning Call releaseFileView() with any non-NULL pointer returned once done with the data. Until then the pack
+     *           stays in memory, even if removePackFile() is called meanwhile.
+     *  @see addPackFile(const char*)
+     *  @js NA
+     *  @lua NA
+     */
+    virtual const unsigned char* getFileView(const char* pszFileName, unsigned long * pSize);
+
+    /**
+     *  Tells that the data returned by getFileView() isn't used anymore, a removed pack is deleted with its last view.
+     *  @js NA
+     *  @lua NA
+     */
+    virtual void releaseFileView(const unsigned char* pData);
+
     
     /** Returns the fullpath for a given filename.
      
@@ -280,6 +302,21 @@ public:
       * @lua NA
       */
 	 void removeAllPaths();
+
+    /**
+     *  Mounts a pack file made by bin/pack_resources.
+     *
+     *  The files of the mounted packs are found before the files of the search paths, in the packs mounted
+     *  last first, and with the same resolution directories. Their full path is the path of the pack followed
+     *  by their name in the pack, like "/mnt/sdcard/game/res.pack/images/hero.png".
+     *  The packs can be read by the loading threads, but they should be mounted and removed from the main thread.
+     *  A removed pack stays in memory until the views of its files returned by getFileView() are released.
+     *
+     *  @return false if the pack can't be opened.
+     */
+    virtual bool addPackFile(const char* pszPackPath);
+    virtual void removePackFile(const char* pszPackPath);
+    virtual void removeAllPackFiles();
     
     /**
      *  Gets the array of search paths.
@@ -407,6 +444,21 @@ protected:
     virtual CCArray* createCCArrayWithContentsOfFile(const std::string& filename);
     
     void updateSearchPathArrayCheck(void);
+
+    /** Returns the mounted pack holding a full path and the name of the file in the pack, or NULL. The packs have to be locked. */
+    CCPackFile* packForFullPath(const std::string& strFullPath, std::string* pFileName);
+
+    /** Releases an unmounted pack, or keeps it until its views are released */
+    void releasePackFile(CCPackFile* pPack);
+
+    /** Full path of a file in the mounted packs, or an empty string if no pack has it */
+    std::string getFullPathInPacks(const std::string& strFilename);
+
+    /** Returns the data of a file of a mounted pack, NULL if the full path isn't in a pack */
+    unsigned char* getFileDataFromPacks(const std::string& strFullPath, unsigned long * pSize);
+
+    /** Whether the full path is a file of a mounted pack, the platforms check it in isFileExist() */
+    bool isFileExistInPacks(const std::string& strFullPath);
     
     /** Dictionary used to lookup filenames based on a key.
      *  It is used internally by the following methods:
@@ -454,6 +506,18 @@ protected:
      * Cache path (for debug)
      */
     std::string m_strCachePath;
+
+    /**
+     *  The mounted packs, the last one is searched first.
+     */
+    std::vector<CCPackFile*> m_packFiles;
+
+    /**
+     *  Number of views returned by getFileView() and not released yet, per pack.
+     *  The removed packs that still have views wait in m_removedPackFiles.
+     */
+    std::map<CCPackFile*, unsigned int> m_packFileViews;
+    std::vector<CCPackFile*> m_removedPackFiles;
     
     /**
      *  The singleton pointer of CCFileUtils.
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "CCCommon.h"
 #include "CCStdC.h"
 #include "CCFileUtils.h"
+#include "support/image_support/ccPixelConversion.h"
 #include "png.h"
 
 #ifndef QUICK_MINI_TARGET
@@ -127,18 +128,20 @@ bool CCImage::initWithImageFile(const char * strPath, EImageFormat eImgFmt/* = e
     int size = 4 * (iSurf->w * iSurf->h);
     bRet = _initWithRawData((void*)iSurf->pixels, size, iSurf->w, iSurf->h, 8, true);
 
-    unsigned int *tmp = (unsigned int *)m_pData;
-    int nrPixels = iSurf->w * iSurf->h;
-    for(int i = 0; i < nrPixels; i++)
-    {
-        unsigned char *p = m_pData + i * 4;
-        tmp[i] = CC_RGB_PREMULTIPLY_ALPHA( p[0], p[1], p[2], p[3] );
-    }
+    ccPremultiplyAlpha(m_pData, iSurf->w * iSurf->h);
 
     SDL_FreeSurface(iSurf);
 #else
     unsigned long nSize = 0;
     std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(strPath);
+    // the images stored as they are in a pack are decoded in place
+    const unsigned char* pView = CCFileUtils::sharedFileUtils()->getFileView(fullPath.c_str(), &nSize);
+    if (pView)
+    {
+        bRet = initWithImageData((void*)pView, nSize, eImgFmt);
+        CCFileUtils::sharedFileUtils()->releaseFileView(pView);
+        return bRet;
+    }
     unsigned char* pBuffer = CCFileUtils::sharedFileUtils()->getFileData(fullPath.c_str(), "rb", &nSize);
     if (pBuffer != NULL && nSize > 0)
     {
@@ -154,6 +157,13 @@ bool CCImage::initWithImageFileThreadSafe(const char *fullpath, EImageFormat ima
 {
     bool bRet = false;
     unsigned long nSize = 0;
+    const unsigned char* pView = CCFileUtils::sharedFileUtils()->getFileView(fullpath, &nSize);
+    if (pView)
+    {
+        bRet = initWithImageData((void*)pView, nSize, imageType);
+        CCFileUtils::sharedFileUtils()->releaseFileView(pView);
+        return bRet;
+    }
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
     CCFileUtilsAndroid *fileUitls = (CCFileUtilsAndroid*)CCFileUtils::sharedFileUtils();
     unsigned char *pBuffer = fileUitls->getFileDataForAsync(fullpath, "rb", &nSize);
@@ -517,15 +527,8 @@ bool CCImage::_initWithPngData(void * pData, int nDatalen)
         if (channel == 4)
         {
             m_bHasAlpha = true;
-            unsigned int *tmp = (unsigned int *)m_pData;
-            for(unsigned short i = 0; i < m_nHeight; i++)
-            {
-                for(unsigned int j = 0; j < rowbytes; j += 4)
-                {
-                    *tmp++ = CC_RGB_PREMULTIPLY_ALPHA( row_pointers[i][j], row_pointers[i][j + 1], 
-                                                      row_pointers[i][j + 2], row_pointers[i][j + 3] );
-                }
-            }
+            // the rows are contiguous
+            ccPremultiplyAlpha(m_pData, m_nWidth * m_nHeight);
             
             m_bPreMulti = true;
         }
@@ -0,0 +1,348 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CCPackFile.h"
+#include "ccMacros.h"
+#include "platform/CCFileUtils.h"
+#include <string.h>
+#include <zlib.h>
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#include <windows.h>
+#define CC_PACK_FILE_MAPPING 1
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID) || (CC_TARGET_PLATFORM == CC_PLATFORM_IOS) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC) || (CC_TARGET_PLATFORM == CC_PLATFORM_LINUX) || (CC_TARGET_PLATFORM == CC_PLATFORM_BLACKBERRY)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define CC_PACK_FILE_MAPPING 1
+#else
+#define CC_PACK_FILE_MAPPING 0
+#endif
+
+NS_CC_BEGIN
+
+//////////////////////////////////////////////////////////////////////////
+// Pack files, version 1. The numbers are 4 bytes little endian.
+// header: "CCPK" version entryCount bucketCount entriesOffset bucketsOffset namesOffset reserved
+// entries: entryCount ccPackEntry, sorted by name
+// buckets: bucketCount indices of entries + 1, 0 for the empty buckets. bucketCount is a power of 2,
+//          an entry is in the first free bucket from (hash & (bucketCount - 1))
+// names: the names of the entries, each followed by a 0
+// then the data of the entries
+//////////////////////////////////////////////////////////////////////////
+#define CC_PACK_FILE_MAGIC "CCPK"
+#define CC_PACK_FILE_VERSION 1
+#define CC_PACK_FILE_HEADER_SIZE 32
+
+static inline unsigned int readPackUInt(const unsigned char* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+CCPackFile* CCPackFile::create(const char* pszPackPath)
+{
+    CCPackFile* pRet = new CCPackFile();
+    if (pRet->initWithFile(pszPackPath))
+    {
+        pRet->autorelease();
+        return pRet;
+    }
+    CC_SAFE_DELETE(pRet);
+    return NULL;
+}
+
+CCPackFile::CCPackFile(void)
+: m_pData(NULL)
+, m_uSize(0)
+, m_bMapped(false)
+, m_pMapping(NULL)
+, m_pEntries(NULL)
+, m_pBuckets(NULL)
+, m_pNames(NULL)
+, m_uEntryCount(0)
+, m_uBucketCount(0)
+{
+}
+
+CCPackFile::~CCPackFile()
+{
+    if (! m_bMapped)
+    {
+        CC_SAFE_DELETE_ARRAY(m_pData);
+    }
+#if CC_PACK_FILE_MAPPING
+    else
+    {
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+        UnmapViewOfFile(m_pData);
+        CloseHandle((HANDLE)m_pMapping);
+#else
+        munmap(m_pData, m_uSize);
+#endif
+    }
+#endif
+}
+
+bool CCPackFile::initWithFile(const char* pszPackPath)
+{
+    if (! pszPackPath || strlen(pszPackPath) == 0)
+    {
+        return false;
+    }
+    m_sPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(pszPackPath);
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    HANDLE file = CreateFileA(m_sPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        m_uSize = GetFileSize(file, NULL);
+        HANDLE mapping = m_uSize > 0 ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+        CloseHandle(file);
+        if (mapping)
+        {
+            m_pData = (unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (m_pData)
+            {
+                m_pMapping = mapping;
+                m_bMapped = true;
+            }
+            else
+            {
+                CloseHandle(mapping);
+            }
+        }
+    }
+#elif CC_PACK_FILE_MAPPING
+    int fd = open(m_sPath.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* data = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data != MAP_FAILED)
+            {
+                m_pData = (unsigned char*)data;
+                m_uSize = st.st_size;
+                m_bMapped = true;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    // the packs which aren't in the file system, like the assets of an apk, are read whole
+    if (! m_bMapped)
+    {
+        m_pData = CCFileUtils::sharedFileUtils()->getFileData(m_sPath.c_str(), "rb", &m_uSize);
+    }
+
+    if (! m_pData || ! validate())
+    {
+        CCLOG("cocos2d: CCPackFile: %s is not a valid pack", m_sPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool CCPackFile::validate(void)
+{
+    if (m_uSize < CC_PACK_FILE_HEADER_SIZE || memcmp(m_pData, CC_PACK_FILE_MAGIC, 4) != 0)
+    {
+        return false;
+    }
+    if (readPackUInt(m_pData + 4) != CC_PACK_FILE_VERSION)
+    {
+        CCLOG("cocos2d: CCPackFile: version %u of the packs is not supported", readPackUInt(m_pData + 4));
+        return false;
+    }
+
+    m_uEntryCount = readPackUInt(m_pData + 8);
+    m_uBucketCount = readPackUInt(m_pData + 12);
+    unsigned int entriesOffset = readPackUInt(m_pData + 16);
+    unsigned int bucketsOffset = readPackUInt(m_pData + 20);
+    unsigned int namesOffset = readPackUInt(m_pData + 24);
+
+    // the tables are read in place, they have to be aligned and inside the file
+    if ((entriesOffset | bucketsOffset) & 3
+        || m_uBucketCount == 0 || (m_uBucketCount & (m_uBucketCount - 1)) != 0 || m_uBucketCount < m_uEntryCount
+        || entriesOffset > m_uSize || m_uEntryCount > (m_uSize - entriesOffset) / sizeof(ccPackEntry)
+        || bucketsOffset > m_uSize || m_uBucketCount > (m_uSize - bucketsOffset) / sizeof(unsigned int)
+        || namesOffset > m_uSize)
+    {
+        return false;
+    }
+    m_pEntries = (const ccPackEntry*)(m_pData + entriesOffset);
+    m_pBuckets = (const unsigned int*)(m_pData + bucketsOffset);
+    m_pNames = (const char*)(m_pData + namesOffset);
+
+    // the lookups trust the entries once they are checked
+    unsigned long namesSize = m_uSize - namesOffset;
+    for (unsigned int i = 0; i < m_uEntryCount; ++i)
+    {
+        const ccPackEntry& entry = m_pEntries[i];
+        if (entry.nameOffset >= namesSize || entry.nameLength >= namesSize - entry.nameOffset
+            || m_pNames[entry.nameOffset + entry.nameLength] != '\0'
+            || entry.dataOffset > m_uSize || entry.storedSize > m_uSize - entry.dataOffset
+            || (entry.method == kCCPackEntryStored && entry.storedSize != entry.size)
+            || (entry.method != kCCPackEntryStored && entry.method != kCCPackEntryDeflated))
+        {
+            return false;
+        }
+    }
+    for (unsigned int i = 0; i < m_uBucketCount; ++i)
+    {
+        if (m_pBuckets[i] > m_uEntryCount)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+unsigned int CCPackFile::hashForName(const char* name, size_t length)
+{
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash = (hash ^ (unsigned char)name[i]) * 16777619u;
+    }
+    return hash;
+}
+
+const char* CCPackFile::nameOfEntry(const ccPackEntry* entry)
+{
+    return m_pNames + entry->nameOffset;
+}
+
+const ccPackEntry* CCPackFile::entryForName(const std::string& strFileName)
+{
+    unsigned int hash = hashForName(strFileName.c_str(), strFileName.length());
+    unsigned int mask = m_uBucketCount - 1;
+    // there is at least one empty bucket, or all the entries are visited
+    for (unsigned int i = 0, bucket = hash & mask; i < m_uBucketCount; ++i, bucket = (bucket + 1) & mask)
+    {
+        unsigned int index = m_pBuckets[bucket];
+        if (index == 0)
+        {
+            break;
+        }
+        const ccPackEntry* entry = m_pEntries + index - 1;
+        if (entry->hash == hash && entry->nameLength == strFileName.length()
+            && memcmp(nameOfEntry(entry), strFileName.c_str(), entry->nameLength) == 0)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+unsigned int CCPackFile::getFileCount()
+{
+    return m_uEntryCount;
+}
+
+const char* CCPackFile::getFilenameAt(unsigned int index)
+{
+    return index < m_uEntryCount ? nameOfEntry(m_pEntries + index) : NULL;
+}
+
+bool CCPackFile::fileExists(const std::string& strFileName)
+{
+    return entryForName(strFileName) != NULL;
+}
+
+bool CCPackFile::directoryExists(const std::string& strDirPath)
+{
+    std::string dir = strDirPath;
+    if (dir.length() > 0 && dir[dir.length() - 1] != '/')
+    {
+        dir += '/';
+    }
+
+    // the first entry not sorted before the directory starts with it if the directory has files
+    unsigned int first = 0, count = m_uEntryCount;
+    while (count > 0)
+    {
+        unsigned int step = count / 2;
+        if (strcmp(nameOfEntry(m_pEntries + first + step), dir.c_str()) < 0)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    return first < m_uEntryCount && strncmp(nameOfEntry(m_pEntries + first), dir.c_str(), dir.length()) == 0;
+}
+
+const unsigned char* CCPackFile::getFileView(const std::string& strFileName, unsigned long* pSize)
+{
+    const ccPackEntry* entry = entryForName(strFileName);
+    if (! entry || entry->method != kCCPackEntryStored)
+    {
+        return NULL;
+    }
+    if (pSize)
+    {
+        *pSize = entry->size;
+    }
+    return m_pData + entry->dataOffset;
+}
+
+unsigned char* CCPackFile::getFileData(const std::string& strFileName, unsigned long* pSize)
+{
+    const ccPackEntry* entry = entryForName(strFileName);
+    if (! entry)
+    {
+        return NULL;
+    }
+
+    unsigned char* pBuffer = new unsigned char[entry->size];
+    if (entry->method == kCCPackEntryStored)
+    {
+        memcpy(pBuffer, m_pData + entry->dataOffset, entry->size);
+    }
+    else
+    {
+        uLongf size = entry->size;
+        int err = uncompress(pBuffer, &size, m_pData + entry->dataOffset, entry->storedSize);
+        if (err != Z_OK || size != entry->size)
+        {
+            CCLOG("cocos2d: CCPackFile: can't inflate %s from %s, error %d", strFileName.c_str(), m_sPath.c_str(), err);
+            CC_SAFE_DELETE_ARRAY(pBuffer);
+            return NULL;
+        }
+    }
+    if (pSize)
+    {
+        *pSize = entry->size;
+    }
+    return pBuffer;
+}
+
+NS_CC_END
@@ -0,0 +1,135 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_PACK_FILE_H__
+#define __CC_PACK_FILE_H__
+
+#include <string>
+#include "cocoa/CCObject.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+/** An entry of the table of contents of a pack file */
+typedef struct _ccPackEntry
+{
+    //! offset of the name in the names table, and its length without the terminating 0
+    unsigned int nameOffset;
+    unsigned int nameLength;
+    //! hash of the name, see CCPackFile::hashForName()
+    unsigned int hash;
+    //! kCCPackEntryStored or kCCPackEntryDeflated
+    unsigned int method;
+    //! offset of the data in the pack, aligned on 16 bytes
+    unsigned int dataOffset;
+    //! size of the data in the pack, and size of the file once inflated
+    unsigned int storedSize;
+    unsigned int size;
+    unsigned int reserved;
+} ccPackEntry;
+
+enum {
+    kCCPackEntryStored = 0,
+    kCCPackEntryDeflated = 1,
+};
+
+/** @brief A read only archive of resources, made by bin/pack_resources.
+
+ The whole pack is mapped in memory when it is opened. Its table of contents holds the entries sorted
+ by name and a hash table of the names, so a file is found without searching nor allocating. The files
+ stored as they are can be read in place with getFileView(), the compressed ones are inflated by
+ getFileData(). Nothing changes once the pack is opened, so it can be read from several threads.
+
+ Packs are usually mounted with CCFileUtils::addPackFile(), their files are then found before the
+ files of the search paths.
+ */
+class CC_DLL CCPackFile : public CCObject
+{
+public:
+    /** Opens a pack file, returns NULL if it can't be opened or isn't a valid pack */
+    static CCPackFile* create(const char* pszPackPath);
+    /**
+     * @js NA
+     * @lua NA
+     */
+    virtual ~CCPackFile();
+
+    /** Full path of the pack file */
+    inline const std::string& getPath() { return m_sPath; }
+
+    /** Number of files in the pack */
+    unsigned int getFileCount();
+    /** Name of a file, the files are sorted by name */
+    const char* getFilenameAt(unsigned int index);
+
+    bool fileExists(const std::string& strFileName);
+    /** Whether some files of the pack are in a directory, strDirPath ends or not with a '/' */
+    bool directoryExists(const std::string& strDirPath);
+
+    /** Returns the data of a file stored as it is, in the memory of the pack, or NULL if the file
+     is compressed or not in the pack. The data stays valid as long as the pack.
+     */
+    const unsigned char* getFileView(const std::string& strFileName, unsigned long* pSize);
+
+    /** Whether a pointer returned by getFileView() points in the memory of this pack */
+    inline bool containsData(const unsigned char* pData) { return pData >= m_pData && pData < m_pData + m_uSize; }
+
+    /** Returns a copy of the data of a file, inflated if needed, or NULL if the file is not in the pack.
+     @warning you are responsible for calling delete[] on any non-NULL pointer returned.
+     */
+    unsigned char* getFileData(const std::string& strFileName, unsigned long* pSize);
+
+    /** FNV-1a hash of the names of the entries */
+    static unsigned int hashForName(const char* name, size_t length);
+
+private:
+    CCPackFile(void);
+    bool initWithFile(const char* pszPackPath);
+    bool validate(void);
+    const ccPackEntry* entryForName(const std::string& strFileName);
+    const char* nameOfEntry(const ccPackEntry* entry);
+
+    std::string m_sPath;
+    unsigned char* m_pData;
+    unsigned long m_uSize;
+    //! whether m_pData is a mapping of the file or a buffer read from it
+    bool m_bMapped;
+    void* m_pMapping;
+    const ccPackEntry* m_pEntries;
+    const unsigned int* m_pBuckets;
+    const char* m_pNames;
+    unsigned int m_uEntryCount;
+    unsigned int m_uBucketCount;
+};
+
+// end of platform group
+/// @}
+
+NS_CC_END
+
+#endif // __CC_PACK_FILE_H__
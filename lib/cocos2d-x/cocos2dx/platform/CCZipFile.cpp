@@ -25,11 +25,16 @@
 #include "CCZipFile.h"
 #include "ccMacros.h"
 #include "platform/CCFileUtils.h"
+#include "CCPackFile.h"
+#include <pthread.h>
 
 NS_CC_BEGIN
 
 static const std::string emptyFilename("");
 
+// guards the idle unzFile of all the zip files, it is only held to take or give back one
+static pthread_mutex_t s_idleFilesMutex = PTHREAD_MUTEX_INITIALIZER;
+
 CCZipFile *CCZipFile::create(const char *zipFilename)
 {
     CCZipFile *zip = new CCZipFile();
@@ -66,8 +71,9 @@ bool CCZipFile::initWithFilename(const char *zipFilename)
 
     m_zipFile = unzOpen(zipFilename);
     if (!m_zipFile) return false;
+    m_sPath = zipFilename;
     
-    return true;
+    return buildIndex();
 }
 
 bool CCZipFile::initWithBuffer(const void *buffer, uLong size)
@@ -76,8 +82,10 @@ bool CCZipFile::initWithBuffer(const void *buffer, uLong size)
 
     m_zipFile = unzOpenBuffer(buffer, size);
     if (!m_zipFile) return false;
+    m_pBuffer = (const unsigned char*)buffer;
+    m_uBufferSize = size;
 
-    return true;
+    return buildIndex();
 }
 
 CCZipFile::~CCZipFile(void)
@@ -85,75 +93,205 @@ CCZipFile::~CCZipFile(void)
     close();
 }
 
+bool CCZipFile::buildIndex(void)
+{
+    m_openedFiles.push_back(m_zipFile);
+    m_idleFiles.push_back(m_zipFile);
+
+    // read the central directory once, the reads then go to the entries without searching
+    char filename[FILENAME_MAX + 1];
+    unz_file_info64 info;
+    int err = unzGoToFirstFile64(m_zipFile, &info, filename, sizeof(filename) - 1);
+    while (err == UNZ_OK)
+    {
+        ZipEntry entry;
+        if (unzGetFilePos(m_zipFile, &entry.pos) == UNZ_OK)
+        {
+            entry.name = filename;
+            entry.hash = CCPackFile::hashForName(filename, entry.name.length());
+            entry.method = info.compression_method;
+            entry.crc = info.crc;
+            entry.compressedSize = (uLong)info.compressed_size;
+            entry.uncompressedSize = (uLong)info.uncompressed_size;
+            entry.dataOffset = 0;
+
+            // the data of the stored entries follows their local header, which only opening the entry reads
+            if (m_pBuffer && entry.method == 0 && (info.flag & 1) == 0 && entry.uncompressedSize > 0
+                && unzOpenCurrentFile(m_zipFile) == UNZ_OK)
+            {
+                ZPOS64_T offset = unzGetCurrentFileZStreamPos64(m_zipFile);
+                if (offset > 0 && offset + entry.uncompressedSize <= m_uBufferSize)
+                {
+                    entry.dataOffset = (uLong)offset;
+                }
+                unzCloseCurrentFile(m_zipFile);
+            }
+            m_entries.push_back(entry);
+        }
+        err = unzGoToNextFile64(m_zipFile, &info, filename, sizeof(filename) - 1);
+    }
+    if (err != UNZ_END_OF_LIST_OF_FILE)
+    {
+        CCLOG("CCZipFile: invalid central directory, error %d", err);
+        return false;
+    }
+
+    unsigned int bucketCount = 1;
+    while (bucketCount < m_entries.size() * 2)
+    {
+        bucketCount *= 2;
+    }
+    m_buckets.assign(bucketCount, 0);
+    for (unsigned int i = 0; i < m_entries.size(); ++i)
+    {
+        unsigned int bucket = m_entries[i].hash & (bucketCount - 1);
+        while (m_buckets[bucket] != 0)
+        {
+            bucket = (bucket + 1) & (bucketCount - 1);
+        }
+        m_buckets[bucket] = i + 1;
+    }
+    return true;
+}
+
+const CCZipFile::ZipEntry* CCZipFile::entryForName(const char *filename)
+{
+    if (!filename || m_buckets.empty()) return NULL;
+
+    size_t length = strlen(filename);
+    unsigned int hash = CCPackFile::hashForName(filename, length);
+    unsigned int mask = (unsigned int)m_buckets.size() - 1;
+    // the table is at most half full, there is always an empty bucket
+    for (unsigned int bucket = hash & mask; m_buckets[bucket] != 0; bucket = (bucket + 1) & mask)
+    {
+        const ZipEntry& entry = m_entries[m_buckets[bucket] - 1];
+        if (entry.hash == hash && entry.name.length() == length && memcmp(entry.name.c_str(), filename, length) == 0)
+        {
+            return &entry;
+        }
+    }
+    return NULL;
+}
+
+unzFile CCZipFile::acquireFile(void)
+{
+    unzFile file = NULL;
+    pthread_mutex_lock(&s_idleFilesMutex);
+    if (!m_idleFiles.empty())
+    {
+        file = m_idleFiles.back();
+        m_idleFiles.pop_back();
+    }
+    pthread_mutex_unlock(&s_idleFilesMutex);
+    if (file) return file;
+
+    // another thread is reading, this one gets its own unzFile
+    file = m_pBuffer ? unzOpenBuffer(m_pBuffer, m_uBufferSize) : unzOpen(m_sPath.c_str());
+    if (file)
+    {
+        pthread_mutex_lock(&s_idleFilesMutex);
+        m_openedFiles.push_back(file);
+        pthread_mutex_unlock(&s_idleFilesMutex);
+    }
+    return file;
+}
+
+void CCZipFile::releaseFile(unzFile file)
+{
+    pthread_mutex_lock(&s_idleFilesMutex);
+    m_idleFiles.push_back(file);
+    pthread_mutex_unlock(&s_idleFilesMutex);
+}
+
+unsigned int CCZipFile::getFileCount(void)
+{
+    return (unsigned int)m_entries.size();
+}
+
+const char* CCZipFile::getFilenameAt(unsigned int index)
+{
+    return index < m_entries.size() ? m_entries[index].name.c_str() : NULL;
+}
+
+bool CCZipFile::fileExists(const char *filename)
+{
+    return entryForName(filename) != NULL;
+}
+
 const std::string CCZipFile::getFirstFilename(void)
 {
-    if (unzGoToFirstFile(m_zipFile) != UNZ_OK) return emptyFilename;
-    std::string path;
-    unz_file_info info;
-    getCurrentFileInfo(&path, &info);
-    return path;
+    m_uNextFile = 0;
+    return getNextFilename();
 }
 
 const std::string CCZipFile::getNextFilename(void)
 {
-    if (unzGoToNextFile(m_zipFile) != UNZ_OK) return emptyFilename;
-    std::string path;
-    unz_file_info info;
-    getCurrentFileInfo(&path, &info);
-    return path;
+    if (m_uNextFile >= m_entries.size()) return emptyFilename;
+    return m_entries[m_uNextFile++].name;
 }
 
 unsigned char* CCZipFile::getFileData(const char *filename, unsigned long *filesize)
 {
     unsigned char *buffer = NULL;
     *filesize = 0;
+
+    const ZipEntry* entry = entryForName(filename);
+    if (!entry) return NULL;
+
+    unzFile file = acquireFile();
+    if (!file) return NULL;
     
     do 
     {
-        int ret = unzLocateFile(m_zipFile, filename, 1);
+        unz_file_pos pos = entry->pos;
+        int ret = unzGoToFilePos(file, &pos);
         CC_BREAK_IF(UNZ_OK != ret);
 
-        std::string path;
-        unz_file_info info;
-        CC_BREAK_IF(UNZ_OK != getCurrentFileInfo(&path, &info));
-        
-        ret = unzOpenCurrentFile(m_zipFile);
+        ret = unzOpenCurrentFile(file);
         CC_BREAK_IF(UNZ_OK != ret);
         
-        buffer = new unsigned char[info.uncompressed_size];
+        buffer = new unsigned char[entry->uncompressedSize];
         int size = 0;
-        size = unzReadCurrentFile(m_zipFile, buffer, info.uncompressed_size);
-        CCAssert(size == 0 || size == (int)info.uncompressed_size, "the file size is wrong");
+        size = unzReadCurrentFile(file, buffer, entry->uncompressedSize);
+        CCAssert(size == 0 || size == (int)entry->uncompressedSize, "the file size is wrong");
         
-        *filesize = info.uncompressed_size;
-        unzCloseCurrentFile(m_zipFile);
+        // the crc is checked once the whole file is read
+        if (unzCloseCurrentFile(file) == UNZ_CRCERROR)
+        {
+            CCLOG("CCZipFile: crc error in %s", filename);
+            CC_SAFE_DELETE_ARRAY(buffer);
+            break;
+        }
+        *filesize = entry->uncompressedSize;
     } while (0);
-    
+
+    releaseFile(file);
     return buffer;
 }
 
-void CCZipFile::close(void)
+const unsigned char* CCZipFile::getFileView(const char *filename, unsigned long *filesize)
 {
-    if (m_zipFile)
-    {
-        unzClose(m_zipFile);
-        m_zipFile = NULL;
-    }
+    *filesize = 0;
+    const ZipEntry* entry = entryForName(filename);
+    if (!entry || entry->dataOffset == 0) return NULL;
+
+    *filesize = entry->uncompressedSize;
+    return m_pBuffer + entry->dataOffset;
 }
 
-int CCZipFile::getCurrentFileInfo(std::string *filename, unz_file_info *info)
+void CCZipFile::close(void)
 {
-    char path[FILENAME_MAX + 1];
-    int ret = unzGetCurrentFileInfo(m_zipFile, info, path, sizeof(path), NULL, 0, NULL, 0);
-    if (ret != UNZ_OK)
+    for (std::vector<unzFile>::iterator it = m_openedFiles.begin(); it != m_openedFiles.end(); ++it)
     {
-        *filename = emptyFilename;
+        unzClose(*it);
     }
-    else
-    {
-        filename->assign(path);
-    }
-    return ret;
+    m_openedFiles.clear();
+    m_idleFiles.clear();
+    m_zipFile = NULL;
+
+    m_entries.clear();
+    m_buckets.clear();
+    m_uNextFile = 0;
 }
 
 NS_CC_END
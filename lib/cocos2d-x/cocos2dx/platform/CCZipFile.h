@@ -26,6 +26,7 @@
 #define __CC_ZIP_FILE_H_
 
 #include <string>
+#include <vector>
 #include "cocoa/CCObject.h"
 #include "ccTypeInfo.h"
 #include "support/zip_support/unzip.h"
@@ -51,21 +52,70 @@ public:
     
     const std::string getFirstFilename(void);
     const std::string getNextFilename(void);
-    
+
+    /** Number of files in the zip, the files are in the order of the central directory */
+    unsigned int getFileCount(void);
+    const char* getFilenameAt(unsigned int index);
+    bool fileExists(const char *filename);
+
+    /** Returns a copy of the data of a file, inflated if needed, or NULL if the file is not in the zip.
+     It can be called from several threads at once, each read uses its own unzFile.
+     @warning you are responsible for calling delete[] on any non-NULL pointer returned.
+     */
     unsigned char* getFileData(const char *filename, unsigned long *filesize);
+
+    /** Returns the data of a file stored without compression in the buffer of a zip created with
+     createWithBuffer(), or NULL if the file is compressed or the zip isn't read from a buffer.
+     The data stays valid as long as the buffer.
+     */
+    const unsigned char* getFileView(const char *filename, unsigned long *filesize);
+
     void close(void);
     
 private:
     CCZipFile(void)
     : m_zipFile(NULL)
+    , m_pBuffer(NULL)
+    , m_uBufferSize(0)
+    , m_uNextFile(0)
     {
     }
     bool initWithFilename(const char *zipFilename);
     bool initWithBuffer(const void *buffer, uLong size);
 
-    int getCurrentFileInfo(std::string *filename, unz_file_info *info);
+    /** An entry of the central directory */
+    struct ZipEntry
+    {
+        std::string name;
+        unsigned int hash;
+        unz_file_pos pos;
+        uLong method;
+        uLong crc;
+        uLong compressedSize;
+        uLong uncompressedSize;
+        //! offset of the data of a stored entry in m_pBuffer, 0 if it can't be read in place
+        uLong dataOffset;
+    };
+
+    bool buildIndex(void);
+    const ZipEntry* entryForName(const char *filename);
+    unzFile acquireFile(void);
+    void releaseFile(unzFile file);
 
+    //! the unzFile of the first read, it builds the index
     unzFile m_zipFile;
+    std::string m_sPath;
+    const unsigned char* m_pBuffer;
+    uLong m_uBufferSize;
+
+    std::vector<ZipEntry> m_entries;
+    //! indices + 1 of the entries, 0 for the empty buckets, the size is a power of 2
+    std::vector<unsigned int> m_buckets;
+    unsigned int m_uNextFile;
+
+    //! the unzFile which aren't reading, m_zipFile is one of them
+    std::vector<unzFile> m_idleFiles;
+    std::vector<unzFile> m_openedFiles;
 };
 
 NS_CC_END
@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include "support/zip_support/ZipUtils.h"
 #include "platform/CCCommon.h"
 #include "jni/Java_org_cocos2dx_lib_Cocos2dxHelper.h"
+#include <pthread.h>
 
 using namespace std;
 
@@ -32,6 +33,8 @@ NS_CC_BEGIN
 
 // record the zip on the resource path
 static ZipFile *s_pZipFile = NULL;
+// the asynchronous loads share one handle of the zip, from several threads
+static pthread_mutex_t s_asyncZipMutex = PTHREAD_MUTEX_INITIALIZER;
 
 CCFileUtils* CCFileUtils::sharedFileUtils()
 {
@@ -67,6 +70,12 @@ bool CCFileUtilsAndroid::isFileExist(const std::string& strFilePath)
         return false;
     }
 
+    // the files of the mounted packs
+    if (isFileExistInPacks(strFilePath))
+    {
+        return true;
+    }
+
     bool bFound = false;
     
     // Check whether file exists in apk.
@@ -135,11 +144,19 @@ unsigned char* CCFileUtilsAndroid::doGetFileData(const char* pszFileName, const
     
     string fullPath = fullPathForFilename(pszFileName);
     
+    pData = getFileDataFromPacks(fullPath, pSize);
+    if (pData)
+    {
+        return pData;
+    }
+    
     if (fullPath[0] != '/')
     {
         if (forAsync)
         {
+            pthread_mutex_lock(&s_asyncZipMutex);
             pData = s_pZipFile->getFileData(fullPath.c_str(), pSize, s_pZipFile->_dataThread);
+            pthread_mutex_unlock(&s_asyncZipMutex);
         }
         else
         {
@@ -248,6 +248,12 @@ bool CCFileUtilsIOS::isFileExist(const std::string& strFilePath)
         return false;
     }
 
+    // the files of the mounted packs
+    if (isFileExistInPacks(strFilePath))
+    {
+        return true;
+    }
+
     bool bRet = false;
     
     if (strFilePath[0] != '/')
@@ -0,0 +1,180 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CCApplication.h"
+#include "CCEGLView.h"
+#include "CCDirector.h"
+#include "platform/CCFileUtils.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <string>
+
+NS_CC_BEGIN
+
+// sharedApplication pointer
+CCApplication * CCApplication::sm_pSharedApplication = 0;
+
+static long getCurrentMicroSeconds()
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec * 1000000L + now.tv_usec;
+}
+
+CCApplication::CCApplication()
+: m_nAnimationInterval(1000000L / 60)
+, m_bFixedTimeStep(false)
+, m_uMaxFrames(0)
+{
+    CC_ASSERT(! sm_pSharedApplication);
+    sm_pSharedApplication = this;
+}
+
+CCApplication::~CCApplication()
+{
+    CC_ASSERT(this == sm_pSharedApplication);
+    sm_pSharedApplication = NULL;
+}
+
+int CCApplication::run()
+{
+    // Initialize instance and cocos2d.
+    if (! applicationDidFinishLaunching())
+    {
+        return 0;
+    }
+
+    CCEGLView* pMainView = CCEGLView::sharedOpenGLView();
+    unsigned int uFrames = 0;
+    long nLast = getCurrentMicroSeconds();
+
+    while (pMainView->isOpenGLReady())
+    {
+        if (m_uMaxFrames > 0 && uFrames >= m_uMaxFrames)
+        {
+            break;
+        }
+
+        if (m_bFixedTimeStep)
+        {
+            CCDirector::sharedDirector()->mainLoop();
+            ++uFrames;
+            continue;
+        }
+
+        // If it's the time to draw next frame, draw it, else sleep a while.
+        long nNow = getCurrentMicroSeconds();
+        if (nNow - nLast >= m_nAnimationInterval)
+        {
+            nLast = nNow;
+            CCDirector::sharedDirector()->mainLoop();
+            ++uFrames;
+        }
+        else
+        {
+            usleep(m_nAnimationInterval - (nNow - nLast));
+        }
+    }
+
+    return 0;
+}
+
+void CCApplication::setAnimationInterval(double interval)
+{
+    m_nAnimationInterval = (long)(interval * 1000000);
+    if (m_bFixedTimeStep)
+    {
+        CCDirector::sharedDirector()->setFixedDeltaTime((float)interval);
+    }
+}
+
+void CCApplication::setFixedTimeStep(bool bFixed)
+{
+    m_bFixedTimeStep = bFixed;
+    CCDirector::sharedDirector()->setFixedDeltaTime(bFixed ? m_nAnimationInterval / 1000000.0f : 0.0f);
+}
+
+void CCApplication::setResourceRootPath(const std::string& rootResDir)
+{
+    m_resourceRootPath = rootResDir;
+    if (m_resourceRootPath.length() > 0 && m_resourceRootPath[m_resourceRootPath.length() - 1] != '/')
+    {
+        m_resourceRootPath += '/';
+    }
+    CCFileUtils* pFileUtils = CCFileUtils::sharedFileUtils();
+    std::vector<std::string> searchPaths = pFileUtils->getSearchPaths();
+    searchPaths.insert(searchPaths.begin(), m_resourceRootPath);
+    pFileUtils->setSearchPaths(searchPaths);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// static member function
+//////////////////////////////////////////////////////////////////////////
+CCApplication* CCApplication::sharedApplication()
+{
+    CC_ASSERT(sm_pSharedApplication);
+    return sm_pSharedApplication;
+}
+
+ccLanguageType CCApplication::getCurrentLanguage()
+{
+    const char* pszLang = getenv("LANG");
+    if (! pszLang || strlen(pszLang) < 2)
+    {
+        return kLanguageEnglish;
+    }
+
+    static const struct { const char* code; ccLanguageType type; } s_languages[] = {
+        { "zh", kLanguageChinese },
+        { "en", kLanguageEnglish },
+        { "fr", kLanguageFrench },
+        { "it", kLanguageItalian },
+        { "de", kLanguageGerman },
+        { "es", kLanguageSpanish },
+        { "ru", kLanguageRussian },
+        { "ko", kLanguageKorean },
+        { "ja", kLanguageJapanese },
+        { "hu", kLanguageHungarian },
+        { "pt", kLanguagePortuguese },
+        { "ar", kLanguageArabic },
+    };
+
+    for (size_t i = 0; i < sizeof(s_languages) / sizeof(s_languages[0]); ++i)
+    {
+        if (0 == strncmp(pszLang, s_languages[i].code, 2))
+        {
+            return s_languages[i].type;
+        }
+    }
+    return kLanguageEnglish;
+}
+
+TargetPlatform CCApplication::getTargetPlatform()
+{
+    return kTargetLinux;
+}
+
+NS_CC_END
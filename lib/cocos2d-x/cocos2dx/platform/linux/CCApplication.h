@@ -0,0 +1,94 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_APPLICATION_LINUX_H__
+#define __CC_APPLICATION_LINUX_H__
+
+#include "platform/CCCommon.h"
+#include "platform/CCApplicationProtocol.h"
+#include <string>
+
+NS_CC_BEGIN
+
+class CC_DLL CCApplication : public CCApplicationProtocol
+{
+public:
+    CCApplication();
+    virtual ~CCApplication();
+
+    /**
+    @brief    Run the message loop.
+              Returns when CCDirector::end() has torn down the view,
+              or after getMaxFrames() frames when a frame limit is set.
+    */
+    int run();
+
+    /**
+    @brief    Get current applicaiton instance.
+    @return Current application instance pointer.
+    */
+    static CCApplication* sharedApplication();
+
+    /* override functions */
+    virtual void setAnimationInterval(double interval);
+    virtual ccLanguageType getCurrentLanguage();
+
+    /**
+     @brief Get target platform
+     */
+    virtual TargetPlatform getTargetPlatform();
+
+    /**
+    @brief    Drive the director with a fixed step clock.
+              Every frame advances the scheduler by exactly the animation interval and
+              frames are issued back to back without sleeping, so runs are reproducible
+              and finish as fast as the CPU allows.
+    */
+    void setFixedTimeStep(bool bFixed);
+    bool isFixedTimeStep() { return m_bFixedTimeStep; }
+
+    /**
+    @brief    Stop the main loop after the given number of frames, 0 means no limit.
+    */
+    void setMaxFrames(unsigned int uMaxFrames) { m_uMaxFrames = uMaxFrames; }
+    unsigned int getMaxFrames() { return m_uMaxFrames; }
+
+    /**
+    @brief    Set the root directory the resources are searched in, e.g. "/home/ci/game/res/".
+    */
+    void setResourceRootPath(const std::string& rootResDir);
+    const std::string& getResourceRootPath() { return m_resourceRootPath; }
+
+protected:
+    long                m_nAnimationInterval;   // micro seconds
+    bool                m_bFixedTimeStep;
+    unsigned int        m_uMaxFrames;
+    std::string         m_resourceRootPath;
+
+    static CCApplication * sm_pSharedApplication;
+};
+
+NS_CC_END
+
+#endif    // __CC_APPLICATION_LINUX_H__
@@ -0,0 +1,230 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CCEGLView.h"
+#include "CCGL.h"
+#include "ccMacros.h"
+
+#if CC_HEADLESS_NULL_GL
+#include "support/CCGLRecorder.h"
+#else
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+NS_CC_BEGIN
+
+CCEGLView::CCEGLView()
+: m_bIsReady(false)
+, m_pDisplay(NULL)
+, m_pConfig(NULL)
+, m_pSurface(NULL)
+, m_pContext(NULL)
+{
+    strcpy(m_szViewName, "Cocos2dxHeadless");
+}
+
+CCEGLView::~CCEGLView()
+{
+    destroyGL();
+}
+
+#if CC_HEADLESS_NULL_GL
+
+bool CCEGLView::initGL(int width, int height)
+{
+    CC_UNUSED_PARAM(width);
+    CC_UNUSED_PARAM(height);
+    // the null GL validates and counts every call
+    CCGLRecorder::sharedRecorder()->setActive(true);
+    m_bIsReady = true;
+    return true;
+}
+
+void CCEGLView::destroyGL()
+{
+    m_bIsReady = false;
+}
+
+void CCEGLView::swapBuffers()
+{
+}
+
+#else
+
+static EGLDisplay getHeadlessDisplay()
+{
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display != EGL_NO_DISPLAY && eglInitialize(display, NULL, NULL))
+    {
+        return display;
+    }
+
+    // no X server, ask mesa for a surfaceless display
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay)
+    {
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+        if (display != EGL_NO_DISPLAY && eglInitialize(display, NULL, NULL))
+        {
+            return display;
+        }
+    }
+#endif
+    return EGL_NO_DISPLAY;
+}
+
+bool CCEGLView::initGL(int width, int height)
+{
+    do
+    {
+        if (! m_pDisplay)
+        {
+            EGLDisplay display = getHeadlessDisplay();
+            CC_BREAK_IF(display == EGL_NO_DISPLAY);
+            m_pDisplay = display;
+
+            const EGLint configAttribs[] = {
+                EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+                EGL_RED_SIZE, 8,
+                EGL_GREEN_SIZE, 8,
+                EGL_BLUE_SIZE, 8,
+                EGL_ALPHA_SIZE, 8,
+                EGL_DEPTH_SIZE, 24,
+                EGL_STENCIL_SIZE, 8,
+                EGL_NONE
+            };
+            EGLConfig config;
+            EGLint numConfigs = 0;
+            CC_BREAK_IF(! eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs < 1);
+            m_pConfig = config;
+
+            eglBindAPI(EGL_OPENGL_ES_API);
+            const EGLint contextAttribs[] = {
+                EGL_CONTEXT_CLIENT_VERSION, 2,
+                EGL_NONE
+            };
+            EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+            CC_BREAK_IF(context == EGL_NO_CONTEXT);
+            m_pContext = context;
+        }
+
+        // the pbuffer can't be resized, make a new one current and keep the context with its GL objects
+        const EGLint surfaceAttribs[] = {
+            EGL_WIDTH, width,
+            EGL_HEIGHT, height,
+            EGL_NONE
+        };
+        EGLSurface surface = eglCreatePbufferSurface(m_pDisplay, m_pConfig, surfaceAttribs);
+        CC_BREAK_IF(surface == EGL_NO_SURFACE);
+        CC_BREAK_IF(! eglMakeCurrent(m_pDisplay, surface, surface, m_pContext));
+
+        if (m_pSurface)
+        {
+            eglDestroySurface(m_pDisplay, m_pSurface);
+        }
+        else
+        {
+            CCLOG("cocos2d: headless GL context %s, %s", glGetString(GL_RENDERER), glGetString(GL_VERSION));
+        }
+        m_pSurface = surface;
+        m_bIsReady = true;
+        return true;
+    } while (0);
+
+    CCLOG("cocos2d: failed to create the headless EGL context, error 0x%x", eglGetError());
+    destroyGL();
+    return false;
+}
+
+void CCEGLView::destroyGL()
+{
+    if (m_pDisplay)
+    {
+        eglMakeCurrent(m_pDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (m_pContext)
+        {
+            eglDestroyContext(m_pDisplay, m_pContext);
+        }
+        if (m_pSurface)
+        {
+            eglDestroySurface(m_pDisplay, m_pSurface);
+        }
+        eglTerminate(m_pDisplay);
+    }
+    m_pDisplay = NULL;
+    m_pConfig = NULL;
+    m_pSurface = NULL;
+    m_pContext = NULL;
+    m_bIsReady = false;
+}
+
+void CCEGLView::swapBuffers()
+{
+    if (m_bIsReady)
+    {
+        eglSwapBuffers(m_pDisplay, m_pSurface);
+    }
+}
+
+#endif // CC_HEADLESS_NULL_GL
+
+bool CCEGLView::isOpenGLReady()
+{
+    return m_bIsReady;
+}
+
+void CCEGLView::end()
+{
+    destroyGL();
+}
+
+void CCEGLView::setFrameSize(float width, float height)
+{
+    if (m_bIsReady && width == m_obScreenSize.width && height == m_obScreenSize.height)
+    {
+        return;
+    }
+
+    if (initGL((int)width, (int)height))
+    {
+        CCEGLViewProtocol::setFrameSize(width, height);
+    }
+}
+
+void CCEGLView::setIMEKeyboardState(bool bOpen)
+{
+    CC_UNUSED_PARAM(bOpen);
+}
+
+CCEGLView* CCEGLView::sharedOpenGLView()
+{
+    static CCEGLView instance;
+    return &instance;
+}
+
+NS_CC_END
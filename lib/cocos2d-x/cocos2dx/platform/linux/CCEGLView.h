@@ -0,0 +1,75 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_EGLVIEW_LINUX_H__
+#define __CC_EGLVIEW_LINUX_H__
+
+#include "platform/CCCommon.h"
+#include "cocoa/CCGeometry.h"
+#include "platform/CCEGLViewProtocol.h"
+
+NS_CC_BEGIN
+
+/**
+ @brief Headless view without a window.
+ 
+ By default an OpenGL ES 2.0 context is created on an EGL pbuffer of the frame size,
+ which works on hosts without X or a GPU through mesa's software rasterizer.
+ When the engine is built with CC_HEADLESS_NULL_GL=1 no context is created at all,
+ GL calls go to the null implementation in CCGLNull.cpp.
+ */
+class CC_DLL CCEGLView : public CCEGLViewProtocol
+{
+public:
+    CCEGLView();
+    virtual ~CCEGLView();
+
+    /* override functions */
+    virtual bool isOpenGLReady();
+    virtual void end();
+    virtual void swapBuffers();
+    virtual void setFrameSize(float width, float height);
+    virtual void setIMEKeyboardState(bool bOpen);
+
+    // static function
+    /**
+    @brief    get the shared main open gl window
+    */
+    static CCEGLView* sharedOpenGLView();
+
+private:
+    bool initGL(int width, int height);
+    void destroyGL();
+
+    bool  m_bIsReady;
+    // EGLDisplay, EGLConfig, EGLSurface and EGLContext, kept opaque to not leak EGL headers
+    void* m_pDisplay;
+    void* m_pConfig;
+    void* m_pSurface;
+    void* m_pContext;
+};
+
+NS_CC_END
+
+#endif    // end of __CC_EGLVIEW_LINUX_H__
@@ -0,0 +1,137 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CCFileUtilsLinux.h"
+#include "platform/CCCommon.h"
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+NS_CC_BEGIN
+
+CCFileUtils* CCFileUtils::sharedFileUtils()
+{
+    if (s_sharedFileUtils == NULL)
+    {
+        s_sharedFileUtils = new CCFileUtilsLinux();
+        s_sharedFileUtils->init();
+    }
+    return s_sharedFileUtils;
+}
+
+CCFileUtilsLinux::CCFileUtilsLinux()
+{
+}
+
+bool CCFileUtilsLinux::init()
+{
+    // resources live next to the executable by default
+    char fullpath[256] = {0};
+    ssize_t length = readlink("/proc/self/exe", fullpath, sizeof(fullpath) - 1);
+    if (length <= 0)
+    {
+        return false;
+    }
+    fullpath[length] = '\0';
+
+    string appPath = fullpath;
+    m_strDefaultResRootPath = appPath.substr(0, appPath.find_last_of("/") + 1);
+    return CCFileUtils::init();
+}
+
+string CCFileUtilsLinux::getWritablePath()
+{
+    if (m_strWritablePath.length() > 0)
+    {
+        return m_strWritablePath;
+    }
+
+    // $HOME/.config/<executable name>/, fall back to the executable directory
+    const char* home = getenv("HOME");
+    if (home)
+    {
+        char fullpath[256] = {0};
+        ssize_t length = readlink("/proc/self/exe", fullpath, sizeof(fullpath) - 1);
+        if (length > 0)
+        {
+            fullpath[length] = '\0';
+            string appName = fullpath;
+            appName = appName.substr(appName.find_last_of("/") + 1);
+
+            string ret = string(home) + "/.config";
+            mkdir(ret.c_str(), 0755);
+            ret += "/" + appName + "/";
+            mkdir(ret.c_str(), 0755);
+            if (isDirectoryExist(ret))
+            {
+                return ret;
+            }
+        }
+    }
+    return m_strDefaultResRootPath;
+}
+
+bool CCFileUtilsLinux::isFileExist(const std::string& strFilePath)
+{
+    if (0 == strFilePath.length())
+    {
+        return false;
+    }
+
+    // the files of the mounted packs
+    if (isFileExistInPacks(strFilePath))
+    {
+        return true;
+    }
+
+    std::string strPath = strFilePath;
+    if (!isAbsolutePath(strPath))
+    { // Not absolute path, add the default root path at the beginning.
+        strPath.insert(0, m_strDefaultResRootPath);
+    }
+
+    struct stat sts;
+    return (stat(strPath.c_str(), &sts) != -1) ? true : false;
+}
+
+bool CCFileUtilsLinux::isDirectoryExist(const std::string& strDirPath)
+{
+    if (0 == strDirPath.length())
+    {
+        return false;
+    }
+
+    std::string strPath = strDirPath;
+    if (!isAbsolutePath(strPath))
+    {
+        strPath.insert(0, m_strDefaultResRootPath);
+    }
+
+    struct stat sts;
+    return (stat(strPath.c_str(), &sts) != -1 && S_ISDIR(sts.st_mode)) ? true : false;
+}
+
+NS_CC_END
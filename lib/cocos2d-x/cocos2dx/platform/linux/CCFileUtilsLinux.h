@@ -0,0 +1,60 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_FILEUTILS_LINUX_H__
+#define __CC_FILEUTILS_LINUX_H__
+
+#include "platform/CCFileUtils.h"
+#include "platform/CCPlatformMacros.h"
+#include "ccTypes.h"
+#include "ccTypeInfo.h"
+#include <string>
+#include <vector>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+
+//! @brief  Helper class to handle file operations
+class CC_DLL CCFileUtilsLinux : public CCFileUtils
+{
+    friend class CCFileUtils;
+    CCFileUtilsLinux();
+public:
+    /* override funtions */
+    bool init();
+    virtual std::string getWritablePath();
+    virtual bool isFileExist(const std::string& strFilePath);
+    virtual bool isDirectoryExist(const std::string& strDirPath);
+};
+
+// end of platform group
+/// @}
+
+NS_CC_END
+
+#endif    // __CC_FILEUTILS_LINUX_H__
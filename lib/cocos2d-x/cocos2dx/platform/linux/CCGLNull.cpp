@@ -0,0 +1,1316 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+/*
+ * Null OpenGL ES 2.0 implementation for the headless linux backend.
+ *
+ * Only compiled when CC_HEADLESS_NULL_GL=1, the binary then doesn't link libGLESv2/libEGL.
+ * Nothing is rendered: object names are handed out, the state the engine queries back
+ * (bindings, viewport, scissor, capabilities) is remembered and shaders always compile,
+ * so the CPU side of the renderer runs unchanged.
+ *
+ * Every call is counted by CCGLRecorder and checked against the rules of the real API
+ * (program in use, bound buffers and their sizes, limits). A failed check is logged and
+ * reported by glGetError, the call has no effect.
+ */
+
+#include "CCGL.h"
+#include "platform/CCPlatformMacros.h"
+
+#if CC_HEADLESS_NULL_GL
+
+#include "support/CCGLRecorder.h"
+#include <string.h>
+#include <map>
+#include <set>
+#include <vector>
+
+#define RECORDER            cocos2d::CCGLRecorder::sharedRecorder()
+#define RECORD_CALL()       RECORDER->recordCall(__FUNCTION__)
+#define RECORD_ERROR(error, reason) RECORDER->recordError(error, __FUNCTION__, reason)
+
+static const GLint kMaxTextureSize = 4096;
+static const GLint kMaxTextureUnits = 8;
+static const GLuint kMaxVertexAttribs = 16;
+
+static GLuint s_uLastName = 0;
+static GLuint s_uCurrentProgram = 0;
+static GLuint s_uArrayBuffer = 0;
+static GLuint s_uElementArrayBuffer = 0;
+static GLenum s_eActiveTexture = GL_TEXTURE0;
+static std::set<GLuint> s_programs;
+static std::map<GLuint, GLsizeiptr> s_bufferSizes;
+static GLint s_iFramebuffer = 0;
+static GLint s_iRenderbuffer = 0;
+static GLint s_viewport[4] = {0};
+static GLint s_scissorBox[4] = {0};
+static std::set<GLenum> s_enabledCaps;
+static std::vector<unsigned char> s_mapBuffer;
+
+static void genNames(GLsizei n, GLuint* names)
+{
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        names[i] = ++s_uLastName;
+    }
+}
+
+static void setCapability(GLenum cap, bool bEnabled)
+{
+    if (bEnabled)
+    {
+        s_enabledCaps.insert(cap);
+    }
+    else
+    {
+        s_enabledCaps.erase(cap);
+    }
+}
+
+static bool isCapabilityEnabled(GLenum cap)
+{
+    return s_enabledCaps.find(cap) != s_enabledCaps.end();
+}
+
+static GLuint* boundBuffer(GLenum target)
+{
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:
+        return &s_uArrayBuffer;
+    case GL_ELEMENT_ARRAY_BUFFER:
+        return &s_uElementArrayBuffer;
+    default:
+        return NULL;
+    }
+}
+
+static bool checkProgramInUse(const char* pszFunction)
+{
+    if (s_uCurrentProgram == 0)
+    {
+        RECORDER->recordError(GL_INVALID_OPERATION, pszFunction, "no program in use");
+        return false;
+    }
+    return true;
+}
+
+static bool checkAttribIndex(GLuint index, const char* pszFunction)
+{
+    if (index >= kMaxVertexAttribs)
+    {
+        RECORDER->recordError(GL_INVALID_VALUE, pszFunction, "attribute index out of range");
+        return false;
+    }
+    return true;
+}
+
+static bool checkTextureSize(GLsizei width, GLsizei height, const char* pszFunction)
+{
+    if (width < 0 || height < 0 || width > kMaxTextureSize || height > kMaxTextureSize)
+    {
+        RECORDER->recordError(GL_INVALID_VALUE, pszFunction, "texture size out of range");
+        return false;
+    }
+    return true;
+}
+
+static bool checkBorder(GLint border, const char* pszFunction)
+{
+    if (border != 0)
+    {
+        RECORDER->recordError(GL_INVALID_VALUE, pszFunction, "border must be 0");
+        return false;
+    }
+    return true;
+}
+
+static unsigned int bytesPerPixel(GLenum format, GLenum type)
+{
+    if (type == GL_UNSIGNED_SHORT_4_4_4_4 || type == GL_UNSIGNED_SHORT_5_5_5_1 || type == GL_UNSIGNED_SHORT_5_6_5)
+    {
+        return 2;
+    }
+    switch (format)
+    {
+    case GL_RGBA:
+        return 4;
+    case GL_RGB:
+        return 3;
+    case GL_LUMINANCE_ALPHA:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+// returns how many values were written
+static int getIntegerv(GLenum pname, GLint* data)
+{
+    switch (pname)
+    {
+    case GL_MAX_TEXTURE_SIZE:
+        data[0] = kMaxTextureSize;
+        return 1;
+    case GL_MAX_TEXTURE_IMAGE_UNITS:
+    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+        data[0] = kMaxTextureUnits;
+        return 1;
+    case GL_MAX_VERTEX_ATTRIBS:
+        data[0] = kMaxVertexAttribs;
+        return 1;
+    case GL_CURRENT_PROGRAM:
+        data[0] = s_uCurrentProgram;
+        return 1;
+    case GL_ARRAY_BUFFER_BINDING:
+        data[0] = s_uArrayBuffer;
+        return 1;
+    case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+        data[0] = s_uElementArrayBuffer;
+        return 1;
+    case GL_ACTIVE_TEXTURE:
+        data[0] = s_eActiveTexture;
+        return 1;
+    case GL_FRAMEBUFFER_BINDING:
+        data[0] = s_iFramebuffer;
+        return 1;
+    case GL_RENDERBUFFER_BINDING:
+        data[0] = s_iRenderbuffer;
+        return 1;
+    case GL_VIEWPORT:
+        memcpy(data, s_viewport, sizeof(s_viewport));
+        return 4;
+    case GL_SCISSOR_BOX:
+        memcpy(data, s_scissorBox, sizeof(s_scissorBox));
+        return 4;
+    case GL_STENCIL_BITS:
+        data[0] = 8;
+        return 1;
+    case GL_DEPTH_BITS:
+        data[0] = 24;
+        return 1;
+    default:
+        data[0] = 0;
+        return 1;
+    }
+}
+
+extern "C" {
+
+void GL_APIENTRY glActiveTexture (GLenum texture)
+{
+    RECORD_CALL();
+    if (texture < GL_TEXTURE0 || texture >= GL_TEXTURE0 + kMaxTextureUnits)
+    {
+        RECORD_ERROR(GL_INVALID_ENUM, "texture unit out of range");
+        return;
+    }
+    s_eActiveTexture = texture;
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glAttachShader (GLuint, GLuint)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glBindAttribLocation (GLuint, GLuint, const GLchar *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glBindBuffer (GLenum target, GLuint buffer)
+{
+    RECORD_CALL();
+    GLuint* pBinding = boundBuffer(target);
+    if (! pBinding)
+    {
+        RECORD_ERROR(GL_INVALID_ENUM, "unknown buffer target");
+        return;
+    }
+    *pBinding = buffer;
+    if (buffer && s_bufferSizes.find(buffer) == s_bufferSizes.end())
+    {
+        s_bufferSizes[buffer] = 0;
+    }
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glBindFramebuffer (GLenum, GLuint framebuffer)
+{
+    RECORD_CALL();
+    s_iFramebuffer = framebuffer;
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glBindRenderbuffer (GLenum, GLuint renderbuffer)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+    s_iRenderbuffer = renderbuffer;
+}
+
+void GL_APIENTRY glBindTexture (GLenum, GLuint)
+{
+    RECORD_CALL();
+    RECORDER->recordTextureBind();
+}
+
+void GL_APIENTRY glBlendColor (GLfloat, GLfloat, GLfloat, GLfloat)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glBlendEquation (GLenum)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glBlendEquationSeparate (GLenum, GLenum)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glBlendFunc (GLenum, GLenum)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glBlendFuncSeparate (GLenum, GLenum, GLenum, GLenum)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glBufferData (GLenum target, GLsizeiptr size, const void *data, GLenum)
+{
+    RECORD_CALL();
+    GLuint* pBinding = boundBuffer(target);
+    if (! pBinding)
+    {
+        RECORD_ERROR(GL_INVALID_ENUM, "unknown buffer target");
+        return;
+    }
+    if (size < 0)
+    {
+        RECORD_ERROR(GL_INVALID_VALUE, "negative size");
+        return;
+    }
+    if (*pBinding == 0)
+    {
+        RECORD_ERROR(GL_INVALID_OPERATION, "no buffer bound");
+        return;
+    }
+    s_bufferSizes[*pBinding] = size;
+    s_mapBuffer.resize(size);
+    // orphaning a buffer (NULL data) only allocates it
+    if (data)
+    {
+        RECORDER->recordBufferUpload((unsigned int)size);
+    }
+}
+
+void GL_APIENTRY glBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const void *)
+{
+    RECORD_CALL();
+    GLuint* pBinding = boundBuffer(target);
+    if (! pBinding)
+    {
+        RECORD_ERROR(GL_INVALID_ENUM, "unknown buffer target");
+        return;
+    }
+    if (offset < 0 || size < 0)
+    {
+        RECORD_ERROR(GL_INVALID_VALUE, "negative offset or size");
+        return;
+    }
+    if (*pBinding == 0)
+    {
+        RECORD_ERROR(GL_INVALID_OPERATION, "no buffer bound");
+        return;
+    }
+    if (offset + size > s_bufferSizes[*pBinding])
+    {
+        RECORD_ERROR(GL_INVALID_VALUE, "range exceeds the buffer size");
+        return;
+    }
+    RECORDER->recordBufferUpload((unsigned int)size);
+}
+
+GLenum GL_APIENTRY glCheckFramebufferStatus (GLenum)
+{
+    RECORD_CALL();
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void GL_APIENTRY glClear (GLbitfield)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glClearColor (GLfloat, GLfloat, GLfloat, GLfloat)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glClearDepthf (GLfloat)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glClearStencil (GLint)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glColorMask (GLboolean, GLboolean, GLboolean, GLboolean)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glCompileShader (GLuint)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glCompressedTexImage2D (GLenum, GLint, GLenum, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *)
+{
+    RECORD_CALL();
+    if (checkTextureSize(width, height, __FUNCTION__) && checkBorder(border, __FUNCTION__))
+    {
+        RECORDER->recordTextureUpload((unsigned int)imageSize);
+    }
+}
+
+void GL_APIENTRY glCompressedTexSubImage2D (GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height, GLenum, GLsizei imageSize, const void *)
+{
+    RECORD_CALL();
+    if (checkTextureSize(width, height, __FUNCTION__))
+    {
+        RECORDER->recordTextureUpload((unsigned int)imageSize);
+    }
+}
+
+void GL_APIENTRY glCopyTexImage2D (GLenum, GLint, GLenum, GLint, GLint, GLsizei, GLsizei, GLint)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glCopyTexSubImage2D (GLenum, GLint, GLint, GLint, GLint, GLint, GLsizei, GLsizei)
+{
+    RECORD_CALL();
+}
+
+GLuint GL_APIENTRY glCreateProgram (void)
+{
+    RECORD_CALL();
+    GLuint program = ++s_uLastName;
+    s_programs.insert(program);
+    return program;
+}
+
+GLuint GL_APIENTRY glCreateShader (GLenum)
+{
+    RECORD_CALL();
+    return ++s_uLastName;
+}
+
+void GL_APIENTRY glCullFace (GLenum)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glDeleteBuffers (GLsizei n, const GLuint *buffers)
+{
+    RECORD_CALL();
+    for (GLsizei i = 0; i < n; ++i)
+    {
+        s_bufferSizes.erase(buffers[i]);
+        if (s_uArrayBuffer == buffers[i])
+        {
+            s_uArrayBuffer = 0;
+        }
+        if (s_uElementArrayBuffer == buffers[i])
+        {
+            s_uElementArrayBuffer = 0;
+        }
+    }
+}
+
+void GL_APIENTRY glDeleteFramebuffers (GLsizei, const GLuint *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glDeleteProgram (GLuint program)
+{
+    RECORD_CALL();
+    // a program in use stays valid until it is replaced
+    if (program != s_uCurrentProgram)
+    {
+        s_programs.erase(program);
+    }
+}
+
+void GL_APIENTRY glDeleteRenderbuffers (GLsizei, const GLuint *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glDeleteShader (GLuint)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glDeleteTextures (GLsizei, const GLuint *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glDepthFunc (GLenum)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glDepthMask (GLboolean)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glDepthRangef (GLfloat, GLfloat)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glDetachShader (GLuint, GLuint)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glDisable (GLenum cap)
+{
+    RECORD_CALL();
+    setCapability(cap, false);
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glDisableVertexAttribArray (GLuint index)
+{
+    RECORD_CALL();
+    checkAttribIndex(index, __FUNCTION__);
+}
+
+void GL_APIENTRY glDrawArrays (GLenum, GLint first, GLsizei count)
+{
+    RECORD_CALL();
+    if (first < 0 || count < 0)
+    {
+        RECORD_ERROR(GL_INVALID_VALUE, "negative first or count");
+        return;
+    }
+    if (! checkProgramInUse(__FUNCTION__))
+    {
+        return;
+    }
+    RECORDER->recordDraw(count);
+}
+
+void GL_APIENTRY glDrawElements (GLenum, GLsizei count, GLenum type, const void *indices)
+{
+    RECORD_CALL();
+    if (count < 0)
+    {
+        RECORD_ERROR(GL_INVALID_VALUE, "negative count");
+        return;
+    }
+    if (type != GL_UNSIGNED_BYTE && type != GL_UNSIGNED_SHORT)
+    {
+        RECORD_ERROR(GL_INVALID_ENUM, "index type not supported by OpenGL ES 2.0");
+        return;
+    }
+    if (! checkProgramInUse(__FUNCTION__))
+    {
+        return;
+    }
+    if (s_uElementArrayBuffer)
+    {
+        // indices is an offset into the bound element array buffer
+        GLsizeiptr end = (GLsizeiptr)(size_t)indices + count * (type == GL_UNSIGNED_SHORT ? 2 : 1);
+        if (end > s_bufferSizes[s_uElementArrayBuffer])
+        {
+            RECORD_ERROR(GL_INVALID_OPERATION, "indices exceed the element array buffer");
+            return;
+        }
+    }
+    else if (! indices && count > 0)
+    {
+        RECORD_ERROR(GL_INVALID_OPERATION, "no element array buffer bound and no client indices");
+        return;
+    }
+    RECORDER->recordDraw(count);
+}
+
+void GL_APIENTRY glEnable (GLenum cap)
+{
+    RECORD_CALL();
+    setCapability(cap, true);
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glEnableVertexAttribArray (GLuint index)
+{
+    RECORD_CALL();
+    checkAttribIndex(index, __FUNCTION__);
+}
+
+void GL_APIENTRY glFinish (void)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glFlush (void)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glFramebufferRenderbuffer (GLenum, GLenum, GLenum, GLuint)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glFramebufferTexture2D (GLenum, GLenum, GLenum, GLuint, GLint)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glFrontFace (GLenum)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glGenBuffers (GLsizei n, GLuint *buffers)
+{
+    RECORD_CALL();
+    genNames(n, buffers);
+}
+
+void GL_APIENTRY glGenerateMipmap (GLenum)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGenFramebuffers (GLsizei n, GLuint *framebuffers)
+{
+    RECORD_CALL();
+    genNames(n, framebuffers);
+}
+
+void GL_APIENTRY glGenRenderbuffers (GLsizei n, GLuint *renderbuffers)
+{
+    RECORD_CALL();
+    genNames(n, renderbuffers);
+}
+
+void GL_APIENTRY glGenTextures (GLsizei n, GLuint *textures)
+{
+    RECORD_CALL();
+    genNames(n, textures);
+}
+
+void GL_APIENTRY glGetActiveAttrib (GLuint, GLuint, GLsizei, GLsizei *, GLint *, GLenum *, GLchar *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGetActiveUniform (GLuint, GLuint, GLsizei, GLsizei *, GLint *, GLenum *, GLchar *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGetAttachedShaders (GLuint, GLsizei, GLsizei *, GLuint *)
+{
+    RECORD_CALL();
+}
+
+GLint GL_APIENTRY glGetAttribLocation (GLuint, const GLchar *)
+{
+    RECORD_CALL();
+    return (GLint)(++s_uLastName);
+}
+
+void GL_APIENTRY glGetBooleanv (GLenum pname, GLboolean *data)
+{
+    RECORD_CALL();
+    GLint value[4] = {0};
+    getIntegerv(pname, value);
+    *data = value[0] ? GL_TRUE : GL_FALSE;
+}
+
+void GL_APIENTRY glGetBufferParameteriv (GLenum, GLenum, GLint *)
+{
+    RECORD_CALL();
+}
+
+GLenum GL_APIENTRY glGetError (void)
+{
+    RECORD_CALL();
+    return RECORDER->popError();
+}
+
+void GL_APIENTRY glGetFloatv (GLenum pname, GLfloat *data)
+{
+    RECORD_CALL();
+    GLint values[4] = {0};
+    int count = getIntegerv(pname, values);
+    for (int i = 0; i < count; ++i)
+    {
+        data[i] = (GLfloat)values[i];
+    }
+}
+
+void GL_APIENTRY glGetFramebufferAttachmentParameteriv (GLenum, GLenum, GLenum, GLint *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGetIntegerv (GLenum pname, GLint *data)
+{
+    RECORD_CALL();
+    getIntegerv(pname, data);
+}
+
+void GL_APIENTRY glGetProgramiv (GLuint, GLenum pname, GLint *params)
+{
+    RECORD_CALL();
+    *params = (pname == GL_LINK_STATUS || pname == GL_VALIDATE_STATUS) ? GL_TRUE : 0;
+}
+
+void GL_APIENTRY glGetProgramInfoLog (GLuint, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    RECORD_CALL();
+    if (length)
+    {
+        *length = 0;
+    }
+    if (infoLog && bufSize > 0)
+    {
+        infoLog[0] = '\0';
+    }
+}
+
+void GL_APIENTRY glGetRenderbufferParameteriv (GLenum, GLenum, GLint *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGetShaderiv (GLuint, GLenum pname, GLint *params)
+{
+    RECORD_CALL();
+    *params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+}
+
+void GL_APIENTRY glGetShaderInfoLog (GLuint, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    RECORD_CALL();
+    if (length)
+    {
+        *length = 0;
+    }
+    if (infoLog && bufSize > 0)
+    {
+        infoLog[0] = '\0';
+    }
+}
+
+void GL_APIENTRY glGetShaderPrecisionFormat (GLenum, GLenum, GLint *, GLint *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGetShaderSource (GLuint, GLsizei bufSize, GLsizei *length, GLchar *source)
+{
+    RECORD_CALL();
+    if (length)
+    {
+        *length = 0;
+    }
+    if (source && bufSize > 0)
+    {
+        source[0] = '\0';
+    }
+}
+
+const GLubyte *GL_APIENTRY glGetString (GLenum name)
+{
+    RECORD_CALL();
+    switch (name)
+    {
+    case GL_VENDOR:
+        return (const GLubyte*)"cocos2d-x";
+    case GL_RENDERER:
+        return (const GLubyte*)"null";
+    case GL_VERSION:
+        return (const GLubyte*)"OpenGL ES 2.0 null";
+    case GL_SHADING_LANGUAGE_VERSION:
+        return (const GLubyte*)"OpenGL ES GLSL ES 1.00";
+    default:
+        return (const GLubyte*)"";
+    }
+}
+
+void GL_APIENTRY glGetTexParameterfv (GLenum, GLenum, GLfloat *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGetTexParameteriv (GLenum, GLenum, GLint *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGetUniformfv (GLuint, GLint, GLfloat *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGetUniformiv (GLuint, GLint, GLint *)
+{
+    RECORD_CALL();
+}
+
+GLint GL_APIENTRY glGetUniformLocation (GLuint, const GLchar *)
+{
+    RECORD_CALL();
+    return (GLint)(++s_uLastName);
+}
+
+void GL_APIENTRY glGetVertexAttribfv (GLuint, GLenum, GLfloat *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGetVertexAttribiv (GLuint, GLenum, GLint *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGetVertexAttribPointerv (GLuint, GLenum, void **)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glHint (GLenum, GLenum)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+GLboolean GL_APIENTRY glIsBuffer (GLuint buffer)
+{
+    RECORD_CALL();
+    return buffer != 0 ? GL_TRUE : GL_FALSE;
+}
+
+GLboolean GL_APIENTRY glIsEnabled (GLenum cap)
+{
+    RECORD_CALL();
+    return isCapabilityEnabled(cap) ? GL_TRUE : GL_FALSE;
+}
+
+GLboolean GL_APIENTRY glIsFramebuffer (GLuint framebuffer)
+{
+    RECORD_CALL();
+    return framebuffer != 0 ? GL_TRUE : GL_FALSE;
+}
+
+GLboolean GL_APIENTRY glIsProgram (GLuint program)
+{
+    RECORD_CALL();
+    return program != 0 ? GL_TRUE : GL_FALSE;
+}
+
+GLboolean GL_APIENTRY glIsRenderbuffer (GLuint renderbuffer)
+{
+    RECORD_CALL();
+    return renderbuffer != 0 ? GL_TRUE : GL_FALSE;
+}
+
+GLboolean GL_APIENTRY glIsShader (GLuint shader)
+{
+    RECORD_CALL();
+    return shader != 0 ? GL_TRUE : GL_FALSE;
+}
+
+GLboolean GL_APIENTRY glIsTexture (GLuint texture)
+{
+    RECORD_CALL();
+    return texture != 0 ? GL_TRUE : GL_FALSE;
+}
+
+void GL_APIENTRY glLineWidth (GLfloat)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glLinkProgram (GLuint)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glPixelStorei (GLenum, GLint)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glPolygonOffset (GLfloat, GLfloat)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glReadPixels (GLint, GLint, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels)
+{
+    RECORD_CALL();
+    if (pixels && format == GL_RGBA && type == GL_UNSIGNED_BYTE)
+    {
+        memset(pixels, 0, width * height * 4);
+    }
+}
+
+void GL_APIENTRY glReleaseShaderCompiler (void)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glRenderbufferStorage (GLenum, GLenum, GLsizei, GLsizei)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glSampleCoverage (GLfloat, GLboolean)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glScissor (GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    RECORD_CALL();
+    s_scissorBox[0] = x;
+    s_scissorBox[1] = y;
+    s_scissorBox[2] = width;
+    s_scissorBox[3] = height;
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glShaderBinary (GLsizei, const GLuint *, GLenum, const void *, GLsizei)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glShaderSource (GLuint, GLsizei, const GLchar *const*, const GLint *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glStencilFunc (GLenum, GLint, GLuint)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glStencilFuncSeparate (GLenum, GLenum, GLint, GLuint)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glStencilMask (GLuint)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glStencilMaskSeparate (GLenum, GLuint)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glStencilOp (GLenum, GLenum, GLenum)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glStencilOpSeparate (GLenum, GLenum, GLenum, GLenum)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glTexImage2D (GLenum, GLint, GLint, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *)
+{
+    RECORD_CALL();
+    if (checkTextureSize(width, height, __FUNCTION__) && checkBorder(border, __FUNCTION__))
+    {
+        RECORDER->recordTextureUpload(width * height * bytesPerPixel(format, type));
+    }
+}
+
+void GL_APIENTRY glTexParameterf (GLenum, GLenum, GLfloat)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glTexParameterfv (GLenum, GLenum, const GLfloat *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glTexParameteri (GLenum, GLenum, GLint)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glTexParameteriv (GLenum, GLenum, const GLint *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glTexSubImage2D (GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *)
+{
+    RECORD_CALL();
+    if (checkTextureSize(width, height, __FUNCTION__))
+    {
+        RECORDER->recordTextureUpload(width * height * bytesPerPixel(format, type));
+    }
+}
+
+void GL_APIENTRY glUniform1f (GLint, GLfloat)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform1fv (GLint, GLsizei, const GLfloat *)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform1i (GLint, GLint)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform1iv (GLint, GLsizei, const GLint *)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform2f (GLint, GLfloat, GLfloat)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform2fv (GLint, GLsizei, const GLfloat *)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform2i (GLint, GLint, GLint)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform2iv (GLint, GLsizei, const GLint *)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform3f (GLint, GLfloat, GLfloat, GLfloat)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform3fv (GLint, GLsizei, const GLfloat *)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform3i (GLint, GLint, GLint, GLint)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform3iv (GLint, GLsizei, const GLint *)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform4f (GLint, GLfloat, GLfloat, GLfloat, GLfloat)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform4fv (GLint, GLsizei, const GLfloat *)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform4i (GLint, GLint, GLint, GLint, GLint)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniform4iv (GLint, GLsizei, const GLint *)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniformMatrix2fv (GLint, GLsizei, GLboolean, const GLfloat *)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniformMatrix3fv (GLint, GLsizei, GLboolean, const GLfloat *)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUniformMatrix4fv (GLint, GLsizei, GLboolean, const GLfloat *)
+{
+    RECORD_CALL();
+    if (checkProgramInUse(__FUNCTION__))
+    {
+        RECORDER->recordUniformUpdate();
+    }
+}
+
+void GL_APIENTRY glUseProgram (GLuint program)
+{
+    RECORD_CALL();
+    if (program && s_programs.find(program) == s_programs.end())
+    {
+        RECORD_ERROR(GL_INVALID_VALUE, "program was never created");
+        return;
+    }
+    s_uCurrentProgram = program;
+    RECORDER->recordProgramBind();
+}
+
+void GL_APIENTRY glValidateProgram (GLuint)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glVertexAttrib1f (GLuint, GLfloat)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glVertexAttrib1fv (GLuint, const GLfloat *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glVertexAttrib2f (GLuint, GLfloat, GLfloat)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glVertexAttrib2fv (GLuint, const GLfloat *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glVertexAttrib3f (GLuint, GLfloat, GLfloat, GLfloat)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glVertexAttrib3fv (GLuint, const GLfloat *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glVertexAttrib4f (GLuint, GLfloat, GLfloat, GLfloat, GLfloat)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glVertexAttrib4fv (GLuint, const GLfloat *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glVertexAttribPointer (GLuint index, GLint size, GLenum, GLboolean, GLsizei stride, const void *)
+{
+    RECORD_CALL();
+    if (! checkAttribIndex(index, __FUNCTION__))
+    {
+        return;
+    }
+    if (size < 1 || size > 4 || stride < 0)
+    {
+        RECORD_ERROR(GL_INVALID_VALUE, "bad size or stride");
+    }
+}
+
+void GL_APIENTRY glViewport (GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    RECORD_CALL();
+    s_viewport[0] = x;
+    s_viewport[1] = y;
+    s_viewport[2] = width;
+    s_viewport[3] = height;
+    RECORDER->recordStateChange();
+}
+
+// extensions referenced by CCGL.h
+
+void *GL_APIENTRY glMapBufferOES (GLenum, GLenum)
+{
+    RECORD_CALL();
+    return s_mapBuffer.empty() ? NULL : &s_mapBuffer[0];
+}
+
+GLboolean GL_APIENTRY glUnmapBufferOES (GLenum)
+{
+    RECORD_CALL();
+    return GL_TRUE;
+}
+
+void GL_APIENTRY glBindVertexArrayOES (GLuint)
+{
+    RECORD_CALL();
+    RECORDER->recordStateChange();
+}
+
+void GL_APIENTRY glDeleteVertexArraysOES (GLsizei, const GLuint *)
+{
+    RECORD_CALL();
+}
+
+void GL_APIENTRY glGenVertexArraysOES (GLsizei n, GLuint *arrays)
+{
+    RECORD_CALL();
+    genNames(n, arrays);
+}
+
+GLboolean GL_APIENTRY glIsVertexArrayOES (GLuint array)
+{
+    RECORD_CALL();
+    return array != 0 ? GL_TRUE : GL_FALSE;
+}
+
+} // extern "C"
+
+#endif // CC_HEADLESS_NULL_GL
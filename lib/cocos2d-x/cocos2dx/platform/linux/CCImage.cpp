@@ -0,0 +1,93 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#define __CC_PLATFORM_IMAGE_CPP__
+#include "platform/CCImageCommon_cpp.h"
+
+NS_CC_BEGIN
+
+/**
+ The headless backend has no font rasterizer. Text images get the size a
+ monospaced font of the requested size would take, with transparent pixels,
+ so label layout and texture upload costs stay representative.
+ */
+bool CCImage::initWithString(
+                               const char *    pText, 
+                               int             nWidth/* = 0*/, 
+                               int             nHeight/* = 0*/,
+                               ETextAlign      eAlignMask/* = kAlignCenter*/,
+                               const char *    pFontName/* = nil*/,
+                               int             nSize/* = 0*/)
+{
+    CC_UNUSED_PARAM(eAlignMask);
+    CC_UNUSED_PARAM(pFontName);
+
+    bool bRet = false;
+    do 
+    {
+        CC_BREAK_IF(! pText);
+
+        int fontSize = nSize > 0 ? nSize : 20;
+        int lines = 1;
+        int columns = 0;
+        int maxColumns = 0;
+        for (const unsigned char* p = (const unsigned char*)pText; *p; ++p)
+        {
+            if (*p == '\n')
+            {
+                ++lines;
+                columns = 0;
+            }
+            else if ((*p & 0xC0) != 0x80)
+            {
+                // count utf-8 lead bytes only
+                ++columns;
+                maxColumns = MAX(maxColumns, columns);
+            }
+        }
+
+        int width = nWidth > 0 ? nWidth : MAX(1, maxColumns * fontSize * 3 / 5);
+        int height = nHeight > 0 ? nHeight : lines * fontSize * 6 / 5;
+
+        // align to even sizes like the other platforms do
+        width = (width / 2) * 2 + 2;
+        height = (height / 2) * 2 + 2;
+
+        m_pData = new unsigned char[width * height * 4];
+        CC_BREAK_IF(! m_pData);
+        memset(m_pData, 0, width * height * 4);
+
+        m_nWidth    = (short)width;
+        m_nHeight   = (short)height;
+        m_bHasAlpha = true;
+        m_bPreMulti = false;
+        m_nBitsPerComponent = 8;
+
+        bRet = true;
+    } while (0);
+
+    return bRet;
+}
+
+NS_CC_END
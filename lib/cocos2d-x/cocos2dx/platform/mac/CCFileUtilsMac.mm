@@ -236,6 +236,12 @@ bool CCFileUtilsMac::isFileExist(const std::string& strFilePath)
     {
         return false;
     }
+
+    // the files of the mounted packs
+    if (isFileExistInPacks(strFilePath))
+    {
+        return true;
+    }
     
     bool bRet = false;
     
@@ -71,6 +71,12 @@ bool CCFileUtilsWin32::isFileExist(const std::string& strFilePath)
 		return false;
 	}
 
+    // the files of the mounted packs
+    if (isFileExistInPacks(strFilePath))
+    {
+        return true;
+    }
+
     std::string strPath = strFilePath;
 	if (!isAbsolutePath(strPath))
 	{ // Not absolute path, add the default root path at the beginning.
@@ -50,6 +50,20 @@ enum ccScriptType {
     kScriptTypeLua,
     kScriptTypeJavascript
 };
+
+/** Garbage collection done by a script engine, see CCScriptEngineProtocol::collectGarbage() */
+typedef struct _ccScriptGCStats
+{
+    //! seconds spent collecting garbage in the last frame
+    float gcTime;
+    //! size of the heap of the script engine, in KB
+    unsigned int heapSize;
+    //! incremental steps done in the last frame
+    unsigned int steps;
+    //! full collections forced since the engine paces its collector
+    unsigned int fullCollections;
+} ccScriptGCStats;
+
 /**
  * @js NA
  * @lua NA
@@ -245,6 +259,14 @@ public:
      * @return true if the assert was handled by the script engine, false otherwise.
      */
     virtual bool handleAssert(const char *msg) = 0;
+
+    /** Called by CCDirector at the end of each frame, the engine can collect its garbage during fIdleTime,
+     the seconds left before the next frame. fIdleTime is negative when the frame is late.
+     */
+    virtual void collectGarbage(float fIdleTime) {};
+
+    /** Garbage collection done by the engine, or NULL if it doesn't pace its collector */
+    virtual const ccScriptGCStats* getGCStats() { return NULL; };
 };
 
 /**
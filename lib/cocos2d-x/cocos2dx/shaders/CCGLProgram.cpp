@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "platform/CCFileUtils.h"
 #include "support/data_support/uthash.h"
 #include "cocoa/CCString.h"
+#include "sprite_nodes/CCAutoBatchRenderer.h"
 // extern
 #include "kazmath/GL/matrix.h"
 #include "kazmath/kazmath.h"
@@ -189,7 +190,7 @@ bool CCGLProgram::compileShader(GLuint * shader, GLenum type, const GLchar* sour
     }
     
     const GLchar *sources[] = {
-#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32 && CC_TARGET_PLATFORM != CC_PLATFORM_LINUX && CC_TARGET_PLATFORM != CC_PLATFORM_MAC)
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32 && CC_TARGET_PLATFORM != CC_PLATFORM_MAC)
         (type == GL_VERTEX_SHADER ? "precision highp float;\n" : "precision mediump float;\n"),
 #endif
         "uniform mat4 CC_PMatrix;\n"
@@ -320,6 +321,12 @@ bool CCGLProgram::link()
 
 void CCGLProgram::use()
 {
+    // the queued sprites are drawn before anything else
+    CCAutoBatchRenderer* pBatchRenderer = CCAutoBatchRenderer::sharedRenderer();
+    if (pBatchRenderer->hasPendingQuads())
+    {
+        pBatchRenderer->flush();
+    }
     ccGLUseProgram(m_uProgram);
 }
 
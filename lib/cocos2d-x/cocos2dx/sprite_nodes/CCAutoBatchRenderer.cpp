@@ -0,0 +1,279 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CCAutoBatchRenderer.h"
+#include "ccMacros.h"
+#include "shaders/CCGLProgram.h"
+#include "shaders/ccGLStateCache.h"
+#include "support/CCNotificationCenter.h"
+#include "support/CCProfiling.h"
+#include "CCEventType.h"
+#include "kazmath/GL/matrix.h"
+#include <stddef.h>
+#include <stdlib.h>
+
+NS_CC_BEGIN
+
+// the indices are GLushort, 4 vertices per quad
+#define kMaxBatchQuads      16384
+#define kInitialBatchQuads  64
+
+static CCAutoBatchRenderer* s_pSharedRenderer = NULL;
+
+CCAutoBatchRenderer* CCAutoBatchRenderer::sharedRenderer(void)
+{
+    if (! s_pSharedRenderer)
+    {
+        s_pSharedRenderer = new CCAutoBatchRenderer();
+    }
+    return s_pSharedRenderer;
+}
+
+void CCAutoBatchRenderer::purgeSharedRenderer(void)
+{
+    CC_SAFE_RELEASE_NULL(s_pSharedRenderer);
+}
+
+CCAutoBatchRenderer::CCAutoBatchRenderer(void)
+: m_bEnabled(false)
+, m_bFlushing(false)
+, m_pQuads(NULL)
+, m_uTotalQuads(0)
+, m_uCapacity(0)
+, m_uIndicesCapacity(0)
+{
+    m_pBuffersVBO[0] = 0;
+    m_pBuffersVBO[1] = 0;
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    // listen the event when app go to background
+    CCNotificationCenter::sharedNotificationCenter()->addObserver(this,
+                                                           callfuncO_selector(CCAutoBatchRenderer::listenBackToForeground),
+                                                           EVENT_COME_TO_FOREGROUND,
+                                                           NULL);
+#endif
+}
+
+CCAutoBatchRenderer::~CCAutoBatchRenderer(void)
+{
+    CC_SAFE_FREE(m_pQuads);
+
+    if (m_pBuffersVBO[0])
+    {
+        glDeleteBuffers(2, m_pBuffersVBO);
+    }
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    CCNotificationCenter::sharedNotificationCenter()->removeObserver(this, EVENT_COME_TO_FOREGROUND);
+#endif
+}
+
+void CCAutoBatchRenderer::listenBackToForeground(CCObject *obj)
+{
+    // the buffers died with the old context, they are created again by the next flush
+    m_pBuffersVBO[0] = 0;
+    m_pBuffersVBO[1] = 0;
+    m_uIndicesCapacity = 0;
+}
+
+void CCAutoBatchRenderer::setEnabled(bool bEnabled)
+{
+    if (! bEnabled)
+    {
+        flush();
+    }
+    m_bEnabled = bEnabled;
+}
+
+void CCAutoBatchRenderer::ensureCapacity(unsigned int capacity)
+{
+    if (capacity <= m_uCapacity)
+    {
+        return;
+    }
+
+    unsigned int newCapacity = MAX(m_uCapacity, kInitialBatchQuads);
+    while (newCapacity < capacity)
+    {
+        newCapacity *= 2;
+    }
+    newCapacity = MIN(newCapacity, kMaxBatchQuads);
+
+    ccV3F_C4B_T2F_Quad* pNewQuads = (ccV3F_C4B_T2F_Quad*)realloc(m_pQuads, newCapacity * sizeof(m_pQuads[0]));
+    if (! pNewQuads)
+    {
+        CCLOG("cocos2d: CCAutoBatchRenderer: not enough memory to queue %u quads", newCapacity);
+        return;
+    }
+    m_pQuads = pNewQuads;
+    m_uCapacity = newCapacity;
+}
+
+void CCAutoBatchRenderer::addQuads(const ccV3F_C4B_T2F_Quad* pQuads, unsigned int n, GLuint texture, CCGLProgram* pProgram, const ccBlendFunc& blendFunc)
+{
+    kmMat4 mv;
+    kmGLGetMatrix(KM_GL_MODELVIEW, &mv);
+    const float* m = mv.mat;
+
+    for (unsigned int i = 0; i < n; i++)
+    {
+        const ccV3F_C4B_T2F_Quad& quad = pQuads[i];
+
+        // hidden sprites have all their vertices at 0, they draw nothing
+        if (quad.bl.vertices.x == quad.tr.vertices.x && quad.bl.vertices.y == quad.tr.vertices.y
+            && quad.tl.vertices.x == quad.br.vertices.x && quad.tl.vertices.y == quad.br.vertices.y)
+        {
+            continue;
+        }
+
+        if (m_uTotalQuads == kMaxBatchQuads)
+        {
+            flush();
+        }
+        ensureCapacity(m_uTotalQuads + 1);
+        if (m_uTotalQuads == m_uCapacity)
+        {
+            return;
+        }
+
+        // merge with the last run when nothing changes between them
+        ccAutoBatchRun* pRun = m_runs.empty() ? NULL : &m_runs.back();
+        if (pRun && pRun->texture == texture && pRun->program == pProgram
+            && pRun->blendFunc.src == blendFunc.src && pRun->blendFunc.dst == blendFunc.dst)
+        {
+            pRun->count++;
+        }
+        else
+        {
+            ccAutoBatchRun run = { texture, pProgram, blendFunc, m_uTotalQuads, 1 };
+            m_runs.push_back(run);
+        }
+
+        ccV3F_C4B_T2F_Quad& dst = m_pQuads[m_uTotalQuads++];
+        dst = quad;
+
+        ccV3F_C4B_T2F* vertex = (ccV3F_C4B_T2F*)&dst;
+        for (int j = 0; j < 4; j++)
+        {
+            ccVertex3F& v = vertex[j].vertices;
+            float x = v.x, y = v.y, z = v.z;
+            v.x = m[0] * x + m[4] * y + m[8] * z + m[12];
+            v.y = m[1] * x + m[5] * y + m[9] * z + m[13];
+            v.z = m[2] * x + m[6] * y + m[10] * z + m[14];
+        }
+    }
+}
+
+void CCAutoBatchRenderer::setupVBO(void)
+{
+    glGenBuffers(2, &m_pBuffersVBO[0]);
+    m_uIndicesCapacity = 0;
+}
+
+void CCAutoBatchRenderer::flush(void)
+{
+    if (m_bFlushing || m_uTotalQuads == 0)
+    {
+        return;
+    }
+    m_bFlushing = true;
+
+    CC_PROFILER_START("CCAutoBatchRenderer - flush");
+
+    if (! m_pBuffersVBO[0])
+    {
+        setupVBO();
+    }
+
+    // the vertices are already transformed
+    kmGLMatrixMode(KM_GL_MODELVIEW);
+    kmGLPushMatrix();
+    kmGLLoadIdentity();
+
+#if CC_TEXTURE_ATLAS_USE_VAO
+    // Avoid changing the element buffer for whatever VAO might be bound.
+    ccGLBindVAO(0);
+#endif
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_pBuffersVBO[1]);
+    if (m_uIndicesCapacity < m_uCapacity)
+    {
+        GLushort* pIndices = (GLushort*)malloc(m_uCapacity * 6 * sizeof(GLushort));
+        for (unsigned int i = 0; i < m_uCapacity; i++)
+        {
+            pIndices[i*6+0] = i*4+0;
+            pIndices[i*6+1] = i*4+1;
+            pIndices[i*6+2] = i*4+2;
+
+            // inverted index. issue #179
+            pIndices[i*6+3] = i*4+3;
+            pIndices[i*6+4] = i*4+2;
+            pIndices[i*6+5] = i*4+1;
+        }
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_uCapacity * 6 * sizeof(GLushort), pIndices, GL_STATIC_DRAW);
+        free(pIndices);
+        m_uIndicesCapacity = m_uCapacity;
+    }
+
+#define kQuadSize sizeof(m_pQuads[0].bl)
+    glBindBuffer(GL_ARRAY_BUFFER, m_pBuffersVBO[0]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(m_pQuads[0]) * m_uTotalQuads, m_pQuads, GL_DYNAMIC_DRAW);
+
+    ccGLEnableVertexAttribs(kCCVertexAttribFlag_PosColorTex);
+
+    // vertices
+    glVertexAttribPointer(kCCVertexAttrib_Position, 3, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(ccV3F_C4B_T2F, vertices));
+
+    // colors
+    glVertexAttribPointer(kCCVertexAttrib_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE, kQuadSize, (GLvoid*) offsetof(ccV3F_C4B_T2F, colors));
+
+    // tex coords
+    glVertexAttribPointer(kCCVertexAttrib_TexCoords, 2, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(ccV3F_C4B_T2F, texCoords));
+
+    for (std::vector<ccAutoBatchRun>::iterator it = m_runs.begin(); it != m_runs.end(); ++it)
+    {
+        it->program->use();
+        it->program->setUniformsForBuiltins();
+        ccGLBlendFunc(it->blendFunc.src, it->blendFunc.dst);
+        ccGLBindTexture2D(it->texture);
+
+        glDrawElements(GL_TRIANGLES, (GLsizei) it->count*6, GL_UNSIGNED_SHORT, (GLvoid*) (it->start*6*sizeof(GLushort)));
+        CC_INCREMENT_GL_DRAWS(1);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    kmGLPopMatrix();
+
+    CHECK_GL_ERROR_DEBUG();
+
+    m_runs.clear();
+    m_uTotalQuads = 0;
+    m_bFlushing = false;
+
+    CC_PROFILER_STOP("CCAutoBatchRenderer - flush");
+}
+
+NS_CC_END
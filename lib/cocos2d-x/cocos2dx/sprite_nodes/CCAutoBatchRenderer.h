@@ -0,0 +1,119 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_AUTO_BATCH_RENDERER_H__
+#define __CC_AUTO_BATCH_RENDERER_H__
+
+#include "cocoa/CCObject.h"
+#include "ccTypes.h"
+#include "CCGL.h"
+#include <vector>
+
+NS_CC_BEGIN
+
+class CCGLProgram;
+
+/**
+ * @addtogroup sprite_nodes
+ * @{
+ */
+
+/** a run of queued quads drawn with the same texture, shader and blending */
+typedef struct _ccAutoBatchRun
+{
+    GLuint texture;
+    CCGLProgram* program;
+    ccBlendFunc blendFunc;
+    unsigned int start;
+    unsigned int count;
+} ccAutoBatchRun;
+
+/** CCAutoBatchRenderer
+ Merges the quads of sprites which are not children of a CCSpriteBatchNode into as few draw calls as possible.
+
+ When enabled, CCSprite::draw and the draw of small sprite batch nodes (CCLabelBMFont, CCScale9Sprite)
+ don't issue GL calls. They queue their quads, already transformed by the current model view matrix, tagged
+ with their texture, shader and blend function. Consecutive quads with the same tags are drawn with a single
+ glDrawElements when the queue is flushed, so the visit order is preserved.
+
+ The queue is flushed before any other shader is used (CCGLProgram::use), before the nodes that change
+ the GL state themselves (clipping, render textures, grids, scroll views) and at the end of the scene.
+
+ Limitations:
+  - the shaders see vertices in world space and an identity model view matrix.
+  - the shader uniforms are set once per run, sprites sharing a shader can't change its uniforms between them.
+ *@js NA
+ *@lua NA
+ */
+class CC_DLL CCAutoBatchRenderer : public CCObject
+{
+public:
+    static CCAutoBatchRenderer* sharedRenderer(void);
+    static void purgeSharedRenderer(void);
+
+    CCAutoBatchRenderer(void);
+    virtual ~CCAutoBatchRenderer(void);
+
+    /** Whether the sprites queue their quads. Default is false. */
+    inline bool isEnabled(void) { return m_bEnabled; }
+    void setEnabled(bool bEnabled);
+
+    /** Whether quads are waiting to be drawn */
+    inline bool hasPendingQuads(void) { return m_uTotalQuads > 0; }
+
+    /** Queues n quads given in the coordinates of the current model view matrix.
+     Quads with all their vertices at the same position (hidden sprites) are skipped.
+     */
+    void addQuads(const ccV3F_C4B_T2F_Quad* pQuads, unsigned int n, GLuint texture, CCGLProgram* pProgram, const ccBlendFunc& blendFunc);
+
+    /** Draws the queued quads */
+    void flush(void);
+
+    /** listen the event that coming to foreground on Android */
+    void listenBackToForeground(CCObject *obj);
+
+private:
+    void ensureCapacity(unsigned int capacity);
+    void setupVBO(void);
+
+private:
+    bool m_bEnabled;
+    bool m_bFlushing;
+
+    ccV3F_C4B_T2F_Quad* m_pQuads;
+    unsigned int m_uTotalQuads;
+    unsigned int m_uCapacity;
+    std::vector<ccAutoBatchRun> m_runs;
+
+    GLuint m_pBuffersVBO[2]; //0: vertex  1: indices
+    // quads the index buffer was built for
+    unsigned int m_uIndicesCapacity;
+};
+
+// end of sprite_nodes group
+/// @}
+
+NS_CC_END
+
+#endif // __CC_AUTO_BATCH_RENDERER_H__
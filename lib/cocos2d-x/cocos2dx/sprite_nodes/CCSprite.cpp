@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "CCSprite.h"
 #include "CCSpriteFrame.h"
 #include "CCSpriteFrameCache.h"
+#include "CCAutoBatchRenderer.h"
 #include "textures/CCTextureCache.h"
 #include "draw_nodes/CCDrawingPrimitives.h"
 #include "shaders/CCShaderCache.h"
@@ -297,6 +298,7 @@ CCSprite* CCSprite::initWithCGImage(CGImageRef pImage, const char *pszKey)
 
 CCSprite::CCSprite(void)
 : m_bShouldBeHidden(false),
+m_bQueuedInBatch(false),
 m_pobTexture(NULL)
 {
 }
@@ -453,6 +455,34 @@ void CCSprite::updateTransform(void)
 {
     CCAssert(m_pobBatchNode, "updateTransform is only valid when CCSprite is being rendered using an CCSpriteBatchNode");
 
+    updateDirtyQuad();
+
+    // MARMALADE CHANGED
+    // recursively iterate over children
+/*    if( m_bHasChildren ) 
+    {
+        // MARMALADE: CHANGED TO USE CCNode*
+        // NOTE THAT WE HAVE ALSO DEFINED virtual CCNode::updateTransform()
+        arrayMakeObjectsPerformSelector(m_pChildren, updateTransform, CCSprite*);
+    }*/
+    CCNode::updateTransform();
+
+#if CC_SPRITE_DEBUG_DRAW
+    // draw bounding box
+    CCPoint vertices[4] = {
+        ccp( m_sQuad.bl.vertices.x, m_sQuad.bl.vertices.y ),
+        ccp( m_sQuad.br.vertices.x, m_sQuad.br.vertices.y ),
+        ccp( m_sQuad.tr.vertices.x, m_sQuad.tr.vertices.y ),
+        ccp( m_sQuad.tl.vertices.x, m_sQuad.tl.vertices.y ),
+    };
+    ccDrawPoly(vertices, 4, true);
+#endif // CC_SPRITE_DEBUG_DRAW
+}
+
+void CCSprite::updateDirtyQuad(void)
+{
+    CCAssert(m_pobBatchNode, "updateDirtyQuad is only valid when CCSprite is being rendered using an CCSpriteBatchNode");
+
     // recalculate matrix only if it is dirty
     if( isDirty() ) {
 
@@ -521,37 +551,41 @@ void CCSprite::updateTransform(void)
         m_bRecursiveDirty = false;
         setDirty(false);
     }
+}
 
-    // MARMALADE CHANGED
-    // recursively iterate over children
-/*    if( m_bHasChildren ) 
+// draw
+
+CCRect CCSprite::getCullingBox(void)
+{
+    // sprites of a batch node are culled by the CCSpriteBatchNode
+    if (m_pobBatchNode)
     {
-        // MARMALADE: CHANGED TO USE CCNode*
-        // NOTE THAT WE HAVE ALSO DEFINED virtual CCNode::updateTransform()
-        arrayMakeObjectsPerformSelector(m_pChildren, updateTransform, CCSprite*);
-    }*/
-    CCNode::updateTransform();
+        return CCRectZero;
+    }
 
-#if CC_SPRITE_DEBUG_DRAW
-    // draw bounding box
-    CCPoint vertices[4] = {
-        ccp( m_sQuad.bl.vertices.x, m_sQuad.bl.vertices.y ),
-        ccp( m_sQuad.br.vertices.x, m_sQuad.br.vertices.y ),
-        ccp( m_sQuad.tr.vertices.x, m_sQuad.tr.vertices.y ),
-        ccp( m_sQuad.tl.vertices.x, m_sQuad.tl.vertices.y ),
-    };
-    ccDrawPoly(vertices, 4, true);
-#endif // CC_SPRITE_DEBUG_DRAW
+    float minX = MIN(MIN(m_sQuad.bl.vertices.x, m_sQuad.br.vertices.x), MIN(m_sQuad.tl.vertices.x, m_sQuad.tr.vertices.x));
+    float minY = MIN(MIN(m_sQuad.bl.vertices.y, m_sQuad.br.vertices.y), MIN(m_sQuad.tl.vertices.y, m_sQuad.tr.vertices.y));
+    float maxX = MAX(MAX(m_sQuad.bl.vertices.x, m_sQuad.br.vertices.x), MAX(m_sQuad.tl.vertices.x, m_sQuad.tr.vertices.x));
+    float maxY = MAX(MAX(m_sQuad.bl.vertices.y, m_sQuad.br.vertices.y), MAX(m_sQuad.tl.vertices.y, m_sQuad.tr.vertices.y));
+    return CCRectMake(minX, minY, maxX - minX, maxY - minY);
 }
 
-// draw
-
 void CCSprite::draw(void)
 {
     CC_PROFILER_START_CATEGORY(kCCProfilerCategorySprite, "CCSprite - draw");
 
     CCAssert(!m_pobBatchNode, "If CCSprite is being rendered by CCSpriteBatchNode, CCSprite#draw SHOULD NOT be called");
 
+    CCAutoBatchRenderer* pBatchRenderer = CCAutoBatchRenderer::sharedRenderer();
+    if (pBatchRenderer->isEnabled())
+    {
+        // drawn with the consecutive sprites sharing the same texture, shader and blending
+        pBatchRenderer->addQuads(&m_sQuad, 1, m_pobTexture->getName(), getShaderProgram(), m_sBlendFunc);
+
+        CC_PROFILER_STOP_CATEGORY(kCCProfilerCategorySprite, "CCSprite - draw");
+        return;
+    }
+
     CC_NODE_DRAW_SETUP();
 
     ccGLBlendFunc( m_sBlendFunc.src, m_sBlendFunc.dst );
@@ -698,24 +732,7 @@ void CCSprite::sortAllChildren()
 {
     if (m_bReorderChildDirty)
     {
-        int i = 0,j = 0,length = m_pChildren->data->num;
-        CCNode** x = (CCNode**)m_pChildren->data->arr;
-        CCNode *tempItem = NULL;
-
-        // insertion sort
-        for(i=1; i<length; i++)
-        {
-            tempItem = x[i];
-            j = i-1;
-
-            //continue moving element downwards while zOrder is smaller or when zOrder is the same but orderOfArrival is smaller
-            while(j>=0 && ( tempItem->getZOrder() < x[j]->getZOrder() || ( tempItem->getZOrder() == x[j]->getZOrder() && tempItem->getOrderOfArrival() < x[j]->getOrderOfArrival() ) ) )
-            {
-                x[j+1] = x[j];
-                j = j-1;
-            }
-            x[j+1] = tempItem;
-        }
+        sortChildrenByZOrder();
 
         if ( m_pobBatchNode)
         {
@@ -747,6 +764,18 @@ void CCSprite::setReorderChildDirtyRecursively(void)
 }
 
 
+void CCSprite::setDirty(bool bDirty)
+{
+    m_bDirty = bDirty;
+
+    // the batch node only rebuilds the quads of the sprites on its dirty list
+    if (bDirty && m_pobBatchNode && ! m_bQueuedInBatch)
+    {
+        m_bQueuedInBatch = true;
+        m_pobBatchNode->addDirtySprite(this);
+    }
+}
+
 void CCSprite::setDirtyRecursively(bool bValue)
 {
     m_bRecursiveDirty = bValue;
@@ -1023,6 +1052,11 @@ CCSpriteBatchNode* CCSprite::getBatchNode(void)
 
 void CCSprite::setBatchNode(CCSpriteBatchNode *pobSpriteBatchNode)
 {
+    if (m_pobBatchNode != pobSpriteBatchNode)
+    {
+        // the previous batch node skips the sprites it doesn't own anymore when it flushes its dirty list
+        m_bQueuedInBatch = false;
+    }
     m_pobBatchNode = pobSpriteBatchNode; // weak reference
 
     // self render
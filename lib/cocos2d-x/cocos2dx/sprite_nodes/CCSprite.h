@@ -84,6 +84,7 @@ class CC_DLL CCSprite : public CCNode, public CCTextureProtocol
 , public CCGLBufferedNode
 #endif // EMSCRIPTEN
 {
+    friend class CCSpriteBatchNode; // flushes the dirty list, see m_bQueuedInBatch
 public:
     /// @{
     /// @name Creators
@@ -301,6 +302,7 @@ public:
     virtual void ignoreAnchorPointForPosition(bool value);
     virtual void setVisible(bool bVisible);
     virtual void draw(void);
+    virtual CCRect getCullingBox(void);
     /// @}
     
     /// @{
@@ -321,6 +323,12 @@ public:
      * Updates the quad according the rotation, position, scale values. 
      */
     virtual void updateTransform(void);
+
+    /**
+     * Updates the quad of this sprite only if it is dirty, without visiting its children.
+     * CCSpriteBatchNode calls it on the sprites of its dirty list, the parent sprites first.
+     */
+    virtual void updateDirtyQuad(void);
     
     /**
      * Returns the batch node object if this sprite is rendered by CCSpriteBatchNode
@@ -416,8 +424,9 @@ public:
     
     /** 
      * Makes the Sprite to be updated in the Atlas.
+     * A dirty sprite queues itself on the dirty list of its batch node, so only its quad is rebuilt on the next draw.
      */
-    inline virtual void setDirty(bool bDirty) { m_bDirty = bDirty; }
+    virtual void setDirty(bool bDirty);
     
     /**
      * Returns the quad (tex coords, vertex coords and color) information.
@@ -520,6 +529,7 @@ protected:
     bool                m_bRecursiveDirty;      /// Whether all of the sprite's children needs to be updated
     bool                m_bHasChildren;         /// Whether the sprite contains children
     bool                m_bShouldBeHidden;      /// should not be drawn because one of the ancestors is not visible
+    bool                m_bQueuedInBatch;       /// Whether the sprite is on the dirty list of its batch node
     CCAffineTransform   m_transformToBatch;
     
     //
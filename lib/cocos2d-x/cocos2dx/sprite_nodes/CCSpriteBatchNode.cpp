@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "CCSpriteBatchNode.h"
 #include "ccConfig.h"
 #include "CCSprite.h"
+#include "CCAutoBatchRenderer.h"
 #include "effects/CCGrid.h"
 #include "draw_nodes/CCDrawingPrimitives.h"
 #include "textures/CCTextureCache.h"
@@ -94,6 +95,9 @@ bool CCSpriteBatchNode::initWithTexture(CCTexture2D *tex, unsigned int capacity)
     m_pobDescendants = new CCArray();
     m_pobDescendants->initWithCapacity(capacity);
 
+    m_pobDirtySprites = new CCArray();
+    m_pobDirtySprites->initWithCapacity(capacity);
+
     setShaderProgram(CCShaderCache::sharedShaderCache()->programForKey(kCCShader_PositionTextureColor));
     return true;
 }
@@ -117,6 +121,7 @@ bool CCSpriteBatchNode::initWithFile(const char* fileImage, unsigned int capacit
 CCSpriteBatchNode::CCSpriteBatchNode()
 : m_pobTextureAtlas(NULL)
 , m_pobDescendants(NULL)
+, m_pobDirtySprites(NULL)
 {
 }
 
@@ -124,6 +129,7 @@ CCSpriteBatchNode::~CCSpriteBatchNode()
 {
     CC_SAFE_RELEASE(m_pobTextureAtlas);
     CC_SAFE_RELEASE(m_pobDescendants);
+    CC_SAFE_RELEASE(m_pobDirtySprites);
 }
 
 // override visit
@@ -248,25 +254,7 @@ void CCSpriteBatchNode::sortAllChildren()
 {
     if (m_bReorderChildDirty)
     {
-        int i = 0,j = 0,length = m_pChildren->data->num;
-        CCNode ** x = (CCNode**)m_pChildren->data->arr;
-        CCNode *tempItem = NULL;
-
-        //insertion sort
-        for(i=1; i<length; i++)
-        {
-            tempItem = x[i];
-            j = i-1;
-
-            //continue moving element downwards while zOrder is smaller or when zOrder is the same but orderOfArrival is smaller
-            while(j>=0 && ( tempItem->getZOrder() < x[j]->getZOrder() || ( tempItem->getZOrder() == x[j]->getZOrder() && tempItem->getOrderOfArrival() < x[j]->getOrderOfArrival() ) ) )
-            {
-                x[j+1] = x[j];
-                j--;
-            }
-
-            x[j+1] = tempItem;
-        }
+        sortChildrenByZOrder();
 
         //sorted now check all children
         if (m_pChildren->count() > 0)
@@ -396,17 +384,149 @@ void CCSpriteBatchNode::draw(void)
         return;
     }
 
+    CCAutoBatchRenderer* pBatchRenderer = CCAutoBatchRenderer::sharedRenderer();
+    if (pBatchRenderer->isEnabled() && m_pobTextureAtlas->getTotalQuads() <= CC_AUTO_BATCH_MAX_NODE_QUADS)
+    {
+        // small batches (labels, scale9 sprites) are merged with the sprites drawn around them
+        updateDirtySprites();
+        pBatchRenderer->addQuads(m_pobTextureAtlas->getQuadsForReading(), m_pobTextureAtlas->getTotalQuads(),
+                                 m_pobTextureAtlas->getTexture()->getName(), getShaderProgram(), m_blendFunc);
+
+        CC_PROFILER_STOP("CCSpriteBatchNode - draw");
+        return;
+    }
+
     CC_NODE_DRAW_SETUP();
 
-    arrayMakeObjectsPerformSelector(m_pChildren, updateTransform, CCSprite*);
+    updateDirtySprites();
 
     ccGLBlendFunc( m_blendFunc.src, m_blendFunc.dst );
 
-    m_pobTextureAtlas->drawQuads();
+    if (CCDirector::sharedDirector()->isCullingEnabled())
+    {
+        drawVisibleQuads();
+    }
+    else
+    {
+        m_pobTextureAtlas->drawQuads();
+    }
 
     CC_PROFILER_STOP("CCSpriteBatchNode - draw");
 }
 
+void CCSpriteBatchNode::addDirtySprite(CCSprite *sprite)
+{
+    m_pobDirtySprites->addObject(sprite);
+}
+
+void CCSpriteBatchNode::updateDirtySprites(void)
+{
+#if CC_SPRITE_DEBUG_DRAW
+    // the bounding boxes are drawn by updateTransform, every frame
+    arrayMakeObjectsPerformSelector(m_pChildren, updateTransform, CCSprite*);
+#endif // CC_SPRITE_DEBUG_DRAW
+
+    if (m_pobDirtySprites->count() == 0)
+    {
+        return;
+    }
+
+    CCObject* pObject = NULL;
+    CCARRAY_FOREACH(m_pobDirtySprites, pObject)
+    {
+        CCSprite* pSprite = (CCSprite*)pObject;
+        // removed from this batch node, or moved to another one, since it was queued
+        if (pSprite->getBatchNode() != this)
+        {
+            continue;
+        }
+        pSprite->m_bQueuedInBatch = false;
+        updateDirtySprite(pSprite);
+    }
+    m_pobDirtySprites->removeAllObjects();
+}
+
+void CCSpriteBatchNode::updateDirtySprite(CCSprite* sprite)
+{
+    if (! sprite->isDirty())
+    {
+        return;
+    }
+
+    // the transform of a child is relative to its parent, so the dirty parents are updated first
+    CCNode* pParent = sprite->getParent();
+    if (pParent && pParent != this)
+    {
+        updateDirtySprite((CCSprite*)pParent);
+    }
+
+    // only the quads of these sprites are updated, and so uploaded by the texture atlas
+    sprite->updateDirtyQuad();
+}
+
+// culled runs shorter than this are drawn anyway, a draw call costs more than a few hidden quads
+#define CC_BATCH_CULLING_MIN_GAP 16
+
+void CCSpriteBatchNode::drawVisibleQuads(void)
+{
+    const CCRect& cullingRect = CCDirector::sharedDirector()->getCullingRect();
+    CCAffineTransform t = nodeToWorldTransform();
+    const ccV3F_C4B_T2F_Quad* quads = m_pobTextureAtlas->getQuadsForReading();
+    unsigned int total = m_pobTextureAtlas->getTotalQuads();
+    unsigned int culled = 0;
+    // culled quads since the pending run, they are drawn if the gap is short
+    unsigned int gapCulled = 0;
+
+    // [runStart, runEnd) is the pending run of visible quads
+    unsigned int runStart = 0;
+    unsigned int runEnd = 0;
+    bool hasRun = false;
+
+    for (unsigned int i = 0; i < total; i++)
+    {
+        const ccV3F_C4B_T2F_Quad& quad = quads[i];
+        float minX = MIN(MIN(quad.bl.vertices.x, quad.br.vertices.x), MIN(quad.tl.vertices.x, quad.tr.vertices.x));
+        float minY = MIN(MIN(quad.bl.vertices.y, quad.br.vertices.y), MIN(quad.tl.vertices.y, quad.tr.vertices.y));
+        float maxX = MAX(MAX(quad.bl.vertices.x, quad.br.vertices.x), MAX(quad.tl.vertices.x, quad.tr.vertices.x));
+        float maxY = MAX(MAX(quad.bl.vertices.y, quad.br.vertices.y), MAX(quad.tl.vertices.y, quad.tr.vertices.y));
+
+        // hidden sprites have all their vertices at 0, they draw nothing
+        if (minX == maxX && minY == maxY)
+        {
+            continue;
+        }
+
+        CCRect box = CCRectApplyAffineTransform(CCRectMake(minX, minY, maxX - minX, maxY - minY), t);
+        if (! box.intersectsRect(cullingRect))
+        {
+            gapCulled++;
+            continue;
+        }
+
+        if (! hasRun)
+        {
+            runStart = i;
+            hasRun = true;
+            culled += gapCulled;
+        }
+        else if (i - runEnd >= CC_BATCH_CULLING_MIN_GAP)
+        {
+            m_pobTextureAtlas->drawNumberOfQuads(runEnd - runStart, runStart);
+            runStart = i;
+            culled += gapCulled;
+        }
+        gapCulled = 0;
+        runEnd = i + 1;
+    }
+
+    if (hasRun)
+    {
+        m_pobTextureAtlas->drawNumberOfQuads(runEnd - runStart, runStart);
+    }
+
+    CC_INCREMENT_CULLED_NODES(culled + gapCulled);
+}
+
 void CCSpriteBatchNode::increaseAtlasCapacity(void)
 {
     // if we're going beyond the current TextureAtlas's capacity,
@@ -762,10 +882,12 @@ CCSpriteBatchNode * CCSpriteBatchNode::addSpriteWithoutQuad(CCSprite*child, unsi
     CCARRAY_FOREACH(m_pobDescendants, pObject)
     {
         CCSprite* pChild = (CCSprite*) pObject;
+        // the descendants are kept in the order of their quads, removeSpriteFromAtlas relies on it
         if (pChild && (pChild->getAtlasIndex() >= z))
         {
-            ++i;
+            break;
         }
+        ++i;
     }
     
     m_pobDescendants->insertObject(child, i);
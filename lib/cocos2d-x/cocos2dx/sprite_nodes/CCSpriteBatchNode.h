@@ -134,6 +134,8 @@ public:
     unsigned int atlasIndexForChild(CCSprite *sprite, int z);
     /* Sprites use this to start sortChildren, don't call this manually */
     void reorderBatch(bool reorder);
+    /* Dirty sprites use this to get their quad rebuilt on the next draw, don't call this manually */
+    void addDirtySprite(CCSprite *sprite);
     // CCTextureProtocol
     virtual CCTexture2D* getTexture(void);
     virtual void setTexture(CCTexture2D *texture);
@@ -155,6 +157,10 @@ public:
     virtual void draw(void);
 
 protected:
+    /** Draws the quads intersecting the culling rect of CCDirector, used when the culling is enabled */
+    void drawVisibleQuads(void);
+    /** Rebuilds the quads of the sprites on the dirty list, instead of visiting all the descendants */
+    void updateDirtySprites(void);
     /** Inserts a quad at a certain index into the texture atlas. The CCSprite won't be added into the children array.
      This method should be called only when you are dealing with very big AtlasSrite and when most of the CCSprite won't be updated.
      For example: a tile map (CCTMXMap) or a label with lots of characters (CCLabelBMFont)
@@ -174,6 +180,7 @@ private:
     void updateAtlasIndex(CCSprite* sprite, int* curIndex);
     void swap(int oldIndex, int newIndex);
     void updateBlendFunc();
+    void updateDirtySprite(CCSprite* sprite);
 
 protected:
     CCTextureAtlas *m_pobTextureAtlas;
@@ -181,6 +188,9 @@ protected:
 
     // all descendants: children, gran children, etc...
     CCArray* m_pobDescendants;
+
+    // sprites whose quad must be rebuilt before the next draw (retained)
+    CCArray* m_pobDirtySprites;
 };
 
 // end of sprite_nodes group
@@ -0,0 +1,149 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CCGLRecorder.h"
+#include "platform/CCCommon.h"
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+NS_CC_BEGIN
+
+static CCGLRecorder* s_pSharedRecorder = NULL;
+
+CCGLRecorder* CCGLRecorder::sharedRecorder(void)
+{
+    if (! s_pSharedRecorder)
+    {
+        s_pSharedRecorder = new CCGLRecorder();
+    }
+    return s_pSharedRecorder;
+}
+
+void CCGLRecorder::purgeSharedRecorder(void)
+{
+    CC_SAFE_DELETE(s_pSharedRecorder);
+}
+
+CCGLRecorder::CCGLRecorder(void)
+: m_bActive(false)
+{
+    reset();
+}
+
+void CCGLRecorder::reset(void)
+{
+    m_ePendingError = GL_NO_ERROR;
+    memset(&m_tFrame, 0, sizeof(m_tFrame));
+    memset(&m_tLastFrame, 0, sizeof(m_tLastFrame));
+    memset(&m_tTotal, 0, sizeof(m_tTotal));
+    m_callCounts.clear();
+}
+
+unsigned int CCGLRecorder::getCallCount(const char* pszFunction)
+{
+    // keys are literals, different copies of the same name must still match
+    unsigned int count = 0;
+    for (map<const char*, unsigned int>::iterator it = m_callCounts.begin(); it != m_callCounts.end(); ++it)
+    {
+        if (0 == strcmp(it->first, pszFunction))
+        {
+            count += it->second;
+        }
+    }
+    return count;
+}
+
+void CCGLRecorder::endFrame(void)
+{
+    m_tTotal.calls              += m_tFrame.calls;
+    m_tTotal.drawCalls          += m_tFrame.drawCalls;
+    m_tTotal.vertices           += m_tFrame.vertices;
+    m_tTotal.bufferUploads      += m_tFrame.bufferUploads;
+    m_tTotal.bufferUploadBytes  += m_tFrame.bufferUploadBytes;
+    m_tTotal.textureUploads     += m_tFrame.textureUploads;
+    m_tTotal.textureUploadBytes += m_tFrame.textureUploadBytes;
+    m_tTotal.textureBinds       += m_tFrame.textureBinds;
+    m_tTotal.programBinds       += m_tFrame.programBinds;
+    m_tTotal.uniformUpdates     += m_tFrame.uniformUpdates;
+    m_tTotal.stateChanges       += m_tFrame.stateChanges;
+    m_tTotal.errors             += m_tFrame.errors;
+
+    m_tLastFrame = m_tFrame;
+    memset(&m_tFrame, 0, sizeof(m_tFrame));
+}
+
+void CCGLRecorder::recordError(GLenum error, const char* pszFunction, const char* pszReason)
+{
+    ++m_tFrame.errors;
+    if (m_ePendingError == GL_NO_ERROR)
+    {
+        m_ePendingError = error;
+    }
+    CCLOG("cocos2d: GL validation error 0x%04x in %s: %s", error, pszFunction, pszReason);
+}
+
+GLenum CCGLRecorder::popError(void)
+{
+    GLenum error = m_ePendingError;
+    m_ePendingError = GL_NO_ERROR;
+    return error;
+}
+
+static void logStats(const char* pszTitle, const ccGLFrameStats& stats)
+{
+    CCLog("%s: calls %u, draws %u, vertices %u, buffer uploads %u (%u bytes), texture uploads %u (%u bytes), "
+          "texture binds %u, program binds %u, uniforms %u, state changes %u, errors %u",
+          pszTitle, stats.calls, stats.drawCalls, stats.vertices,
+          stats.bufferUploads, stats.bufferUploadBytes, stats.textureUploads, stats.textureUploadBytes,
+          stats.textureBinds, stats.programBinds, stats.uniformUpdates, stats.stateChanges, stats.errors);
+}
+
+static bool compareCallCount(const pair<const char*, unsigned int>& a, const pair<const char*, unsigned int>& b)
+{
+    return a.second > b.second;
+}
+
+void CCGLRecorder::dumpStats(void)
+{
+    if (! m_bActive)
+    {
+        CCLog("cocos2d: GL recorder inactive, the GL backend doesn't record calls");
+        return;
+    }
+
+    logStats("cocos2d: GL last frame", m_tLastFrame);
+    logStats("cocos2d: GL total", m_tTotal);
+
+    vector<pair<const char*, unsigned int> > counts(m_callCounts.begin(), m_callCounts.end());
+    sort(counts.begin(), counts.end(), compareCallCount);
+    for (vector<pair<const char*, unsigned int> >::iterator it = counts.begin(); it != counts.end(); ++it)
+    {
+        CCLog("\t%-32s %u", it->first, it->second);
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,132 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __SUPPORT_CCGLRECORDER_H__
+#define __SUPPORT_CCGLRECORDER_H__
+
+#include "platform/CCPlatformMacros.h"
+#include "CCGL.h"
+#include <map>
+#include <string>
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup global
+ * @{
+ */
+
+/** GL work issued during one frame */
+typedef struct _ccGLFrameStats
+{
+    unsigned int calls;               ///< every GL entry point
+    unsigned int drawCalls;           ///< glDrawArrays/glDrawElements
+    unsigned int vertices;            ///< vertices (or indices) submitted by the draw calls
+    unsigned int bufferUploads;       ///< glBufferData/glBufferSubData
+    unsigned int bufferUploadBytes;
+    unsigned int textureUploads;      ///< glTexImage2D/glTexSubImage2D and the compressed variants
+    unsigned int textureUploadBytes;
+    unsigned int textureBinds;
+    unsigned int programBinds;
+    unsigned int uniformUpdates;
+    unsigned int stateChanges;        ///< capabilities, blending, masks, viewport, framebuffer binds
+    unsigned int errors;              ///< calls that failed validation
+} ccGLFrameStats;
+
+/** CCGLRecorder
+ Collects the GL calls issued by the renderer.
+
+ The recorder is fed by a recording GL backend, currently the null GL of the
+ headless linux platform (CC_HEADLESS_NULL_GL=1), which validates each call
+ instead of executing it. On other backends isActive() is false and all
+ counters stay 0.
+
+ CCDirector closes a frame after swapping buffers, so in automated tests
+ getLastFrameStats().drawCalls is the number of draw calls of the last
+ rendered frame.
+ *@js NA
+ *@lua NA
+ */
+class CC_DLL CCGLRecorder
+{
+public:
+    static CCGLRecorder* sharedRecorder(void);
+    static void purgeSharedRecorder(void);
+
+    /** whether a recording GL backend feeds this recorder */
+    inline bool isActive(void) { return m_bActive; }
+    inline void setActive(bool bActive) { m_bActive = bActive; }
+
+    /** counters of the frame being rendered */
+    inline const ccGLFrameStats& getFrameStats(void) { return m_tFrame; }
+    /** counters of the last completed frame */
+    inline const ccGLFrameStats& getLastFrameStats(void) { return m_tLastFrame; }
+    /** counters since the recorder was created or reset */
+    inline const ccGLFrameStats& getTotalStats(void) { return m_tTotal; }
+    /** number of times the named entry point was called since the last reset, e.g. "glBindTexture" */
+    unsigned int getCallCount(const char* pszFunction);
+
+    /** closes the current frame, called by CCDirector every frame */
+    void endFrame(void);
+    /** clears all counters */
+    void reset(void);
+    /** logs the last frame counters, the totals and the per entry point call counts */
+    void dumpStats(void);
+
+    // recording interface of the GL backend
+    inline void recordCall(const char* pszFunction)
+    {
+        ++m_tFrame.calls;
+        ++m_callCounts[pszFunction];
+    }
+    inline void recordDraw(unsigned int uVertices) { ++m_tFrame.drawCalls; m_tFrame.vertices += uVertices; }
+    inline void recordBufferUpload(unsigned int uBytes) { ++m_tFrame.bufferUploads; m_tFrame.bufferUploadBytes += uBytes; }
+    inline void recordTextureUpload(unsigned int uBytes) { ++m_tFrame.textureUploads; m_tFrame.textureUploadBytes += uBytes; }
+    inline void recordTextureBind(void) { ++m_tFrame.textureBinds; }
+    inline void recordProgramBind(void) { ++m_tFrame.programBinds; }
+    inline void recordUniformUpdate(void) { ++m_tFrame.uniformUpdates; }
+    inline void recordStateChange(void) { ++m_tFrame.stateChanges; }
+    /** records a failed validation; like GL, the first error is kept until popError() */
+    void recordError(GLenum error, const char* pszFunction, const char* pszReason);
+    /** returns and clears the pending error, what glGetError() answers */
+    GLenum popError(void);
+
+private:
+    CCGLRecorder(void);
+
+    bool m_bActive;
+    GLenum m_ePendingError;
+    ccGLFrameStats m_tFrame;
+    ccGLFrameStats m_tLastFrame;
+    ccGLFrameStats m_tTotal;
+    // keyed by the entry point name literal
+    std::map<const char*, unsigned int> m_callCounts;
+};
+
+// end of global group
+/// @}
+
+NS_CC_END
+
+#endif // __SUPPORT_CCGLRECORDER_H__
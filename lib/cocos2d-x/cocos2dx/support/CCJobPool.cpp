@@ -0,0 +1,256 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CCJobPool.h"
+#include "platform/CCThread.h"
+#include "ccMacros.h"
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#include <windows.h>
+#elif (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
+#include <unistd.h>
+#endif
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8) && !defined(EMSCRIPTEN)
+#include <pthread.h>
+#define CC_JOB_POOL_USE_THREADS 1
+#endif
+
+NS_CC_BEGIN
+
+static CCJobPool* s_pSharedJobPool = NULL;
+
+#ifdef CC_JOB_POOL_USE_THREADS
+
+static pthread_t*       s_pThreads = NULL;
+static unsigned int     s_uStartedThreads = 0;
+
+// guards the jobs below, the threads sleep on s_jobsCondition until there are jobs to run
+static pthread_mutex_t  s_jobsMutex;
+static pthread_cond_t   s_jobsCondition;
+static pthread_cond_t   s_doneCondition;
+static bool             s_bQuit = false;
+
+static CC_JOB_FUNCTION  s_pfnJob = NULL;
+static void**           s_ppJobData = NULL;
+static unsigned int     s_uJobCount = 0;
+static unsigned int     s_uNextJob = 0;
+static unsigned int     s_uDoneJobs = 0;
+
+// runs the jobs left, s_jobsMutex must be locked
+static void runJobsLeft(void)
+{
+    while (s_uNextJob < s_uJobCount)
+    {
+        unsigned int index = s_uNextJob++;
+        CC_JOB_FUNCTION pfnJob = s_pfnJob;
+        void* pData = s_ppJobData[index];
+        pthread_mutex_unlock(&s_jobsMutex);
+
+        pfnJob(pData);
+
+        pthread_mutex_lock(&s_jobsMutex);
+        if (++s_uDoneJobs == s_uJobCount)
+        {
+            pthread_cond_signal(&s_doneCondition);
+        }
+    }
+}
+
+static void* runJobsThread(void* data)
+{
+    CC_UNUSED_PARAM(data);
+
+    // create autorelease pool for iOS
+    CCThread thread;
+    thread.createAutoreleasePool();
+
+    pthread_mutex_lock(&s_jobsMutex);
+    while (! s_bQuit)
+    {
+        if (s_uNextJob >= s_uJobCount)
+        {
+            pthread_cond_wait(&s_jobsCondition, &s_jobsMutex);
+            continue;
+        }
+        runJobsLeft();
+    }
+    pthread_mutex_unlock(&s_jobsMutex);
+
+    return 0;
+}
+
+#endif // CC_JOB_POOL_USE_THREADS
+
+CCJobPool::CCJobPool(void)
+: m_uThreadCount(CC_JOB_POOL_THREADS)
+{
+}
+
+CCJobPool::~CCJobPool(void)
+{
+    stopThreads();
+}
+
+CCJobPool* CCJobPool::sharedJobPool(void)
+{
+    if (! s_pSharedJobPool)
+    {
+        s_pSharedJobPool = new CCJobPool();
+    }
+    return s_pSharedJobPool;
+}
+
+void CCJobPool::purgeSharedJobPool(void)
+{
+    CC_SAFE_RELEASE_NULL(s_pSharedJobPool);
+}
+
+unsigned int CCJobPool::getProcessorCount(void)
+{
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#elif (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (unsigned int)count : 1;
+#else
+    return 1;
+#endif
+}
+
+void CCJobPool::setThreadCount(unsigned int uCount)
+{
+    if (m_uThreadCount != uCount)
+    {
+        // the threads are started again with the new count by the next runJobs
+        stopThreads();
+        m_uThreadCount = uCount;
+    }
+}
+
+unsigned int CCJobPool::getThreadCount(void)
+{
+    return m_uThreadCount > 0 ? m_uThreadCount : getProcessorCount();
+}
+
+void CCJobPool::startThreads(void)
+{
+#ifdef CC_JOB_POOL_USE_THREADS
+    if (s_pThreads)
+    {
+        return;
+    }
+
+    pthread_mutex_init(&s_jobsMutex, NULL);
+    pthread_cond_init(&s_jobsCondition, NULL);
+    pthread_cond_init(&s_doneCondition, NULL);
+    s_bQuit = false;
+
+    // the calling thread of runJobs is one of them
+    unsigned int threadCount = getThreadCount() - 1;
+    s_pThreads = new pthread_t[threadCount > 0 ? threadCount : 1];
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        if (pthread_create(&s_pThreads[s_uStartedThreads], NULL, runJobsThread, NULL) == 0)
+        {
+            ++s_uStartedThreads;
+        }
+    }
+    CCLOG("cocos2d: CCJobPool: %u threads running the jobs", s_uStartedThreads + 1);
+#endif
+}
+
+void CCJobPool::stopThreads(void)
+{
+#ifdef CC_JOB_POOL_USE_THREADS
+    if (! s_pThreads)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s_jobsMutex);
+    s_bQuit = true;
+    pthread_cond_broadcast(&s_jobsCondition);
+    pthread_mutex_unlock(&s_jobsMutex);
+
+    for (unsigned int i = 0; i < s_uStartedThreads; ++i)
+    {
+        pthread_join(s_pThreads[i], NULL);
+    }
+    CC_SAFE_DELETE_ARRAY(s_pThreads);
+    s_uStartedThreads = 0;
+
+    pthread_mutex_destroy(&s_jobsMutex);
+    pthread_cond_destroy(&s_jobsCondition);
+    pthread_cond_destroy(&s_doneCondition);
+#endif
+}
+
+void CCJobPool::runJobs(CC_JOB_FUNCTION pfnJob, void** ppData, unsigned int uCount)
+{
+    if (uCount == 0)
+    {
+        return;
+    }
+
+#ifdef CC_JOB_POOL_USE_THREADS
+    if (uCount > 1 && getThreadCount() > 1)
+    {
+        startThreads();
+    }
+    if (uCount > 1 && s_uStartedThreads > 0)
+    {
+        pthread_mutex_lock(&s_jobsMutex);
+        CCAssert(s_uJobCount == 0, "CCJobPool: runJobs can't be called by a job");
+        s_pfnJob = pfnJob;
+        s_ppJobData = ppData;
+        s_uJobCount = uCount;
+        s_uNextJob = 0;
+        s_uDoneJobs = 0;
+        pthread_cond_broadcast(&s_jobsCondition);
+
+        runJobsLeft();
+        while (s_uDoneJobs < s_uJobCount)
+        {
+            pthread_cond_wait(&s_doneCondition, &s_jobsMutex);
+        }
+
+        s_uJobCount = 0;
+        s_uNextJob = 0;
+        s_pfnJob = NULL;
+        s_ppJobData = NULL;
+        pthread_mutex_unlock(&s_jobsMutex);
+        return;
+    }
+#endif
+
+    for (unsigned int i = 0; i < uCount; ++i)
+    {
+        pfnJob(ppData[i]);
+    }
+}
+
+NS_CC_END
@@ -0,0 +1,89 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __SUPPORT_CCJOBPOOL_H__
+#define __SUPPORT_CCJOBPOOL_H__
+
+#include "ccConfig.h"
+#include "cocoa/CCObject.h"
+#include "platform/platform.h"
+
+NS_CC_BEGIN
+
+/**
+ * @addtogroup global
+ * @{
+ */
+
+/** function run by a job of CCJobPool::runJobs, with the data of the job */
+typedef void (*CC_JOB_FUNCTION)(void* pData);
+
+/** @brief A pool of threads running jobs in parallel.
+
+ runJobs hands a list of jobs to the threads of the pool, runs some of them on the calling thread too,
+ and returns once all of them are done. The jobs only work on their own data: they must not touch
+ the node tree, the autorelease pool nor OpenGL, which belong to the main thread.
+ The threads are started on the first runJobs and sleep between the calls.
+ *@js NA
+ *@lua NA
+ */
+class CC_DLL CCJobPool : public CCObject
+{
+public:
+    ~CCJobPool(void);
+
+    /** returns the shared job pool */
+    static CCJobPool* sharedJobPool(void);
+    /** stops the threads and releases the shared job pool */
+    static void purgeSharedJobPool(void);
+
+    /** number of processor cores of the device */
+    static unsigned int getProcessorCount(void);
+
+    /** Number of threads running the jobs, the calling thread of runJobs included.
+     0 runs one thread per processor core, 1 runs the jobs on the calling thread only.
+     Defaults to CC_JOB_POOL_THREADS. It can't be changed by a job.
+     */
+    void setThreadCount(unsigned int uCount);
+    unsigned int getThreadCount(void);
+
+    /** Runs pfnJob(ppData[i]) for the uCount jobs, in any order and on any thread of the pool,
+     and returns when they are all done. It must not be called by a job.
+     */
+    void runJobs(CC_JOB_FUNCTION pfnJob, void** ppData, unsigned int uCount);
+
+private:
+    CCJobPool(void);
+    void startThreads(void);
+    void stopThreads(void);
+
+    unsigned int m_uThreadCount;
+};
+
+// end of global group
+/// @}
+
+NS_CC_END
+
+#endif // __SUPPORT_CCJOBPOOL_H__
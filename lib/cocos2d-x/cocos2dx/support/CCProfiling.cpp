@@ -23,6 +23,27 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
 #include "CCProfiling.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
+#include <pthread.h>
+#else
+#include "CCPThreadWinRT.h"
+#endif
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
+#include <mach/mach_time.h>
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_WINRT) || (CC_TARGET_PLATFORM == CC_PLATFORM_WP8)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 
 using namespace std;
 
@@ -34,6 +55,291 @@ bool kCCProfilerCategorySprite = false;
 bool kCCProfilerCategoryBatchSprite = false;
 bool kCCProfilerCategoryParticles = false;
 
+// zones nested deeper are timed by nobody but still balanced
+#define kCCProfilerMaxDepth     64
+// threads recording at the same time, the slots of exited threads are reused
+#define kCCProfilerMaxThreads   32
+
+typedef struct _ccProfilerEvent
+{
+    const ccProfilerZone*   zone;
+    unsigned long long      begin;
+    unsigned long long      end;
+    unsigned int            depth;
+} ccProfilerEvent;
+
+typedef struct _ccProfilerThread
+{
+    unsigned int            index;
+    bool                    active;
+    // guards the ring against the dumps made from another thread
+    pthread_mutex_t         lock;
+    ccProfilerEvent*        events;
+    unsigned int            next;
+    unsigned int            count;
+    // zones entered and not left yet
+    const ccProfilerZone*   stackZones[kCCProfilerMaxDepth];
+    unsigned long long      stackBegins[kCCProfilerMaxDepth];
+    unsigned int            depth;
+} ccProfilerThread;
+
+static bool                 s_bEnabled = true;
+static unsigned long long   s_uEpoch = 0;
+
+static pthread_once_t       s_threadKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t        s_threadKey;
+static pthread_mutex_t      s_threadsMutex = PTHREAD_MUTEX_INITIALIZER;
+static ccProfilerThread*    s_pThreads[kCCProfilerMaxThreads];
+static unsigned int         s_uThreadCount = 0;
+// marks the threads started once every slot was taken
+static ccProfilerThread     s_noThread;
+
+// guarded by s_threadsMutex
+static map<string, ccProfilerZone>*         s_pNamedZones = NULL;
+static map<string, unsigned long long>*     s_pResetTimes = NULL;
+
+static void threadExited(void* pThread)
+{
+    ccProfilerThread* thread = (ccProfilerThread*)pThread;
+    if (thread != &s_noThread)
+    {
+        // the events stay available to the dumps until the slot is reused
+        pthread_mutex_lock(&s_threadsMutex);
+        thread->active = false;
+        pthread_mutex_unlock(&s_threadsMutex);
+    }
+}
+
+static void createThreadKey(void)
+{
+    pthread_key_create(&s_threadKey, threadExited);
+}
+
+static ccProfilerThread* registerThread(void)
+{
+    ccProfilerThread* thread = NULL;
+
+    pthread_mutex_lock(&s_threadsMutex);
+    if (s_uEpoch == 0)
+    {
+        s_uEpoch = CCProfiler::now();
+    }
+    if (s_uThreadCount < kCCProfilerMaxThreads)
+    {
+        thread = new ccProfilerThread();
+        thread->index = s_uThreadCount;
+        thread->events = (ccProfilerEvent*)malloc(sizeof(ccProfilerEvent) * CC_PROFILER_EVENTS_PER_THREAD);
+        pthread_mutex_init(&thread->lock, NULL);
+        s_pThreads[s_uThreadCount++] = thread;
+    }
+    else
+    {
+        for (unsigned int i = 0; i < s_uThreadCount; ++i)
+        {
+            if (! s_pThreads[i]->active)
+            {
+                thread = s_pThreads[i];
+                break;
+            }
+        }
+    }
+
+    if (thread)
+    {
+        pthread_mutex_lock(&thread->lock);
+        thread->active = true;
+        thread->next = 0;
+        thread->count = 0;
+        thread->depth = 0;
+        pthread_mutex_unlock(&thread->lock);
+    }
+    else
+    {
+        CCLOG("cocos2d: CCProfiler: too many threads, the new ones are not recorded");
+        thread = &s_noThread;
+    }
+    pthread_mutex_unlock(&s_threadsMutex);
+
+    pthread_setspecific(s_threadKey, thread);
+    return thread;
+}
+
+static inline ccProfilerThread* currentThread(void)
+{
+    pthread_once(&s_threadKeyOnce, createThreadKey);
+    ccProfilerThread* thread = (ccProfilerThread*)pthread_getspecific(s_threadKey);
+    if (! thread)
+    {
+        thread = registerThread();
+    }
+    return thread == &s_noThread ? NULL : thread;
+}
+
+static inline bool isZoneNamed(const ccProfilerZone* pZone, const char* name)
+{
+    return pZone->name == name || strcmp(pZone->name, name) == 0;
+}
+
+void CCProfilerBeginZone(const ccProfilerZone* pZone)
+{
+    if (! s_bEnabled)
+    {
+        return;
+    }
+
+    ccProfilerThread* thread = currentThread();
+    if (! thread)
+    {
+        return;
+    }
+
+    unsigned int depth = thread->depth++;
+    if (depth < kCCProfilerMaxDepth)
+    {
+        thread->stackZones[depth] = pZone;
+        // must the be last thing to execute
+        thread->stackBegins[depth] = CCProfiler::now();
+    }
+}
+
+void CCProfilerEndZone(const char* timerName)
+{
+    // must the be 1st thing to execute
+    unsigned long long end = CCProfiler::now();
+
+    // threads which never began a zone are not registered here
+    pthread_once(&s_threadKeyOnce, createThreadKey);
+    ccProfilerThread* thread = (ccProfilerThread*)pthread_getspecific(s_threadKey);
+    if (! thread || thread == &s_noThread || thread->depth == 0)
+    {
+        return;
+    }
+
+    if (thread->depth > kCCProfilerMaxDepth)
+    {
+        --thread->depth;
+        return;
+    }
+
+    // zones started while the profiler was disabled have nothing to close
+    unsigned int level = thread->depth;
+    while (level > 0 && ! isZoneNamed(thread->stackZones[level - 1], timerName))
+    {
+        --level;
+    }
+    if (level == 0)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&thread->lock);
+    while (thread->depth >= level)
+    {
+        unsigned int depth = --thread->depth;
+        ccProfilerEvent* event = thread->events + thread->next;
+        event->zone = thread->stackZones[depth];
+        event->begin = thread->stackBegins[depth];
+        event->end = end;
+        event->depth = depth;
+
+        if (++thread->next == CC_PROFILER_EVENTS_PER_THREAD)
+        {
+            thread->next = 0;
+        }
+        if (thread->count < CC_PROFILER_EVENTS_PER_THREAD)
+        {
+            ++thread->count;
+        }
+    }
+    pthread_mutex_unlock(&thread->lock);
+}
+
+CCProfilerScope::CCProfilerScope(const ccProfilerZone* pZone)
+: m_pZone(pZone)
+{
+    CCProfilerBeginZone(pZone);
+}
+
+CCProfilerScope::~CCProfilerScope(void)
+{
+    CCProfilerEndZone(m_pZone->name);
+}
+
+// copies the recorded events of every thread, in the order they ended,
+// leaving out the zones reset after they began
+static void collectEvents(vector<ccProfilerEvent>& events, vector<unsigned int>& threadIndices)
+{
+    pthread_mutex_lock(&s_threadsMutex);
+    for (unsigned int i = 0; i < s_uThreadCount; ++i)
+    {
+        ccProfilerThread* thread = s_pThreads[i];
+        pthread_mutex_lock(&thread->lock);
+        unsigned int index = (thread->next + CC_PROFILER_EVENTS_PER_THREAD - thread->count) % CC_PROFILER_EVENTS_PER_THREAD;
+        for (unsigned int n = 0; n < thread->count; ++n)
+        {
+            const ccProfilerEvent& event = thread->events[index];
+            if (++index == CC_PROFILER_EVENTS_PER_THREAD)
+            {
+                index = 0;
+            }
+
+            if (s_pResetTimes)
+            {
+                map<string, unsigned long long>::iterator it = s_pResetTimes->find(event.zone->name);
+                if (it != s_pResetTimes->end() && event.begin < it->second)
+                {
+                    continue;
+                }
+            }
+            events.push_back(event);
+            threadIndices.push_back(thread->index);
+        }
+        pthread_mutex_unlock(&thread->lock);
+    }
+    pthread_mutex_unlock(&s_threadsMutex);
+}
+
+static void writeJSONString(FILE* fp, const char* str)
+{
+    fputc('"', fp);
+    for (const char* p = str ? str : ""; *p; ++p)
+    {
+        unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\')
+        {
+            fputc('\\', fp);
+            fputc(c, fp);
+        }
+        else if (c < 0x20)
+        {
+            fprintf(fp, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+typedef struct _ccProfilerSummary
+{
+    string                      name;
+    vector<unsigned long long>  durations;
+    unsigned long long          total;
+    unsigned long long          self;
+} ccProfilerSummary;
+
+static bool compareSummaryByTotal(const ccProfilerSummary* a, const ccProfilerSummary* b)
+{
+    return a->total > b->total;
+}
+
+static inline double percentile(const vector<unsigned long long>& sorted, unsigned int percent)
+{
+    size_t index = (sorted.size() - 1) * percent / 100;
+    return sorted[index] / 1000.0;
+}
 
 static CCProfiler* g_sSharedProfiler = NULL;
 
@@ -48,132 +354,210 @@ CCProfiler* CCProfiler::sharedProfiler(void)
     return g_sSharedProfiler;
 }
 
-CCProfilingTimer* CCProfiler::createAndAddTimerWithName(const char* timerName)
+unsigned long long CCProfiler::now(void)
 {
-    CCProfilingTimer *t = new CCProfilingTimer();
-    t->initWithName(timerName);
-    m_pActiveTimers->setObject(t, timerName);
-    t->release();
-
-    return t;
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS) || (CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
+    static mach_timebase_info_data_t s_timebase = { 0, 0 };
+    if (s_timebase.denom == 0)
+    {
+        mach_timebase_info(&s_timebase);
+    }
+    return mach_absolute_time() * s_timebase.numer / s_timebase.denom;
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_WINRT) || (CC_TARGET_PLATFORM == CC_PLATFORM_WP8)
+    static LARGE_INTEGER s_frequency = { 0 };
+    if (s_frequency.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&s_frequency);
+    }
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    unsigned long long seconds = counter.QuadPart / s_frequency.QuadPart;
+    unsigned long long remainder = counter.QuadPart % s_frequency.QuadPart;
+    return seconds * 1000000000ULL + remainder * 1000000000ULL / s_frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
 }
 
 void CCProfiler::releaseTimer(const char* timerName)
 {
-    m_pActiveTimers->removeObjectForKey(timerName);
+    pthread_mutex_lock(&s_threadsMutex);
+    if (! s_pResetTimes)
+    {
+        s_pResetTimes = new map<string, unsigned long long>();
+    }
+    (*s_pResetTimes)[timerName] = now();
+    pthread_mutex_unlock(&s_threadsMutex);
 }
 
 void CCProfiler::releaseAllTimers()
 {
-    m_pActiveTimers->removeAllObjects();
+    pthread_mutex_lock(&s_threadsMutex);
+    for (unsigned int i = 0; i < s_uThreadCount; ++i)
+    {
+        ccProfilerThread* thread = s_pThreads[i];
+        pthread_mutex_lock(&thread->lock);
+        thread->next = 0;
+        thread->count = 0;
+        pthread_mutex_unlock(&thread->lock);
+    }
+    CC_SAFE_DELETE(s_pResetTimes);
+    pthread_mutex_unlock(&s_threadsMutex);
 }
 
 bool CCProfiler::init()
 {
-    m_pActiveTimers = new CCDictionary();
     return true;
 }
 
 CCProfiler::~CCProfiler(void)
 {
-    CC_SAFE_RELEASE(m_pActiveTimers);
 }
 
-void CCProfiler::displayTimers()
+bool CCProfiler::isEnabled(void)
 {
-    CCDictElement* pElement = NULL;
-    CCDICT_FOREACH(m_pActiveTimers, pElement)
-    {
-        CCProfilingTimer* timer = (CCProfilingTimer*)pElement->getObject();
-        CCLog("%s", timer->description());
-    }
+    return s_bEnabled;
 }
 
-// implementation of CCProfilingTimer
-
-bool CCProfilingTimer::initWithName(const char* timerName)
+void CCProfiler::setEnabled(bool bEnabled)
 {
-    m_NameStr = timerName;
-    return true;
+    s_bEnabled = bEnabled;
 }
 
-CCProfilingTimer::CCProfilingTimer()
-: numberOfCalls(0)
-, m_dAverageTime1(0)
-, m_dAverageTime2(0)
-, totalTime(0)
-, minTime(100000000)
-, maxTime(0)
-{}
+void CCProfiler::displayTimers()
+{
+    vector<ccProfilerEvent> events;
+    vector<unsigned int> threadIndices;
+    collectEvents(events, threadIndices);
 
+    // time spent by the direct children of the zones still open, per thread and depth.
+    // Children end before their parent, so it is known when the parent shows up.
+    vector<unsigned long long> childTimes((kCCProfilerMaxDepth + 1) * kCCProfilerMaxThreads, 0);
 
-CCProfilingTimer::~CCProfilingTimer(void)
-{
-    
-}
+    map<string, ccProfilerSummary> summaries;
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        const ccProfilerEvent& event = events[i];
+        unsigned long long* children = &childTimes[threadIndices[i] * (kCCProfilerMaxDepth + 1)];
+        unsigned long long duration = event.end - event.begin;
+        unsigned long long childTime = children[event.depth + 1];
+        children[event.depth + 1] = 0;
+        children[event.depth] += duration;
+
+        ccProfilerSummary& summary = summaries[event.zone->name];
+        if (summary.durations.empty())
+        {
+            summary.name = event.zone->name;
+            summary.total = 0;
+            summary.self = 0;
+        }
+        summary.durations.push_back(duration);
+        summary.total += duration;
+        summary.self += childTime < duration ? duration - childTime : 0;
+    }
 
-const char* CCProfilingTimer::description()
-{
-    static char s_desciption[512] = {0};
-    
-    sprintf(s_desciption, "%s ::\tavg1: %dµ,\tavg2: %dµ,\tmin: %dµ,\tmax: %dµ,\ttotal: %.2fs,\tnr calls: %d", m_NameStr.c_str(), m_dAverageTime1, m_dAverageTime2, minTime, maxTime, totalTime/1000000., numberOfCalls);
-    return s_desciption;
+    vector<ccProfilerSummary*> sorted;
+    for (map<string, ccProfilerSummary>::iterator it = summaries.begin(); it != summaries.end(); ++it)
+    {
+        sorted.push_back(&it->second);
+    }
+    std::sort(sorted.begin(), sorted.end(), compareSummaryByTotal);
+
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        ccProfilerSummary* summary = sorted[i];
+        vector<unsigned long long>& durations = summary->durations;
+        std::sort(durations.begin(), durations.end());
+        CCLog("%s ::\tcalls: %u,\tp50: %.1fus,\tp90: %.1fus,\tp99: %.1fus,\tmax: %.1fus,\ttotal: %.2fms,\tself: %.2fms",
+              summary->name.c_str(), (unsigned int)durations.size(),
+              percentile(durations, 50), percentile(durations, 90), percentile(durations, 99),
+              durations.back() / 1000.0, summary->total / 1000000.0, summary->self / 1000000.0);
+    }
 }
 
-void CCProfilingTimer::reset()
+bool CCProfiler::dumpChromeTrace(const char* pszPath)
 {
-    numberOfCalls = 0;
-    m_dAverageTime1 = 0;
-    m_dAverageTime2 = 0;
-    totalTime = 0;
-    minTime = 100000000;
-    maxTime = 0;
-    gettimeofday((struct timeval*)&m_sStartTime, NULL);
+    FILE* fp = fopen(pszPath, "wb");
+    if (! fp)
+    {
+        CCLOG("cocos2d: CCProfiler: can not write %s", pszPath);
+        return false;
+    }
+
+    vector<ccProfilerEvent> events;
+    vector<unsigned int> threadIndices;
+    collectEvents(events, threadIndices);
+
+    fputs("{\"traceEvents\":[\n", fp);
+    pthread_mutex_lock(&s_threadsMutex);
+    unsigned int threadCount = s_uThreadCount;
+    unsigned long long epoch = s_uEpoch;
+    pthread_mutex_unlock(&s_threadsMutex);
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}",
+                i == 0 ? "" : ",\n", i, i);
+    }
+
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        const ccProfilerEvent& event = events[i];
+        fputs(",\n{\"name\":", fp);
+        writeJSONString(fp, event.zone->name);
+        fprintf(fp, ",\"cat\":\"cocos2d\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u",
+                (event.begin - epoch) / 1000.0, (event.end - event.begin) / 1000.0, threadIndices[i]);
+        if (event.zone->file)
+        {
+            fputs(",\"args\":{\"file\":", fp);
+            writeJSONString(fp, event.zone->file);
+            fprintf(fp, ",\"line\":%d}", event.zone->line);
+        }
+        fputc('}', fp);
+    }
+    fputs("\n],\"displayTimeUnit\":\"ms\"}\n", fp);
+
+    bool bRet = ferror(fp) == 0;
+    fclose(fp);
+    CCLOG("cocos2d: CCProfiler: %u events written to %s", (unsigned int)events.size(), pszPath);
+    return bRet;
 }
 
 void CCProfilingBeginTimingBlock(const char *timerName)
 {
-    CCProfiler* p = CCProfiler::sharedProfiler();
-    CCProfilingTimer* timer = (CCProfilingTimer*)p->m_pActiveTimers->objectForKey(timerName);
-    if( ! timer )
+    if (! s_bEnabled)
     {
-        timer = p->createAndAddTimerWithName(timerName);
+        return;
     }
 
-    // must the be last thing to execute
-    timer->numberOfCalls++;
-    gettimeofday((struct timeval*)&timer->m_sStartTime, NULL);
+    pthread_mutex_lock(&s_threadsMutex);
+    if (! s_pNamedZones)
+    {
+        s_pNamedZones = new map<string, ccProfilerZone>();
+    }
+    map<string, ccProfilerZone>::iterator it = s_pNamedZones->find(timerName);
+    if (it == s_pNamedZones->end())
+    {
+        it = s_pNamedZones->insert(make_pair(string(timerName), ccProfilerZone())).first;
+        it->second.name = it->first.c_str();
+        it->second.file = NULL;
+        it->second.line = 0;
+    }
+    const ccProfilerZone* pZone = &it->second;
+    pthread_mutex_unlock(&s_threadsMutex);
+
+    CCProfilerBeginZone(pZone);
 }
 
 void CCProfilingEndTimingBlock(const char *timerName)
 {
-    // must the be 1st thing to execute
-    struct timeval now;
-    gettimeofday( &now, NULL);
-
-    CCProfiler* p = CCProfiler::sharedProfiler();
-    CCProfilingTimer* timer = (CCProfilingTimer*)p->m_pActiveTimers->objectForKey(timerName);
-
-    CCAssert(timer, "CCProfilingTimer  not found");
-    
-    int duration = 1000000 * (now.tv_sec - timer->m_sStartTime.tv_sec) + (now.tv_usec - timer->m_sStartTime.tv_usec);
-
-    timer->totalTime += duration;
-    timer->m_dAverageTime1 = (timer->m_dAverageTime1 + duration) / 2.0f;
-    timer->m_dAverageTime2 = timer->totalTime / timer->numberOfCalls;
-    timer->maxTime = MAX( timer->maxTime, duration);
-    timer->minTime = MIN( timer->minTime, duration);
+    CCProfilerEndZone(timerName);
 }
 
 void CCProfilingResetTimingBlock(const char *timerName)
 {
-    CCProfiler* p = CCProfiler::sharedProfiler();
-    CCProfilingTimer *timer = (CCProfilingTimer*)p->m_pActiveTimers->objectForKey(timerName);
-
-    CCAssert(timer, "CCProfilingTimer not found");
-
-    timer->reset();
+    CCProfiler::sharedProfiler()->releaseTimer(timerName);
 }
 
 NS_CC_END
-
@@ -28,8 +28,6 @@ THE SOFTWARE.
 #include "ccConfig.h"
 #include "cocoa/CCObject.h"
 #include "platform/platform.h"
-#include "cocoa/CCDictionary.h"
-#include <string>
 
 NS_CC_BEGIN
 
@@ -38,10 +36,27 @@ NS_CC_BEGIN
  * @{
  */
 
-class CCProfilingTimer;
+/** Static description of a profiled code region.
+ Zones are declared with static storage by the CC_PROFILER_ZONE and CC_PROFILER_START
+ macros, so recording an event only stores a pointer to its zone: no name lookup and
+ no allocation happen on the hot path.
+ *@js NA
+ *@lua NA
+ */
+typedef struct _ccProfilerZone
+{
+    const char* name;
+    const char* file;
+    int         line;
+} ccProfilerZone;
 
 /** CCProfiler
- cocos2d builtin profiler.
+ cocos2d builtin hierarchical profiler.
+
+ Every thread records the zones it enters and leaves into its own ring buffer, using
+ a monotonic nanosecond clock. Nested zones keep their depth, so the recorded frames
+ can be dumped as a Chrome trace (chrome://tracing, Perfetto) or summarized per zone
+ with percentiles.
 
  To use it, enable set the CC_ENABLE_PROFILERS=1 in the ccConfig.h file
  *@js NA
@@ -52,46 +67,52 @@ class CC_DLL CCProfiler : public CCObject
 {
 public:
     ~CCProfiler(void);
-    /** display the timers */
+    /** logs the per zone summary of the recorded events:
+     calls, total time, p50 / p90 / p99 and max durations */
     void displayTimers(void);
     bool init(void);
 
 public:
     static CCProfiler* sharedProfiler(void);
-    /** Creates and adds a new timer */
-    CCProfilingTimer* createAndAddTimerWithName(const char* timerName);
-    /** releases a timer */
+    /** discards the recorded events of a zone */
     void releaseTimer(const char* timerName);
-    /** releases all timers */
+    /** discards all the recorded events */
     void releaseAllTimers();
 
-    CCDictionary* m_pActiveTimers;
+    /** whether the zones are recorded. Enabled by default */
+    bool isEnabled(void);
+    void setEnabled(bool bEnabled);
+
+    /** writes the recorded events of all threads as a Chrome trace event JSON file.
+     @return false if the file could not be written */
+    bool dumpChromeTrace(const char* pszPath);
+
+    /** the time of the monotonic profiler clock, in nanoseconds */
+    static unsigned long long now(void);
 };
-/**
+
+/** RAII helper which records a zone for the lifetime of the scope.
+ Use CC_PROFILER_ZONE rather than declaring it directly.
  *@js NA
  *@lua NA
  */
-class CCProfilingTimer : public CCObject
+class CC_DLL CCProfilerScope
 {
 public:
-    CCProfilingTimer();
-    ~CCProfilingTimer();
-    bool initWithName(const char* timerName);
-    const char* description(void);
-    struct cc_timeval* getStartTime(void) { return &m_sStartTime; };
-    /** resets the timer properties */
-    void reset();
-
-    std::string m_NameStr;
-    int               numberOfCalls;
-    int               m_dAverageTime1;
-    int               m_dAverageTime2;
-    long long         totalTime;
-    int               minTime;
-    int               maxTime;
-    struct cc_timeval m_sStartTime;
+    explicit CCProfilerScope(const ccProfilerZone* pZone);
+    ~CCProfilerScope(void);
+private:
+    const ccProfilerZone* m_pZone;
 };
 
+/** enters a zone on the calling thread */
+extern CC_DLL void CCProfilerBeginZone(const ccProfilerZone* pZone);
+/** leaves the innermost zone of the calling thread named timerName,
+ closing the zones nested inside it */
+extern CC_DLL void CCProfilerEndZone(const char *timerName);
+
+/** name based timers, kept for dynamically built names such as CC_PROFILER_START_INSTANCE.
+ They look up the zone in a shared map, prefer the macros with constant names. */
 extern CC_DLL void CCProfilingBeginTimingBlock(const char *timerName);
 extern CC_DLL void CCProfilingEndTimingBlock(const char *timerName);
 extern CC_DLL void CCProfilingResetTimingBlock(const char *timerName);
@@ -0,0 +1,523 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ccPixelConversion.h"
+#include "ccMacros.h"
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CC_PIXEL_CONVERSION_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define CC_PIXEL_CONVERSION_NEON 1
+#include <arm_neon.h>
+#endif
+
+NS_CC_BEGIN
+
+#if defined(CC_PIXEL_CONVERSION_SSE2) || defined(CC_PIXEL_CONVERSION_NEON)
+static const bool s_bVectorAvailable = true;
+#else
+static const bool s_bVectorAvailable = false;
+#endif
+static bool s_bVectorized = s_bVectorAvailable;
+
+// thresholds of the ordered dithering
+static const unsigned char s_bayerMatrix[4][4] =
+{
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5},
+};
+
+// Fills the offsets added to the RGBA components of 4 consecutive pixels of the row y,
+// before they are truncated to the given number of bits. The alpha is not dithered.
+static void makeDitherRow(unsigned int y, unsigned int rBits, unsigned int gBits, unsigned int bBits, unsigned char dither[16])
+{
+    for (unsigned int x = 0; x < 4; ++x)
+    {
+        unsigned int threshold = s_bayerMatrix[y & 3][x];
+        dither[x * 4 + 0] = (unsigned char)((threshold << (8 - rBits)) >> 4);
+        dither[x * 4 + 1] = (unsigned char)((threshold << (8 - gBits)) >> 4);
+        dither[x * 4 + 2] = (unsigned char)((threshold << (8 - bBits)) >> 4);
+        dither[x * 4 + 3] = 0;
+    }
+}
+
+static inline unsigned int dithered(unsigned int component, unsigned int offset)
+{
+    component += offset;
+    return component > 255 ? 255 : component;
+}
+
+// scalar conversions of the pixels [x, width) of a row, dither holds the offsets of 4 pixels
+
+typedef void (*ScalarRowFunc)(const unsigned char* in, unsigned char* out, unsigned int x, unsigned int width, const unsigned char* dither);
+
+static void rgba8888ToRGB565(const unsigned char* in, unsigned char* out, unsigned int x, unsigned int width, const unsigned char* dither)
+{
+    // Convert "RRRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA" to "RRRRRGGGGGGBBBBB"
+    unsigned short* outPixel16 = (unsigned short*)out;
+    for (; x < width; ++x)
+    {
+        const unsigned char* p = in + x * 4;
+        const unsigned char* d = dither + (x & 3) * 4;
+        outPixel16[x] =
+            ((dithered(p[0], d[0]) >> 3) << 11) |  // R
+            ((dithered(p[1], d[1]) >> 2) << 5)  |  // G
+            ((dithered(p[2], d[2]) >> 3) << 0);    // B
+    }
+}
+
+static void rgb888ToRGB565(const unsigned char* in, unsigned char* out, unsigned int x, unsigned int width, const unsigned char* dither)
+{
+    // Convert "RRRRRRRRRGGGGGGGGBBBBBBBB" to "RRRRRGGGGGGBBBBB"
+    unsigned short* outPixel16 = (unsigned short*)out;
+    for (; x < width; ++x)
+    {
+        const unsigned char* p = in + x * 3;
+        const unsigned char* d = dither + (x & 3) * 4;
+        outPixel16[x] =
+            ((dithered(p[0], d[0]) >> 3) << 11) |  // R
+            ((dithered(p[1], d[1]) >> 2) << 5)  |  // G
+            ((dithered(p[2], d[2]) >> 3) << 0);    // B
+    }
+}
+
+static void rgba8888ToRGBA4444(const unsigned char* in, unsigned char* out, unsigned int x, unsigned int width, const unsigned char* dither)
+{
+    // Convert "RRRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA" to "RRRRGGGGBBBBAAAA"
+    unsigned short* outPixel16 = (unsigned short*)out;
+    for (; x < width; ++x)
+    {
+        const unsigned char* p = in + x * 4;
+        const unsigned char* d = dither + (x & 3) * 4;
+        outPixel16[x] =
+            ((dithered(p[0], d[0]) >> 4) << 12) | // R
+            ((dithered(p[1], d[1]) >> 4) << 8)  | // G
+            ((dithered(p[2], d[2]) >> 4) << 4)  | // B
+            ((p[3] >> 4) << 0);                   // A
+    }
+}
+
+static void rgba8888ToRGB5A1(const unsigned char* in, unsigned char* out, unsigned int x, unsigned int width, const unsigned char* dither)
+{
+    // Convert "RRRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA" to "RRRRRGGGGGBBBBBA"
+    unsigned short* outPixel16 = (unsigned short*)out;
+    for (; x < width; ++x)
+    {
+        const unsigned char* p = in + x * 4;
+        const unsigned char* d = dither + (x & 3) * 4;
+        outPixel16[x] =
+            ((dithered(p[0], d[0]) >> 3) << 11) | // R
+            ((dithered(p[1], d[1]) >> 3) << 6)  | // G
+            ((dithered(p[2], d[2]) >> 3) << 1)  | // B
+            ((p[3] >> 7) << 0);                   // A
+    }
+}
+
+static void rgba8888ToA8(const unsigned char* in, unsigned char* out, unsigned int x, unsigned int width, const unsigned char* dither)
+{
+    // Convert "RRRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA" to "AAAAAAAA"
+    for (; x < width; ++x)
+    {
+        out[x] = in[x * 4 + 3];
+    }
+}
+
+static void rgba8888ToRGB888(const unsigned char* in, unsigned char* out, unsigned int x, unsigned int width, const unsigned char* dither)
+{
+    // Convert "RRRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA" to "RRRRRRRRGGGGGGGGBBBBBBBB"
+    for (; x < width; ++x)
+    {
+        out[x * 3 + 0] = in[x * 4 + 0]; // R
+        out[x * 3 + 1] = in[x * 4 + 1]; // G
+        out[x * 3 + 2] = in[x * 4 + 2]; // B
+    }
+}
+
+static void premultiplyAlpha(unsigned char* pixels, unsigned int i, unsigned int count)
+{
+    for (; i < count; ++i)
+    {
+        unsigned char* p = pixels + i * 4;
+        unsigned int alpha = p[3] + 1;
+        p[0] = (unsigned char)((p[0] * alpha) >> 8);
+        p[1] = (unsigned char)((p[1] * alpha) >> 8);
+        p[2] = (unsigned char)((p[2] * alpha) >> 8);
+    }
+}
+
+// vectorized conversions of the beginning of a row, they return the number of pixels converted
+
+typedef unsigned int (*VectorRowFunc)(const unsigned char* in, unsigned char* out, unsigned int width, const unsigned char* dither);
+
+#if defined(CC_PIXEL_CONVERSION_SSE2)
+
+// the 16-bit pixels are computed in the low half of 32-bit lanes, from the RGBA bytes of the lanes
+
+struct RGB565SSE2
+{
+    static inline __m128i convert(__m128i p)
+    {
+        return _mm_or_si128(_mm_or_si128(
+            _mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF8)), 8),        // R
+            _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xFC00)), 5)),     // G
+            _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF80000)), 19));  // B
+    }
+};
+
+struct RGBA4444SSE2
+{
+    static inline __m128i convert(__m128i p)
+    {
+        return _mm_or_si128(_mm_or_si128(
+            _mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF0)), 8),        // R
+            _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF000)), 4)),     // G
+            _mm_or_si128(
+            _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF00000)), 16),   // B
+            _mm_srli_epi32(p, 28)));                                          // A
+    }
+};
+
+struct RGB5A1SSE2
+{
+    static inline __m128i convert(__m128i p)
+    {
+        return _mm_or_si128(_mm_or_si128(
+            _mm_slli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF8)), 8),        // R
+            _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF800)), 5)),     // G
+            _mm_or_si128(
+            _mm_srli_epi32(_mm_and_si128(p, _mm_set1_epi32(0xF80000)), 18),   // B
+            _mm_srli_epi32(p, 31)));                                          // A
+    }
+};
+
+// packs the low halves of the lanes, _mm_packs_epi32 saturates so they are sign extended first
+static inline __m128i packLow16(__m128i a, __m128i b)
+{
+    a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+    b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+    return _mm_packs_epi32(a, b);
+}
+
+template <class CONVERTER>
+static unsigned int rgba8888To16Vector(const unsigned char* in, unsigned char* out, unsigned int width, const unsigned char* dither)
+{
+    // the row is converted from its first pixel, so the lanes match the 4 pixels of the dither pattern
+    __m128i d = _mm_loadu_si128((const __m128i*)dither);
+    unsigned int x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i p0 = _mm_adds_epu8(_mm_loadu_si128((const __m128i*)(in + x * 4)), d);
+        __m128i p1 = _mm_adds_epu8(_mm_loadu_si128((const __m128i*)(in + x * 4 + 16)), d);
+        _mm_storeu_si128((__m128i*)(out + x * 2), packLow16(CONVERTER::convert(p0), CONVERTER::convert(p1)));
+    }
+    return x;
+}
+
+static unsigned int rgba8888ToA8Vector(const unsigned char* in, unsigned char* out, unsigned int width, const unsigned char* dither)
+{
+    unsigned int x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m128i a0 = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(in + x * 4)), 24);
+        __m128i a1 = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(in + x * 4 + 16)), 24);
+        __m128i a2 = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(in + x * 4 + 32)), 24);
+        __m128i a3 = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(in + x * 4 + 48)), 24);
+        _mm_storeu_si128((__m128i*)(out + x), _mm_packus_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3)));
+    }
+    return x;
+}
+
+static unsigned int premultiplyAlphaVector(unsigned char* pixels, unsigned int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    // the colors are multiplied by alpha + 1, the alpha by 256 so it is unchanged
+    const __m128i colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alphaFactor = _mm_set_epi16(256, 0, 0, 0, 256, 0, 0, 0);
+    unsigned int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i p = _mm_loadu_si128((const __m128i*)(pixels + i * 4));
+        __m128i lo = _mm_unpacklo_epi8(p, zero);
+        __m128i hi = _mm_unpackhi_epi8(p, zero);
+        __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        alphaLo = _mm_or_si128(_mm_and_si128(_mm_add_epi16(alphaLo, one), colorMask), alphaFactor);
+        alphaHi = _mm_or_si128(_mm_and_si128(_mm_add_epi16(alphaHi, one), colorMask), alphaFactor);
+        lo = _mm_srli_epi16(_mm_mullo_epi16(lo, alphaLo), 8);
+        hi = _mm_srli_epi16(_mm_mullo_epi16(hi, alphaHi), 8);
+        _mm_storeu_si128((__m128i*)(pixels + i * 4), _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+// SSE2 has no byte shuffle, the RGB888 conversions stay scalar
+static const VectorRowFunc rgb888ToRGB565Vector = NULL;
+static const VectorRowFunc rgba8888ToRGB888Vector = NULL;
+
+#elif defined(CC_PIXEL_CONVERSION_NEON)
+
+// the components of 8 pixels are shifted to the top of 16-bit lanes, then inserted from the top down
+
+struct RGB565NEON
+{
+    static inline uint16x8_t convert(uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a)
+    {
+        uint16x8_t v = vshll_n_u8(r, 8);
+        v = vsriq_n_u16(v, vshll_n_u8(g, 8), 5);
+        return vsriq_n_u16(v, vshll_n_u8(b, 8), 11);
+    }
+};
+
+struct RGBA4444NEON
+{
+    static inline uint16x8_t convert(uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a)
+    {
+        uint16x8_t v = vshll_n_u8(r, 8);
+        v = vsriq_n_u16(v, vshll_n_u8(g, 8), 4);
+        v = vsriq_n_u16(v, vshll_n_u8(b, 8), 8);
+        return vsriq_n_u16(v, vshll_n_u8(a, 8), 12);
+    }
+};
+
+struct RGB5A1NEON
+{
+    static inline uint16x8_t convert(uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a)
+    {
+        uint16x8_t v = vshll_n_u8(r, 8);
+        v = vsriq_n_u16(v, vshll_n_u8(g, 8), 5);
+        v = vsriq_n_u16(v, vshll_n_u8(b, 8), 10);
+        return vsriq_n_u16(v, vshll_n_u8(a, 8), 15);
+    }
+};
+
+// the offsets of the dither pattern, one vector per component
+static inline uint8x16x4_t loadDither(const unsigned char* dither)
+{
+    unsigned char pattern[64];
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        memcpy(pattern + i * 16, dither, 16);
+    }
+    return vld4q_u8(pattern);
+}
+
+template <class CONVERTER>
+static inline void store16Vector(unsigned char* out, uint8x16_t r, uint8x16_t g, uint8x16_t b, uint8x16_t a)
+{
+    vst1q_u16((uint16_t*)out, CONVERTER::convert(vget_low_u8(r), vget_low_u8(g), vget_low_u8(b), vget_low_u8(a)));
+    vst1q_u16((uint16_t*)(out + 16), CONVERTER::convert(vget_high_u8(r), vget_high_u8(g), vget_high_u8(b), vget_high_u8(a)));
+}
+
+template <class CONVERTER>
+static unsigned int rgba8888To16Vector(const unsigned char* in, unsigned char* out, unsigned int width, const unsigned char* dither)
+{
+    // the row is converted from its first pixel, so the lanes match the pixels of the dither pattern
+    uint8x16x4_t d = loadDither(dither);
+    unsigned int x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16x4_t p = vld4q_u8(in + x * 4);
+        store16Vector<CONVERTER>(out + x * 2, vqaddq_u8(p.val[0], d.val[0]), vqaddq_u8(p.val[1], d.val[1]), vqaddq_u8(p.val[2], d.val[2]), p.val[3]);
+    }
+    return x;
+}
+
+static unsigned int rgb888ToRGB565Vector(const unsigned char* in, unsigned char* out, unsigned int width, const unsigned char* dither)
+{
+    uint8x16x4_t d = loadDither(dither);
+    unsigned int x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16x3_t p = vld3q_u8(in + x * 3);
+        store16Vector<RGB565NEON>(out + x * 2, vqaddq_u8(p.val[0], d.val[0]), vqaddq_u8(p.val[1], d.val[1]), vqaddq_u8(p.val[2], d.val[2]), d.val[3]);
+    }
+    return x;
+}
+
+static unsigned int rgba8888ToA8Vector(const unsigned char* in, unsigned char* out, unsigned int width, const unsigned char* dither)
+{
+    unsigned int x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        vst1q_u8(out + x, vld4q_u8(in + x * 4).val[3]);
+    }
+    return x;
+}
+
+static unsigned int rgba8888ToRGB888Vector(const unsigned char* in, unsigned char* out, unsigned int width, const unsigned char* dither)
+{
+    unsigned int x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16x4_t p = vld4q_u8(in + x * 4);
+        uint8x16x3_t rgb;
+        rgb.val[0] = p.val[0];
+        rgb.val[1] = p.val[1];
+        rgb.val[2] = p.val[2];
+        vst3q_u8(out + x * 3, rgb);
+    }
+    return x;
+}
+
+// c * (a + 1) >> 8, computed as (c * a + c) >> 8
+static inline uint8x16_t premultiplyVector(uint8x16_t c, uint8x16_t a)
+{
+    uint8x8_t lo = vget_low_u8(c);
+    uint8x8_t hi = vget_high_u8(c);
+    return vcombine_u8(vshrn_n_u16(vaddw_u8(vmull_u8(lo, vget_low_u8(a)), lo), 8),
+                       vshrn_n_u16(vaddw_u8(vmull_u8(hi, vget_high_u8(a)), hi), 8));
+}
+
+static unsigned int premultiplyAlphaVector(unsigned char* pixels, unsigned int count)
+{
+    unsigned int i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t p = vld4q_u8(pixels + i * 4);
+        p.val[0] = premultiplyVector(p.val[0], p.val[3]);
+        p.val[1] = premultiplyVector(p.val[1], p.val[3]);
+        p.val[2] = premultiplyVector(p.val[2], p.val[3]);
+        vst4q_u8(pixels + i * 4, p);
+    }
+    return i;
+}
+
+#endif
+
+#if defined(CC_PIXEL_CONVERSION_SSE2)
+static const VectorRowFunc rgba8888ToRGB565Vector = rgba8888To16Vector<RGB565SSE2>;
+static const VectorRowFunc rgba8888ToRGBA4444Vector = rgba8888To16Vector<RGBA4444SSE2>;
+static const VectorRowFunc rgba8888ToRGB5A1Vector = rgba8888To16Vector<RGB5A1SSE2>;
+#elif defined(CC_PIXEL_CONVERSION_NEON)
+static const VectorRowFunc rgba8888ToRGB565Vector = rgba8888To16Vector<RGB565NEON>;
+static const VectorRowFunc rgba8888ToRGBA4444Vector = rgba8888To16Vector<RGBA4444NEON>;
+static const VectorRowFunc rgba8888ToRGB5A1Vector = rgba8888To16Vector<RGB5A1NEON>;
+#else
+static const VectorRowFunc rgba8888ToRGB565Vector = NULL;
+static const VectorRowFunc rgba8888ToRGBA4444Vector = NULL;
+static const VectorRowFunc rgba8888ToRGB5A1Vector = NULL;
+static const VectorRowFunc rgb888ToRGB565Vector = NULL;
+static const VectorRowFunc rgba8888ToA8Vector = NULL;
+static const VectorRowFunc rgba8888ToRGB888Vector = NULL;
+#endif
+
+void ccPremultiplyAlpha(unsigned char* pixels, unsigned int count)
+{
+    unsigned int i = 0;
+#if defined(CC_PIXEL_CONVERSION_SSE2) || defined(CC_PIXEL_CONVERSION_NEON)
+    if (s_bVectorized)
+    {
+        i = premultiplyAlphaVector(pixels, count);
+    }
+#endif
+    premultiplyAlpha(pixels, i, count);
+}
+
+bool ccConvertPixels(const unsigned char* in, bool bHasAlpha, unsigned int width, unsigned int height,
+                     CCTexture2DPixelFormat format, bool bDither, unsigned char* out)
+{
+    ScalarRowFunc scalarFunc = NULL;
+    VectorRowFunc vectorFunc = NULL;
+    // bits kept of the RGB components, the formats with less than 8 are dithered
+    unsigned int rBits = 8, gBits = 8, bBits = 8;
+
+    switch (format)
+    {
+        case kCCTexture2DPixelFormat_RGB565:
+            scalarFunc = bHasAlpha ? rgba8888ToRGB565 : rgb888ToRGB565;
+            vectorFunc = bHasAlpha ? rgba8888ToRGB565Vector : rgb888ToRGB565Vector;
+            rBits = 5; gBits = 6; bBits = 5;
+            break;
+        case kCCTexture2DPixelFormat_RGBA4444:
+            scalarFunc = rgba8888ToRGBA4444;
+            vectorFunc = rgba8888ToRGBA4444Vector;
+            rBits = 4; gBits = 4; bBits = 4;
+            break;
+        case kCCTexture2DPixelFormat_RGB5A1:
+            scalarFunc = rgba8888ToRGB5A1;
+            vectorFunc = rgba8888ToRGB5A1Vector;
+            rBits = 5; gBits = 5; bBits = 5;
+            break;
+        case kCCTexture2DPixelFormat_A8:
+            scalarFunc = rgba8888ToA8;
+            vectorFunc = rgba8888ToA8Vector;
+            break;
+        case kCCTexture2DPixelFormat_RGB888:
+            scalarFunc = rgba8888ToRGB888;
+            vectorFunc = rgba8888ToRGB888Vector;
+            break;
+        default:
+            break;
+    }
+    if (scalarFunc == NULL || (! bHasAlpha && format != kCCTexture2DPixelFormat_RGB565))
+    {
+        return false;
+    }
+
+    unsigned int inBytes = bHasAlpha ? 4 : 3;
+    unsigned int outBytes = CCTexture2D::bytesPerPixelForFormat(format);
+    unsigned char dither[16];
+    bDither = bDither && rBits < 8;
+    if (! bDither)
+    {
+        // without a pattern the rows don't matter, the pixels are converted in one go
+        memset(dither, 0, sizeof(dither));
+        width *= height;
+        height = 1;
+    }
+    if (! s_bVectorized)
+    {
+        vectorFunc = NULL;
+    }
+
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        const unsigned char* inRow = in + y * width * inBytes;
+        unsigned char* outRow = out + y * width * outBytes;
+        if (bDither)
+        {
+            makeDitherRow(y, rBits, gBits, bBits, dither);
+        }
+        unsigned int x = vectorFunc ? vectorFunc(inRow, outRow, width, dither) : 0;
+        scalarFunc(inRow, outRow, x, width, dither);
+    }
+    return true;
+}
+
+void ccSetPixelConversionVectorized(bool bVectorized)
+{
+    s_bVectorized = bVectorized && s_bVectorAvailable;
+}
+
+bool ccIsPixelConversionVectorized()
+{
+    return s_bVectorized;
+}
+
+NS_CC_END
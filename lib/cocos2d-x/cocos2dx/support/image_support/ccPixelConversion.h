@@ -0,0 +1,56 @@
+/****************************************************************************
+ Copyright (c) 2010-2013 cocos2d-x.org
+ 
+ http://www.cocos2d-x.org
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __SUPPORT_IMAGE_SUPPORT_CCPIXELCONVERSION_H__
+#define __SUPPORT_IMAGE_SUPPORT_CCPIXELCONVERSION_H__
+
+#include "textures/CCTexture2D.h"
+
+/** @file ccPixelConversion.h
+Conversion of the decoded images to the pixel formats of the textures.
+The loops use SSE2 or NEON when the target supports them, and give the same pixels as the scalar ones.
+*/
+
+NS_CC_BEGIN
+
+/** Premultiplies the RGB components of count RGBA8888 pixels by their alpha, in place. */
+void CC_DLL ccPremultiplyAlpha(unsigned char* pixels, unsigned int count);
+
+/** Converts width x height pixels, RGBA8888 if bHasAlpha otherwise RGB888, to the given pixel format.
+ Supported are RGB565 from both, and RGBA4444, RGB5A1, A8 and RGB888 from RGBA8888.
+ If bDither the 16-bit formats are dithered with an ordered 4x4 pattern, which hides the banding of gradients.
+ @return false if the conversion is not supported
+ */
+bool CC_DLL ccConvertPixels(const unsigned char* in, bool bHasAlpha, unsigned int width, unsigned int height,
+                            CCTexture2DPixelFormat format, bool bDither, unsigned char* out);
+
+/** Whether the conversions use the SSE2 / NEON code. Enabled by default when the target has it,
+ disabling it runs the scalar code, e.g. to compare them.
+ */
+void CC_DLL ccSetPixelConversionVectorized(bool bVectorized);
+bool CC_DLL ccIsPixelConversionVectorized();
+
+NS_CC_END
+
+#endif // __SUPPORT_IMAGE_SUPPORT_CCPIXELCONVERSION_H__
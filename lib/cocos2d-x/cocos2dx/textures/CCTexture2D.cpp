@@ -38,6 +38,7 @@ THE SOFTWARE.
 #include "platform/CCImage.h"
 #include "CCGL.h"
 #include "support/ccUtils.h"
+#include "support/image_support/ccPixelConversion.h"
 #include "platform/CCPlatformMacros.h"
 
 #ifndef QUICK_MINI_TARGET
@@ -62,11 +63,69 @@ NS_CC_BEGIN
 // Default is: RGBA8888 (32-bit textures)
 static CCTexture2DPixelFormat g_defaultAlphaPixelFormat = kCCTexture2DPixelFormat_Default;
 
+// whether the 16-bit formats are dithered
+static bool g_bDitherEnabled = false;
+
 // By default PVR images are treated as if they don't have the alpha channel premultiplied
 static bool PVRHaveAlphaPremultiplied_ = false;
 
+// GL formats of the uncompressed pixel formats
+static bool getGLFormat(CCTexture2DPixelFormat pixelFormat, GLenum *pInternalFormat, GLenum *pFormat, GLenum *pType)
+{
+    switch(pixelFormat)
+    {
+    case kCCTexture2DPixelFormat_RGBA8888:
+        *pInternalFormat = GL_RGBA; *pFormat = GL_RGBA; *pType = GL_UNSIGNED_BYTE;
+        return true;
+    case kCCTexture2DPixelFormat_RGB888:
+        *pInternalFormat = GL_RGB; *pFormat = GL_RGB; *pType = GL_UNSIGNED_BYTE;
+        return true;
+    case kCCTexture2DPixelFormat_RGBA4444:
+        *pInternalFormat = GL_RGBA; *pFormat = GL_RGBA; *pType = GL_UNSIGNED_SHORT_4_4_4_4;
+        return true;
+    case kCCTexture2DPixelFormat_RGB5A1:
+        *pInternalFormat = GL_RGBA; *pFormat = GL_RGBA; *pType = GL_UNSIGNED_SHORT_5_5_5_1;
+        return true;
+    case kCCTexture2DPixelFormat_RGB565:
+        *pInternalFormat = GL_RGB; *pFormat = GL_RGB; *pType = GL_UNSIGNED_SHORT_5_6_5;
+        return true;
+    case kCCTexture2DPixelFormat_AI88:
+        *pInternalFormat = GL_LUMINANCE_ALPHA; *pFormat = GL_LUMINANCE_ALPHA; *pType = GL_UNSIGNED_BYTE;
+        return true;
+    case kCCTexture2DPixelFormat_A8:
+        *pInternalFormat = GL_ALPHA; *pFormat = GL_ALPHA; *pType = GL_UNSIGNED_BYTE;
+        return true;
+    case kCCTexture2DPixelFormat_I8:
+        *pInternalFormat = GL_LUMINANCE; *pFormat = GL_LUMINANCE; *pType = GL_UNSIGNED_BYTE;
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void setUnpackAlignment(unsigned int bytesPerRow)
+{
+    if(bytesPerRow % 8 == 0)
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 8);
+    }
+    else if(bytesPerRow % 4 == 0)
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+    else if(bytesPerRow % 2 == 0)
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+    }
+    else
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    }
+}
+
 CCTexture2D::CCTexture2D()
 : m_bPVRHaveAlphaPremultiplied(true)
+, m_ePixelFormat(kCCTexture2DPixelFormat_Default)
 , m_uPixelsWide(0)
 , m_uPixelsHigh(0)
 , m_uName(0)
@@ -74,6 +133,7 @@ CCTexture2D::CCTexture2D()
 , m_fMaxT(0.0)
 , m_bHasPremultipliedAlpha(false)
 , m_bHasMipmaps(false)
+, m_uLastUsedFrame(0)
 , m_pShaderProgram(NULL)
 {
 }
@@ -179,36 +239,7 @@ bool CCTexture2D::hasPremultipliedAlpha()
 
 bool CCTexture2D::initWithData(const void *data, CCTexture2DPixelFormat pixelFormat, unsigned int pixelsWide, unsigned int pixelsHigh, const CCSize& contentSize)
 {
-    unsigned int bitsPerPixel;
-    //Hack: bitsPerPixelForFormat returns wrong number for RGB_888 textures. See function.
-    if(pixelFormat == kCCTexture2DPixelFormat_RGB888)
-    {
-        bitsPerPixel = 24;
-    }
-    else
-    {
-        bitsPerPixel = bitsPerPixelForFormat(pixelFormat);
-    }
-
-    unsigned int bytesPerRow = pixelsWide * bitsPerPixel / 8;
-
-    if(bytesPerRow % 8 == 0)
-    {
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 8);
-    }
-    else if(bytesPerRow % 4 == 0)
-    {
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-    }
-    else if(bytesPerRow % 2 == 0)
-    {
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
-    }
-    else
-    {
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    }
-
+    setUnpackAlignment(pixelsWide * bytesPerPixelForFormat(pixelFormat));
 
     glGenTextures(1, &m_uName);
     ccGLBindTexture2D(m_uName);
@@ -218,37 +249,16 @@ bool CCTexture2D::initWithData(const void *data, CCTexture2DPixelFormat pixelFor
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
 
-    // Specify OpenGL texture image
+    // Specify OpenGL texture image, data may be NULL to fill it later with updateWithData
 
-    switch(pixelFormat)
+    GLenum internalFormat, format, type;
+    if (getGLFormat(pixelFormat, &internalFormat, &format, &type))
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, (GLsizei)pixelsWide, (GLsizei)pixelsHigh, 0, format, type, data);
+    }
+    else
     {
-    case kCCTexture2DPixelFormat_RGBA8888:
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, (GLsizei)pixelsWide, (GLsizei)pixelsHigh, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-        break;
-    case kCCTexture2DPixelFormat_RGB888:
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, (GLsizei)pixelsWide, (GLsizei)pixelsHigh, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-        break;
-    case kCCTexture2DPixelFormat_RGBA4444:
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, (GLsizei)pixelsWide, (GLsizei)pixelsHigh, 0, GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, data);
-        break;
-    case kCCTexture2DPixelFormat_RGB5A1:
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, (GLsizei)pixelsWide, (GLsizei)pixelsHigh, 0, GL_RGBA, GL_UNSIGNED_SHORT_5_5_5_1, data);
-        break;
-    case kCCTexture2DPixelFormat_RGB565:
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, (GLsizei)pixelsWide, (GLsizei)pixelsHigh, 0, GL_RGB, GL_UNSIGNED_SHORT_5_6_5, data);
-        break;
-    case kCCTexture2DPixelFormat_AI88:
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE_ALPHA, (GLsizei)pixelsWide, (GLsizei)pixelsHigh, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, data);
-        break;
-    case kCCTexture2DPixelFormat_A8:
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, (GLsizei)pixelsWide, (GLsizei)pixelsHigh, 0, GL_ALPHA, GL_UNSIGNED_BYTE, data);
-        break;
-    case kCCTexture2DPixelFormat_I8:
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, (GLsizei)pixelsWide, (GLsizei)pixelsHigh, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, data);
-        break;
-    default:
         CCAssert(0, "NSInternalInconsistencyException");
-
     }
 
     m_tContentSize = contentSize;
@@ -299,20 +309,37 @@ bool CCTexture2D::initWithImage(CCImage *uiImage)
 }
 
 bool CCTexture2D::initPremultipliedATextureWithImage(CCImage *image, unsigned int width, unsigned int height)
+{
+    CCSize                    imageSize = CCSizeMake((float)(image->getWidth()), (float)(image->getHeight()));
+    CCTexture2DPixelFormat    pixelFormat;
+
+    // Repack the pixel data into the right format
+    unsigned char*            tempData = convertImageData(image, g_defaultAlphaPixelFormat, g_bDitherEnabled, &pixelFormat);
+
+    initWithData(tempData, pixelFormat, width, height, imageSize);
+    
+    if (tempData != image->getData())
+    {
+        delete [] tempData;
+    }
+
+    m_bHasPremultipliedAlpha = image->isPremultipliedAlpha();
+    return true;
+}
+
+unsigned char* CCTexture2D::convertImageData(CCImage *image, CCTexture2DPixelFormat defaultAlphaPixelFormat, bool bDither, CCTexture2DPixelFormat *pPixelFormat)
 {
     unsigned char*            tempData = image->getData();
-    unsigned int*             inPixel32  = NULL;
-    unsigned char*            inPixel8 = NULL;
-    unsigned short*           outPixel16 = NULL;
     bool                      hasAlpha = image->hasAlpha();
-    CCSize                    imageSize = CCSizeMake((float)(image->getWidth()), (float)(image->getHeight()));
+    unsigned int              width = image->getWidth();
+    unsigned int              height = image->getHeight();
     CCTexture2DPixelFormat    pixelFormat;
     size_t                    bpp = image->getBitsPerComponent();
 
     // compute pixel format
     if (hasAlpha)
     {
-    	pixelFormat = g_defaultAlphaPixelFormat;
+    	pixelFormat = defaultAlphaPixelFormat;
     }
     else
     {
@@ -328,113 +355,39 @@ bool CCTexture2D::initPremultipliedATextureWithImage(CCImage *image, unsigned in
     }
     
     // Repack the pixel data into the right format
-    unsigned int length = width * height;
-
-    if (pixelFormat == kCCTexture2DPixelFormat_RGB565)
-    {
-        if (hasAlpha)
-        {
-            // Convert "RRRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA" to "RRRRRGGGGGGBBBBB"
-            
-            tempData = new unsigned char[width * height * 2];
-            outPixel16 = (unsigned short*)tempData;
-            inPixel32 = (unsigned int*)image->getData();
-            
-            for(unsigned int i = 0; i < length; ++i, ++inPixel32)
-            {
-                *outPixel16++ = 
-                ((((*inPixel32 >>  0) & 0xFF) >> 3) << 11) |  // R
-                ((((*inPixel32 >>  8) & 0xFF) >> 2) << 5)  |  // G
-                ((((*inPixel32 >> 16) & 0xFF) >> 3) << 0);    // B
-            }
-        }
-        else 
-        {
-            // Convert "RRRRRRRRRGGGGGGGGBBBBBBBB" to "RRRRRGGGGGGBBBBB"
-            
-            tempData = new unsigned char[width * height * 2];
-            outPixel16 = (unsigned short*)tempData;
-            inPixel8 = (unsigned char*)image->getData();
-            
-            for(unsigned int i = 0; i < length; ++i)
-            {
-                *outPixel16++ = 
-                (((*inPixel8++ & 0xFF) >> 3) << 11) |  // R
-                (((*inPixel8++ & 0xFF) >> 2) << 5)  |  // G
-                (((*inPixel8++ & 0xFF) >> 3) << 0);    // B
-            }
-        }    
-    }
-    else if (pixelFormat == kCCTexture2DPixelFormat_RGBA4444)
+    if (pixelFormat == kCCTexture2DPixelFormat_RGB565
+        || (hasAlpha && (pixelFormat == kCCTexture2DPixelFormat_RGBA4444
+                         || pixelFormat == kCCTexture2DPixelFormat_RGB5A1
+                         || pixelFormat == kCCTexture2DPixelFormat_A8
+                         || pixelFormat == kCCTexture2DPixelFormat_RGB888)))
     {
-        // Convert "RRRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA" to "RRRRGGGGBBBBAAAA"
-        
-        inPixel32 = (unsigned int*)image->getData();  
-        tempData = new unsigned char[width * height * 2];
-        outPixel16 = (unsigned short*)tempData;
-        
-        for(unsigned int i = 0; i < length; ++i, ++inPixel32)
-        {
-            *outPixel16++ = 
-            ((((*inPixel32 >> 0) & 0xFF) >> 4) << 12) | // R
-            ((((*inPixel32 >> 8) & 0xFF) >> 4) <<  8) | // G
-            ((((*inPixel32 >> 16) & 0xFF) >> 4) << 4) | // B
-            ((((*inPixel32 >> 24) & 0xFF) >> 4) << 0);  // A
-        }
-    }
-    else if (pixelFormat == kCCTexture2DPixelFormat_RGB5A1)
-    {
-        // Convert "RRRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA" to "RRRRRGGGGGBBBBBA"
-        inPixel32 = (unsigned int*)image->getData();   
-        tempData = new unsigned char[width * height * 2];
-        outPixel16 = (unsigned short*)tempData;
-        
-        for(unsigned int i = 0; i < length; ++i, ++inPixel32)
-        {
-            *outPixel16++ = 
-            ((((*inPixel32 >> 0) & 0xFF) >> 3) << 11) | // R
-            ((((*inPixel32 >> 8) & 0xFF) >> 3) <<  6) | // G
-            ((((*inPixel32 >> 16) & 0xFF) >> 3) << 1) | // B
-            ((((*inPixel32 >> 24) & 0xFF) >> 7) << 0);  // A
-        }
-    }
-    else if (pixelFormat == kCCTexture2DPixelFormat_A8)
-    {
-        // Convert "RRRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA" to "AAAAAAAA"
-        inPixel32 = (unsigned int*)image->getData();
-        tempData = new unsigned char[width * height];
-        unsigned char *outPixel8 = tempData;
-        
-        for(unsigned int i = 0; i < length; ++i, ++inPixel32)
-        {
-            *outPixel8++ = (*inPixel32 >> 24) & 0xFF;  // A
-        }
-    }
-    
-    if (hasAlpha && pixelFormat == kCCTexture2DPixelFormat_RGB888)
-    {
-        // Convert "RRRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA" to "RRRRRRRRGGGGGGGGBBBBBBBB"
-        inPixel32 = (unsigned int*)image->getData();
-        tempData = new unsigned char[width * height * 3];
-        unsigned char *outPixel8 = tempData;
-        
-        for(unsigned int i = 0; i < length; ++i, ++inPixel32)
-        {
-            *outPixel8++ = (*inPixel32 >> 0) & 0xFF; // R
-            *outPixel8++ = (*inPixel32 >> 8) & 0xFF; // G
-            *outPixel8++ = (*inPixel32 >> 16) & 0xFF; // B
-        }
+        tempData = new unsigned char[width * height * bytesPerPixelForFormat(pixelFormat)];
+        ccConvertPixels(image->getData(), hasAlpha, width, height, pixelFormat, bDither, tempData);
     }
     
-    initWithData(tempData, pixelFormat, width, height, imageSize);
-    
-    if (tempData != image->getData())
+    *pPixelFormat = pixelFormat;
+    return tempData;
+}
+
+void CCTexture2D::updateWithData(const void *data, unsigned int offsetX, unsigned int offsetY, unsigned int width, unsigned int height)
+{
+    CCAssert(offsetX + width <= m_uPixelsWide && offsetY + height <= m_uPixelsHigh, "CCTexture2D: region out of the texture");
+
+    GLenum internalFormat, format, type;
+    if (! getGLFormat(m_ePixelFormat, &internalFormat, &format, &type))
     {
-        delete [] tempData;
+        CCAssert(0, "NSInternalInconsistencyException");
+        return;
     }
 
-    m_bHasPremultipliedAlpha = image->isPremultipliedAlpha();
-    return true;
+    setUnpackAlignment(width * bytesPerPixelForFormat(m_ePixelFormat));
+    ccGLBindTexture2D(m_uName);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, (GLint)offsetX, (GLint)offsetY, (GLsizei)width, (GLsizei)height, format, type, data);
+}
+
+void CCTexture2D::setHasPremultipliedAlpha(bool bHasPremultipliedAlpha)
+{
+    m_bHasPremultipliedAlpha = bHasPremultipliedAlpha;
 }
 
 // implementation CCTexture2D (Text)
@@ -783,6 +736,36 @@ bool CCTexture2D::hasMipmaps()
     return m_bHasMipmaps;
 }
 
+unsigned int CCTexture2D::getMemoryBytes()
+{
+    unsigned int bpp = bitsPerPixelForFormat();
+    unsigned int width = m_uPixelsWide;
+    unsigned int height = m_uPixelsHigh;
+    unsigned int bytes = width * height * bpp / 8;
+
+    if (m_bHasMipmaps)
+    {
+        // each level halves the previous one, down to 1 x 1
+        while (width > 1 || height > 1)
+        {
+            width = MAX(width / 2, 1);
+            height = MAX(height / 2, 1);
+            bytes += MAX(width * height * bpp / 8, 1);
+        }
+    }
+    return bytes;
+}
+
+unsigned int CCTexture2D::getLastUsedFrame()
+{
+    return m_uLastUsedFrame;
+}
+
+void CCTexture2D::setLastUsedFrame(unsigned int uFrame)
+{
+    m_uLastUsedFrame = uFrame;
+}
+
 void CCTexture2D::setTexParameters(ccTexParams *texParams)
 {
     CCAssert( (m_uPixelsWide == ccNextPOT(m_uPixelsWide) || texParams->wrapS == GL_CLAMP_TO_EDGE) &&
@@ -898,6 +881,16 @@ CCTexture2DPixelFormat CCTexture2D::defaultAlphaPixelFormat()
     return g_defaultAlphaPixelFormat;
 }
 
+void CCTexture2D::setDitherEnabled(bool bEnabled)
+{
+    g_bDitherEnabled = bEnabled;
+}
+
+bool CCTexture2D::isDitherEnabled()
+{
+    return g_bDitherEnabled;
+}
+
 unsigned int CCTexture2D::bitsPerPixelForFormat(CCTexture2DPixelFormat format)
 {
 	unsigned int ret=0;
@@ -943,6 +936,29 @@ unsigned int CCTexture2D::bitsPerPixelForFormat(CCTexture2DPixelFormat format)
 	return ret;
 }
 
+unsigned int CCTexture2D::bytesPerPixelForFormat(CCTexture2DPixelFormat format)
+{
+    switch (format)
+    {
+        case kCCTexture2DPixelFormat_RGBA8888:
+            return 4;
+        case kCCTexture2DPixelFormat_RGB888:
+            // the pixels are packed in memory, unlike what bitsPerPixelForFormat returns
+            return 3;
+        case kCCTexture2DPixelFormat_RGB565:
+        case kCCTexture2DPixelFormat_RGBA4444:
+        case kCCTexture2DPixelFormat_RGB5A1:
+        case kCCTexture2DPixelFormat_AI88:
+            return 2;
+        case kCCTexture2DPixelFormat_A8:
+        case kCCTexture2DPixelFormat_I8:
+            return 1;
+        default:
+            // compressed formats have no whole number of bytes per pixel
+            return 0;
+    }
+}
+
 unsigned int CCTexture2D::bitsPerPixelForFormat()
 {
 	return this->bitsPerPixelForFormat(m_ePixelFormat);
@@ -142,6 +142,22 @@ public:
      */
     bool initWithData(const void* data, CCTexture2DPixelFormat pixelFormat, unsigned int pixelsWide, unsigned int pixelsHigh, const CCSize& contentSize);
 
+    /** Replaces a region of the texture with data in the pixel format of the texture.
+     * Together with initWithData(NULL, ...), it uploads a big image in several steps.
+     * @js NA
+     * @lua NA
+     */
+    void updateWithData(const void* data, unsigned int offsetX, unsigned int offsetY, unsigned int width, unsigned int height);
+
+    /** Converts the pixels of an image to the format initWithImage creates its texture with,
+     * images with alpha taking defaultAlphaPixelFormat, dithered if bDither (see setDitherEnabled).
+     * It only reads the image, so it can run on any thread.
+     * @return the data of the image when no conversion is needed, otherwise a buffer the caller must delete[]
+     * @js NA
+     * @lua NA
+     */
+    static unsigned char* convertImageData(CCImage* image, CCTexture2DPixelFormat defaultAlphaPixelFormat, bool bDither, CCTexture2DPixelFormat* pPixelFormat);
+
     /**
     Drawing extensions to make it easy to draw basic quads using a CCTexture2D object.
     These functions require GL_TEXTURE_2D and both GL_VERTEX_ARRAY and GL_TEXTURE_COORD_ARRAY client states to be enabled.
@@ -231,6 +247,9 @@ public:
      */
     unsigned int bitsPerPixelForFormat(CCTexture2DPixelFormat format);
 
+    /** bytes per pixel of the uncompressed formats as stored in memory, 0 for the compressed ones */
+    static unsigned int bytesPerPixelForFormat(CCTexture2DPixelFormat format);
+
     /** sets the default pixel format for UIImagescontains alpha channel.
     If the UIImage contains alpha channel, then the options are:
     - generate 32-bit textures: kCCTexture2DPixelFormat_RGBA8888 (default one)
@@ -256,6 +275,12 @@ public:
     */
     static CCTexture2DPixelFormat defaultAlphaPixelFormat();
 
+    /** dithers the images converted to the 16-bit formats (RGB565, RGBA4444, RGB5A1) with an ordered pattern,
+    which hides the banding of gradients. Disabled by default.
+    */
+    static void setDitherEnabled(bool bEnabled);
+    static bool isDitherEnabled();
+
     /** treats (or not) PVR files as if they have alpha premultiplied.
      Since it is impossible to know at runtime if the PVR images have the alpha channel premultiplied, it is
      possible load them as if they have (or not) the alpha channel premultiplied.
@@ -270,7 +295,16 @@ public:
     const CCSize& getContentSizeInPixels();
     
     bool hasPremultipliedAlpha();
+    /** for the textures whose data is uploaded with initWithData / updateWithData */
+    void setHasPremultipliedAlpha(bool bHasPremultipliedAlpha);
     bool hasMipmaps();
+
+    /** bytes of video memory used by the texture, its mipmaps included */
+    unsigned int getMemoryBytes();
+
+    /** last frame (see CCDirector::getTotalFrames) the texture was used in, maintained by CCTextureCache */
+    unsigned int getLastUsedFrame();
+    void setLastUsedFrame(unsigned int uFrame);
 private:
     bool initPremultipliedATextureWithImage(CCImage * image, unsigned int pixelsWide, unsigned int pixelsHigh);
     
@@ -299,6 +333,8 @@ private:
 
     bool m_bHasMipmaps;
 
+    unsigned int m_uLastUsedFrame;
+
     /** shader program used by drawAtPoint and drawInRect */
     CC_PROPERTY(CCGLProgram*, m_pShaderProgram, ShaderProgram);
 };
@@ -47,6 +47,7 @@ NS_CC_BEGIN
 CCTextureAtlas::CCTextureAtlas()
     :m_pIndices(NULL)
     ,m_bDirty(false)
+    ,m_uDirtyRanges(0)
     ,m_pTexture(NULL)
     ,m_pQuads(NULL)
 {}
@@ -96,7 +97,7 @@ void CCTextureAtlas::setTexture(CCTexture2D * var)
 ccV3F_C4B_T2F_Quad* CCTextureAtlas::getQuads()
 {
     //if someone accesses the quads directly, presume that changes will be made
-    m_bDirty = true;
+    setDirty(true);
     return m_pQuads;
 }
 
@@ -194,7 +195,7 @@ bool CCTextureAtlas::initWithTexture(CCTexture2D *texture, unsigned int capacity
     setupVBO();
 #endif
 
-    m_bDirty = true;
+    setDirty(true);
 
     return true;
 }
@@ -208,7 +209,7 @@ void CCTextureAtlas::listenBackToForeground(CCObject *obj)
 #endif
     
     // set m_bDirty to true to force it rebinding buffer
-    m_bDirty = true;
+    setDirty(true);
 }
 
 const char* CCTextureAtlas::description()
@@ -306,6 +307,125 @@ void CCTextureAtlas::mapBuffers()
     CHECK_GL_ERROR_DEBUG();
 }
 
+void CCTextureAtlas::setDirty(bool bDirty)
+{
+    m_bDirty = bDirty;
+    m_uDirtyRanges = 0;
+    if (bDirty)
+    {
+        m_pDirtyRanges[0] = 0;
+        m_pDirtyRanges[1] = UINT_MAX;
+        m_uDirtyRanges = 1;
+    }
+}
+
+void CCTextureAtlas::markQuadsDirty(unsigned int index, unsigned int amount)
+{
+    CCAssert(index + amount <= m_uCapacity, "markQuadsDirty: Invalid index + amount");
+    markDirtyQuads(index, index + amount);
+}
+
+void CCTextureAtlas::markDirtyQuads(unsigned int begin, unsigned int end)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+    m_bDirty = true;
+
+    unsigned int* ranges = m_pDirtyRanges;
+    unsigned int count = m_uDirtyRanges;
+
+    // first range that ends at or after the new one begins
+    unsigned int first = 0;
+    while (first < count && ranges[first * 2 + 1] < begin)
+    {
+        first++;
+    }
+
+    // the ranges overlapping or touching the new one are merged into it
+    unsigned int last = first;
+    while (last < count && ranges[last * 2] <= end)
+    {
+        begin = MIN(begin, ranges[last * 2]);
+        end = MAX(end, ranges[last * 2 + 1]);
+        last++;
+    }
+
+    if (last == first)
+    {
+        memmove(&ranges[(first + 1) * 2], &ranges[first * 2], sizeof(ranges[0]) * 2 * (count - first));
+        count++;
+    }
+    else if (last > first + 1)
+    {
+        memmove(&ranges[(first + 1) * 2], &ranges[last * 2], sizeof(ranges[0]) * 2 * (count - last));
+        count -= last - first - 1;
+    }
+    ranges[first * 2] = begin;
+    ranges[first * 2 + 1] = end;
+
+    // too many ranges: merge the two closest ones, the quads between them are uploaded too
+    if (count > CC_TEXTURE_ATLAS_DIRTY_RANGES)
+    {
+        unsigned int closest = 0;
+        for (unsigned int i = 1; i < count - 1; i++)
+        {
+            if (ranges[i * 2 + 2] - ranges[i * 2 + 1] < ranges[closest * 2 + 2] - ranges[closest * 2 + 1])
+            {
+                closest = i;
+            }
+        }
+        ranges[closest * 2 + 1] = ranges[closest * 2 + 3];
+        memmove(&ranges[(closest + 1) * 2], &ranges[(closest + 2) * 2], sizeof(ranges[0]) * 2 * (count - closest - 2));
+        count--;
+    }
+
+    m_uDirtyRanges = count;
+}
+
+void CCTextureAtlas::uploadDirtyQuads()
+{
+    // the array buffer of the VBO is bound by the caller
+    unsigned int dirtyQuads = 0;
+    for (unsigned int i = 0; i < m_uDirtyRanges; i++)
+    {
+        unsigned int end = MIN(m_pDirtyRanges[i * 2 + 1], m_uTotalQuads);
+        if (m_pDirtyRanges[i * 2] < end)
+        {
+            dirtyQuads += end - m_pDirtyRanges[i * 2];
+        }
+    }
+
+    if (dirtyQuads * 100 >= m_uTotalQuads * CC_TEXTURE_ATLAS_ORPHAN_PERCENT)
+    {
+        // orphaning: the driver allocates a new buffer instead of waiting for the draws that still use the old one
+        glBufferData(GL_ARRAY_BUFFER, sizeof(m_pQuads[0]) * m_uCapacity, NULL, GL_DYNAMIC_DRAW);
+#if CC_TEXTURE_ATLAS_USE_VAO
+        void *buf = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
+        memcpy(buf, m_pQuads, sizeof(m_pQuads[0]) * m_uTotalQuads);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+#else
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(m_pQuads[0]) * m_uTotalQuads, m_pQuads);
+#endif
+    }
+    else
+    {
+        // only the updated quads, the unchanged ones (static sprites of a batch node) aren't uploaded again
+        for (unsigned int i = 0; i < m_uDirtyRanges; i++)
+        {
+            unsigned int begin = m_pDirtyRanges[i * 2];
+            unsigned int end = MIN(m_pDirtyRanges[i * 2 + 1], m_uTotalQuads);
+            if (begin < end)
+            {
+                glBufferSubData(GL_ARRAY_BUFFER, sizeof(m_pQuads[0]) * begin, sizeof(m_pQuads[0]) * (end - begin), &m_pQuads[begin]);
+            }
+        }
+    }
+
+    setDirty(false);
+}
+
 // TextureAtlas - Update, Insert, Move & Remove
 
 void CCTextureAtlas::updateQuad(ccV3F_C4B_T2F_Quad *quad, unsigned int index)
@@ -316,9 +436,7 @@ void CCTextureAtlas::updateQuad(ccV3F_C4B_T2F_Quad *quad, unsigned int index)
 
     m_pQuads[index] = *quad;    
 
-
-    m_bDirty = true;
-
+    markDirtyQuads(index, index + 1);
 }
 
 void CCTextureAtlas::insertQuad(ccV3F_C4B_T2F_Quad *quad, unsigned int index)
@@ -340,9 +458,8 @@ void CCTextureAtlas::insertQuad(ccV3F_C4B_T2F_Quad *quad, unsigned int index)
 
     m_pQuads[index] = *quad;
 
-
-    m_bDirty = true;
-
+    // the following quads moved too
+    markDirtyQuads(index, m_uTotalQuads);
 }
 
 void CCTextureAtlas::insertQuads(ccV3F_C4B_T2F_Quad* quads, unsigned int index, unsigned int amount)
@@ -373,7 +490,7 @@ void CCTextureAtlas::insertQuads(ccV3F_C4B_T2F_Quad* quads, unsigned int index,
         j++;
     }
 
-    m_bDirty = true;
+    markDirtyQuads(max - amount, m_uTotalQuads);
 }
 
 void CCTextureAtlas::insertQuadFromIndex(unsigned int oldIndex, unsigned int newIndex)
@@ -401,9 +518,7 @@ void CCTextureAtlas::insertQuadFromIndex(unsigned int oldIndex, unsigned int new
     memmove( &m_pQuads[dst],&m_pQuads[src], sizeof(m_pQuads[0]) * howMany );
     m_pQuads[newIndex] = quadsBackup;
 
-
-    m_bDirty = true;
-
+    markDirtyQuads(MIN(oldIndex, newIndex), MAX(oldIndex, newIndex) + 1);
 }
 
 void CCTextureAtlas::removeQuadAtIndex(unsigned int index)
@@ -422,9 +537,7 @@ void CCTextureAtlas::removeQuadAtIndex(unsigned int index)
 
     m_uTotalQuads--;
 
-
-    m_bDirty = true;
-
+    markDirtyQuads(index, m_uTotalQuads);
 }
 
 void CCTextureAtlas::removeQuadsAtIndex(unsigned int index, unsigned int amount)
@@ -440,7 +553,7 @@ void CCTextureAtlas::removeQuadsAtIndex(unsigned int index, unsigned int amount)
         memmove( &m_pQuads[index], &m_pQuads[index+amount], sizeof(m_pQuads[0]) * remaining );
     }
 
-    m_bDirty = true;
+    markDirtyQuads(index, m_uTotalQuads);
 }
 
 void CCTextureAtlas::removeAllQuads()
@@ -517,7 +630,7 @@ bool CCTextureAtlas::resizeCapacity(unsigned int newCapacity)
     setupIndices();
     mapBuffers();
 
-    m_bDirty = true;
+    setDirty(true);
 
     return true;
 }
@@ -555,7 +668,7 @@ void CCTextureAtlas::moveQuadsFromIndex(unsigned int oldIndex, unsigned int amou
 
     free(tempQuads);
 
-    m_bDirty = true;
+    markDirtyQuads(MIN(oldIndex, newIndex), MAX(oldIndex, newIndex) + amount);
 }
 
 void CCTextureAtlas::moveQuadsFromIndex(unsigned int index, unsigned int newIndex)
@@ -563,6 +676,8 @@ void CCTextureAtlas::moveQuadsFromIndex(unsigned int index, unsigned int newInde
     CCAssert(newIndex + (m_uTotalQuads - index) <= m_uCapacity, "moveQuadsFromIndex move is out of bounds");
 
     memmove(m_pQuads + newIndex,m_pQuads + index, (m_uTotalQuads - index) * sizeof(m_pQuads[0]));
+
+    markDirtyQuads(MIN(index, newIndex), MAX(index, newIndex) + (m_uTotalQuads - index));
 }
 
 void CCTextureAtlas::fillWithEmptyQuadsFromIndex(unsigned int index, unsigned int amount)
@@ -575,6 +690,8 @@ void CCTextureAtlas::fillWithEmptyQuadsFromIndex(unsigned int index, unsigned in
     {
         m_pQuads[i] = quad;
     }
+
+    markDirtyQuads(index, to);
 }
 
 // TextureAtlas - Drawing
@@ -607,21 +724,8 @@ void CCTextureAtlas::drawNumberOfQuads(unsigned int n, unsigned int start)
     if (m_bDirty) 
     {
         glBindBuffer(GL_ARRAY_BUFFER, m_pBuffersVBO[0]);
-        // option 1: subdata
-        //glBufferSubData(GL_ARRAY_BUFFER, sizeof(m_pQuads[0])*start, sizeof(m_pQuads[0]) * n , &m_pQuads[start] );
-		
-		// option 2: data
-        //		glBufferData(GL_ARRAY_BUFFER, sizeof(quads_[0]) * (n-start), &quads_[start], GL_DYNAMIC_DRAW);
-		
-		// option 3: orphaning + glMapBuffer
-		glBufferData(GL_ARRAY_BUFFER, sizeof(m_pQuads[0]) * (n-start), NULL, GL_DYNAMIC_DRAW);
-		void *buf = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-		memcpy(buf, m_pQuads, sizeof(m_pQuads[0])* (n-start));
-		glUnmapBuffer(GL_ARRAY_BUFFER);
-		
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-        m_bDirty = false;
+        uploadDirtyQuads();
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
     ccGLBindVAO(m_uVAOname);
@@ -654,8 +758,8 @@ void CCTextureAtlas::drawNumberOfQuads(unsigned int n, unsigned int start)
     // XXX: update is done in draw... perhaps it should be done in a timer
     if (m_bDirty) 
     {
-        glBufferSubData(GL_ARRAY_BUFFER, sizeof(m_pQuads[0])*start, sizeof(m_pQuads[0]) * n , &m_pQuads[start] );
-        m_bDirty = false;
+        // upload the updated quads, the dirty flag is cleared and later draws may use other ranges
+        uploadDirtyQuads();
     }
 
     ccGLEnableVertexAttribs(kCCVertexAttribFlag_PosColorTex);
@@ -62,6 +62,8 @@ protected:
 #endif
     GLuint              m_pBuffersVBO[2]; //0: vertex  1: indices
     bool                m_bDirty; //indicates whether or not the array buffer of the VBO needs to be updated
+    unsigned int        m_uDirtyRanges; //number of ranges of quads to upload when the atlas is dirty
+    unsigned int        m_pDirtyRanges[(CC_TEXTURE_ATLAS_DIRTY_RANGES + 1) * 2]; //sorted [begin, end) pairs, end is UINT_MAX to upload them all
 
 
     /** quantity of quads that are going to be drawn */
@@ -214,12 +216,28 @@ public:
 
     /** whether or not the array buffer of the VBO needs to be updated*/
     inline bool isDirty(void) { return m_bDirty; }
-    /** specify if the array buffer of the VBO needs to be updated */
-    inline void setDirty(bool bDirty) { m_bDirty = bDirty; }
+    /** specify if the array buffer of the VBO needs to be updated, all the quads are uploaded on the next draw */
+    void setDirty(bool bDirty);
+
+    /** Quads that are going to be rendered, for reading only.
+     Unlike getQuads() it doesn't mark the atlas dirty, so the next draw doesn't upload all the quads.
+     */
+    inline const ccV3F_C4B_T2F_Quad* getQuadsForReading(void) { return m_pQuads; }
+
+    /** Quads that are going to be rendered, for writing without marking the atlas dirty.
+     The caller marks the quads it changed with markQuadsDirty, so several writers can fill disjoint ranges
+     of the atlas at the same time.
+     */
+    inline ccV3F_C4B_T2F_Quad* getQuadsForUpdate(void) { return m_pQuads; }
+
+    /** marks amount quads from index as changed, they are uploaded by the next draw */
+    void markQuadsDirty(unsigned int index, unsigned int amount);
 
 private:
     void setupIndices();
     void mapBuffers();
+    void markDirtyQuads(unsigned int begin, unsigned int end);
+    void uploadDirtyQuads();
 #if CC_TEXTURE_ATLAS_USE_VAO
     void setupVBOandVAO();
 #else
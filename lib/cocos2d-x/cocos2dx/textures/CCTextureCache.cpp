@@ -34,6 +34,9 @@ THE SOFTWARE.
 #include "platform/CCThread.h"
 #include "platform/CCImage.h"
 #include "support/ccUtils.h"
+#include "support/CCProfiling.h"
+#include "support/CCJobPool.h"
+#include "CCConfiguration.h"
 #include "CCScheduler.h"
 #include "cocoa/CCString.h"
 #include "script_support/CCScriptSupport.h"
@@ -43,6 +46,10 @@ THE SOFTWARE.
 #include <cctype>
 #include <queue>
 #include <list>
+#include <map>
+#include <set>
+#include <vector>
+#include <algorithm>
 
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
 #include <pthread.h>
@@ -57,12 +64,24 @@ using namespace std;
 
 NS_CC_BEGIN
 
-typedef struct _AsyncStruct
+// a caller waiting for an image loaded asynchronously
+typedef struct _AsyncRequest
 {
-    std::string            filename;
     CCObject    *target;
     SEL_CallFuncO        selector;
     int handler;
+} AsyncRequest;
+
+// an image decoded by the loading threads, shared by all the requests of its path
+typedef struct _AsyncStruct
+{
+    std::string            filename;
+    int priority;
+    // default alpha pixel format and dithering when the image was requested
+    CCTexture2DPixelFormat pixelFormat;
+    bool dither;
+    // only accessed by the main thread
+    std::vector<AsyncRequest> requests;
 } AsyncStruct;
 
 typedef struct _ImageInfo
@@ -70,29 +89,48 @@ typedef struct _ImageInfo
     AsyncStruct *asyncStruct;
     CCImage        *image;
     CCImage::EImageFormat imageType;
+    // the pixels converted by the loading thread, the data of the image when no conversion was needed
+    unsigned char  *data;
+    CCTexture2DPixelFormat pixelFormat;
+    // the texture uploaded on the main thread, and its rows uploaded so far
+    CCTexture2D    *texture;
+    unsigned int    uploadedRows;
 } ImageInfo;
 
-static pthread_t s_loadingThread;
-
-static pthread_mutex_t		s_SleepMutex;
+static pthread_t*           s_pLoadingThreads = NULL;
+static unsigned int         s_uLoadingThreadCount = 0;
+static unsigned int         s_uAsyncThreadCount = CC_TEXTURE_CACHE_ASYNC_THREADS;
+static unsigned int         s_uAsyncCompletionsPerFrame = 0;
+static unsigned int         s_uAsyncUploadBytesPerFrame = CC_TEXTURE_CACHE_ASYNC_UPLOAD_BYTES_PER_FRAME;
+static float                s_fAsyncUploadTimePerFrame = CC_TEXTURE_CACHE_ASYNC_UPLOAD_TIME_PER_FRAME;
+static unsigned int         s_uAsyncUploadSliceBytes = CC_TEXTURE_CACHE_ASYNC_UPLOAD_SLICE_BYTES;
+static bool                 s_bAsyncCancelReleasedTargets = CC_TEXTURE_CACHE_ASYNC_CANCEL_RELEASED_TARGETS != 0;
+static ccTextureUploadStats s_tAsyncUploadStats = { 0, 0, 0, 0, 0.0f };
+
+static pthread_mutex_t		s_asyncStructQueueMutex;
 static pthread_cond_t		s_SleepCondition;
 
-static pthread_mutex_t      s_asyncStructQueueMutex;
 static pthread_mutex_t      s_ImageInfoMutex;
 
 #ifdef EMSCRIPTEN
 // Hack to get ASM.JS validation (no undefined symbols allowed).
 #define pthread_cond_signal(_)
+#define pthread_cond_broadcast(_)
 #endif // EMSCRIPTEN
 
-static unsigned long s_nAsyncRefCount = 0;
-
 static bool need_quit = false;
 
-static std::queue<AsyncStruct*>* s_pAsyncStructQueue = NULL;
+// images waiting for a loading thread, by decreasing priority. Guarded by s_asyncStructQueueMutex
+static std::list<AsyncStruct*>* s_pAsyncStructQueue = NULL;
 
+// decoded images waiting for the main thread. Guarded by s_ImageInfoMutex
 static std::queue<ImageInfo*>*   s_pImageQueue = NULL;
 
+// decoded images waiting for their upload, the first one may be partially uploaded. Only accessed by the main thread
+static std::list<ImageInfo*>*    s_pUploadQueue = NULL;
+
+// every image requested and not delivered yet, by path. Only accessed by the main thread
+static std::map<std::string, AsyncStruct*>* s_pAsyncStructMap = NULL;
 
 static CCImage::EImageFormat computeImageFormatType(string& filename)
 {
@@ -122,31 +160,37 @@ static CCImage::EImageFormat computeImageFormatType(string& filename)
 
 static void loadImageData(AsyncStruct *pAsyncStruct)
 {
+    CC_PROFILER_ZONE("CCTextureCache - loadImageData");
+
     const char *filename = pAsyncStruct->filename.c_str();
 
     // compute image type
     CCImage::EImageFormat imageType = computeImageFormatType(pAsyncStruct->filename);
+
+    // generate image, failures are reported to the main thread with a NULL image
+    CCImage *pImage = NULL;
     if (imageType == CCImage::kFmtUnKnown)
     {
         CCLOG("unsupported format %s",filename);
-        delete pAsyncStruct;
-        return;
     }
-        
-    // generate image            
-    CCImage *pImage = new CCImage();
-    if (pImage && !pImage->initWithImageFileThreadSafe(filename, imageType))
+    else
     {
-        CC_SAFE_RELEASE(pImage);
-        CCLOG("can not load %s", filename);
-        return;
+        pImage = new CCImage();
+        if (! pImage->initWithImageFileThreadSafe(filename, imageType))
+        {
+            CC_SAFE_RELEASE_NULL(pImage);
+            CCLOG("can not load %s", filename);
+        }
     }
 
-    // generate image info
+    // generate image info, converting the pixels here rather than on the main thread
     ImageInfo *pImageInfo = new ImageInfo();
     pImageInfo->asyncStruct = pAsyncStruct;
     pImageInfo->image = pImage;
     pImageInfo->imageType = imageType;
+    pImageInfo->data = pImage ? CCTexture2D::convertImageData(pImage, pAsyncStruct->pixelFormat, pAsyncStruct->dither, &pImageInfo->pixelFormat) : NULL;
+    pImageInfo->texture = NULL;
+    pImageInfo->uploadedRows = 0;
     // put the image info into the queue
     pthread_mutex_lock(&s_ImageInfoMutex);
     s_pImageQueue->push(pImageInfo);
@@ -155,53 +199,189 @@ static void loadImageData(AsyncStruct *pAsyncStruct)
 
 static void* loadImage(void* data)
 {
-    AsyncStruct *pAsyncStruct = NULL;
-
-    while (true)
+    pthread_mutex_lock(&s_asyncStructQueueMutex);
+    while (! need_quit)
     {
+        if (s_pAsyncStructQueue->empty())
+        {
+            pthread_cond_wait(&s_SleepCondition, &s_asyncStructQueueMutex);
+            continue;
+        }
+
+        // get async struct from queue
+        AsyncStruct *pAsyncStruct = s_pAsyncStructQueue->front();
+        s_pAsyncStructQueue->pop_front();
+        pthread_mutex_unlock(&s_asyncStructQueueMutex);
+
         // create autorelease pool for iOS
         CCThread thread;
         thread.createAutoreleasePool();
+        loadImageData(pAsyncStruct);
+
+        pthread_mutex_lock(&s_asyncStructQueueMutex);
+    }
+    pthread_mutex_unlock(&s_asyncStructQueueMutex);
+    
+    return 0;
+}
+
+// inserts after the images of the same or a higher priority, s_asyncStructQueueMutex must be locked
+static void queueAsyncStruct(AsyncStruct *pAsyncStruct)
+{
+    std::list<AsyncStruct*>::iterator it = s_pAsyncStructQueue->begin();
+    while (it != s_pAsyncStructQueue->end() && (*it)->priority >= pAsyncStruct->priority)
+    {
+        ++it;
+    }
+    s_pAsyncStructQueue->insert(it, pAsyncStruct);
+}
 
-        std::queue<AsyncStruct*> *pQueue = s_pAsyncStructQueue;
-        pthread_mutex_lock(&s_asyncStructQueueMutex);// get async struct from queue
-        if (pQueue->empty())
+// removes an image no loading thread has started to decode yet
+static bool unqueueAsyncStruct(AsyncStruct *pAsyncStruct)
+{
+    bool bRet = false;
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
+    pthread_mutex_lock(&s_asyncStructQueueMutex);
+    std::list<AsyncStruct*>::iterator it = std::find(s_pAsyncStructQueue->begin(), s_pAsyncStructQueue->end(), pAsyncStruct);
+    if (it != s_pAsyncStructQueue->end())
+    {
+        s_pAsyncStructQueue->erase(it);
+        bRet = true;
+    }
+    pthread_mutex_unlock(&s_asyncStructQueueMutex);
+#endif
+    return bRet;
+}
+
+static void deleteImageInfo(ImageInfo *pImageInfo)
+{
+    if (pImageInfo->image && pImageInfo->data != pImageInfo->image->getData())
+    {
+        delete [] pImageInfo->data;
+    }
+    CC_SAFE_RELEASE(pImageInfo->image);
+    CC_SAFE_RELEASE(pImageInfo->texture);
+    delete pImageInfo->asyncStruct;
+    delete pImageInfo;
+}
+
+static unsigned int getBytesPerRow(ImageInfo *pImageInfo)
+{
+    return pImageInfo->image->getWidth() * CCTexture2D::bytesPerPixelForFormat(pImageInfo->pixelFormat);
+}
+
+static bool isUploadBudgetSpent(unsigned int uploadedBytes, unsigned long long startTime)
+{
+    if (s_uAsyncUploadBytesPerFrame > 0 && uploadedBytes >= s_uAsyncUploadBytesPerFrame)
+    {
+        return true;
+    }
+    return s_fAsyncUploadTimePerFrame > 0 && (CCProfiler::now() - startTime) >= s_fAsyncUploadTimePerFrame * 1000000000.0f;
+}
+
+// uploads a whole image, or the next slice of an image too big to be uploaded at once.
+// Returns the bytes uploaded
+static unsigned int uploadImage(ImageInfo *pImageInfo)
+{
+    CCImage *pImage = pImageInfo->image;
+    unsigned int width = pImage->getWidth();
+    unsigned int height = pImage->getHeight();
+    unsigned int bytesPerRow = getBytesPerRow(pImageInfo);
+
+    if (pImageInfo->texture == NULL)
+    {
+        pImageInfo->texture = new CCTexture2D();
+        CCSize imageSize = CCSizeMake((float)width, (float)height);
+        if (s_uAsyncUploadSliceBytes == 0 || bytesPerRow * height <= s_uAsyncUploadSliceBytes)
         {
-            pthread_mutex_unlock(&s_asyncStructQueueMutex);
-            if (need_quit) {
-                break;
-            }
-            else {
-                pthread_cond_wait(&s_SleepCondition, &s_SleepMutex);
-                continue;
-            }
+            pImageInfo->texture->initWithData(pImageInfo->data, pImageInfo->pixelFormat, width, height, imageSize);
+            pImageInfo->uploadedRows = height;
         }
         else
         {
-            pAsyncStruct = pQueue->front();
-            pQueue->pop();
-            pthread_mutex_unlock(&s_asyncStructQueueMutex);
-            loadImageData(pAsyncStruct);
-        }        
+            // allocate the texture, its rows are filled by the next calls
+            pImageInfo->texture->initWithData(NULL, pImageInfo->pixelFormat, width, height, imageSize);
+        }
+        pImageInfo->texture->setHasPremultipliedAlpha(pImage->isPremultipliedAlpha());
+        if (pImageInfo->uploadedRows == height)
+        {
+            return bytesPerRow * height;
+        }
     }
-    
-    if( s_pAsyncStructQueue != NULL )
+
+    unsigned int rows = MAX(s_uAsyncUploadSliceBytes / bytesPerRow, 1);
+    rows = MIN(rows, height - pImageInfo->uploadedRows);
+    pImageInfo->texture->updateWithData(pImageInfo->data + pImageInfo->uploadedRows * bytesPerRow, 0, pImageInfo->uploadedRows, width, rows);
+    pImageInfo->uploadedRows += rows;
+    return bytesPerRow * rows;
+}
+
+typedef bool (*AsyncRequestFilter)(const AsyncStruct *pAsyncStruct, const AsyncRequest& request, const void *data);
+
+static bool isRequestOfTarget(const AsyncStruct *pAsyncStruct, const AsyncRequest& request, const void *data)
+{
+    return request.target == data;
+}
+
+static bool isRequestOfPath(const AsyncStruct *pAsyncStruct, const AsyncRequest& request, const void *data)
+{
+    return pAsyncStruct->filename == *(const std::string*)data;
+}
+
+static bool isAnyRequest(const AsyncStruct *pAsyncStruct, const AsyncRequest& request, const void *data)
+{
+    return true;
+}
+
+// the target is only retained by its requests, nobody else would see the callback.
+// The targets are found before any request is dropped, releasing them can delete them
+static bool isReleasedTargetRequest(const AsyncStruct *pAsyncStruct, const AsyncRequest& request, const void *data)
+{
+    const std::set<CCObject*>& releasedTargets = *(const std::set<CCObject*>*)data;
+    return request.target && releasedTargets.find(request.target) != releasedTargets.end();
+}
+
+// drops the matching requests, and the images nobody waits for anymore if they are not decoded yet.
+// Images already being decoded are dropped when they are delivered.
+static void removeAsyncRequests(AsyncRequestFilter filter, const void *data)
+{
+    if (s_pAsyncStructMap == NULL)
     {
-        delete s_pAsyncStructQueue;
-        s_pAsyncStructQueue = NULL;
-        delete s_pImageQueue;
-        s_pImageQueue = NULL;
+        return;
+    }
 
-        pthread_mutex_destroy(&s_asyncStructQueueMutex);
-        pthread_mutex_destroy(&s_ImageInfoMutex);
-        pthread_mutex_destroy(&s_SleepMutex);
-        pthread_cond_destroy(&s_SleepCondition);
+    std::map<std::string, AsyncStruct*>::iterator it = s_pAsyncStructMap->begin();
+    while (it != s_pAsyncStructMap->end())
+    {
+        AsyncStruct *pAsyncStruct = it->second;
+        std::vector<AsyncRequest>& requests = pAsyncStruct->requests;
+        bool bRemoved = false;
+        for (size_t i = 0; i < requests.size(); )
+        {
+            if (filter(pAsyncStruct, requests[i], data))
+            {
+                CC_SAFE_RELEASE(requests[i].target);
+                requests.erase(requests.begin() + i);
+                bRemoved = true;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        if (bRemoved && requests.empty() && unqueueAsyncStruct(pAsyncStruct))
+        {
+            delete pAsyncStruct;
+            s_pAsyncStructMap->erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
     }
-    
-    return 0;
 }
 
-
 // implementation CCTextureCache
 
 // TextureCache - Alloc, Init & Dealloc
@@ -221,18 +401,61 @@ CCTextureCache::CCTextureCache()
     CCAssert(g_sharedTextureCache == NULL, "Attempted to allocate a second instance of a singleton.");
     
     m_pTextures = new CCDictionary();
+    m_uMemoryBudget = CC_TEXTURE_CACHE_MEMORY_BUDGET;
+    m_bMemoryBudgetScheduled = false;
+    m_bEvictionDeferred = false;
 }
 
 CCTextureCache::~CCTextureCache()
 {
     CCLOGINFO("cocos2d: deallocing CCTextureCache.");
-    need_quit = true;
-    pthread_cond_signal(&s_SleepCondition);
+    if (s_pAsyncStructQueue != NULL)
+    {
+        pthread_mutex_lock(&s_asyncStructQueueMutex);
+        need_quit = true;
+        pthread_cond_broadcast(&s_SleepCondition);
+        pthread_mutex_unlock(&s_asyncStructQueueMutex);
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
+        for (unsigned int i = 0; i < s_uLoadingThreadCount; ++i)
+        {
+            pthread_join(s_pLoadingThreads[i], NULL);
+        }
+#endif
+
+        // drop the images still queued or decoded
+        removeAsyncRequests(isAnyRequest, NULL);
+        while (! s_pImageQueue->empty())
+        {
+            deleteImageInfo(s_pImageQueue->front());
+            s_pImageQueue->pop();
+        }
+        while (! s_pUploadQueue->empty())
+        {
+            deleteImageInfo(s_pUploadQueue->front());
+            s_pUploadQueue->pop_front();
+        }
+
+        CC_SAFE_DELETE_ARRAY(s_pLoadingThreads);
+        s_uLoadingThreadCount = 0;
+        CC_SAFE_DELETE(s_pAsyncStructQueue);
+        CC_SAFE_DELETE(s_pImageQueue);
+        CC_SAFE_DELETE(s_pUploadQueue);
+        CC_SAFE_DELETE(s_pAsyncStructMap);
+
+        pthread_mutex_destroy(&s_asyncStructQueueMutex);
+        pthread_mutex_destroy(&s_ImageInfoMutex);
+        pthread_cond_destroy(&s_SleepCondition);
+    }
     CC_SAFE_RELEASE(m_pTextures);
 }
 
 void CCTextureCache::purgeSharedTextureCache()
 {
+    if (g_sharedTextureCache && g_sharedTextureCache->m_bMemoryBudgetScheduled)
+    {
+        // the scheduler retains the cache
+        CCDirector::sharedDirector()->getScheduler()->unscheduleSelector(schedule_selector(CCTextureCache::memoryBudgetCallBack), g_sharedTextureCache);
+    }
     CC_SAFE_RELEASE_NULL(g_sharedTextureCache);
 }
 
@@ -253,17 +476,17 @@ CCDictionary* CCTextureCache::snapshotTextures()
     return pRet;
 }
 
-void CCTextureCache::addImageAsync(const char *path, CCObject *target, SEL_CallFuncO selector)
+void CCTextureCache::addImageAsync(const char *path, CCObject *target, SEL_CallFuncO selector, int priority)
 {
-    addImageAsyncImpl(path, target, selector);
+    addImageAsyncImpl(path, target, selector, 0, priority);
 }
 
-void CCTextureCache::addImageAsync(const char *path, int handler)
+void CCTextureCache::addImageAsync(const char *path, int handler, int priority)
 {
-    addImageAsyncImpl(path, NULL, NULL, handler);
+    addImageAsyncImpl(path, NULL, NULL, handler, priority);
 }
 
-void CCTextureCache::addImageAsyncImpl(const char *path, CCObject *target, SEL_CallFuncO selector, int handler)
+void CCTextureCache::addImageAsyncImpl(const char *path, CCObject *target, SEL_CallFuncO selector, int handler, int priority)
 {
 #ifdef EMSCRIPTEN
     CCLOGWARN("Cannot load image %s asynchronously in Emscripten builds.", path);
@@ -287,6 +510,7 @@ void CCTextureCache::addImageAsyncImpl(const char *path, CCObject *target, SEL_C
 
     if (texture != NULL)
     {
+        touchTexture(texture);
         if (target && selector)
         {
             (target->*selector)(texture);
@@ -303,44 +527,75 @@ void CCTextureCache::addImageAsyncImpl(const char *path, CCObject *target, SEL_C
     // lazy init
     if (s_pAsyncStructQueue == NULL)
     {             
-        s_pAsyncStructQueue = new queue<AsyncStruct*>();
+        s_pAsyncStructQueue = new list<AsyncStruct*>();
         s_pImageQueue = new queue<ImageInfo*>();        
+        s_pUploadQueue = new list<ImageInfo*>();
+        s_pAsyncStructMap = new map<std::string, AsyncStruct*>();
         
         pthread_mutex_init(&s_asyncStructQueueMutex, NULL);
         pthread_mutex_init(&s_ImageInfoMutex, NULL);
-        pthread_mutex_init(&s_SleepMutex, NULL);
         pthread_cond_init(&s_SleepCondition, NULL);
+        need_quit = false;
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
-        pthread_create(&s_loadingThread, NULL, loadImage, NULL);
+        unsigned int threadCount = s_uAsyncThreadCount > 0 ? s_uAsyncThreadCount : CCJobPool::getProcessorCount();
+        s_pLoadingThreads = new pthread_t[threadCount];
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            if (pthread_create(&s_pLoadingThreads[s_uLoadingThreadCount], NULL, loadImage, NULL) == 0)
+            {
+                ++s_uLoadingThreadCount;
+            }
+        }
+        CCLOG("cocos2d: CCTextureCache: %u threads loading the images asynchronously", s_uLoadingThreadCount);
 #endif
-        need_quit = false;
     }
 
-    if (0 == s_nAsyncRefCount)
+    if (s_pAsyncStructMap->empty())
     {
         CCDirector::sharedDirector()->getScheduler()->scheduleSelector(schedule_selector(CCTextureCache::addImageAsyncCallBack), this, 0, false);
     }
 
-    ++s_nAsyncRefCount;
-
     if (target)
     {
         target->retain();
     }
 
+    AsyncRequest request;
+    request.target = target;
+    request.selector = selector;
+    request.handler = handler;
+
+    // the image is already loading, wait for it
+    map<std::string, AsyncStruct*>::iterator it = s_pAsyncStructMap->find(fullpath);
+    if (it != s_pAsyncStructMap->end())
+    {
+        AsyncStruct *data = it->second;
+        data->requests.push_back(request);
+        if (priority > data->priority && unqueueAsyncStruct(data))
+        {
+            data->priority = priority;
+            pthread_mutex_lock(&s_asyncStructQueueMutex);
+            queueAsyncStruct(data);
+            pthread_mutex_unlock(&s_asyncStructQueueMutex);
+        }
+        return;
+    }
+
     // generate async struct
     AsyncStruct *data = new AsyncStruct();
     data->filename = fullpath.c_str();
-    data->target = target;
-    data->selector = selector;
-    data->handler = handler;
+    data->priority = priority;
+    data->pixelFormat = CCTexture2D::defaultAlphaPixelFormat();
+    data->dither = CCTexture2D::isDitherEnabled();
+    data->requests.push_back(request);
+    s_pAsyncStructMap->insert(make_pair(fullpath, data));
 
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT) && (CC_TARGET_PLATFORM != CC_PLATFORM_WP8)
     // add async struct into queue
     pthread_mutex_lock(&s_asyncStructQueueMutex);
-    s_pAsyncStructQueue->push(data);
-    pthread_mutex_unlock(&s_asyncStructQueueMutex);
+    queueAsyncStruct(data);
     pthread_cond_signal(&s_SleepCondition);
+    pthread_mutex_unlock(&s_asyncStructQueueMutex);
 #else
     // WinRT uses an Async Task to load the image since the ThreadPool has a limited number of threads
     //std::replace( data->filename.begin(), data->filename.end(), '/', '\\'); 
@@ -350,71 +605,238 @@ void CCTextureCache::addImageAsyncImpl(const char *path, CCObject *target, SEL_C
 #endif
 }
 
+void CCTextureCache::cancelImageAsync(CCObject *target)
+{
+    removeAsyncRequests(isRequestOfTarget, target);
+}
+
+void CCTextureCache::cancelImageAsync(const char *path)
+{
+    CCAssert(path != NULL, "TextureCache: fileimage MUST not be NULL");
+    std::string fullpath = CCFileUtils::sharedFileUtils()->fullPathForFilename(path);
+    removeAsyncRequests(isRequestOfPath, &fullpath);
+}
+
+void CCTextureCache::cancelAllImageAsync()
+{
+    removeAsyncRequests(isAnyRequest, NULL);
+}
+
+void CCTextureCache::setAsyncCancelReleasedTargets(bool bEnabled)
+{
+    s_bAsyncCancelReleasedTargets = bEnabled;
+}
+
+bool CCTextureCache::isAsyncCancelReleasedTargets()
+{
+    return s_bAsyncCancelReleasedTargets;
+}
+
+void CCTextureCache::setAsyncThreadCount(unsigned int uCount)
+{
+    s_uAsyncThreadCount = uCount;
+}
+
+unsigned int CCTextureCache::getAsyncThreadCount()
+{
+    return s_uLoadingThreadCount > 0 ? s_uLoadingThreadCount : s_uAsyncThreadCount;
+}
+
+void CCTextureCache::setAsyncCompletionsPerFrame(unsigned int uCount)
+{
+    s_uAsyncCompletionsPerFrame = uCount;
+}
+
+unsigned int CCTextureCache::getAsyncCompletionsPerFrame()
+{
+    return s_uAsyncCompletionsPerFrame;
+}
+
+void CCTextureCache::setAsyncUploadBytesPerFrame(unsigned int uBytes)
+{
+    s_uAsyncUploadBytesPerFrame = uBytes;
+}
+
+unsigned int CCTextureCache::getAsyncUploadBytesPerFrame()
+{
+    return s_uAsyncUploadBytesPerFrame;
+}
+
+void CCTextureCache::setAsyncUploadTimePerFrame(float fSeconds)
+{
+    s_fAsyncUploadTimePerFrame = fSeconds;
+}
+
+float CCTextureCache::getAsyncUploadTimePerFrame()
+{
+    return s_fAsyncUploadTimePerFrame;
+}
+
+void CCTextureCache::setAsyncUploadSliceBytes(unsigned int uBytes)
+{
+    s_uAsyncUploadSliceBytes = uBytes;
+}
+
+unsigned int CCTextureCache::getAsyncUploadSliceBytes()
+{
+    return s_uAsyncUploadSliceBytes;
+}
+
+const ccTextureUploadStats& CCTextureCache::getAsyncUploadStats()
+{
+    return s_tAsyncUploadStats;
+}
+
 void CCTextureCache::addImageAsyncCallBack(float dt)
 {
-    // the image is generated in loading thread
-    std::queue<ImageInfo*> *imagesQueue = s_pImageQueue;
+    CC_PROFILER_ZONE("CCTextureCache - addImageAsyncCallBack");
 
+    if (s_bAsyncCancelReleasedTargets)
+    {
+        // forget the requests whose target has been released by everybody else
+        std::map<CCObject*, unsigned int> requestCounts;
+        for (map<std::string, AsyncStruct*>::iterator it = s_pAsyncStructMap->begin(); it != s_pAsyncStructMap->end(); ++it)
+        {
+            std::vector<AsyncRequest>& requests = it->second->requests;
+            for (size_t i = 0; i < requests.size(); ++i)
+            {
+                if (requests[i].target && ! requests[i].handler)
+                {
+                    ++requestCounts[requests[i].target];
+                }
+            }
+        }
+        std::set<CCObject*> releasedTargets;
+        for (std::map<CCObject*, unsigned int>::iterator it = requestCounts.begin(); it != requestCounts.end(); ++it)
+        {
+            if (it->first->retainCount() == it->second)
+            {
+                releasedTargets.insert(it->first);
+            }
+        }
+        if (! releasedTargets.empty())
+        {
+            removeAsyncRequests(isReleasedTargetRequest, &releasedTargets);
+        }
+    }
+
+    // the images are generated in loading threads, take the ones decoded since the last frame at once
     pthread_mutex_lock(&s_ImageInfoMutex);
-    if (imagesQueue->empty())
+    while (! s_pImageQueue->empty())
     {
-        pthread_mutex_unlock(&s_ImageInfoMutex);
+        s_pUploadQueue->push_back(s_pImageQueue->front());
+        s_pImageQueue->pop();
     }
-    else
+    pthread_mutex_unlock(&s_ImageInfoMutex);
+
+    // upload the textures within the budget of the frame, the rest waits for the next ones
+    unsigned long long startTime = CCProfiler::now();
+    unsigned int uploadedBytes = 0;
+    unsigned int completions = 0;
+    unsigned int uploadedTextures = 0;
+    bool bUploaded = false;
+    unsigned int maxTextureSize = CCConfiguration::sharedConfiguration()->getMaxTextureSize();
+    while (! s_pUploadQueue->empty())
     {
-        ImageInfo *pImageInfo = imagesQueue->front();
-        imagesQueue->pop();
-        pthread_mutex_unlock(&s_ImageInfoMutex);
-
+        ImageInfo *pImageInfo = s_pUploadQueue->front();
         AsyncStruct *pAsyncStruct = pImageInfo->asyncStruct;
         CCImage *pImage = pImageInfo->image;
-
-        CCObject *target = pAsyncStruct->target;
-        SEL_CallFuncO selector = pAsyncStruct->selector;
         const char* filename = pAsyncStruct->filename.c_str();
-        int handler = pAsyncStruct->handler;
 
-        // generate texture in render thread
-        CCTexture2D *texture = new CCTexture2D();
-#if 0 //TODO: (CC_TARGET_PLATFORM == CC_PLATFORM_IOS)
-        texture->initWithImage(pImage, kCCResolutioniPhone);
-#else
-        texture->initWithImage(pImage);
-#endif
+        // images failing to load or cancelled while decoding have no texture
+        CCTexture2D *texture = NULL;
+        bool bUpload = pImage && ! pAsyncStruct->requests.empty();
+        if (bUpload && (pImage->getWidth() > maxTextureSize || pImage->getHeight() > maxTextureSize))
+        {
+            CCLOG("cocos2d: WARNING: Image (%u x %u) is bigger than the supported %u x %u", pImage->getWidth(), pImage->getHeight(), maxTextureSize, maxTextureSize);
+            bUpload = false;
+        }
+        if (bUpload)
+        {
+            // the image may have been loaded synchronously meanwhile
+            texture = (CCTexture2D*)m_pTextures->objectForKey(filename);
+        }
+        if (bUpload && ! texture)
+        {
+            if ((bUploaded && isUploadBudgetSpent(uploadedBytes, startTime))
+                || (s_uAsyncCompletionsPerFrame > 0 && completions >= s_uAsyncCompletionsPerFrame))
+            {
+                break;
+            }
+
+            // generate texture in render thread
+            uploadedBytes += uploadImage(pImageInfo);
+            bUploaded = true;
+            if (pImageInfo->uploadedRows < pImage->getHeight())
+            {
+                continue;
+            }
+            texture = pImageInfo->texture;
+            ++uploadedTextures;
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
-       // cache the texture file name
-       VolatileTexture::addImageTexture(texture, filename, pImageInfo->imageType);
+            // cache the texture file name
+            VolatileTexture::addImageTexture(texture, filename, pImageInfo->imageType);
 #endif
 
-        // cache the texture
-        m_pTextures->setObject(texture, filename);
-        texture->autorelease();
-
-        if (target && selector)
-        {
-            (target->*selector)(texture);
-            target->release();
-        }        
-        if (handler)
+            // cache the texture
+            cacheTexture(texture, filename);
+        }
+        s_pUploadQueue->pop_front();
+        ++completions;
+
+        // the callbacks may request or cancel other images, the image must be forgotten first
+        std::vector<AsyncRequest> requests;
+        requests.swap(pAsyncStruct->requests);
+        s_pAsyncStructMap->erase(pAsyncStruct->filename);
+        if (texture)
         {
-            CCScriptEngineManager::sharedManager()->getScriptEngine()->executeEvent(handler, "addImageAsync", texture, "CCTexture2D");
+            touchTexture(texture);
+            texture->retain();
         }
+        deleteImageInfo(pImageInfo);
 
-        pImage->release();
-        delete pAsyncStruct;
-        delete pImageInfo;
+        for (size_t n = 0; n < requests.size(); ++n)
+        {
+            AsyncRequest& request = requests[n];
+            if (texture && request.target && request.selector)
+            {
+                (request.target->*request.selector)(texture);
+            }
+            if (texture && request.handler)
+            {
+                CCScriptEngineManager::sharedManager()->getScriptEngine()->executeEvent(request.handler, "addImageAsync", texture, "CCTexture2D");
+            }
+            CC_SAFE_RELEASE(request.target);
+        }
+        CC_SAFE_RELEASE(texture);
+    }
 
-        --s_nAsyncRefCount;
-        if (0 == s_nAsyncRefCount)
+    s_tAsyncUploadStats.queuedImages = 0;
+    s_tAsyncUploadStats.queuedBytes = 0;
+    for (list<ImageInfo*>::iterator it = s_pUploadQueue->begin(); it != s_pUploadQueue->end(); ++it)
+    {
+        ImageInfo *pImageInfo = *it;
+        if (pImageInfo->image)
         {
-            CCDirector::sharedDirector()->getScheduler()->unscheduleSelector(schedule_selector(CCTextureCache::addImageAsyncCallBack), this);
+            ++s_tAsyncUploadStats.queuedImages;
+            s_tAsyncUploadStats.queuedBytes += (pImageInfo->image->getHeight() - pImageInfo->uploadedRows) * getBytesPerRow(pImageInfo);
         }
     }
+    s_tAsyncUploadStats.uploadedBytes = uploadedBytes;
+    s_tAsyncUploadStats.uploadTime = bUploaded ? (CCProfiler::now() - startTime) / 1000000000.0f : 0.0f;
+    s_tAsyncUploadStats.uploadedTextures = uploadedTextures;
+
+    if (s_pAsyncStructMap->empty())
+    {
+        CCDirector::sharedDirector()->getScheduler()->unscheduleSelector(schedule_selector(CCTextureCache::addImageAsyncCallBack), this);
+    }
 }
 
 CCTexture2D * CCTextureCache::addImage(const char * path)
 {
+    CC_PROFILER_ZONE("CCTextureCache - addImage");
+
     CCAssert(path != NULL, "TextureCache: fileimage MUST not be NULL");
 
     CCTexture2D * texture = NULL;
@@ -502,7 +924,7 @@ CCTexture2D * CCTextureCache::addImage(const char * path)
                     // cache the texture file name
                     VolatileTexture::addImageTexture(texture, fullpath.c_str(), eImageFormat);
 #endif
-                    m_pTextures->setObject(texture, pathKey.c_str());
+                    cacheTexture(texture, pathKey.c_str());
                     texture->release();
                 }
                 else
@@ -516,7 +938,7 @@ CCTexture2D * CCTextureCache::addImage(const char * path)
     CC_SAFE_RELEASE(pImage);
 
     //pthread_mutex_unlock(m_pDictLock);
-    return texture;
+    return touchTexture(texture);
 }
 
 #ifndef QUICK_MINI_TARGET
@@ -530,7 +952,7 @@ CCTexture2D * CCTextureCache::addPVRImage(const char* path)
     
     if( (texture = (CCTexture2D*)m_pTextures->objectForKey(key.c_str())) ) 
     {
-        return texture;
+        return touchTexture(texture);
     }
 
     // Split up directory and filename
@@ -542,7 +964,7 @@ CCTexture2D * CCTextureCache::addPVRImage(const char* path)
         // cache the texture file name
         VolatileTexture::addImageTexture(texture, fullpath.c_str(), CCImage::kFmtRawData);
 #endif
-        m_pTextures->setObject(texture, key.c_str());
+        cacheTexture(texture, key.c_str());
         texture->autorelease();
     }
     else
@@ -551,7 +973,7 @@ CCTexture2D * CCTextureCache::addPVRImage(const char* path)
         CC_SAFE_DELETE(texture);
     }
 
-    return texture;
+    return touchTexture(texture);
 }
 
 CCTexture2D* CCTextureCache::addETCImage(const char* path)
@@ -563,7 +985,7 @@ CCTexture2D* CCTextureCache::addETCImage(const char* path)
     
     if( (texture = (CCTexture2D*)m_pTextures->objectForKey(key.c_str())) )
     {
-        return texture;
+        return touchTexture(texture);
     }
     
     // Split up directory and filename
@@ -571,7 +993,7 @@ CCTexture2D* CCTextureCache::addETCImage(const char* path)
     texture = new CCTexture2D();
     if(texture != NULL && texture->initWithETCFile(fullpath.c_str()))
     {
-        m_pTextures->setObject(texture, key.c_str());
+        cacheTexture(texture, key.c_str());
         texture->autorelease();
     }
     else
@@ -580,7 +1002,7 @@ CCTexture2D* CCTextureCache::addETCImage(const char* path)
         CC_SAFE_DELETE(texture);
     }
     
-    return texture;
+    return touchTexture(texture);
 }
 
 #endif // QUICK_MINI_TARGET
@@ -614,7 +1036,7 @@ CCTexture2D* CCTextureCache::addUIImage(CCImage *image, const char *key)
 
         if(key && texture)
         {
-            m_pTextures->setObject(texture, forKey.c_str());
+            cacheTexture(texture, forKey.c_str());
             texture->autorelease();
         }
         else
@@ -628,7 +1050,7 @@ CCTexture2D* CCTextureCache::addUIImage(CCImage *image, const char *key)
     VolatileTexture::addCCImage(texture, image);
 #endif
     
-    return texture;
+    return touchTexture(texture);
 }
 
 // TextureCache - Remove
@@ -680,6 +1102,133 @@ void CCTextureCache::removeUnusedTextures()
     }
 }
 
+static bool isUsedBefore(CCDictElement* pElement1, CCDictElement* pElement2)
+{
+    return ((CCTexture2D*)pElement1->getObject())->getLastUsedFrame() < ((CCTexture2D*)pElement2->getObject())->getLastUsedFrame();
+}
+
+unsigned int CCTextureCache::removeLeastRecentlyUsedTextures(unsigned int uBytes)
+{
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    // the textures are being recreated after the loss of the context
+    if (VolatileTexture::isReloading)
+    {
+        m_bEvictionDeferred = true;
+        return 0;
+    }
+#endif
+
+    unsigned int uFrame = CCDirector::sharedDirector()->getTotalFrames();
+    unsigned int uTotalBytes = 0;
+    std::vector<CCDictElement*> candidates;
+    m_bEvictionDeferred = false;
+    CCDictElement* pElement = NULL;
+    CCDICT_FOREACH(m_pTextures, pElement)
+    {
+        CCTexture2D *texture = (CCTexture2D*)pElement->getObject();
+        uTotalBytes += texture->getMemoryBytes();
+        if (texture->retainCount() > 1)
+        {
+            // retained by nodes, so in use
+            texture->setLastUsedFrame(uFrame);
+        }
+        else if (texture->getLastUsedFrame() != uFrame)
+        {
+            candidates.push_back(pElement);
+        }
+        else
+        {
+            m_bEvictionDeferred = true;
+        }
+    }
+    if (uTotalBytes <= uBytes)
+    {
+        return 0;
+    }
+
+    std::sort(candidates.begin(), candidates.end(), isUsedBefore);
+    unsigned int uFreedBytes = 0;
+    for (std::vector<CCDictElement*>::iterator iter = candidates.begin(); iter != candidates.end() && uTotalBytes - uFreedBytes > uBytes; ++iter)
+    {
+        CCTexture2D *texture = (CCTexture2D*)(*iter)->getObject();
+        uFreedBytes += texture->getMemoryBytes();
+        CCLOG("cocos2d: CCTextureCache: removing texture unused for %u frames: %s", uFrame - texture->getLastUsedFrame(), (*iter)->getStrKey());
+        m_pTextures->removeObjectForElememt(*iter);
+    }
+    return uFreedBytes;
+}
+
+void CCTextureCache::setMemoryBudget(unsigned int uBytes)
+{
+    m_uMemoryBudget = uBytes;
+    checkMemoryBudget();
+}
+
+unsigned int CCTextureCache::getMemoryBudget()
+{
+    return m_uMemoryBudget;
+}
+
+unsigned int CCTextureCache::getCachedTexturesBytes()
+{
+    unsigned int uTotalBytes = 0;
+    CCDictElement* pElement = NULL;
+    CCDICT_FOREACH(m_pTextures, pElement)
+    {
+        uTotalBytes += ((CCTexture2D*)pElement->getObject())->getMemoryBytes();
+    }
+    return uTotalBytes;
+}
+
+void CCTextureCache::memoryBudgetCallBack(float dt)
+{
+    checkMemoryBudget();
+}
+
+void CCTextureCache::checkMemoryBudget()
+{
+    unsigned int uTotalBytes = 0;
+    m_bEvictionDeferred = false;
+    if (m_uMemoryBudget > 0)
+    {
+        uTotalBytes = getCachedTexturesBytes();
+        if (uTotalBytes > m_uMemoryBudget)
+        {
+            uTotalBytes -= removeLeastRecentlyUsedTextures(m_uMemoryBudget);
+        }
+    }
+
+    // the textures kept only because this frame used them can be evicted by the next frames. When the textures
+    // retained by nodes are all that keep the cache over budget, the scans stop until a texture is added or the budget changes
+    bool bRetry = m_uMemoryBudget > 0 && uTotalBytes > m_uMemoryBudget && m_bEvictionDeferred;
+    if (bRetry && ! m_bMemoryBudgetScheduled)
+    {
+        CCDirector::sharedDirector()->getScheduler()->scheduleSelector(schedule_selector(CCTextureCache::memoryBudgetCallBack), this, 0, false);
+    }
+    else if (! bRetry && m_bMemoryBudgetScheduled)
+    {
+        CCDirector::sharedDirector()->getScheduler()->unscheduleSelector(schedule_selector(CCTextureCache::memoryBudgetCallBack), this);
+    }
+    m_bMemoryBudgetScheduled = bRetry;
+}
+
+void CCTextureCache::cacheTexture(CCTexture2D* texture, const char* key)
+{
+    m_pTextures->setObject(texture, key);
+    // stamped first, so the budget never evicts the texture being added
+    touchTexture(texture);
+    checkMemoryBudget();
+}
+
+CCTexture2D* CCTextureCache::touchTexture(CCTexture2D* texture)
+{
+    if (texture)
+    {
+        texture->setLastUsedFrame(CCDirector::sharedDirector()->getTotalFrames());
+    }
+    return texture;
+}
+
 void CCTextureCache::removeTexture(CCTexture2D* texture)
 {
     if( ! texture )
@@ -704,7 +1253,7 @@ void CCTextureCache::removeTextureForKey(const char *textureKeyName)
 
 CCTexture2D* CCTextureCache::textureForKey(const char* key)
 {
-    return (CCTexture2D*)m_pTextures->objectForKey(CCFileUtils::sharedFileUtils()->fullPathForFilename(key));
+    return touchTexture((CCTexture2D*)m_pTextures->objectForKey(CCFileUtils::sharedFileUtils()->fullPathForFilename(key)));
 }
 
 void CCTextureCache::reloadAllTextures()
@@ -718,27 +1267,34 @@ void CCTextureCache::dumpCachedTextureInfo()
 {
     unsigned int count = 0;
     unsigned int totalBytes = 0;
+    unsigned int frame = CCDirector::sharedDirector()->getTotalFrames();
 
     CCDictElement* pElement = NULL;
     CCDICT_FOREACH(m_pTextures, pElement)
     {
         CCTexture2D* tex = (CCTexture2D*)pElement->getObject();
         unsigned int bpp = tex->bitsPerPixelForFormat();
-        // Each texture takes up width * height * bytesPerPixel bytes.
-        unsigned int bytes = tex->getPixelsWide() * tex->getPixelsHigh() * bpp / 8;
+        // Each texture takes up width * height * bytesPerPixel bytes, plus a third with the mipmaps.
+        unsigned int bytes = tex->getMemoryBytes();
         totalBytes += bytes;
         count++;
-        CCLOG("cocos2d: \"%s\" rc=%lu id=%lu %lu x %lu @ %ld bpp => %lu KB",
+        CCLOG("cocos2d: \"%s\" rc=%lu id=%lu %lu x %lu @ %ld bpp%s => %lu KB, unused for %lu frames",
                pElement->getStrKey(),
                (long)tex->retainCount(),
                (long)tex->getName(),
                (long)tex->getPixelsWide(),
                (long)tex->getPixelsHigh(),
                (long)bpp,
-               (long)bytes / 1024);
+               tex->hasMipmaps() ? " mipmapped" : "",
+               (long)bytes / 1024,
+               (long)(frame - tex->getLastUsedFrame()));
     }
 
     CCLOG("cocos2d: CCTextureCache dumpDebugInfo: %ld textures, for %lu KB (%.2f MB)", (long)count, (long)totalBytes / 1024, totalBytes / (1024.0f*1024.0f));
+    if (m_uMemoryBudget > 0)
+    {
+        CCLOG("cocos2d: CCTextureCache dumpDebugInfo: budget of %lu KB (%.2f MB)", (long)m_uMemoryBudget / 1024, m_uMemoryBudget / (1024.0f*1024.0f));
+    }
 }
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
@@ -49,6 +49,21 @@ class CCImage;
  * @{
  */
 
+/** Uploads of the textures loaded asynchronously, updated every frame they are in progress */
+typedef struct _ccTextureUploadStats
+{
+    /** decoded images waiting for their upload */
+    unsigned int queuedImages;
+    /** bytes of these images left to upload */
+    unsigned int queuedBytes;
+    /** textures completed during the last frame */
+    unsigned int uploadedTextures;
+    /** bytes uploaded during the last frame */
+    unsigned int uploadedBytes;
+    /** seconds spent uploading during the last frame */
+    float        uploadTime;
+} ccTextureUploadStats;
+
 /** @brief Singleton that handles the loading of textures
 * Once the texture is loaded, the next time it will return
 * a reference of the previously loaded texture reducing GPU & CPU memory
@@ -59,10 +74,19 @@ protected:
     CCDictionary* m_pTextures;
     //pthread_mutex_t                *m_pDictLock;
 
+    unsigned int m_uMemoryBudget;
+    bool m_bMemoryBudgetScheduled;
+    //! whether the last removeLeastRecentlyUsedTextures kept unretained textures only because the current frame used them
+    bool m_bEvictionDeferred;
 
 private:
     /// todo: void addImageWithAsyncObject(CCAsyncObject* async);
     void addImageAsyncCallBack(float dt);
+    void addImageAsyncImpl(const char *path, CCObject *target, SEL_CallFuncO selector, int handler, int priority);
+    void memoryBudgetCallBack(float dt);
+    void checkMemoryBudget();
+    void cacheTexture(CCTexture2D* texture, const char* key);
+    CCTexture2D* touchTexture(CCTexture2D* texture);
 public:
     /**
      *  @js ctor
@@ -106,13 +130,66 @@ public:
     * If the file image was not previously loaded, it will create a new CCTexture2D object and it will return it.
     * Otherwise it will load a texture in a new thread, and when the image is loaded, the callback will be called with the Texture2D as a parameter.
     * The callback will be called from the main thread, so it is safe to create any cocos2d object from the callback.
+    * The images are decoded by a pool of threads, the ones with a higher priority first. Several requests of the same
+    * image share a single decode. The target is retained until the callback or until cancelImageAsync is called,
+    * so a target released by everybody else still gets its callback unless setAsyncCancelReleasedTargets is enabled.
+    * The texture takes the default alpha pixel format set when the image is first requested, and is uploaded within
+    * the budget set by setAsyncUploadBytesPerFrame and setAsyncUploadTimePerFrame.
     * Supported image extensions: .png, .jpg
     * @since v0.8
     * @lua NA
     */
-    void addImageAsync(const char *path, CCObject *target, SEL_CallFuncO selector);
-    void addImageAsync(const char *path, int handler);
-    void addImageAsyncImpl(const char *path, CCObject *target, SEL_CallFuncO selector, int handler = 0);
+    void addImageAsync(const char *path, CCObject *target, SEL_CallFuncO selector, int priority = 0);
+    void addImageAsync(const char *path, int handler, int priority = 0);
+
+    /** Cancels the asynchronous loads requested by a target, its callbacks won't be called.
+    * @lua NA
+    */
+    void cancelImageAsync(CCObject *target);
+    /** Cancels all the asynchronous loads of an image */
+    void cancelImageAsync(const char *path);
+    /** Cancels all the asynchronous loads */
+    void cancelAllImageAsync();
+
+    /** Whether the asynchronous loads of a target retained by nothing but its requests are cancelled,
+    * before the images are uploaded. When disabled, the callers must call cancelImageAsync for the targets going away.
+    * Defaults to CC_TEXTURE_CACHE_ASYNC_CANCEL_RELEASED_TARGETS.
+    * @lua NA
+    */
+    void setAsyncCancelReleasedTargets(bool bEnabled);
+    bool isAsyncCancelReleasedTargets();
+
+    /** Number of threads decoding the asynchronous loads, 0 means one per processor core.
+    * It is applied when the threads start, at the first asynchronous load after the cache is created.
+    */
+    void setAsyncThreadCount(unsigned int uCount);
+    unsigned int getAsyncThreadCount();
+
+    /** Maximum number of asynchronous loads completed per frame, 0 (the default) means no limit.
+    * Every completed load creates its texture on the main thread.
+    */
+    void setAsyncCompletionsPerFrame(unsigned int uCount);
+    unsigned int getAsyncCompletionsPerFrame();
+
+    /** Budget of the texture uploads of the asynchronous loads, per frame: the bytes uploaded and
+    * the seconds spent uploading. The images left wait for the next frames, 0 disables a limit.
+    * The first upload of a frame always happens, so big images still make progress.
+    */
+    void setAsyncUploadBytesPerFrame(unsigned int uBytes);
+    unsigned int getAsyncUploadBytesPerFrame();
+    void setAsyncUploadTimePerFrame(float fSeconds);
+    float getAsyncUploadTimePerFrame();
+
+    /** Images bigger than this are uploaded in slices of rows of about this size, checking the budget
+    * between the slices. 0 uploads every image at once.
+    */
+    void setAsyncUploadSliceBytes(unsigned int uBytes);
+    unsigned int getAsyncUploadSliceBytes();
+
+    /** queued bytes and upload time of the asynchronous loads
+    * @lua NA
+    */
+    const ccTextureUploadStats& getAsyncUploadStats();
 
     /* Returns a Texture2D object given an CGImageRef image
     * If the image was not previously loaded, it will create a new CCTexture2D object and it will return it.
@@ -149,6 +226,23 @@ public:
     */
     void removeUnusedTextures();
 
+    /** Removes the least recently used textures that have a retain count of 1,
+    * until the cached textures use at most uBytes of memory.
+    * The textures used during the current frame are kept. Returns the bytes freed.
+    */
+    unsigned int removeLeastRecentlyUsedTextures(unsigned int uBytes);
+
+    /** Memory budget of the cached textures in bytes, see CC_TEXTURE_CACHE_MEMORY_BUDGET.
+    * When set, removeLeastRecentlyUsedTextures is called with it whenever a texture is added, and then every frame
+    * while the textures used by the current frame keep the cache over budget. The textures retained by nodes are
+    * only evicted by the next addition or budget change after they are released. 0 means no limit.
+    */
+    void setMemoryBudget(unsigned int uBytes);
+    unsigned int getMemoryBudget();
+
+    /** bytes of memory used by the cached textures */
+    unsigned int getCachedTexturesBytes();
+
     /** Deletes a texture from the cache given a texture
     */
     void removeTexture(CCTexture2D* texture);
@@ -32,10 +32,34 @@ THE SOFTWARE.
 #include "shaders/CCGLProgram.h"
 #include "support/CCPointExtension.h"
 #include "support/data_support/ccCArray.h"
+#include "support/CCNotificationCenter.h"
+#include "support/CCProfiling.h"
+#include "shaders/ccGLStateCache.h"
 #include "CCDirector.h"
+#include "CCEventType.h"
+#include <stddef.h>
 
 NS_CC_BEGIN
 
+#if CC_SPRITEBATCHNODE_RENDER_SUBPIXEL
+#define RENDER_IN_SUBPIXEL
+#else
+#define RENDER_IN_SUBPIXEL(__ARGS__) (ceil(__ARGS__))
+#endif
+
+static unsigned int s_uDefaultChunkSize = CC_TMX_LAYER_CHUNK_SIZE;
+
+void CCTMXLayer::setDefaultChunkSize(unsigned int uChunkSize)
+{
+    // the quads of a chunk are indexed with GLushort
+    CCAssert(uChunkSize <= 128, "TMXLayer: the chunks can't be larger than 128 tiles");
+    s_uDefaultChunkSize = uChunkSize;
+}
+
+unsigned int CCTMXLayer::getDefaultChunkSize(void)
+{
+    return s_uDefaultChunkSize;
+}
 
 // CCTMXLayer - init & alloc & dealloc
 
@@ -56,6 +80,13 @@ bool CCTMXLayer::initWithTilesetInfo(CCTMXTilesetInfo *tilesetInfo, CCTMXLayerIn
     float totalNumberOfTiles = size.width * size.height;
     float capacity = totalNumberOfTiles * 0.35f + 1; // 35 percent is occupied ?
 
+    // with chunks, the texture atlas only holds the tiles returned by tileAt
+    m_uChunkSize = s_uDefaultChunkSize;
+    if (m_uChunkSize)
+    {
+        capacity = kDefaultSpriteBatchCapacity;
+    }
+
     CCTexture2D *texture = NULL;
     if( tilesetInfo )
     {
@@ -86,7 +117,7 @@ bool CCTMXLayer::initWithTilesetInfo(CCTMXTilesetInfo *tilesetInfo, CCTMXLayerIn
         CCPoint offset = this->calculateLayerOffset(layerInfo->m_tOffset);
         this->setPosition(CC_POINT_PIXELS_TO_POINTS(offset));
 
-        m_pAtlasIndexArray = ccCArrayNew((unsigned int)totalNumberOfTiles);
+        m_pAtlasIndexArray = ccCArrayNew(m_uChunkSize ? kDefaultSpriteBatchCapacity : (unsigned int)totalNumberOfTiles);
 
         this->setContentSize(CC_SIZE_PIXELS_TO_POINTS(CCSizeMake(m_tLayerSize.width * m_tMapTileSize.width, m_tLayerSize.height * m_tMapTileSize.height)));
 
@@ -107,6 +138,9 @@ CCTMXLayer::CCTMXLayer()
 ,m_sLayerName("")
 ,m_pReusedTile(NULL)
 ,m_pAtlasIndexArray(NULL)    
+,m_uChunkSize(0)
+,m_uChunksWide(0)
+,m_uChunkIndicesBuffer(0)
 {}
 
 CCTMXLayer::~CCTMXLayer()
@@ -122,6 +156,36 @@ CCTMXLayer::~CCTMXLayer()
     }
 
     CC_SAFE_DELETE_ARRAY(m_pTiles);
+
+    for (unsigned int i = 0; i < m_tChunks.size(); i++)
+    {
+        if (m_tChunks[i].buffer)
+        {
+            glDeleteBuffers(1, &m_tChunks[i].buffer);
+        }
+    }
+    if (m_uChunkIndicesBuffer)
+    {
+        glDeleteBuffers(1, &m_uChunkIndicesBuffer);
+    }
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    if (m_uChunkSize)
+    {
+        CCNotificationCenter::sharedNotificationCenter()->removeObserver(this, EVENT_COME_TO_FOREGROUND);
+    }
+#endif
+}
+
+void CCTMXLayer::listenBackToForeground(CCObject *obj)
+{
+    // the buffers died with the old context, the chunks are built again when they are visible
+    for (unsigned int i = 0; i < m_tChunks.size(); i++)
+    {
+        m_tChunks[i].buffer = 0;
+        m_tChunks[i].dirty = true;
+    }
+    m_uChunkIndicesBuffer = 0;
 }
 
 CCTMXTilesetInfo * CCTMXLayer::getTileSet()
@@ -138,6 +202,13 @@ void CCTMXLayer::setTileSet(CCTMXTilesetInfo* var)
 
 void CCTMXLayer::releaseMap()
 {
+    // the chunks are built from the gids, whenever they become visible
+    if (m_uChunkSize)
+    {
+        CCLOG("cocos2d: CCTMXLayer: the map of a layer drawn in chunks can't be released");
+        return;
+    }
+
     if (m_pTiles)
     {
         delete [] m_pTiles;
@@ -185,7 +256,11 @@ void CCTMXLayer::setupTiles()
             // XXX: gid == 0 --> empty tile
             if (gid != 0) 
             {
-                this->appendTileForGID(gid, ccp(x, y));
+                // with chunks, the quads are built when their chunk is visible
+                if (! m_uChunkSize)
+                {
+                    this->appendTileForGID(gid, ccp(x, y));
+                }
 
                 // Optimization: update min and max GID rendered by the layer
                 m_uMinGID = MIN(gid, m_uMinGID);
@@ -196,6 +271,11 @@ void CCTMXLayer::setupTiles()
 
     CCAssert( m_uMaxGID >= m_pTileSet->m_uFirstGid &&
         m_uMinGID >= m_pTileSet->m_uFirstGid, "TMX: Only 1 tileset per layer is supported");    
+
+    if (m_uChunkSize)
+    {
+        setupChunks();
+    }
 }
 
 // CCTMXLayer - Properties
@@ -345,8 +425,33 @@ CCSprite * CCTMXLayer::tileAt(const CCPoint& pos)
             tile->setAnchorPoint(CCPointZero);
             tile->setOpacity(m_cOpacity);
 
-            unsigned int indexForZ = atlasIndexForExistantZ(z);
-            this->addSpriteWithoutQuad(tile, indexForZ, z);
+            if (m_uChunkSize)
+            {
+                // the tile leaves its chunk and gets a quad of the texture atlas
+                unsigned int indexForZ = atlasIndexForNewZ(z);
+                this->insertQuadFromSprite(tile, indexForZ);
+
+                // the quads of the other tiles moved
+                CCObject* pObject = NULL;
+                CCARRAY_FOREACH(m_pChildren, pObject)
+                {
+                    CCSprite* pChild = (CCSprite*) pObject;
+                    unsigned int ai = pChild->getAtlasIndex();
+                    if (ai >= indexForZ)
+                    {
+                        pChild->setAtlasIndex(ai+1);
+                    }
+                }
+
+                ccCArrayInsertValueAtIndex(m_pAtlasIndexArray, (void*)(intptr_t)z, indexForZ);
+                this->addSpriteWithoutQuad(tile, indexForZ, z);
+                setChunkDirtyAt(pos);
+            }
+            else
+            {
+                unsigned int indexForZ = atlasIndexForExistantZ(z);
+                this->addSpriteWithoutQuad(tile, indexForZ, z);
+            }
             tile->release();
         }
     }
@@ -523,7 +628,15 @@ void CCTMXLayer::setTileGID(unsigned int gid, const CCPoint& pos, ccTMXTileFlags
         // empty tile. create a new one
         else if (currentGID == 0)
         {
-            insertTileForGID(gidAndFlags, pos);
+            if (m_uChunkSize)
+            {
+                m_pTiles[(unsigned int)(pos.x + pos.y * m_tLayerSize.width)] = gidAndFlags;
+                setChunkDirtyAt(pos);
+            }
+            else
+            {
+                insertTileForGID(gidAndFlags, pos);
+            }
         }
         // modifying an existing tile with a non-empty tile
         else 
@@ -542,6 +655,11 @@ void CCTMXLayer::setTileGID(unsigned int gid, const CCPoint& pos, ccTMXTileFlags
                 }
                 m_pTiles[z] = gidAndFlags;
             } 
+            else if (m_uChunkSize)
+            {
+                m_pTiles[z] = gidAndFlags;
+                setChunkDirtyAt(pos);
+            }
             else 
             {
                 updateTileForGID(gidAndFlags, pos);
@@ -580,7 +698,24 @@ void CCTMXLayer::removeTileAt(const CCPoint& pos)
 
     unsigned int gid = tileGIDAt(pos);
 
-    if (gid) 
+    if (gid && m_uChunkSize)
+    {
+        unsigned int z = (unsigned int)(pos.x + pos.y * m_tLayerSize.width);
+        m_pTiles[z] = 0;
+
+        // only the tiles returned by tileAt have a quad in the texture atlas
+        CCSprite *sprite = (CCSprite*)getChildByTag(z);
+        if (sprite)
+        {
+            ccCArrayRemoveValueAtIndex(m_pAtlasIndexArray, atlasIndexForExistantZ(z));
+            CCSpriteBatchNode::removeChild(sprite, true);
+        }
+        else
+        {
+            setChunkDirtyAt(pos);
+        }
+    }
+    else if (gid) 
     {
         unsigned int z = (unsigned int)(pos.x + pos.y * m_tLayerSize.width);
         unsigned int atlasIndex = atlasIndexForExistantZ(z);
@@ -622,6 +757,319 @@ void CCTMXLayer::removeTileAt(const CCPoint& pos)
     }
 }
 
+// CCTMXLayer - chunks
+void CCTMXLayer::setupChunks()
+{
+    m_uChunksWide = ((unsigned int)m_tLayerSize.width + m_uChunkSize - 1) / m_uChunkSize;
+    unsigned int chunksHigh = ((unsigned int)m_tLayerSize.height + m_uChunkSize - 1) / m_uChunkSize;
+
+    // the tiles can be larger than the map's tiles, and rotated
+    float extent = MAX(m_pTileSet->m_tTileSize.width, m_pTileSet->m_tTileSize.height) / m_fContentScaleFactor;
+    float hexOffset = (m_uLayerOrientation == CCTMXOrientationHex) ? m_tMapTileSize.height / 2 / m_fContentScaleFactor : 0;
+
+    m_tChunks.resize(m_uChunksWide * chunksHigh);
+    for (unsigned int cy = 0; cy < chunksHigh; cy++)
+    {
+        for (unsigned int cx = 0; cx < m_uChunksWide; cx++)
+        {
+            float x0 = (float)(cx * m_uChunkSize);
+            float y0 = (float)(cy * m_uChunkSize);
+            float x1 = MIN(x0 + m_uChunkSize, m_tLayerSize.width) - 1;
+            float y1 = MIN(y0 + m_uChunkSize, m_tLayerSize.height) - 1;
+
+            // the positions are linear in the tile coordinates, the corners of the chunk bound them
+            CCPoint corners[4] = { positionAt(ccp(x0, y0)), positionAt(ccp(x1, y0)), positionAt(ccp(x0, y1)), positionAt(ccp(x1, y1)) };
+            float minX = corners[0].x, maxX = corners[0].x, minY = corners[0].y, maxY = corners[0].y;
+            for (int i = 1; i < 4; i++)
+            {
+                minX = MIN(minX, corners[i].x);
+                maxX = MAX(maxX, corners[i].x);
+                minY = MIN(minY, corners[i].y);
+                maxY = MAX(maxY, corners[i].y);
+            }
+
+            ccTMXChunk& chunk = m_tChunks[cx + cy * m_uChunksWide];
+            chunk.bounds = CCRectMake(minX, minY - hexOffset, maxX - minX + extent, maxY - minY + extent + hexOffset);
+            chunk.buffer = 0;
+            chunk.quadCount = 0;
+            chunk.dirty = true;
+        }
+    }
+
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+    // listen the event when app go to background
+    CCNotificationCenter::sharedNotificationCenter()->addObserver(this,
+                                                           callfuncO_selector(CCTMXLayer::listenBackToForeground),
+                                                           EVENT_COME_TO_FOREGROUND,
+                                                           NULL);
+#endif
+}
+
+void CCTMXLayer::setChunkDirtyAt(const CCPoint& pos)
+{
+    unsigned int cx = (unsigned int)pos.x / m_uChunkSize;
+    unsigned int cy = (unsigned int)pos.y / m_uChunkSize;
+    m_tChunks[cx + cy * m_uChunksWide].dirty = true;
+}
+
+bool CCTMXLayer::hasTileSpriteAt(unsigned int z)
+{
+    // with chunks, the atlas index array only holds the tiles returned by tileAt
+    if (m_pAtlasIndexArray->num == 0)
+    {
+        return false;
+    }
+    int key = z;
+    return bsearch((void*)&key, (void*)&m_pAtlasIndexArray->arr[0], m_pAtlasIndexArray->num, sizeof(void*), compareInts) != NULL;
+}
+
+void CCTMXLayer::setupTileQuad(unsigned int gid, const CCPoint& pos, ccV3F_C4B_T2F_Quad* quad)
+{
+    CCRect rect = m_pTileSet->rectForGID(gid);
+    CCTexture2D *tex = m_pobTextureAtlas->getTexture();
+    float atlasWidth = (float)tex->getPixelsWide();
+    float atlasHeight = (float)tex->getPixelsHigh();
+
+    // same texture coordinates as the tile sprites, see CCSprite::setTextureCoords
+    float left, right, top, bottom;
+#if CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+    left    = (2*rect.origin.x+1)/(2*atlasWidth);
+    right   = left + (rect.size.width*2-2)/(2*atlasWidth);
+    top     = (2*rect.origin.y+1)/(2*atlasHeight);
+    bottom  = top + (rect.size.height*2-2)/(2*atlasHeight);
+#else
+    left    = rect.origin.x/atlasWidth;
+    right   = (rect.origin.x + rect.size.width) / atlasWidth;
+    top     = rect.origin.y/atlasHeight;
+    bottom  = (rect.origin.y + rect.size.height) / atlasHeight;
+#endif // ! CC_FIX_ARTIFACTS_BY_STRECHING_TEXEL
+
+    float width = rect.size.width / m_fContentScaleFactor;
+    float height = rect.size.height / m_fContentScaleFactor;
+
+    // corners of the tile in the texture, bottom left, bottom right, top left, top right
+    ccTex2F bl = { left, bottom }, br = { right, bottom }, tl = { left, top }, tr = { right, top };
+
+    // the diagonal flag rotates the tile like setupTileSprite does
+    if (gid & kCCTMXTileDiagonalFlag)
+    {
+        unsigned int flag = gid & (kCCTMXTileHorizontalFlag | kCCTMXTileVerticalFlag);
+        if (flag == 0 || flag == (kCCTMXTileVerticalFlag | kCCTMXTileHorizontalFlag))
+        {
+            CC_SWAP(bl, br, ccTex2F);
+            CC_SWAP(tl, tr, ccTex2F);
+        }
+
+        if (flag == kCCTMXTileHorizontalFlag || flag == (kCCTMXTileVerticalFlag | kCCTMXTileHorizontalFlag))
+        {
+            // rotated by 90 degrees
+            quad->bl.texCoords = br;
+            quad->br.texCoords = tr;
+            quad->tl.texCoords = bl;
+            quad->tr.texCoords = tl;
+        }
+        else
+        {
+            // rotated by 270 degrees
+            quad->bl.texCoords = tl;
+            quad->br.texCoords = bl;
+            quad->tl.texCoords = tr;
+            quad->tr.texCoords = br;
+        }
+        CC_SWAP(width, height, float);
+    }
+    else
+    {
+        if (gid & kCCTMXTileHorizontalFlag)
+        {
+            CC_SWAP(bl, br, ccTex2F);
+            CC_SWAP(tl, tr, ccTex2F);
+        }
+        if (gid & kCCTMXTileVerticalFlag)
+        {
+            CC_SWAP(bl, tl, ccTex2F);
+            CC_SWAP(br, tr, ccTex2F);
+        }
+        quad->bl.texCoords = bl;
+        quad->br.texCoords = br;
+        quad->tl.texCoords = tl;
+        quad->tr.texCoords = tr;
+    }
+
+    CCPoint position = positionAt(pos);
+    float vertexZ = (float)vertexZForPos(pos);
+    float x1 = RENDER_IN_SUBPIXEL(position.x);
+    float y1 = RENDER_IN_SUBPIXEL(position.y);
+    float x2 = RENDER_IN_SUBPIXEL(position.x + width);
+    float y2 = RENDER_IN_SUBPIXEL(position.y + height);
+    quad->bl.vertices = vertex3(x1, y1, vertexZ);
+    quad->br.vertices = vertex3(x2, y1, vertexZ);
+    quad->tl.vertices = vertex3(x1, y2, vertexZ);
+    quad->tr.vertices = vertex3(x2, y2, vertexZ);
+
+    // same color as the tile sprites, which have the opacity of the layer
+    ccColor4B color = ccc4(255, 255, 255, m_cOpacity);
+    if (tex->hasPremultipliedAlpha())
+    {
+        color.r = color.g = color.b = m_cOpacity;
+    }
+    quad->bl.colors = color;
+    quad->br.colors = color;
+    quad->tl.colors = color;
+    quad->tr.colors = color;
+}
+
+void CCTMXLayer::buildChunk(unsigned int index)
+{
+    ccTMXChunk& chunk = m_tChunks[index];
+    unsigned int x0 = (index % m_uChunksWide) * m_uChunkSize;
+    unsigned int y0 = (index / m_uChunksWide) * m_uChunkSize;
+    unsigned int x1 = MIN(x0 + m_uChunkSize, (unsigned int)m_tLayerSize.width);
+    unsigned int y1 = MIN(y0 + m_uChunkSize, (unsigned int)m_tLayerSize.height);
+
+    // the tiles are drawn in the same order as in the texture atlas, row by row
+    std::vector<ccV3F_C4B_T2F_Quad> quads;
+    quads.reserve((x1 - x0) * (y1 - y0));
+    for (unsigned int y = y0; y < y1; y++)
+    {
+        for (unsigned int x = x0; x < x1; x++)
+        {
+            unsigned int z = (unsigned int)(x + m_tLayerSize.width * y);
+            unsigned int gid = m_pTiles[z];
+            // the tiles returned by tileAt are drawn by the texture atlas
+            if (gid != 0 && ! hasTileSpriteAt(z))
+            {
+                quads.push_back(ccV3F_C4B_T2F_Quad());
+                setupTileQuad(gid, ccp(x, y), &quads.back());
+            }
+        }
+    }
+
+    chunk.quadCount = (unsigned int)quads.size();
+    chunk.dirty = false;
+    if (chunk.quadCount == 0)
+    {
+        return;
+    }
+
+    if (! chunk.buffer)
+    {
+        glGenBuffers(1, &chunk.buffer);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, chunk.buffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quads[0]) * chunk.quadCount, &quads[0], GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void CCTMXLayer::drawChunks()
+{
+    CCDirector* pDirector = CCDirector::sharedDirector();
+    CCRect visibleRect;
+    visibleRect.origin = pDirector->getVisibleOrigin();
+    visibleRect.size = pDirector->getVisibleSize();
+    CCAffineTransform t = nodeToWorldTransform();
+
+    bool bSetup = false;
+    unsigned int culled = 0;
+    for (unsigned int i = 0; i < m_tChunks.size(); i++)
+    {
+        if (! CCRectApplyAffineTransform(m_tChunks[i].bounds, t).intersectsRect(visibleRect))
+        {
+            culled++;
+            continue;
+        }
+
+        // the geometry of a chunk is built the first time it is visible
+        if (m_tChunks[i].dirty)
+        {
+            buildChunk(i);
+        }
+        if (m_tChunks[i].quadCount == 0)
+        {
+            continue;
+        }
+
+        if (! bSetup)
+        {
+            bSetup = true;
+            CC_NODE_DRAW_SETUP();
+            ccGLBlendFunc(m_blendFunc.src, m_blendFunc.dst);
+            ccGLBindTexture2D(m_pobTextureAtlas->getTexture()->getName());
+
+#if CC_TEXTURE_ATLAS_USE_VAO
+            // Avoid changing the element buffer for whatever VAO might be bound.
+            ccGLBindVAO(0);
+#endif
+
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_uChunkIndicesBuffer);
+            if (! m_uChunkIndicesBuffer)
+            {
+                unsigned int capacity = m_uChunkSize * m_uChunkSize;
+                GLushort* pIndices = (GLushort*)malloc(capacity * 6 * sizeof(GLushort));
+                for (unsigned int j = 0; j < capacity; j++)
+                {
+                    pIndices[j*6+0] = j*4+0;
+                    pIndices[j*6+1] = j*4+1;
+                    pIndices[j*6+2] = j*4+2;
+
+                    // inverted index. issue #179
+                    pIndices[j*6+3] = j*4+3;
+                    pIndices[j*6+4] = j*4+2;
+                    pIndices[j*6+5] = j*4+1;
+                }
+                glGenBuffers(1, &m_uChunkIndicesBuffer);
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_uChunkIndicesBuffer);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, capacity * 6 * sizeof(GLushort), pIndices, GL_STATIC_DRAW);
+                free(pIndices);
+            }
+
+            ccGLEnableVertexAttribs(kCCVertexAttribFlag_PosColorTex);
+        }
+
+#define kQuadSize sizeof(ccV3F_C4B_T2F)
+        glBindBuffer(GL_ARRAY_BUFFER, m_tChunks[i].buffer);
+
+        // vertices
+        glVertexAttribPointer(kCCVertexAttrib_Position, 3, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(ccV3F_C4B_T2F, vertices));
+
+        // colors
+        glVertexAttribPointer(kCCVertexAttrib_Color, 4, GL_UNSIGNED_BYTE, GL_TRUE, kQuadSize, (GLvoid*) offsetof(ccV3F_C4B_T2F, colors));
+
+        // tex coords
+        glVertexAttribPointer(kCCVertexAttrib_TexCoords, 2, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(ccV3F_C4B_T2F, texCoords));
+
+        glDrawElements(GL_TRIANGLES, (GLsizei)m_tChunks[i].quadCount*6, GL_UNSIGNED_SHORT, 0);
+        CC_INCREMENT_GL_DRAWS(1);
+    }
+
+    if (bSetup)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        CHECK_GL_ERROR_DEBUG();
+    }
+
+    CC_INCREMENT_CULLED_NODES(culled);
+}
+
+void CCTMXLayer::draw()
+{
+    if (! m_uChunkSize)
+    {
+        CCSpriteBatchNode::draw();
+        return;
+    }
+
+    CC_PROFILER_START("CCTMXLayer - draw");
+
+    drawChunks();
+
+    // the tiles returned by tileAt
+    CCSpriteBatchNode::draw();
+
+    CC_PROFILER_STOP("CCTMXLayer - draw");
+}
+
 //CCTMXLayer - obtaining positions, offset
 CCPoint CCTMXLayer::calculateLayerOffset(const CCPoint& pos)
 {
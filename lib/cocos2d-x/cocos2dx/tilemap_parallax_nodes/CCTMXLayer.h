@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "base_nodes/CCAtlasNode.h"
 #include "sprite_nodes/CCSpriteBatchNode.h"
 #include "CCTMXXMLParser.h"
+#include <vector>
 NS_CC_BEGIN
 
 class CCTMXMapInfo;
@@ -69,6 +70,12 @@ http://www.cocos2d-iphone.org/wiki/doku.php/prog_guide:tiled_maps
 Tiles can have tile flags for additional properties. At the moment only flip horizontal and flip vertical are used. These bit flags are defined in CCTMXXMLParser.h.
 
 @since 1.1
+
+When the layer is created with a chunk size (see setDefaultChunkSize), the tiles are not put in the CCTextureAtlas.
+The layer is split into square chunks of tiles, each one with its own vertex buffer built the first time the chunk
+is visible, and only the chunks intersecting the visible rect are drawn. The tiles returned by tileAt are still
+CCSprite children drawn by the texture atlas, after the chunks. Changing a tile rebuilds its chunk the next time
+it is drawn.
 */
 
 class CC_DLL CCTMXLayer : public CCSpriteBatchNode
@@ -108,6 +115,7 @@ public:
     /** dealloc the map that contains the tile position from memory.
     Unless you want to know at runtime the tiles positions, you can safely call this method.
     If you are going to call layer->tileGIDAt() then, don't release the map
+    The layers drawn in chunks keep their map, their chunks are built from it.
     */
     void releaseMap();
 
@@ -178,6 +186,27 @@ public:
 
     inline const char* getLayerName(){ return m_sLayerName.c_str(); }
     inline void setLayerName(const char *layerName){ m_sLayerName = layerName; }
+
+    /** Side, in tiles, of the chunks of the layers created from now on. 0 puts all the tiles in the texture atlas.
+     It can't be greater than 128. Default is CC_TMX_LAYER_CHUNK_SIZE.
+     */
+    static void setDefaultChunkSize(unsigned int uChunkSize);
+    static unsigned int getDefaultChunkSize(void);
+
+    /** Side of the chunks of this layer in tiles, 0 if its tiles are in the texture atlas */
+    inline unsigned int getChunkSize(void) { return m_uChunkSize; }
+
+    /**
+     * @js NA
+     * @lua NA
+     */
+    virtual void draw(void);
+
+    /** listen the event that coming to foreground on Android
+     * @js NA
+     * @lua NA
+     */
+    void listenBackToForeground(CCObject *obj);
 private:
     CCPoint positionForIsoAt(const CCPoint& pos);
     CCPoint positionForOrthoAt(const CCPoint& pos);
@@ -199,6 +228,25 @@ private:
     // index
     unsigned int atlasIndexForExistantZ(unsigned int z);
     unsigned int atlasIndexForNewZ(int z);
+
+    /* chunks */
+    typedef struct _ccTMXChunk
+    {
+        //! bounding box of the tiles of the chunk, in points
+        CCRect bounds;
+        //! vertex buffer of the quads, 0 until the chunk is visible
+        GLuint buffer;
+        unsigned int quadCount;
+        //! the quads have to be built again before drawing the chunk
+        bool dirty;
+    } ccTMXChunk;
+
+    void setupChunks();
+    void buildChunk(unsigned int index);
+    void drawChunks();
+    void setupTileQuad(unsigned int gid, const CCPoint& pos, ccV3F_C4B_T2F_Quad* quad);
+    void setChunkDirtyAt(const CCPoint& pos);
+    bool hasTileSpriteAt(unsigned int z);
 protected:
     //! name of the layer
     std::string m_sLayerName;
@@ -218,6 +266,14 @@ protected:
     
     // used for retina display
     float               m_fContentScaleFactor;            
+
+    //! 0 if the tiles are quads of the texture atlas
+    unsigned int        m_uChunkSize;
+    //! chunks in rows of m_uChunksWide
+    std::vector<ccTMXChunk> m_tChunks;
+    unsigned int        m_uChunksWide;
+    //! indices shared by the chunks
+    GLuint              m_uChunkIndicesBuffer;
 };
 
 // end of tilemap_parallax_nodes group
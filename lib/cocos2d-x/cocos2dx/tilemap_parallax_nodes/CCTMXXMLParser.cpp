@@ -27,13 +27,14 @@ THE SOFTWARE.
 
 #include <map>
 #include <sstream>
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
 #include "CCTMXXMLParser.h"
 #include "CCTMXTiledMap.h"
 #include "ccMacros.h"
 #include "platform/CCFileUtils.h"
-#include "support/zip_support/ZipUtils.h"
 #include "support/CCPointExtension.h"
-#include "support/base64.h"
 #include "platform/platform.h"
 
 using namespace std;
@@ -64,6 +65,201 @@ static const char* valueForKey(const char *key, std::map<std::string, std::strin
     }
     return "";
 }
+
+//////////////////////////////////////////////////////////////////////////
+// Compiled maps, version 1. The numbers are 4 bytes little endian, the strings are a length and
+// their characters, the flags and the opacity are 1 byte.
+// "TMXC" version orientation mapSize tileSize properties
+// tilesets: count, then name firstGid tileSize spacing margin sourceImage imageSize
+// tile properties: count, then gid properties
+// layers: count, then name layerSize visible opacity offset minGID maxGID properties tileCount tiles
+// object groups: count, then name positionOffset properties objectCount objects
+// The properties and the objects are dictionaries: count, then key value. A value is a type byte,
+// 's' for a string, 'a' for an array (count then values) or 'd' for a dictionary, then its content.
+// The tiles are stored as they are in memory, like the data of the tmx files.
+//////////////////////////////////////////////////////////////////////////
+#define TMX_COMPILED_MAP_MAGIC "TMXC"
+#define TMX_COMPILED_MAP_VERSION 1
+
+// size of the decoded bytes handed to zlib at once
+#define TMX_DECODER_BUFFER_SIZE (32 * 1024)
+
+// value of the base64 characters, -1 for the others
+static signed char s_base64Values[256];
+static bool s_bBase64ValuesInited = false;
+
+/** Decodes the base64 text of a <data> element as the parser hands it over, and inflates it when it is
+ compressed, straight into the tiles of the layer. Neither the text nor the decoded bytes are kept whole.
+ */
+class CCTMXTileDataDecoder
+{
+public:
+    CCTMXTileDataDecoder(unsigned int *pTiles, unsigned int uTileCount, bool bCompressed)
+    : m_pOut((unsigned char*)pTiles)
+    , m_uOutLength(uTileCount * sizeof(unsigned int))
+    , m_uOutOffset(0)
+    , m_bCompressed(bCompressed)
+    , m_bStreamInited(false)
+    , m_bDone(false)
+    , m_bError(false)
+    , m_uQuad(0)
+    , m_nQuadChars(0)
+    , m_uBufferLength(0)
+    {
+        if (! s_bBase64ValuesInited)
+        {
+            const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            memset(s_base64Values, -1, sizeof(s_base64Values));
+            for (int i = 0; i < 64; ++i)
+            {
+                s_base64Values[(unsigned char)alphabet[i]] = (signed char)i;
+            }
+            s_bBase64ValuesInited = true;
+        }
+
+        if (m_bCompressed)
+        {
+            memset(&m_tStream, 0, sizeof(m_tStream));
+            // 15 + 32: window of 32k, and zlib or gzip header detected automatically
+            m_bStreamInited = (inflateInit2(&m_tStream, 15 + 32) == Z_OK);
+            m_bError = ! m_bStreamInited;
+        }
+    }
+
+    ~CCTMXTileDataDecoder()
+    {
+        if (m_bStreamInited)
+        {
+            inflateEnd(&m_tStream);
+        }
+    }
+
+    void decode(const char *text, int len)
+    {
+        const unsigned char *p = (const unsigned char*)text;
+        const unsigned char *end = p + len;
+        unsigned int quad = m_uQuad;
+        int quadChars = m_nQuadChars;
+        while (p < end && ! m_bDone && ! m_bError)
+        {
+            unsigned char *out = m_pBuffer + m_uBufferLength;
+            unsigned char *outEnd = m_pBuffer + TMX_DECODER_BUFFER_SIZE - 3;
+            while (p < end && out <= outEnd)
+            {
+                // whitespaces and the '=' padding are skipped, finish() handles the last incomplete quad
+                int value = s_base64Values[*p++];
+                if (value < 0)
+                {
+                    continue;
+                }
+                quad = (quad << 6) | value;
+                if (++quadChars == 4)
+                {
+                    out[0] = (unsigned char)(quad >> 16);
+                    out[1] = (unsigned char)(quad >> 8);
+                    out[2] = (unsigned char)quad;
+                    out += 3;
+                    quad = 0;
+                    quadChars = 0;
+                }
+            }
+            m_uBufferLength = (unsigned int)(out - m_pBuffer);
+            if (out > outEnd)
+            {
+                flush();
+            }
+        }
+        m_uQuad = quad;
+        m_nQuadChars = quadChars;
+    }
+
+    /** Flushes the last bytes. Returns false if the data couldn't be decoded. */
+    bool finish()
+    {
+        // there is always room for the two last bytes, the buffer is flushed when it has less than 3 bytes left
+        if (m_nQuadChars == 2)
+        {
+            m_pBuffer[m_uBufferLength++] = (unsigned char)(m_uQuad >> 4);
+        }
+        else if (m_nQuadChars == 3)
+        {
+            m_pBuffer[m_uBufferLength++] = (unsigned char)(m_uQuad >> 10);
+            m_pBuffer[m_uBufferLength++] = (unsigned char)(m_uQuad >> 2);
+        }
+        m_nQuadChars = 0;
+        flush();
+        return ! m_bError;
+    }
+
+    /** Number of bytes of tiles written */
+    inline unsigned int getDecodedLength() { return m_uOutOffset; }
+
+private:
+    // hands the decoded bytes to zlib, or copies them when the data isn't compressed
+    void flush()
+    {
+        if (m_uBufferLength == 0 || m_bDone || m_bError)
+        {
+            m_uBufferLength = 0;
+            return;
+        }
+
+        if (! m_bCompressed)
+        {
+            unsigned int length = MIN(m_uBufferLength, m_uOutLength - m_uOutOffset);
+            memcpy(m_pOut + m_uOutOffset, m_pBuffer, length);
+            m_uOutOffset += length;
+            if (length < m_uBufferLength)
+            {
+                CCLOG("cocos2d: TiledMap: the data is larger than the layer");
+                m_bDone = true;
+            }
+            m_uBufferLength = 0;
+            return;
+        }
+
+        m_tStream.next_in = m_pBuffer;
+        m_tStream.avail_in = m_uBufferLength;
+        while (m_tStream.avail_in > 0 && ! m_bDone && ! m_bError)
+        {
+            if (m_uOutOffset == m_uOutLength)
+            {
+                CCLOG("cocos2d: TiledMap: the data is larger than the layer");
+                m_bDone = true;
+                break;
+            }
+            m_tStream.next_out = m_pOut + m_uOutOffset;
+            m_tStream.avail_out = m_uOutLength - m_uOutOffset;
+
+            int err = inflate(&m_tStream, Z_NO_FLUSH);
+            m_uOutOffset = m_uOutLength - m_tStream.avail_out;
+            if (err == Z_STREAM_END)
+            {
+                m_bDone = true;
+            }
+            else if (err != Z_OK)
+            {
+                CCLOG("cocos2d: TiledMap: inflate data error %d", err);
+                m_bError = true;
+            }
+        }
+        m_uBufferLength = 0;
+    }
+
+    unsigned char *m_pOut;
+    unsigned int m_uOutLength;
+    unsigned int m_uOutOffset;
+    bool m_bCompressed;
+    bool m_bStreamInited;
+    bool m_bDone;
+    bool m_bError;
+    z_stream m_tStream;
+    unsigned int m_uQuad;
+    int m_nQuadChars;
+    unsigned char m_pBuffer[TMX_DECODER_BUFFER_SIZE];
+    unsigned int m_uBufferLength;
+};
+
 // implementation CCTMXLayerInfo
 CCTMXLayerInfo::CCTMXLayerInfo()
 : m_sName("")
@@ -189,7 +385,32 @@ bool CCTMXMapInfo::initWithXML(const char* tmxString, const char* resourcePath)
 bool CCTMXMapInfo::initWithTMXFile(const char *tmxFile)
 {
     internalInit(tmxFile, NULL);
-    return parseXMLFile(m_sTMXFileName.c_str());
+
+    // the file is read once, then parsed as a compiled map or as XML depending on its header
+    unsigned long size = 0;
+    unsigned char* pData = CCFileUtils::sharedFileUtils()->getFileData(m_sTMXFileName.c_str(), "rb", &size);
+    if (! pData || size == 0)
+    {
+        CC_SAFE_DELETE_ARRAY(pData);
+        return false;
+    }
+
+    bool bRet = false;
+    if (size >= 4 && memcmp(pData, TMX_COMPILED_MAP_MAGIC, 4) == 0)
+    {
+        bRet = parseCompiledMap(pData, size);
+    }
+    else
+    {
+        CCSAXParser parser;
+        if (parser.init("UTF-8"))
+        {
+            parser.setDelegator(this);
+            bRet = parser.parse((const char*)pData, (unsigned int)size);
+        }
+    }
+    CC_SAFE_DELETE_ARRAY(pData);
+    return bRet;
 }
 
 CCTMXMapInfo::CCTMXMapInfo()
@@ -203,6 +424,7 @@ CCTMXMapInfo::CCTMXMapInfo()
 , m_pProperties(NULL)
 , m_pTileProperties(NULL)
 , m_uCurrentFirstGID(0)
+, m_pTileDataDecoder(NULL)
 {
 }
 
@@ -214,6 +436,7 @@ CCTMXMapInfo::~CCTMXMapInfo()
     CC_SAFE_RELEASE(m_pProperties);
     CC_SAFE_RELEASE(m_pTileProperties);
     CC_SAFE_RELEASE(m_pObjectGroups);
+    CC_SAFE_DELETE(m_pTileDataDecoder);
 }
 
 CCArray* CCTMXMapInfo::getLayers()
@@ -485,6 +708,8 @@ void CCTMXMapInfo::startElement(void *ctx, const char *name, const char **atts)
         std::string encoding = valueForKey("encoding", attributeDict);
         std::string compression = valueForKey("compression", attributeDict);
 
+        // each layer has its own encoding
+        pTMXMapInfo->setLayerAttribs(TMXLayerAttribNone);
         if( encoding == "base64" )
         {
             int layerAttribs = pTMXMapInfo->getLayerAttribs();
@@ -502,6 +727,15 @@ void CCTMXMapInfo::startElement(void *ctx, const char *name, const char **atts)
                 pTMXMapInfo->setLayerAttribs(layerAttribs | TMXLayerAttribZlib);
             }
             CCAssert( compression == "" || compression == "gzip" || compression == "zlib", "TMX: unsupported compression method" );
+
+            // the text is decoded into the tiles as it is parsed
+            CCTMXLayerInfo* layer = (CCTMXLayerInfo*)pTMXMapInfo->getLayers()->lastObject();
+            unsigned int tileCount = (unsigned int)(layer->m_tLayerSize.width * layer->m_tLayerSize.height);
+            CC_SAFE_DELETE_ARRAY(layer->m_pTiles);
+            layer->m_pTiles = new unsigned int[tileCount];
+            CC_SAFE_DELETE(m_pTileDataDecoder);
+            m_pTileDataDecoder = new CCTMXTileDataDecoder(layer->m_pTiles, tileCount,
+                (pTMXMapInfo->getLayerAttribs() & (TMXLayerAttribGzip | TMXLayerAttribZlib)) != 0);
         }
         CCAssert( pTMXMapInfo->getLayerAttribs() != TMXLayerAttribNone, "TMX tile map: Only base64 and/or gzip/zlib maps are supported" );
 
@@ -694,53 +928,33 @@ void CCTMXMapInfo::endElement(void *ctx, const char *name)
     CCTMXMapInfo *pTMXMapInfo = this;
     std::string elementName = (char*)name;
 
-    int len = 0;
-
     if(elementName == "data" && pTMXMapInfo->getLayerAttribs()&TMXLayerAttribBase64) 
     {
         pTMXMapInfo->setStoringCharacters(false);
 
         CCTMXLayerInfo* layer = (CCTMXLayerInfo*)pTMXMapInfo->getLayers()->lastObject();
-
-        std::string currentString = pTMXMapInfo->getCurrentString();
-        unsigned char *buffer;
-        len = base64Decode((unsigned char*)currentString.c_str(), (unsigned int)currentString.length(), &buffer);
-        if( ! buffer ) 
+        if (! m_pTileDataDecoder)
         {
-            CCLOG("cocos2d: TiledMap: decode data error");
             return;
         }
 
-        if( pTMXMapInfo->getLayerAttribs() & (TMXLayerAttribGzip | TMXLayerAttribZlib) )
-        {
-            unsigned char *deflated;
-            CCSize s = layer->m_tLayerSize;
-            // int sizeHint = s.width * s.height * sizeof(uint32_t);
-            int sizeHint = (int)(s.width * s.height * sizeof(unsigned int));
-
-            int inflatedLen = ZipUtils::ccInflateMemoryWithHint(buffer, len, &deflated, sizeHint);
-            CCAssert(inflatedLen == sizeHint, "");
-
-            inflatedLen = (size_t)&inflatedLen; // XXX: to avoid warnings in compiler
-            
-            delete [] buffer;
-            buffer = NULL;
-
-            if( ! deflated ) 
-            {
-                CCLOG("cocos2d: TiledMap: inflate data error");
-                return;
-            }
+        bool bDecoded = m_pTileDataDecoder->finish();
+        unsigned int decodedLength = m_pTileDataDecoder->getDecodedLength();
+        CC_SAFE_DELETE(m_pTileDataDecoder);
 
-            layer->m_pTiles = (unsigned int*) deflated;
-        }
-        else
+        if( ! bDecoded ) 
         {
-            layer->m_pTiles = (unsigned int*) buffer;
+            CCLOG("cocos2d: TiledMap: decode data error");
+            CC_SAFE_DELETE_ARRAY(layer->m_pTiles);
+            return;
         }
 
-        pTMXMapInfo->setCurrentString("");
-
+        unsigned int length = (unsigned int)(layer->m_tLayerSize.width * layer->m_tLayerSize.height * sizeof(unsigned int));
+        if (decodedLength < length)
+        {
+            CCLOG("cocos2d: TiledMap: the data of layer %s is smaller than the layer", layer->m_sName.c_str());
+            memset((unsigned char*)layer->m_pTiles + decodedLength, 0, length - decodedLength);
+        }
     } 
     else if (elementName == "map")
     {
@@ -768,15 +982,384 @@ void CCTMXMapInfo::textHandler(void *ctx, const char *ch, int len)
 {
     CC_UNUSED_PARAM(ctx);
     CCTMXMapInfo *pTMXMapInfo = this;
-    std::string pText((char*)ch,0,len);
 
-    if (pTMXMapInfo->getStoringCharacters())
+    if (pTMXMapInfo->getStoringCharacters() && m_pTileDataDecoder)
     {
-        std::string currentString = pTMXMapInfo->getCurrentString();
-        currentString += pText;
-        pTMXMapInfo->setCurrentString(currentString.c_str());
+        m_pTileDataDecoder->decode(ch, len);
     }
 }
 
-NS_CC_END
+// compiled maps, laid out as described at the top of the file
+static void writeTMXUInt(std::string& out, unsigned int value)
+{
+    out += (char)(value & 0xff);
+    out += (char)((value >> 8) & 0xff);
+    out += (char)((value >> 16) & 0xff);
+    out += (char)((value >> 24) & 0xff);
+}
+
+static void writeTMXFloat(std::string& out, float value)
+{
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    writeTMXUInt(out, bits);
+}
+
+static void writeTMXString(std::string& out, const std::string& value)
+{
+    writeTMXUInt(out, (unsigned int)value.length());
+    out += value;
+}
+
+static void writeTMXDictionary(std::string& out, CCDictionary* dict);
 
+static void writeTMXValue(std::string& out, CCObject* value)
+{
+    CCDictionary* pDict = dynamic_cast<CCDictionary*>(value);
+    CCArray* pArray = dynamic_cast<CCArray*>(value);
+    CCString* pString = dynamic_cast<CCString*>(value);
+    if (pDict)
+    {
+        out += 'd';
+        writeTMXDictionary(out, pDict);
+    }
+    else if (pArray)
+    {
+        out += 'a';
+        writeTMXUInt(out, pArray->count());
+        CCObject* pObj = NULL;
+        CCARRAY_FOREACH(pArray, pObj)
+        {
+            writeTMXValue(out, pObj);
+        }
+    }
+    else
+    {
+        out += 's';
+        writeTMXString(out, pString ? pString->getCString() : "");
+    }
+}
+
+static void writeTMXDictionary(std::string& out, CCDictionary* dict)
+{
+    writeTMXUInt(out, dict ? dict->count() : 0);
+    if (dict)
+    {
+        CCDictElement* pElement = NULL;
+        CCDICT_FOREACH(dict, pElement)
+        {
+            writeTMXString(out, pElement->getStrKey());
+            writeTMXValue(out, pElement->getObject());
+        }
+    }
+}
+
+// the reader fails once it went past the end of the data, the values read then are 0 or empty
+typedef struct _ccTMXReader
+{
+    const unsigned char* p;
+    const unsigned char* end;
+    bool error;
+} ccTMXReader;
+
+static inline bool canReadTMX(ccTMXReader& reader, unsigned long length)
+{
+    if (reader.error || (unsigned long)(reader.end - reader.p) < length)
+    {
+        reader.error = true;
+        return false;
+    }
+    return true;
+}
+
+static unsigned int readTMXUInt(ccTMXReader& reader)
+{
+    if (! canReadTMX(reader, 4))
+    {
+        return 0;
+    }
+    const unsigned char* p = reader.p;
+    reader.p += 4;
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static unsigned char readTMXByte(ccTMXReader& reader)
+{
+    return canReadTMX(reader, 1) ? *reader.p++ : 0;
+}
+
+static float readTMXFloat(ccTMXReader& reader)
+{
+    unsigned int bits = readTMXUInt(reader);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static std::string readTMXString(ccTMXReader& reader)
+{
+    unsigned int length = readTMXUInt(reader);
+    if (! canReadTMX(reader, length))
+    {
+        return "";
+    }
+    std::string value((const char*)reader.p, length);
+    reader.p += length;
+    return value;
+}
+
+static void readTMXDictionary(ccTMXReader& reader, CCDictionary* dict, int depth);
+
+// returns a retained value
+static CCObject* readTMXValue(ccTMXReader& reader, int depth)
+{
+    unsigned char type = readTMXByte(reader);
+    if (type == 'd' && depth < 8)
+    {
+        CCDictionary* pDict = new CCDictionary();
+        readTMXDictionary(reader, pDict, depth + 1);
+        return pDict;
+    }
+    else if (type == 'a' && depth < 8)
+    {
+        unsigned int count = readTMXUInt(reader);
+        CCArray* pArray = new CCArray();
+        pArray->initWithCapacity(MIN(count, 64u));
+        for (unsigned int i = 0; i < count && ! reader.error; ++i)
+        {
+            CCObject* pObj = readTMXValue(reader, depth + 1);
+            pArray->addObject(pObj);
+            pObj->release();
+        }
+        return pArray;
+    }
+    else if (type != 's')
+    {
+        reader.error = true;
+    }
+    return new CCString(readTMXString(reader));
+}
+
+static void readTMXDictionary(ccTMXReader& reader, CCDictionary* dict, int depth)
+{
+    unsigned int count = readTMXUInt(reader);
+    for (unsigned int i = 0; i < count && ! reader.error; ++i)
+    {
+        std::string key = readTMXString(reader);
+        CCObject* pObj = readTMXValue(reader, depth);
+        if (! key.empty())
+        {
+            dict->setObject(pObj, key);
+        }
+        pObj->release();
+    }
+}
+
+std::string CCTMXMapInfo::getResourceDirectory()
+{
+    // the images of the tilesets are relative to the directory of the map
+    if (m_sTMXFileName.find_last_of("/") != string::npos)
+    {
+        return m_sTMXFileName.substr(0, m_sTMXFileName.find_last_of("/") + 1);
+    }
+    return m_sResources + (m_sResources.size() ? "/" : "");
+}
+
+bool CCTMXMapInfo::parseCompiledMap(const unsigned char* pData, unsigned long uSize)
+{
+    ccTMXReader reader = { pData + 4, pData + uSize, false };
+
+    unsigned int version = readTMXUInt(reader);
+    if (version != TMX_COMPILED_MAP_VERSION)
+    {
+        CCLOG("cocos2d: TMXFormat: version %u of the compiled maps is not supported", version);
+        return false;
+    }
+
+    m_nOrientation = (int)readTMXUInt(reader);
+    m_tMapSize.width = readTMXFloat(reader);
+    m_tMapSize.height = readTMXFloat(reader);
+    m_tTileSize.width = readTMXFloat(reader);
+    m_tTileSize.height = readTMXFloat(reader);
+    readTMXDictionary(reader, m_pProperties, 0);
+
+    std::string dir = getResourceDirectory();
+    unsigned int count = readTMXUInt(reader);
+    for (unsigned int i = 0; i < count && ! reader.error; ++i)
+    {
+        CCTMXTilesetInfo *tileset = new CCTMXTilesetInfo();
+        tileset->m_sName = readTMXString(reader);
+        tileset->m_uFirstGid = readTMXUInt(reader);
+        tileset->m_tTileSize.width = readTMXFloat(reader);
+        tileset->m_tTileSize.height = readTMXFloat(reader);
+        tileset->m_uSpacing = readTMXUInt(reader);
+        tileset->m_uMargin = readTMXUInt(reader);
+        std::string image = readTMXString(reader);
+        tileset->m_sSourceImage = CCFileUtils::sharedFileUtils()->isAbsolutePath(image) ? image : dir + image;
+        tileset->m_tImageSize.width = readTMXFloat(reader);
+        tileset->m_tImageSize.height = readTMXFloat(reader);
+        m_pTilesets->addObject(tileset);
+        tileset->release();
+    }
+
+    count = readTMXUInt(reader);
+    for (unsigned int i = 0; i < count && ! reader.error; ++i)
+    {
+        unsigned int gid = readTMXUInt(reader);
+        CCDictionary *dict = new CCDictionary();
+        readTMXDictionary(reader, dict, 0);
+        m_pTileProperties->setObject(dict, gid);
+        dict->release();
+    }
+
+    count = readTMXUInt(reader);
+    for (unsigned int i = 0; i < count && ! reader.error; ++i)
+    {
+        CCTMXLayerInfo *layer = new CCTMXLayerInfo();
+        layer->m_sName = readTMXString(reader);
+        layer->m_tLayerSize.width = readTMXFloat(reader);
+        layer->m_tLayerSize.height = readTMXFloat(reader);
+        layer->m_bVisible = readTMXByte(reader) != 0;
+        layer->m_cOpacity = readTMXByte(reader);
+        layer->m_tOffset.x = readTMXFloat(reader);
+        layer->m_tOffset.y = readTMXFloat(reader);
+        layer->m_uMinGID = readTMXUInt(reader);
+        layer->m_uMaxGID = readTMXUInt(reader);
+        readTMXDictionary(reader, layer->getProperties(), 0);
+
+        unsigned int tileCount = readTMXUInt(reader);
+        if (tileCount != (unsigned int)(layer->m_tLayerSize.width * layer->m_tLayerSize.height)
+            || ! canReadTMX(reader, (unsigned long)tileCount * sizeof(unsigned int)))
+        {
+            reader.error = true;
+        }
+        else
+        {
+            layer->m_pTiles = new unsigned int[tileCount];
+            memcpy(layer->m_pTiles, reader.p, tileCount * sizeof(unsigned int));
+            reader.p += tileCount * sizeof(unsigned int);
+        }
+        m_pLayers->addObject(layer);
+        layer->release();
+    }
+
+    count = readTMXUInt(reader);
+    for (unsigned int i = 0; i < count && ! reader.error; ++i)
+    {
+        CCTMXObjectGroup *objectGroup = new CCTMXObjectGroup();
+        objectGroup->setGroupName(readTMXString(reader).c_str());
+        CCPoint positionOffset;
+        positionOffset.x = readTMXFloat(reader);
+        positionOffset.y = readTMXFloat(reader);
+        objectGroup->setPositionOffset(positionOffset);
+        readTMXDictionary(reader, objectGroup->getProperties(), 0);
+
+        unsigned int objectCount = readTMXUInt(reader);
+        for (unsigned int j = 0; j < objectCount && ! reader.error; ++j)
+        {
+            CCDictionary *dict = new CCDictionary();
+            readTMXDictionary(reader, dict, 0);
+            objectGroup->getObjects()->addObject(dict);
+            dict->release();
+        }
+        m_pObjectGroups->addObject(objectGroup);
+        objectGroup->release();
+    }
+
+    if (reader.error)
+    {
+        CCLOG("cocos2d: TMXFormat: the compiled map %s is truncated or corrupted", m_sTMXFileName.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool CCTMXMapInfo::saveCompiledMapToFile(const char *pszFilePath)
+{
+    std::string out(TMX_COMPILED_MAP_MAGIC);
+    writeTMXUInt(out, TMX_COMPILED_MAP_VERSION);
+
+    writeTMXUInt(out, (unsigned int)m_nOrientation);
+    writeTMXFloat(out, m_tMapSize.width);
+    writeTMXFloat(out, m_tMapSize.height);
+    writeTMXFloat(out, m_tTileSize.width);
+    writeTMXFloat(out, m_tTileSize.height);
+    writeTMXDictionary(out, m_pProperties);
+
+    std::string dir = getResourceDirectory();
+    CCObject* pObj = NULL;
+    writeTMXUInt(out, m_pTilesets->count());
+    CCARRAY_FOREACH(m_pTilesets, pObj)
+    {
+        CCTMXTilesetInfo* tileset = (CCTMXTilesetInfo*)pObj;
+        writeTMXString(out, tileset->m_sName);
+        writeTMXUInt(out, tileset->m_uFirstGid);
+        writeTMXFloat(out, tileset->m_tTileSize.width);
+        writeTMXFloat(out, tileset->m_tTileSize.height);
+        writeTMXUInt(out, tileset->m_uSpacing);
+        writeTMXUInt(out, tileset->m_uMargin);
+        const std::string& image = tileset->m_sSourceImage;
+        bool bInDir = dir.size() && image.compare(0, dir.size(), dir) == 0;
+        writeTMXString(out, bInDir ? image.substr(dir.size()) : image);
+        writeTMXFloat(out, tileset->m_tImageSize.width);
+        writeTMXFloat(out, tileset->m_tImageSize.height);
+    }
+
+    writeTMXUInt(out, m_pTileProperties->count());
+    CCDictElement* pElement = NULL;
+    CCDICT_FOREACH(m_pTileProperties, pElement)
+    {
+        writeTMXUInt(out, (unsigned int)pElement->getIntKey());
+        writeTMXDictionary(out, (CCDictionary*)pElement->getObject());
+    }
+
+    writeTMXUInt(out, m_pLayers->count());
+    CCARRAY_FOREACH(m_pLayers, pObj)
+    {
+        CCTMXLayerInfo* layer = (CCTMXLayerInfo*)pObj;
+        writeTMXString(out, layer->m_sName);
+        writeTMXFloat(out, layer->m_tLayerSize.width);
+        writeTMXFloat(out, layer->m_tLayerSize.height);
+        out += (char)(layer->m_bVisible ? 1 : 0);
+        out += (char)layer->m_cOpacity;
+        writeTMXFloat(out, layer->m_tOffset.x);
+        writeTMXFloat(out, layer->m_tOffset.y);
+        writeTMXUInt(out, layer->m_uMinGID);
+        writeTMXUInt(out, layer->m_uMaxGID);
+        writeTMXDictionary(out, layer->getProperties());
+
+        unsigned int tileCount = layer->m_pTiles ? (unsigned int)(layer->m_tLayerSize.width * layer->m_tLayerSize.height) : 0;
+        writeTMXUInt(out, tileCount);
+        out.append((const char*)layer->m_pTiles, tileCount * sizeof(unsigned int));
+    }
+
+    writeTMXUInt(out, m_pObjectGroups->count());
+    CCARRAY_FOREACH(m_pObjectGroups, pObj)
+    {
+        CCTMXObjectGroup* objectGroup = (CCTMXObjectGroup*)pObj;
+        writeTMXString(out, objectGroup->getGroupName());
+        writeTMXFloat(out, objectGroup->getPositionOffset().x);
+        writeTMXFloat(out, objectGroup->getPositionOffset().y);
+        writeTMXDictionary(out, objectGroup->getProperties());
+
+        CCArray* objects = objectGroup->getObjects();
+        writeTMXUInt(out, objects ? objects->count() : 0);
+        CCObject* pObject = NULL;
+        CCARRAY_FOREACH(objects, pObject)
+        {
+            writeTMXDictionary(out, (CCDictionary*)pObject);
+        }
+    }
+
+    FILE* fp = fopen(pszFilePath, "wb");
+    if (! fp)
+    {
+        CCLOG("cocos2d: TMXFormat: can't write the compiled map %s", pszFilePath);
+        return false;
+    }
+    bool bRet = fwrite(out.data(), 1, out.size(), fp) == out.size();
+    fclose(fp);
+    return bRet;
+}
+
+NS_CC_END
@@ -38,6 +38,7 @@ THE SOFTWARE.
 NS_CC_BEGIN
 
 class CCTMXObjectGroup;
+class CCTMXTileDataDecoder;
 
 /** @file
 * Internal TMX parser
@@ -144,6 +145,11 @@ And it also contains:
 
 This information is obtained from the TMX file.
 
+A map can also be loaded from a compiled map, written by saveCompiledMapToFile(). Compiled maps hold the
+same information with the tiles of the layers stored as they are in memory, they are read in one go
+without parsing XML nor decoding base64 and zlib. formatWithTMXFile() recognises them by their header,
+whatever the extension of the file.
+
 */
 class CC_DLL CCTMXMapInfo : public CCObject, public CCSAXDelegator
 {    
@@ -197,6 +203,12 @@ public:
     bool parseXMLFile(const char *xmlFilename);
     /* initializes parsing of an XML string, either a tmx (Map) string or tsx (Tileset) string */
     bool parseXMLString(const char *xmlString);
+    /** Writes the map as a compiled map, which can be loaded with formatWithTMXFile() or CCTMXTiledMap::create().
+     The images of the tilesets are written relative to the directory of the map, so the compiled map
+     should be saved next to the tmx file it comes from.
+     @return true if the file was written
+     */
+    bool saveCompiledMapToFile(const char *pszFilePath);
 
     CCDictionary* getTileProperties();
     void setTileProperties(CCDictionary* tileProperties);
@@ -220,6 +232,8 @@ public:
     inline void setTMXFileName(const char *fileName){ m_sTMXFileName = fileName; }
 private:
     void internalInit(const char* tmxFileName, const char* resourcePath);
+    bool parseCompiledMap(const unsigned char* pData, unsigned long uSize);
+    std::string getResourceDirectory();
 protected:
     //! tmx filename
     std::string m_sTMXFileName;
@@ -230,6 +244,8 @@ protected:
     //! tile properties
     CCDictionary* m_pTileProperties;
     unsigned int m_uCurrentFirstGID;
+    //! decodes the base64 text of the current layer into its tiles
+    CCTMXTileDataDecoder* m_pTileDataDecoder;
 };
 
 // end of tilemap_parallax_nodes group
@@ -407,6 +407,7 @@ CCAffineTransform CCArmature::nodeToParentTransform()
         }
 
         m_bTransformDirty = false;
+        ++m_uTransformGeneration;
     }
 
     return m_sTransform;
@@ -497,6 +497,8 @@ void CCScrollView::beforeDraw()
 {
     if (m_bClippingToBounds)
     {
+        // the queued sprites are drawn without the scissor
+        CCAutoBatchRenderer::sharedRenderer()->flush();
 		m_bScissorRestored = false;
         CCRect frame = getViewRect();
         if (CCEGLView::sharedOpenGLView()->isScissorEnabled()) {
@@ -526,6 +528,7 @@ void CCScrollView::afterDraw()
 {
     if (m_bClippingToBounds)
     {
+        CCAutoBatchRenderer::sharedRenderer()->flush();
         if (m_bScissorRestored) {//restore the parent's scissor rect
             CCEGLView::sharedOpenGLView()->setScissorInPoints(m_tParentScissorRect.origin.x, m_tParentScissorRect.origin.y, m_tParentScissorRect.size.width, m_tParentScissorRect.size.height);
         }
@@ -23,6 +23,11 @@
  ****************************************************************************/
 
 #include "CCLuaEngine.h"
+
+extern "C" {
+#include "lauxlib.h"
+}
+
 #include "cocos2d.h"
 #include "cocoa/CCArray.h"
 #include "cocoa/CCEventDispatcher.h"
@@ -53,9 +58,113 @@ bool CCLuaEngine::init(void)
 {
     m_stack = CCLuaStack::create();
     m_stack->retain();
+
+    // let collectgarbage("stop") and collectgarbage("restart") of the scripts hold against the pacing
+    lua_State* L = m_stack->getLuaState();
+    lua_getglobal(L, "collectgarbage");
+    lua_pushlightuserdata(L, this);
+    lua_pushcclosure(L, lua_collectgarbage, 2);
+    lua_setglobal(L, "collectgarbage");
+
+    setGCPacingEnabled(true);
     return true;
 }
 
+int CCLuaEngine::lua_collectgarbage(lua_State* L)
+{
+    CCLuaEngine* pEngine = (CCLuaEngine*)lua_touserdata(L, lua_upvalueindex(2));
+    const char* opt = luaL_optstring(L, 1, "collect");
+    if (strcmp(opt, "stop") == 0)
+    {
+        pEngine->m_bGCStoppedByScript = true;
+    }
+    else if (strcmp(opt, "restart") == 0)
+    {
+        pEngine->m_bGCStoppedByScript = false;
+    }
+
+    lua_pushvalue(L, lua_upvalueindex(1));
+    lua_insert(L, 1);
+    lua_call(L, lua_gettop(L) - 1, LUA_MULTRET);
+    return lua_gettop(L);
+}
+
+void CCLuaEngine::setGCPacingEnabled(bool bEnabled)
+{
+    if (bEnabled == m_bGCPacingEnabled) return;
+
+    lua_State* L = m_stack->getLuaState();
+    m_bGCPacingEnabled = bEnabled;
+    m_bGCCycleRunning = false;
+    memset(&m_gcStats, 0, sizeof(m_gcStats));
+    if (bEnabled)
+    {
+        // the automatic collector keeps running as a safety net, for the frames that allocate a lot
+        m_nGCSavedPause = lua_gc(L, LUA_GCSETPAUSE, kCCLuaGCPacingPause);
+        m_uGCLiveHeap = lua_gc(L, LUA_GCCOUNT, 0);
+        m_gcStats.heapSize = m_uGCLiveHeap;
+    }
+    else
+    {
+        lua_gc(L, LUA_GCSETPAUSE, m_nGCSavedPause);
+    }
+}
+
+void CCLuaEngine::collectGarbage(float fIdleTime)
+{
+    if (!m_bGCPacingEnabled) return;
+
+    m_gcStats.steps = 0;
+    m_gcStats.gcTime = 0;
+    lua_State* L = m_stack->getLuaState();
+    if (m_bGCStoppedByScript)
+    {
+        // the steps would restart the collector
+        m_gcStats.heapSize = lua_gc(L, LUA_GCCOUNT, 0);
+        return;
+    }
+
+    struct cc_timeval start, now;
+    CCTime::gettimeofdayCocos2d(&start, NULL);
+
+    unsigned int heap = lua_gc(L, LUA_GCCOUNT, 0);
+    if (m_uGCHeapLimit > 0 && heap > m_uGCHeapLimit && heap > m_uGCLiveHeap + m_uGCLiveHeap / 2)
+    {
+        // the steps don't keep up with the allocations
+        lua_gc(L, LUA_GCCOLLECT, 0);
+        m_bGCCycleRunning = false;
+        m_uGCLiveHeap = lua_gc(L, LUA_GCCOUNT, 0);
+        m_gcStats.fullCollections++;
+    }
+    else if (m_bGCCycleRunning || heap >= m_uGCLiveHeap * 2)
+    {
+        // like the default pause of the collector, a cycle starts once the heap doubled since the last one
+        m_bGCCycleRunning = true;
+        float elapsed = 0;
+        do
+        {
+            m_gcStats.steps++;
+            if (lua_gc(L, LUA_GCSTEP, 0))
+            {
+                m_bGCCycleRunning = false;
+                m_uGCLiveHeap = lua_gc(L, LUA_GCCOUNT, 0);
+                break;
+            }
+            CCTime::gettimeofdayCocos2d(&now, NULL);
+            elapsed = CCTime::timersubCocos2d(&start, &now) / 1000.0f;
+        } while (elapsed < fIdleTime);
+    }
+
+    CCTime::gettimeofdayCocos2d(&now, NULL);
+    m_gcStats.gcTime = CCTime::timersubCocos2d(&start, &now) / 1000.0f;
+    m_gcStats.heapSize = lua_gc(L, LUA_GCCOUNT, 0);
+}
+
+const ccScriptGCStats* CCLuaEngine::getGCStats(void)
+{
+    return m_bGCPacingEnabled ? &m_gcStats : NULL;
+}
+
 void CCLuaEngine::addSearchPath(const char* path)
 {
     m_stack->addSearchPath(path);
@@ -40,6 +40,9 @@ extern "C" {
 
 NS_CC_BEGIN
 
+/** Pause of the garbage collector of Lua while CCLuaEngine paces it, in percent of the live heap */
+#define kCCLuaGCPacingPause 400
+
 namespace extension {
     class CCTableViewCell;
     class CCTableView;
@@ -130,17 +133,70 @@ public:
     virtual int executeEventWithArgs(int nHandler, CCArray* pArgs);
 
     virtual bool handleAssert(const char *msg);
+
+    /**
+     @brief Let the engine pace the garbage collector of Lua, enabled by default.
+     collectGarbage() does the incremental steps in the idle time of the frames, so they don't land in the
+     middle of busy frames. The automatic collector keeps running with a pause of kCCLuaGCPacingPause, it only
+     starts a cycle when the heap grew past 4 times its live size, during long loading frames for instance.
+     A cycle the idle time of a frame did not finish goes on with the automatic steps of the next frames.
+     The settings of collectgarbage() in the scripts hold: "setpause" and "setstepmul" tune the automatic
+     collector, and the engine does no steps while a script stopped it. Disabling the pacing restores the
+     pause of the collector.
+     */
+    void setGCPacingEnabled(bool bEnabled);
+    bool isGCPacingEnabled(void) {
+        return m_bGCPacingEnabled;
+    }
+
+    /**
+     @brief Size of the heap in KB above which a frame does a full collection instead of incremental steps,
+     unless most of the heap is live data. 0 by default, there is no limit.
+     */
+    void setGCHeapLimit(unsigned int uHeapLimit) {
+        m_uGCHeapLimit = uHeapLimit;
+    }
+    unsigned int getGCHeapLimit(void) {
+        return m_uGCHeapLimit;
+    }
+
+    /**
+     @brief Called by CCDirector at the end of each frame, does incremental steps of the collector until
+     fIdleTime seconds are spent, at least one step when a cycle is running even if the frame is late.
+     */
+    virtual void collectGarbage(float fIdleTime);
+    virtual const ccScriptGCStats* getGCStats(void);
     
 private:
     CCLuaEngine(void)
     : m_stack(NULL)
+    , m_bGCPacingEnabled(false)
+    , m_bGCCycleRunning(false)
+    , m_bGCStoppedByScript(false)
+    , m_nGCSavedPause(0)
+    , m_uGCHeapLimit(0)
+    , m_uGCLiveHeap(0)
     {
     }
     
     bool init(void);
+
+    /** collectgarbage() of the scripts, tells the engine when they stop or restart the collector */
+    static int lua_collectgarbage(lua_State* L);
     
     static CCLuaEngine* m_defaultEngine;
     CCLuaStack *m_stack;
+
+    bool m_bGCPacingEnabled;
+    //! whether the steps of the last frames left a cycle of the collector unfinished
+    bool m_bGCCycleRunning;
+    bool m_bGCStoppedByScript;
+    //! pause of the collector before the engine paced it
+    int m_nGCSavedPause;
+    unsigned int m_uGCHeapLimit;
+    //! size of the heap in KB after the last finished cycle, an estimate of the live data
+    unsigned int m_uGCLiveHeap;
+    ccScriptGCStats m_gcStats;
 };
 
 NS_CC_END
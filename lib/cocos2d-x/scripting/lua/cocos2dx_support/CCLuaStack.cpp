@@ -37,6 +37,7 @@ extern "C" {
 #include "ccMacros.h"
 #include "platform/CCZipFile.h"
 #include "platform/CCFileUtils.h"
+#include "support/CCProfiling.h"
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS || CC_TARGET_PLATFORM == CC_PLATFORM_MAC)
 #include "platform/ios/CCLuaObjcBridge.h"
@@ -79,6 +80,14 @@ extern "C" {
 #endif // QUICK_MINI_TARGET
 
 #include <string>
+#include <sys/stat.h>
+#include <zlib.h>
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -109,6 +118,12 @@ CCLuaStack::~CCLuaStack(void)
 {
     s_map.erase(s_map.find(m_state));
     lua_close(m_state);
+    for (std::vector<ChunksZip>::iterator it = m_chunksZips.begin(); it != m_chunksZips.end(); ++it)
+    {
+        CCZipFile *zip = it->zip;
+        releaseChunksZip(&*it);
+        zip->release();
+    }
     if (m_xxteaKey) free(m_xxteaKey);
     if (m_xxteaSign) free(m_xxteaSign);
 }
@@ -141,6 +156,12 @@ bool CCLuaStack::init(void)
     lua_pushcfunction(m_state, lua_loadChunksFromZIP);
     lua_setglobal(m_state, "CCLuaLoadChunksFromZIP");
 
+    // register CCLuaMountChunksFromZIP, CCLuaGetChunksStats
+    lua_pushcfunction(m_state, lua_mountChunksFromZIP);
+    lua_setglobal(m_state, "CCLuaMountChunksFromZIP");
+    lua_pushcfunction(m_state, lua_getChunksStats);
+    lua_setglobal(m_state, "CCLuaGetChunksStats");
+
     // register CCLuaStackSnapshot
     luaopen_snapshot(m_state);
 
@@ -230,7 +251,7 @@ int CCLuaStack::executeScriptFile(const char* filename)
     std::string fullPath = CCFileUtils::sharedFileUtils()->fullPathForFilename(filename);
     unsigned long chunkSize = 0;
     unsigned char *chunk = CCFileUtils::sharedFileUtils()->getFileData(fullPath.c_str(), "rb", &chunkSize);
-    if (lua_loadbuffer(m_state, (const char*)chunk, (int)chunkSize, fullPath.c_str()) == 0)
+    if (lua_loadfilebuffer(m_state, (const char*)chunk, (int)chunkSize, fullPath.c_str()) == 0)
     {
         return executeFunction(0);
     }
@@ -533,6 +554,8 @@ int CCLuaStack::lua_print(lua_State *L)
 
 int CCLuaStack::lua_execute(lua_State *L, int numArgs, bool removeResult)
 {
+    CC_PROFILER_ZONE("CCLuaStack - execute");
+
     int functionIndex = -(numArgs + 1);
     if (!lua_isfunction(L, functionIndex))
     {
@@ -596,6 +619,86 @@ int CCLuaStack::lua_execute(lua_State *L, int numArgs, bool removeResult)
     return ret;
 }
 
+CCZipFile *CCLuaStack::createChunksZip(CCLuaStack *stack, const std::string &zipFilePath, ChunksZip *chunksZip)
+{
+    CCFileUtils *utils = CCFileUtils::sharedFileUtils();
+    unsigned long size = 0;
+    chunksZip->zip = NULL;
+    chunksZip->view = NULL;
+    chunksZip->data = NULL;
+    chunksZip->decrypted = NULL;
+
+    // a zip stored in a mounted pack is read in place, the view keeps the pack mapped
+    const unsigned char *zipFileView = utils->getFileView(zipFilePath.c_str(), &size);
+    chunksZip->view = zipFileView;
+    if (!zipFileView)
+    {
+        chunksZip->data = utils->getFileData(zipFilePath.c_str(), "rb", &size);
+        zipFileView = chunksZip->data;
+    }
+    if (!zipFileView) return NULL;
+
+    bool isXXTEA = stack && stack->m_xxteaEnabled;
+    for (unsigned int i = 0; isXXTEA && i < stack->m_xxteaSignLen && i < size; ++i)
+    {
+        isXXTEA = zipFileView[i] == stack->m_xxteaSign[i];
+    }
+
+    if (isXXTEA)
+    {
+        // decrypt XXTEA, the whole archive is encrypted so it can only be decrypted at once
+        xxtea_long len = 0;
+        chunksZip->decrypted = xxtea_decrypt((unsigned char*)zipFileView + stack->m_xxteaSignLen,
+                                             (xxtea_long)size - (xxtea_long)stack->m_xxteaSignLen,
+                                             (unsigned char*)stack->m_xxteaKey,
+                                             (xxtea_long)stack->m_xxteaKeyLen,
+                                             &len);
+        delete []chunksZip->data;
+        chunksZip->data = NULL;
+        if (chunksZip->view)
+        {
+            utils->releaseFileView(chunksZip->view);
+            chunksZip->view = NULL;
+        }
+        chunksZip->zip = CCZipFile::createWithBuffer(chunksZip->decrypted, len);
+    }
+    else
+    {
+        chunksZip->zip = CCZipFile::createWithBuffer(zipFileView, size);
+    }
+
+    if (chunksZip->zip)
+    {
+        CCLOG("createChunksZip() - load zip file: %s%s", zipFilePath.c_str(), isXXTEA ? "*" : "");
+    }
+    return chunksZip->zip;
+}
+
+void CCLuaStack::releaseChunksZip(ChunksZip *chunksZip)
+{
+    // the zip reads the buffer until it is closed
+    if (chunksZip->zip)
+    {
+        chunksZip->zip->close();
+        chunksZip->zip = NULL;
+    }
+    if (chunksZip->view)
+    {
+        CCFileUtils::sharedFileUtils()->releaseFileView(chunksZip->view);
+        chunksZip->view = NULL;
+    }
+    if (chunksZip->data)
+    {
+        delete []chunksZip->data;
+        chunksZip->data = NULL;
+    }
+    if (chunksZip->decrypted)
+    {
+        free(chunksZip->decrypted);
+        chunksZip->decrypted = NULL;
+    }
+}
+
 int CCLuaStack::lua_loadChunksFromZIP(lua_State *L)
 {
     if (lua_gettop(L) < 1)
@@ -614,57 +717,40 @@ int CCLuaStack::lua_loadChunksFromZIP(lua_State *L)
 
     do
     {
-        unsigned long size = 0;
-        void *buffer = NULL;
-        unsigned char *zipFileData = utils->getFileData(zipFilePath.c_str(), "rb", &size);
-        CCZipFile *zip = NULL;
-
-        bool isXXTEA = stack && stack->m_xxteaEnabled;
-        for (unsigned int i = 0; isXXTEA && i < stack->m_xxteaSignLen && i < size; ++i)
-        {
-            isXXTEA = zipFileData[i] == stack->m_xxteaSign[i];
-        }
-
-        if (isXXTEA)
-        {
-            // decrypt XXTEA
-            xxtea_long len = 0;
-            buffer = xxtea_decrypt(zipFileData + stack->m_xxteaSignLen,
-                                   (xxtea_long)size - (xxtea_long)stack->m_xxteaSignLen,
-                                   (unsigned char*)stack->m_xxteaKey,
-                                   (xxtea_long)stack->m_xxteaKeyLen,
-                                   &len);
-            delete []zipFileData;
-            zipFileData = NULL;
-            zip = CCZipFile::createWithBuffer(buffer, len);
-        }
-        else
-        {
-            zip = CCZipFile::createWithBuffer(zipFileData, size);
-        }
+        ChunksZip chunksZip;
+        CCZipFile *zip = createChunksZip(stack, zipFilePath, &chunksZip);
 
         if (zip)
         {
-            CCLOG("lua_loadChunksFromZIP() - load zip file: %s%s", zipFilePath.c_str(), isXXTEA ? "*" : "");
             lua_getglobal(L, "package");
             lua_getfield(L, -1, "preload");
 
             int count = 0;
-            string filename = zip->getFirstFilename();
-            while (filename.length())
+            for (unsigned int i = 0; i < zip->getFileCount(); ++i)
             {
+                const char *filename = zip->getFilenameAt(i);
                 unsigned long bufferSize = 0;
-                unsigned char *buffer = zip->getFileData(filename.c_str(), &bufferSize);
+                // the chunks stored by compile_scripts are loaded from the archive without a copy,
+                // the deflated ones (older archives, or PHP without setCompressionName) are inflated
+                unsigned char *buffer = NULL;
+                const unsigned char *chunk = zip->getFileView(filename, &bufferSize);
+                if (!chunk)
+                {
+                    buffer = zip->getFileData(filename, &bufferSize);
+                    chunk = buffer;
+                }
                 if (bufferSize)
                 {
-                    if (lua_loadbuffer(L, (char*)buffer, (int)bufferSize, filename.c_str()) == 0)
+                    if (lua_loadbuffer(L, (const char*)chunk, (int)bufferSize, filename) == 0)
                     {
-                        lua_setfield(L, -2, filename.c_str());
+                        lua_setfield(L, -2, filename);
                         ++count;
                     }
+                }
+                if (buffer)
+                {
                     delete []buffer;
                 }
-                filename = zip->getNextFilename();
             }
             CCLOG("lua_loadChunksFromZIP() - loaded chunks count: %d", count);
             lua_pop(L, 2);
@@ -676,19 +762,343 @@ int CCLuaStack::lua_loadChunksFromZIP(lua_State *L)
             lua_pushboolean(L, 0);
         }
 
-        if (zipFileData)
+        releaseChunksZip(&chunksZip);
+    } while (0);
+
+    return 1;
+}
+
+int CCLuaStack::mountChunksFromZip(const char *zipFilePath)
+{
+    pushString(zipFilePath);
+    lua_mountChunksFromZIP(m_state);
+    int ret = lua_toboolean(m_state, -1);
+    lua_pop(m_state, 1);
+    return ret;
+}
+
+const ccLuaChunksStats& CCLuaStack::getChunksStats(void)
+{
+    return m_chunksStats;
+}
+
+int CCLuaStack::lua_mountChunksFromZIP(lua_State *L)
+{
+    if (lua_gettop(L) < 1)
+    {
+        CCLOG("lua_mountChunksFromZIP() - invalid arguments");
+        return 0;
+    }
+
+    const char *zipFilename = lua_tostring(L, -1);
+    lua_settop(L, 0);
+    string zipFilePath = CCFileUtils::sharedFileUtils()->fullPathForFilename(zipFilename);
+    zipFilename = NULL;
+
+    CCLuaStack *stack = CCLuaStack::stack(L);
+    ChunksZip chunksZip;
+    if (!stack || !createChunksZip(stack, zipFilePath, &chunksZip))
+    {
+        CCLOG("lua_mountChunksFromZIP() - not found or invalid zip file: %s", zipFilePath.c_str());
+        releaseChunksZip(&chunksZip);
+        lua_pushboolean(L, 0);
+        return 1;
+    }
+
+    // the loader goes after package.preload, it is added with the first zip
+    if (stack->m_chunksZips.empty())
+    {
+        stack->addLuaLoader(lua_chunksZipLoader);
+    }
+    chunksZip.zip->retain();
+    stack->m_chunksZips.push_back(chunksZip);
+    stack->m_chunksStats.archives++;
+    stack->m_chunksStats.chunks += chunksZip.zip->getFileCount();
+    CCLOG("lua_mountChunksFromZIP() - mounted chunks count: %u", chunksZip.zip->getFileCount());
+
+    lua_pushboolean(L, 1);
+    return 1;
+}
+
+int CCLuaStack::lua_getChunksStats(lua_State *L)
+{
+    CCLuaStack *stack = CCLuaStack::stack(L);
+    if (!stack) return 0;
+
+    const ccLuaChunksStats& stats = stack->m_chunksStats;
+    lua_newtable(L);
+    lua_pushinteger(L, stats.archives);
+    lua_setfield(L, -2, "archives");
+    lua_pushinteger(L, stats.chunks);
+    lua_setfield(L, -2, "chunks");
+    lua_pushinteger(L, stats.loadedChunks);
+    lua_setfield(L, -2, "loadedChunks");
+    lua_pushnumber(L, stats.loadedBytes);
+    lua_setfield(L, -2, "loadedBytes");
+    lua_pushnumber(L, stats.loadTime);
+    lua_setfield(L, -2, "loadTime");
+    lua_pushinteger(L, stats.cacheHits);
+    lua_setfield(L, -2, "cacheHits");
+    lua_pushinteger(L, stats.cacheMisses);
+    lua_setfield(L, -2, "cacheMisses");
+    return 1;
+}
+
+int CCLuaStack::lua_chunksZipLoader(lua_State *L)
+{
+    CCLuaStack *stack = CCLuaStack::stack(L);
+    const char *moduleName = luaL_checkstring(L, 1);
+    if (!stack) return 0;
+
+    for (std::vector<ChunksZip>::reverse_iterator it = stack->m_chunksZips.rbegin(); it != stack->m_chunksZips.rend(); ++it)
+    {
+        CCZipFile *zip = it->zip;
+        if (!zip->fileExists(moduleName)) continue;
+
+        struct cc_timeval start, end;
+        CCTime::gettimeofdayCocos2d(&start, NULL);
+
+        unsigned long chunkSize = 0;
+        unsigned char *buffer = NULL;
+        const unsigned char *chunk = zip->getFileView(moduleName, &chunkSize);
+        if (!chunk)
         {
-            delete []zipFileData;
+            buffer = zip->getFileData(moduleName, &chunkSize);
+            chunk = buffer;
         }
+        // lua_loadbuffer decrypts the chunks encrypted by xxtea_chunk
+        int ret = chunk ? lua_loadbuffer(L, (const char*)chunk, (int)chunkSize, moduleName) : 1;
         if (buffer)
         {
-            free(buffer);
+            delete []buffer;
+        }
+        if (!chunk)
+        {
+            lua_pushfstring(L, "\n\tcannot read chunk '%s' from zip", moduleName);
         }
-    } while (0);
 
+        CCTime::gettimeofdayCocos2d(&end, NULL);
+        if (ret == 0)
+        {
+            stack->m_chunksStats.loadedChunks++;
+            stack->m_chunksStats.loadedBytes += chunkSize;
+            stack->m_chunksStats.loadTime += CCTime::timersubCocos2d(&start, &end) / 1000.0f;
+        }
+        // the compiled chunk, or the error message
+        return 1;
+    }
+
+    lua_pushfstring(L, "\n\tno chunk '%s' in mounted zips", moduleName);
     return 1;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// bytecode cache: one file per Lua file, named after the hash of its path
+// header: "CCLB" version flags mtime sourceSize sourceCrc pathLength, then the path and the bytecode
+//////////////////////////////////////////////////////////////////////////
+#define CC_LUA_BYTECODE_CACHE_MAGIC     "CCLB"
+#define CC_LUA_BYTECODE_CACHE_VERSION   1
+#define CC_LUA_BYTECODE_CACHE_EXTNAME   ".ljbc"
+#define CC_LUA_BYTECODE_CACHE_STRIPPED  1
+
+typedef struct
+{
+    char magic[4];
+    unsigned int version;
+    unsigned int flags;
+    unsigned int mtime;
+    unsigned int sourceSize;
+    unsigned int sourceCrc;
+    unsigned int pathLength;
+    unsigned int reserved;
+} ccLuaBytecodeCacheHeader;
+
+static void fillBytecodeCacheHeader(ccLuaBytecodeCacheHeader *header, const char *chunk, int chunkSize, const char *fullPath, bool stripped)
+{
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, CC_LUA_BYTECODE_CACHE_MAGIC, 4);
+    header->version = CC_LUA_BYTECODE_CACHE_VERSION;
+    header->flags = stripped ? CC_LUA_BYTECODE_CACHE_STRIPPED : 0;
+    // the files of an apk have no modification time, their content is checked anyway
+    struct stat st;
+    header->mtime = stat(fullPath, &st) == 0 ? (unsigned int)st.st_mtime : 0;
+    header->sourceSize = (unsigned int)chunkSize;
+    header->sourceCrc = (unsigned int)crc32(crc32(0L, Z_NULL, 0), (const Bytef*)chunk, (uInt)chunkSize);
+    header->pathLength = (unsigned int)strlen(fullPath);
+}
+
+void CCLuaStack::setBytecodeCacheEnabled(bool enabled, bool stripDebugInfo /* = false */)
+{
+    m_bytecodeCacheEnabled = enabled;
+    m_bytecodeCacheStripped = stripDebugInfo;
+}
+
+bool CCLuaStack::isBytecodeCacheEnabled(void)
+{
+    return m_bytecodeCacheEnabled;
+}
+
+void CCLuaStack::setBytecodeCachePath(const char *path)
+{
+    m_bytecodeCachePath = path ? path : "";
+    if (m_bytecodeCachePath.length() > 0 && m_bytecodeCachePath[m_bytecodeCachePath.length() - 1] != '/')
+    {
+        m_bytecodeCachePath.append("/");
+    }
+}
+
+const std::string& CCLuaStack::getBytecodeCachePath(void)
+{
+    if (m_bytecodeCachePath.length() == 0)
+    {
+        setBytecodeCachePath((CCFileUtils::sharedFileUtils()->getWritablePath() + "luacache/").c_str());
+    }
+    return m_bytecodeCachePath;
+}
+
+void CCLuaStack::clearBytecodeCache(void)
+{
+    const std::string& path = getBytecodeCachePath();
+    size_t extnameLength = strlen(CC_LUA_BYTECODE_CACHE_EXTNAME);
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    WIN32_FIND_DATAA data;
+    HANDLE find = FindFirstFileA((path + "*" CC_LUA_BYTECODE_CACHE_EXTNAME).c_str(), &data);
+    if (find == INVALID_HANDLE_VALUE) return;
+    do
+    {
+        DeleteFileA((path + data.cFileName).c_str());
+    } while (FindNextFileA(find, &data));
+    FindClose(find);
+#else
+    DIR *dir = opendir(path.c_str());
+    if (!dir) return;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        size_t length = strlen(entry->d_name);
+        if (length > extnameLength && strcmp(entry->d_name + length - extnameLength, CC_LUA_BYTECODE_CACHE_EXTNAME) == 0)
+        {
+            unlink((path + entry->d_name).c_str());
+        }
+    }
+    closedir(dir);
+#endif
+}
+
+std::string CCLuaStack::bytecodeCacheFilename(const char *fullPath)
+{
+    // FNV-1a and crc of the path, a collision only makes the two files miss the cache
+    unsigned int hash = 2166136261u;
+    for (const char *p = fullPath; *p; ++p)
+    {
+        hash = (hash ^ (unsigned char)*p) * 16777619u;
+    }
+    unsigned int crc = (unsigned int)crc32(crc32(0L, Z_NULL, 0), (const Bytef*)fullPath, (uInt)strlen(fullPath));
+    char filename[32];
+    sprintf(filename, "%08x%08x" CC_LUA_BYTECODE_CACHE_EXTNAME, hash, crc);
+    return getBytecodeCachePath() + filename;
+}
+
+bool CCLuaStack::loadCachedBytecode(const char *chunk, int chunkSize, const char *fullPath)
+{
+    std::string cacheFilename = bytecodeCacheFilename(fullPath);
+    FILE *fp = fopen(cacheFilename.c_str(), "rb");
+    if (!fp) return false;
+
+    bool loaded = false;
+    ccLuaBytecodeCacheHeader expected, header;
+    fillBytecodeCacheHeader(&expected, chunk, chunkSize, fullPath, m_bytecodeCacheStripped);
+    std::string path(expected.pathLength, '\0');
+    if (fread(&header, sizeof(header), 1, fp) == 1 && memcmp(&header, &expected, sizeof(header)) == 0
+        && fread(&path[0], 1, header.pathLength, fp) == header.pathLength && path == fullPath)
+    {
+        long start = ftell(fp);
+        fseek(fp, 0, SEEK_END);
+        long size = ftell(fp) - start;
+        fseek(fp, start, SEEK_SET);
+        if (size > 0)
+        {
+            char *bytecode = new char[size];
+            // the bytecode of another version of LuaJIT doesn't load, the file is then compiled again
+            if (fread(bytecode, 1, size, fp) == (size_t)size)
+            {
+                loaded = luaL_loadbuffer(m_state, bytecode, size, fullPath) == 0;
+                if (!loaded)
+                {
+                    lua_pop(m_state, 1);
+                }
+            }
+            delete []bytecode;
+        }
+    }
+    fclose(fp);
+    return loaded;
+}
+
+void CCLuaStack::cacheBytecode(const char *chunk, int chunkSize, const char *fullPath)
+{
+    // the compiled function is on the top of the stack, string.dump() strips it when asked
+    std::string cacheFilename = bytecodeCacheFilename(fullPath);
+    std::string tempFilename = cacheFilename + ".tmp";
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
+    CreateDirectoryA(getBytecodeCachePath().c_str(), NULL);
+#else
+    mkdir(getBytecodeCachePath().c_str(), 0755);
+#endif
+    FILE *fp = fopen(tempFilename.c_str(), "wb");
+    if (!fp) return;
+
+    ccLuaBytecodeCacheHeader header;
+    fillBytecodeCacheHeader(&header, chunk, chunkSize, fullPath, m_bytecodeCacheStripped);
+    bool written = fwrite(&header, sizeof(header), 1, fp) == 1 && fwrite(fullPath, 1, header.pathLength, fp) == header.pathLength;
+    if (written)
+    {
+        lua_getglobal(m_state, "string");                               /* L: func string */
+        lua_getfield(m_state, -1, "dump");                              /* L: func string dump */
+        lua_remove(m_state, -2);                                        /* L: func dump */
+        lua_pushvalue(m_state, -2);                                     /* L: func dump func */
+        lua_pushboolean(m_state, m_bytecodeCacheStripped);              /* L: func dump func strip */
+        written = lua_pcall(m_state, 2, 1, 0) == 0;                     /* L: func bytecode */
+        size_t size = 0;
+        const char *bytecode = written ? lua_tolstring(m_state, -1, &size) : NULL;
+        written = bytecode && size > 0 && fwrite(bytecode, 1, size, fp) == size;
+        lua_pop(m_state, 1);                                            /* L: func */
+    }
+    fclose(fp);
+
+    // the cache file is replaced at once, a crash while writing it can't leave it truncated
+    remove(cacheFilename.c_str());
+    if (!written || rename(tempFilename.c_str(), cacheFilename.c_str()) != 0)
+    {
+        remove(tempFilename.c_str());
+    }
+}
+
+int CCLuaStack::lua_loadfilebuffer(lua_State *L, const char *chunk, int chunkSize, const char *fullPath)
+{
+    CCLuaStack *stack = CCLuaStack::stack(L);
+    // the files already compiled or encrypted go as they are
+    if (!stack || !stack->m_bytecodeCacheEnabled || !chunk || chunkSize <= 0 || chunk[0] == LUA_SIGNATURE[0]
+        || (stack->m_xxteaEnabled && chunkSize >= stack->m_xxteaSignLen && strncmp(chunk, stack->m_xxteaSign, stack->m_xxteaSignLen) == 0))
+    {
+        return lua_loadbuffer(L, chunk, chunkSize, fullPath);
+    }
+
+    if (stack->loadCachedBytecode(chunk, chunkSize, fullPath))
+    {
+        stack->m_chunksStats.cacheHits++;
+        return 0;
+    }
+
+    int r = lua_loadbuffer(L, chunk, chunkSize, fullPath);
+    if (r == 0)
+    {
+        stack->m_chunksStats.cacheMisses++;
+        stack->cacheBytecode(chunk, chunkSize, fullPath);
+    }
+    return r;
+}
+
 int CCLuaStack::lua_loadbuffer(lua_State *L, const char *chunk, int chunkSize, const char *chunkName)
 {
     CCLuaStack *stack = CCLuaStack::stack(L);
@@ -737,6 +1147,8 @@ int CCLuaStack::lua_loadbuffer(lua_State *L, const char *chunk, int chunkSize, c
 
 int CCLuaStack::executeFunctionReturnArray(int nHandler,int nNumArgs,int nNummResults,CCArray* pResultArray)
 {
+    CC_PROFILER_ZONE("CCLuaStack - executeFunctionReturnArray");
+
     if (NULL == pResultArray)
         return 0;
 
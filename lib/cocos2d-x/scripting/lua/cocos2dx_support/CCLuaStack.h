@@ -26,6 +26,8 @@
 #define __CC_LUA_STACK_H_
 
 #include <map>
+#include <vector>
+#include <string>
 
 extern "C" {
 #include "lua.h"
@@ -42,6 +44,22 @@ NS_CC_BEGIN
 #define CC_DEFAULT_XXTEA_SIGN_LEN   5
 
 class CCLuaStack;
+class CCZipFile;
+
+/** Chunks of the zips mounted with CCLuaStack::mountChunksFromZip(), and Lua files loaded through the bytecode cache */
+typedef struct _ccLuaChunksStats
+{
+    //! mounted zips, and chunks in them
+    unsigned int archives;
+    unsigned int chunks;
+    //! chunks compiled by require(), their size and the time spent to read and compile them, in seconds
+    unsigned int loadedChunks;
+    unsigned long loadedBytes;
+    float loadTime;
+    //! Lua files loaded from the bytecode cache, and compiled then cached
+    unsigned int cacheHits;
+    unsigned int cacheMisses;
+} ccLuaChunksStats;
 
 typedef std::map<lua_State*, CCLuaStack*> CCLuaStackMap;
 typedef CCLuaStackMap::iterator CCLuaStackMapIterator;
@@ -130,6 +148,29 @@ public:
 
     virtual int loadChunksFromZip(const char *zipFilePath);
 
+    /**
+     @brief Mount a zip of chunks made by compile_scripts, a chunk is only decrypted and compiled when its module is required.
+     The chunks of the zips mounted last are found first, before the Lua files of the search paths.
+     @return 1 if the zip is mounted.
+     */
+    virtual int mountChunksFromZip(const char *zipFilePath);
+    const ccLuaChunksStats& getChunksStats(void);
+
+    /**
+     @brief Cache the bytecode of the Lua files compiled from their sources, the cached bytecode is loaded
+     instead of parsing the file again while its path, modification time and content don't change.
+     @param stripDebugInfo whether the cached bytecode drops the line numbers and the names of the locals.
+     */
+    virtual void setBytecodeCacheEnabled(bool enabled, bool stripDebugInfo = false);
+    bool isBytecodeCacheEnabled(void);
+
+    /** Directory of the cached bytecode, "luacache/" in the writable path by default */
+    virtual void setBytecodeCachePath(const char *path);
+    const std::string& getBytecodeCachePath(void);
+
+    /** Remove the cached bytecode */
+    virtual void clearBytecodeCache(void);
+
     virtual void setXXTEAKeyAndSign(const char *key, int keyLen);
     virtual void setXXTEAKeyAndSign(const char *key, int keyLen, const char *sign, int signLen);
     virtual bool handleAssert(const char *msg);
@@ -143,7 +184,10 @@ protected:
     , m_xxteaSign(NULL)
     , m_xxteaSignLen(0)
     , m_callFromLua(0)
+    , m_bytecodeCacheEnabled(false)
+    , m_bytecodeCacheStripped(false)
     {
+        memset(&m_chunksStats, 0, sizeof(m_chunksStats));
     }
 
     bool init(void);
@@ -160,11 +204,38 @@ protected:
     char *m_xxteaSign;
     int   m_xxteaSignLen;
 
+    /** A zip of chunks and the buffer it is read from */
+    struct ChunksZip
+    {
+        CCZipFile *zip;
+        const unsigned char *view;  //!< a file view of a mounted pack, released with the zip
+        unsigned char *data;
+        void *decrypted;
+    };
+    std::vector<ChunksZip> m_chunksZips;
+    ccLuaChunksStats m_chunksStats;
+
+    bool m_bytecodeCacheEnabled;
+    bool m_bytecodeCacheStripped;
+    std::string m_bytecodeCachePath;
+
+    std::string bytecodeCacheFilename(const char *fullPath);
+    bool loadCachedBytecode(const char *chunk, int chunkSize, const char *fullPath);
+    void cacheBytecode(const char *chunk, int chunkSize, const char *fullPath);
+
+    static CCZipFile *createChunksZip(CCLuaStack *stack, const std::string &zipFilePath, ChunksZip *chunksZip);
+    static void releaseChunksZip(ChunksZip *chunksZip);
+
 public:
     static int lua_print(lua_State *L);
     static int lua_execute(lua_State *L, int numArgs, bool removeResult);
     static int lua_loadChunksFromZIP(lua_State *L);
+    static int lua_mountChunksFromZIP(lua_State *L);
+    static int lua_getChunksStats(lua_State *L);
+    static int lua_chunksZipLoader(lua_State *L);
     static int lua_loadbuffer(lua_State *L, const char *chunk, int chunkSize, const char *chunkName);
+    /** Loads the content of a Lua file, through the bytecode cache when it is enabled */
+    static int lua_loadfilebuffer(lua_State *L, const char *chunk, int chunkSize, const char *fullPath);
 };
 
 NS_CC_END
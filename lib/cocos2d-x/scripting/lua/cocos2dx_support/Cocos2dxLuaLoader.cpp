@@ -91,7 +91,7 @@ extern "C"
 
         if (chunk)
         {
-            CCLuaStack::lua_loadbuffer(L, (char*)chunk, (int)chunkSize, chunkName.c_str());
+            CCLuaStack::lua_loadfilebuffer(L, (char*)chunk, (int)chunkSize, chunkName.c_str());
             delete []chunk;
         }
         else
@@ -131,7 +131,6 @@ local CCObjectTypes = {
     "CCPointShape",
     "CCPolygonShape",
     "CCProfiler",
-    "CCProfilingTimer",
     "CCProgressFromTo",
     "CCProgressTimer",
     "CCProgressTo",
@@ -0,0 +1,117 @@
+/*
+ * Headless driver of the linux platform.
+ *
+ * Runs a scene of sprites, a batch node, a particle system, primitives and the stats labels
+ * for a number of frames (120 by default, or the first argument) with a fixed time step.
+ * Built with NULL_GL=1, the GL calls are validated by the null GL and the driver fails
+ * when one of them was invalid or nothing was drawn.
+ */
+
+#include "cocos2d.h"
+#include "support/CCGLRecorder.h"
+
+USING_NS_CC;
+
+class HeadlessApplication : public CCApplication
+{
+public:
+    virtual bool applicationDidFinishLaunching()
+    {
+        CCDirector* pDirector = CCDirector::sharedDirector();
+        pDirector->setOpenGLView(CCEGLView::sharedOpenGLView());
+        pDirector->setDisplayStats(true);
+        pDirector->runWithScene(createScene());
+        return true;
+    }
+
+    virtual void applicationDidEnterBackground()
+    {
+        CCDirector::sharedDirector()->stopAnimation();
+    }
+
+    virtual void applicationWillEnterForeground()
+    {
+        CCDirector::sharedDirector()->startAnimation();
+    }
+
+private:
+    CCScene* createScene()
+    {
+        CCScene* pScene = CCScene::create();
+        CCSize size = CCDirector::sharedDirector()->getWinSize();
+        pScene->addChild(CCLayerColor::create(ccc4(32, 32, 48, 255)));
+
+        // a checkerboard texture, so the driver needs no resource file
+        static const unsigned int kTextureSize = 32;
+        unsigned int pixels[kTextureSize * kTextureSize];
+        for (unsigned int y = 0; y < kTextureSize; y++)
+        {
+            for (unsigned int x = 0; x < kTextureSize; x++)
+            {
+                pixels[y * kTextureSize + x] = ((x / 8 + y / 8) % 2) ? 0xffffffff : 0xff4080ff;
+            }
+        }
+        CCTexture2D* pTexture = new CCTexture2D();
+        pTexture->initWithData(pixels, kCCTexture2DPixelFormat_RGBA8888, kTextureSize, kTextureSize,
+                               CCSizeMake(kTextureSize, kTextureSize));
+        pTexture->autorelease();
+
+        CCSpriteBatchNode* pBatch = CCSpriteBatchNode::createWithTexture(pTexture);
+        pScene->addChild(pBatch);
+        for (int i = 0; i < 64; i++)
+        {
+            CCSprite* pSprite = CCSprite::createWithTexture(pTexture);
+            pSprite->setPosition(ccp(40 + (i % 16) * (size.width - 80) / 15, size.height - 40 - (i / 16) * 48));
+            pSprite->runAction(CCRepeatForever::create(CCRotateBy::create(1.0f, 90 + i * 5)));
+            pBatch->addChild(pSprite);
+        }
+
+        for (int i = 0; i < 8; i++)
+        {
+            CCSprite* pSprite = CCSprite::createWithTexture(pTexture);
+            pSprite->setPosition(ccp(60 + i * 64, size.height / 2));
+            pSprite->runAction(CCRepeatForever::create(CCSequence::createWithTwoActions(
+                CCMoveBy::create(0.5f, ccp(0, 40)), CCMoveBy::create(0.5f, ccp(0, -40)))));
+            pScene->addChild(pSprite);
+        }
+
+        CCParticleSun* pSun = CCParticleSun::create();
+        pSun->setPosition(ccp(size.width * 0.75f, size.height / 2));
+        pScene->addChild(pSun);
+
+        CCDrawNode* pDrawNode = CCDrawNode::create();
+        CCPoint triangle[] = { ccp(40, 120), ccp(160, 120), ccp(100, 220) };
+        pDrawNode->drawPolygon(triangle, 3, ccc4f(0, 1, 0, 0.5f), 2, ccc4f(1, 1, 1, 1));
+        pDrawNode->drawSegment(ccp(200, 120), ccp(400, 220), 4, ccc4f(1, 0, 0, 1));
+        pDrawNode->drawDot(ccp(480, 160), 20, ccc4f(0, 0, 1, 1));
+        pScene->addChild(pDrawNode);
+
+        return pScene;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    HeadlessApplication app;
+    CCEGLView::sharedOpenGLView()->setFrameSize(960, 640);
+    app.setFixedTimeStep(true);
+    app.setMaxFrames(argc > 1 ? atoi(argv[1]) : 120);
+    app.run();
+
+    CCGLRecorder* pRecorder = CCGLRecorder::sharedRecorder();
+    if (! pRecorder->isActive())
+    {
+        CCLog("headless: %u frames rendered", CCDirector::sharedDirector()->getTotalFrames());
+        return 0;
+    }
+
+    pRecorder->dumpStats();
+    const ccGLFrameStats& stats = pRecorder->getTotalStats();
+    if (stats.errors > 0 || stats.drawCalls == 0)
+    {
+        CCLog("headless: FAILED, %u invalid GL calls, %u draw calls", stats.errors, stats.drawCalls);
+        return 1;
+    }
+    CCLog("headless: OK, %u draw calls", stats.drawCalls);
+    return 0;
+}
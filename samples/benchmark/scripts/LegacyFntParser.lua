@@ -0,0 +1,97 @@
+
+-- a copy of the line by line FNT parser that CCBMFontConfiguration used before the in place and binary parsers,
+-- kept to compare them: each line is cut from the rest of the file, and each field from its line
+
+local LegacyFntParser = {}
+
+local find = string.find
+local sub = string.sub
+local match = string.match
+
+-- "key=value" up to the next space, like line.substr(index, index2 - index) then sscanf
+local function value(line, key)
+    local index = find(line, key, 1, true)
+    local index2 = find(line, " ", index, true)
+    return sub(line, index, index2 and index2 - 1 or -1)
+end
+
+local function number(line, key)
+    return tonumber(match(value(line, key), "=(%-?[%d%.]+)"))
+end
+
+local function parseInfoArguments(config, line)
+    -- info face="Script" size=32 bold=0 italic=0 charset="" unicode=1 stretchH=100 smooth=1 aa=1 padding=1,4,3,2 spacing=0,0 outline=0
+    local top, right, bottom, left = match(value(line, "padding="), "padding=(%-?%d+),(%-?%d+),(%-?%d+),(%-?%d+)")
+    config.padding = {top = tonumber(top), right = tonumber(right), bottom = tonumber(bottom), left = tonumber(left)}
+end
+
+local function parseCommonArguments(config, line)
+    -- common lineHeight=104 base=26 scaleW=1024 scaleH=512 pages=1 packed=0
+    config.commonHeight = number(line, "lineHeight=")
+    assert(number(line, "pages=") == 1, "CCBitfontAtlas: only supports 1 page")
+end
+
+local function parseImageFileName(config, line, fntFile)
+    -- page id=0 file="bitmapFontTest.png"
+    assert(number(line, "id=") == 0, "LabelBMFont file could not be found")
+    local index = find(line, '"', 1, true) + 1
+    local index2 = find(line, '"', index, true)
+    config.atlasName = CCFileUtils:sharedFileUtils():fullPathFromRelativeFile(sub(line, index, index2 - 1), fntFile)
+end
+
+local function parseCharacterDefinition(line)
+    -- char id=32   x=0     y=0     width=0     height=0     xoffset=0     yoffset=44    xadvance=14     page=0  chnl=0
+    return {
+        charID   = number(line, "id="),
+        x        = number(line, "x="),
+        y        = number(line, "y="),
+        width    = number(line, "width="),
+        height   = number(line, "height="),
+        xOffset  = number(line, "xoffset="),
+        yOffset  = number(line, "yoffset="),
+        xAdvance = number(line, "xadvance="),
+    }
+end
+
+local function parseKerningEntry(config, line)
+    -- kerning first=121  second=44  amount=-7
+    local first = number(line, "first=")
+    local second = number(line, "second=")
+    config.kernings[first * 65536 + second] = number(line, "amount=")
+end
+
+-- parses the contents of a text FNT file, returns the font definitions, kernings, padding, line height and atlas name
+function LegacyFntParser.parse(contents, fntFile)
+    local config = {fontDefs = {}, kernings = {}, characterSet = {}}
+    local strLeft = contents
+    while #strLeft > 0 do
+        local line
+        local pos = find(strLeft, "\n", 1, true)
+        if pos then
+            line = sub(strLeft, 1, pos - 1)
+            strLeft = sub(strLeft, pos + 1)
+        else
+            line = strLeft
+            strLeft = ""
+        end
+
+        if sub(line, 1, 9) == "info face" then
+            parseInfoArguments(config, line)
+        elseif sub(line, 1, 17) == "common lineHeight" then
+            parseCommonArguments(config, line)
+        elseif sub(line, 1, 7) == "page id" then
+            parseImageFileName(config, line, fntFile)
+        elseif sub(line, 1, 7) == "chars c" then
+            -- ignore this line
+        elseif sub(line, 1, 4) == "char" then
+            local fontDef = parseCharacterDefinition(line)
+            config.fontDefs[fontDef.charID] = fontDef
+            config.characterSet[fontDef.charID] = true
+        elseif sub(line, 1, 13) == "kerning first" then
+            parseKerningEntry(config, line)
+        end
+    end
+    return config
+end
+
+return LegacyFntParser
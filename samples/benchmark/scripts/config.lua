@@ -10,5 +10,18 @@ CONFIG_SCREEN_HEIGHT = 640
 -- auto scale mode
 CONFIG_SCREEN_AUTOSCALE = "FIXED_HEIGHT"
 
+-- log the time of converting the decoded sprite sheet to a texture with the scalar and SIMD pixel conversions at startup
+BENCHMARK_PIXEL_CONVERSION = false
+
+-- add particle systems to the scene, switch between the scalar and SIMD particle updates every 300 frames
+-- and log the CPU time of the frames with each
+BENCHMARK_PARTICLE_KERNELS = false
+
+-- log the time of parsing the font with the legacy line by line parser, the in place text parser
+-- and the binary parser at startup
+BENCHMARK_FNT_PARSERS = false
+
 GAME_TEXTURE_DATA_FILENAME  = "AllSprites.plist"
 GAME_TEXTURE_IMAGE_FILENAME = "AllSprites.png"
+GAME_TEXT_FONT_FILENAME     = "UIFont.fnt"
+GAME_BINARY_FONT_FILENAME   = "UIFontBinary.fnt"
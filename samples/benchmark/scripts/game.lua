@@ -7,11 +7,77 @@ game = {}
 
 function game.startup()
     CCFileUtils:sharedFileUtils():addSearchPath("res/")
+    if BENCHMARK_PIXEL_CONVERSION then
+        game.benchmarkPixelConversion(20)
+    end
+    if BENCHMARK_FNT_PARSERS then
+        game.benchmarkFntParsers(200)
+    end
     display.addSpriteFramesWithFile(GAME_TEXTURE_DATA_FILENAME, GAME_TEXTURE_IMAGE_FILENAME)
 
     game.benchmark()
 end
 
+-- converts the decoded sprite sheet to a RGBA4444 texture, with the scalar then the SIMD pixel conversions
+function game.benchmarkPixelConversion(iterations)
+    local cache = CCTextureCache:sharedTextureCache()
+    local image = CCImage:new()
+    image:initWithImageFile(CCFileUtils:sharedFileUtils():fullPathForFilename(GAME_TEXTURE_IMAGE_FILENAME))
+    local key = "benchmarkPixelConversion"
+    local format = CCTexture2D:defaultAlphaPixelFormat()
+    local vectorized = ccIsPixelConversionVectorized()
+    CCTexture2D:setDefaultAlphaPixelFormat(kCCTexture2DPixelFormat_RGBA4444)
+    for _, simd in ipairs({false, true}) do
+        ccSetPixelConversionVectorized(simd)
+        local start = os.clock()
+        for i = 1, iterations do
+            cache:removeTextureForKey(key)
+            cache:addUIImage(image, key)
+        end
+        printf("pixel conversion, %s: %.3f ms per texture", simd and "SIMD" or "scalar",
+               (os.clock() - start) * 1000 / iterations)
+    end
+    cache:removeTextureForKey(key)
+    image:release()
+    CCTexture2D:setDefaultAlphaPixelFormat(format)
+    ccSetPixelConversionVectorized(vectorized)
+end
+
+-- parses the text font with the legacy line by line parser and the in place parser, and its binary conversion
+function game.benchmarkFntParsers(iterations)
+    local LegacyFntParser = require("LegacyFntParser")
+    local fullPath = CCFileUtils:sharedFileUtils():fullPathForFilename(GAME_TEXT_FONT_FILENAME)
+    local start = os.clock()
+    local config
+    for i = 1, iterations do
+        config = LegacyFntParser.parse(CCString:createWithContentsOfFile(fullPath):getCString(), fullPath)
+    end
+    local glyphs, kernings = 0, 0
+    for _ in pairs(config.fontDefs) do glyphs = glyphs + 1 end
+    for _ in pairs(config.kernings) do kernings = kernings + 1 end
+    printf("FNT parser, by lines: %.3f ms, %d glyphs, %d kernings",
+           (os.clock() - start) * 1000 / iterations, glyphs, kernings)
+
+    -- CCBMFontConfiguration is reached through CCLabelBMFont, the time of creating a label
+    -- from the cached configuration is taken off
+    CCLabelBMFont:create("", GAME_TEXT_FONT_FILENAME)
+    start = os.clock()
+    for i = 1, iterations do
+        CCLabelBMFont:create("", GAME_TEXT_FONT_FILENAME)
+    end
+    local cached = os.clock() - start
+    for _, font in ipairs({GAME_TEXT_FONT_FILENAME, GAME_BINARY_FONT_FILENAME}) do
+        start = os.clock()
+        for i = 1, iterations do
+            CCLabelBMFont:purgeCachedData()
+            CCLabelBMFont:create("", font)
+        end
+        printf("FNT parser, %s: %.3f ms", font == GAME_TEXT_FONT_FILENAME and "in place" or "binary",
+               (os.clock() - start - cached) * 1000 / iterations)
+    end
+    CCLabelBMFont:purgeCachedData()
+end
+
 function game.exit()
     os.exit()
 end
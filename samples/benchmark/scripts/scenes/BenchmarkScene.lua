@@ -33,12 +33,22 @@ function BenchmarkScene:ctor()
 
     self.label = ui.newBMFontLabel({
         text = "00000",
-        font = "UIFont.fnt",
+        font = GAME_TEXT_FONT_FILENAME,
         x = display.cx,
         y = display.top - 40,
     })
     self:addChild(self.label)
 
+    if BENCHMARK_PARTICLE_KERNELS then
+        for i = 1, 4 do
+            local particles = CCParticleGalaxy:createWithTotalParticles(2500)
+            particles:setPosition(display.left + display.width * i / 5, display.cy)
+            self:addChild(particles)
+        end
+        self.particleFrames = 0
+        self.particleClock = os.clock()
+    end
+
     self.coins = {}
     self.state = "IDLE"
 
@@ -106,6 +116,22 @@ function BenchmarkScene:onEnterFrame(dt)
         local coin = coins[i]
         coin:onEnterFrame(dt)
     end
+
+    if self.particleFrames then
+        self:updateParticleKernelsBenchmark()
+    end
+end
+
+function BenchmarkScene:updateParticleKernelsBenchmark()
+    self.particleFrames = self.particleFrames + 1
+    if self.particleFrames == 300 then
+        local clock = os.clock()
+        printf("particles, %s: %.3f ms of CPU per frame", ccIsParticleKernelsVectorized() and "SIMD" or "scalar",
+               (clock - self.particleClock) * 1000 / self.particleFrames)
+        ccSetParticleKernelsVectorized(not ccIsParticleKernelsVectorized())
+        self.particleFrames = 0
+        self.particleClock = clock
+    end
 end
 
 function BenchmarkScene:onEnter()
@@ -1,8 +1,4 @@
 
--- avoid memory leak
-collectgarbage("setpause", 100)
-collectgarbage("setstepmul", 5000)
-
 require "mainMenu"
 ----------------
 
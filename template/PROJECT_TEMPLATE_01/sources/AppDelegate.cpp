@@ -40,7 +40,7 @@ bool AppDelegate::applicationDidFinishLaunching()
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS || CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
     // load framework
-    pStack->loadChunksFromZip("res/framework_precompiled.zip");
+    pStack->mountChunksFromZip("res/framework_precompiled.zip");
 
     // set script path
     string path = CCFileUtils::sharedFileUtils()->fullPathForFilename("scripts/main.lua");
@@ -49,7 +49,7 @@ bool AppDelegate::applicationDidFinishLaunching()
     if (m_projectConfig.isLoadPrecompiledFramework())
     {
         const string precompiledFrameworkPath = SimulatorConfig::sharedDefaults()->getPrecompiledFrameworkPath();
-        pStack->loadChunksFromZip(precompiledFrameworkPath.c_str());
+        pStack->mountChunksFromZip(precompiledFrameworkPath.c_str());
     }
 
     // set script path